@@ -41,6 +41,7 @@
 #include "servers/display/display_server.h"
 #include "servers/rendering/rendering_server.h"
 #include "servers/rendering/rendering_server_types.h"
+#include "servers/rendering/shader_compiler.h"
 
 #define _EXT_DEBUG_OUTPUT_SYNCHRONOUS_ARB 0x8242
 #define _EXT_DEBUG_NEXT_LOGGED_MESSAGE_LENGTH_ARB 0x8243
@@ -357,6 +358,7 @@ RasterizerGLES3::RasterizerGLES3() {
 
 				if (!shader_cache_dir.is_empty()) {
 					ShaderGLES3::set_shader_cache_dir(shader_cache_dir);
+					ShaderCompiler::set_cache_dir(shader_cache_dir.path_join("shader_compiler"));
 				}
 			}
 		}
@@ -2338,6 +2338,13 @@ void MaterialStorage::shader_set_code(RID p_shader, const String &p_code) {
 	}
 }
 
+void MaterialStorage::shaders_set_code(const Vector<RID> &p_shaders, const Vector<String> &p_codes) {
+	ERR_FAIL_COND(p_shaders.size() != p_codes.size());
+	for (int i = 0; i < p_shaders.size(); i++) {
+		shader_set_code(p_shaders[i], p_codes[i]);
+	}
+}
+
 void MaterialStorage::shader_set_path_hint(RID p_shader, const String &p_path) {
 	GLES3::Shader *shader = shader_owner.get_or_null(p_shader);
 	ERR_FAIL_NULL(shader);
@@ -35,6 +35,7 @@
 #include "core/object/class_db.h"
 #include "core/os/os.h"
 #include "core/variant/typed_array.h"
+#include "scene/animation/animation_mixer.h"
 #include "scene/main/node.h"
 #include "scene/main/scene_tree.h"
 #include "servers/audio/audio_server.h"
@@ -135,6 +136,9 @@ void Performance::_bind_methods() {
 	BIND_ENUM_CONSTANT(NAVIGATION_3D_EDGE_FREE_COUNT);
 	BIND_ENUM_CONSTANT(NAVIGATION_3D_OBSTACLE_COUNT);
 #endif // NAVIGATION_3D_DISABLED
+	BIND_ENUM_CONSTANT(ANIMATION_LOD_FULL_RATE);
+	BIND_ENUM_CONSTANT(ANIMATION_LOD_REDUCED_RATE);
+	BIND_ENUM_CONSTANT(ANIMATION_LOD_OFFSCREEN);
 	BIND_ENUM_CONSTANT(MONITOR_MAX);
 
 	BIND_ENUM_CONSTANT(MONITOR_TYPE_QUANTITY);
@@ -230,6 +234,9 @@ String Performance::get_monitor_name(Monitor p_monitor) const {
 		PNAME("navigation_3d/edges_free"),
 		PNAME("navigation_3d/obstacles"),
 #endif // NAVIGATION_3D_DISABLED
+		PNAME("animation/lod_full_rate"),
+		PNAME("animation/lod_reduced_rate"),
+		PNAME("animation/lod_offscreen"),
 	};
 	static_assert(std_size(names) == MONITOR_MAX);
 
@@ -454,6 +461,12 @@ double Performance::get_monitor(Monitor p_monitor) const {
 		case NAVIGATION_3D_OBSTACLE_COUNT:
 			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_OBSTACLE_COUNT);
 #endif // NAVIGATION_3D_DISABLED
+		case ANIMATION_LOD_FULL_RATE:
+			return AnimationMixer::get_lod_state_count(AnimationMixer::LOD_STATE_FULL_RATE);
+		case ANIMATION_LOD_REDUCED_RATE:
+			return AnimationMixer::get_lod_state_count(AnimationMixer::LOD_STATE_REDUCED_RATE);
+		case ANIMATION_LOD_OFFSCREEN:
+			return AnimationMixer::get_lod_state_count(AnimationMixer::LOD_STATE_OFFSCREEN);
 
 		default: {
 		}
@@ -527,6 +540,9 @@ Performance::MonitorType Performance::get_monitor_type(Monitor p_monitor) const
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
 #endif // _3D_DISABLED
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
 
 	};
 	static_assert((sizeof(types) / sizeof(MonitorType)) == MONITOR_MAX);
@@ -122,6 +122,9 @@ public:
 		NAVIGATION_3D_EDGE_FREE_COUNT,
 		NAVIGATION_3D_OBSTACLE_COUNT,
 #endif // _3D_DISABLED
+		ANIMATION_LOD_FULL_RATE,
+		ANIMATION_LOD_REDUCED_RATE,
+		ANIMATION_LOD_OFFSCREEN,
 		MONITOR_MAX
 	};
 
@@ -32,6 +32,58 @@
 
 #include "godot_collision_solver_2d.h"
 
+GodotConstraint2D::SortKey GodotAreaPair2D::get_sort_key() const {
+	SortKey key;
+	key.objects[0] = area->get_self();
+	key.objects[1] = body->get_self();
+	key.shapes[0] = area_shape;
+	key.shapes[1] = body_shape;
+	return key;
+}
+
+void GodotAreaPair2D::save_snapshot(uint8_t *r_buffer) const {
+	SnapshotWriter writer;
+	writer.ptr = r_buffer;
+	writer.write(uint8_t(colliding));
+	writer.write(uint8_t(body_has_attached_area));
+}
+
+void GodotAreaPair2D::restore_snapshot(const uint8_t *p_buffer) {
+	uint8_t was_colliding = 0;
+	uint8_t had_attached_area = 0;
+	if (p_buffer) {
+		SnapshotReader reader;
+		reader.ptr = p_buffer;
+		reader.end = p_buffer + get_snapshot_size();
+		reader.read(was_colliding);
+		reader.read(had_attached_area);
+	}
+
+	// Same as pre_solve(), so the body and the area see the overlap end or start again.
+	if (bool(had_attached_area) != body_has_attached_area) {
+		body_has_attached_area = had_attached_area;
+		if (body_has_attached_area) {
+			body->add_area(area);
+		} else {
+			body->remove_area(area);
+		}
+	}
+
+	if (bool(was_colliding) != colliding) {
+		colliding = was_colliding;
+		if (area->has_monitor_callback()) {
+			if (colliding) {
+				area->add_body_to_query(body, body_shape, area_shape);
+			} else {
+				area->remove_body_from_query(body, body_shape, area_shape);
+			}
+		}
+	}
+
+	process_collision = false;
+	has_space_override = false;
+}
+
 bool GodotAreaPair2D::setup(real_t p_step) {
 	bool result = false;
 	if (area->collides_with(body) && GodotCollisionSolver2D::solve(body->get_shape(body_shape), body->get_transform() * body->get_shape_transform(body_shape), Vector2(), area->get_shape(area_shape), area->get_transform() * area->get_shape_transform(area_shape), Vector2(), nullptr, this)) {
@@ -120,6 +172,15 @@ GodotAreaPair2D::~GodotAreaPair2D() {
 
 //////////////////////////////////
 
+GodotConstraint2D::SortKey GodotArea2Pair2D::get_sort_key() const {
+	SortKey key;
+	key.objects[0] = area_a->get_self();
+	key.objects[1] = area_b->get_self();
+	key.shapes[0] = shape_a;
+	key.shapes[1] = shape_b;
+	return key;
+}
+
 bool GodotArea2Pair2D::setup(real_t p_step) {
 	bool result_a = area_a->collides_with(area_b);
 	bool result_b = area_b->collides_with(area_a);
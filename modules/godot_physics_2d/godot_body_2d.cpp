@@ -149,6 +149,37 @@ void GodotBody2D::set_active(bool p_active) {
 	}
 }
 
+void GodotBody2D::save_snapshot(SnapshotState &r_state) const {
+	r_state.transform = get_transform();
+	r_state.inv_transform = get_inv_transform();
+	r_state.new_transform = new_transform;
+	r_state.linear_velocity = linear_velocity;
+	r_state.applied_force = applied_force;
+	r_state.constant_force = constant_force;
+	r_state.angular_velocity = angular_velocity;
+	r_state.applied_torque = applied_torque;
+	r_state.constant_torque = constant_torque;
+	r_state.still_time = still_time;
+}
+
+void GodotBody2D::restore_snapshot(const SnapshotState &p_state, const Rect2 *p_shape_aabbs) {
+	_set_transform(p_state.transform, p_shape_aabbs == nullptr);
+	_set_inv_transform(p_state.inv_transform);
+	if (p_shape_aabbs) {
+		_set_shape_aabbs(p_shape_aabbs);
+	}
+	new_transform = p_state.new_transform;
+	linear_velocity = p_state.linear_velocity;
+	applied_force = p_state.applied_force;
+	constant_force = p_state.constant_force;
+	angular_velocity = p_state.angular_velocity;
+	applied_torque = p_state.applied_torque;
+	constant_torque = p_state.constant_torque;
+	still_time = p_state.still_time;
+
+	_update_transform_dependent();
+}
+
 void GodotBody2D::set_param(PhysicsServer2D::BodyParameter p_param, const Variant &p_value) {
 	switch (p_param) {
 		case PhysicsServer2D::BODY_PARAM_BOUNCE: {
@@ -284,6 +284,25 @@ public:
 	void set_active(bool p_active);
 	_FORCE_INLINE_ bool is_active() const { return active; }
 
+	// State that changes while simulating, saved in space snapshots. Everything else is set by the user and left alone by a restore.
+	struct SnapshotState {
+		Transform2D transform;
+		Transform2D inv_transform;
+		Transform2D new_transform;
+		Vector2 linear_velocity;
+		Vector2 applied_force;
+		Vector2 constant_force;
+		real_t angular_velocity = 0.0;
+		real_t applied_torque = 0.0;
+		real_t constant_torque = 0.0;
+		real_t still_time = 0.0;
+	};
+
+	void save_snapshot(SnapshotState &r_state) const;
+	// The sleep state is restored by the space, which also keeps track of the order bodies were activated in.
+	// Shape bounds can be null, in which case they are recomputed from the transform.
+	void restore_snapshot(const SnapshotState &p_state, const Rect2 *p_shape_aabbs);
+
 	_FORCE_INLINE_ void wakeup() {
 		if ((!get_space()) || mode == PhysicsServer2D::BODY_MODE_STATIC || mode == PhysicsServer2D::BODY_MODE_KINEMATIC) {
 			return;
@@ -36,6 +36,7 @@
 #define ACCUMULATE_IMPULSES
 
 #define MIN_VELOCITY 0.001
+#define CONTACT_NORMAL_MATCH_THRESHOLD 0.9
 #define MAX_BIAS_ROTATION (Math::PI / 8)
 
 void GodotBodyPair2D::_add_contact(const Vector2 &p_point_A, const Vector2 &p_point_B, void *p_self) {
@@ -56,19 +57,32 @@ void GodotBodyPair2D::_contact_added_callback(const Vector2 &p_point_A, const Ve
 	contact.local_A = local_A;
 	contact.local_B = local_B;
 	contact.normal = (p_point_A - p_point_B).normalized();
-	contact.used = true;
 
-	// Attempt to determine if the contact will be reused.
+	// Warm start from the matching contact of the previous manifold.
+	int match = _find_matching_contact(local_A, local_B, contact.normal);
+	if (match > -1) {
+		Contact &prev = prev_contacts[match];
+		prev.matched = true;
+		contact.prev_match = match;
+		contact.acc_normal_impulse = prev.acc_normal_impulse;
+		contact.acc_tangent_impulse = prev.acc_tangent_impulse;
+	}
+
+	// A contact generated twice in the same step only keeps the latest position.
 	real_t recycle_radius_2 = space->get_contact_recycle_radius() * space->get_contact_recycle_radius();
 
 	for (int i = 0; i < contact_count; i++) {
 		Contact &c = contacts[i];
 		if (c.local_A.distance_squared_to(local_A) < (recycle_radius_2) &&
 				c.local_B.distance_squared_to(local_B) < (recycle_radius_2)) {
-			contact.acc_normal_impulse = c.acc_normal_impulse;
-			contact.acc_tangent_impulse = c.acc_tangent_impulse;
-			contact.acc_bias_impulse = c.acc_bias_impulse;
-			contact.acc_bias_impulse_center_of_mass = c.acc_bias_impulse_center_of_mass;
+			if (match == -1) {
+				contact.acc_normal_impulse = c.acc_normal_impulse;
+				contact.acc_tangent_impulse = c.acc_tangent_impulse;
+				contact.prev_match = c.prev_match;
+			} else if (c.prev_match > -1) {
+				// The replaced contact's match is free again for the next contacts.
+				prev_contacts[c.prev_match].matched = false;
+			}
 			c = contact;
 			return;
 		}
@@ -108,8 +122,14 @@ void GodotBodyPair2D::_contact_added_callback(const Vector2 &p_point_A, const Ve
 		}
 
 		if (least_deep > -1) {
-			// Replace the least deep contact by the new one.
+			// Replace the least deep contact by the new one, and free its match for the next contacts.
+			if (contacts[least_deep].prev_match > -1) {
+				prev_contacts[contacts[least_deep].prev_match].matched = false;
+			}
 			contacts[least_deep] = contact;
+		} else if (match > -1) {
+			// The new contact is dropped, leave its match to the next ones.
+			prev_contacts[match].matched = false;
 		}
 
 		return;
@@ -119,46 +139,49 @@ void GodotBodyPair2D::_contact_added_callback(const Vector2 &p_point_A, const Ve
 	contact_count++;
 }
 
-void GodotBodyPair2D::_validate_contacts() {
-	// Make sure to erase contacts that are no longer valid.
-	real_t max_separation = space->get_contact_max_separation();
-	real_t max_separation2 = max_separation * max_separation;
-
-	const Transform2D &transform_A = A->get_transform();
-	const Transform2D &transform_B = B->get_transform();
-
+void GodotBodyPair2D::_begin_manifold_update() {
+	// The manifold is rebuilt from the contacts generated this step,
+	// the previous one is only kept to carry accumulated impulses over.
 	for (int i = 0; i < contact_count; i++) {
-		Contact &c = contacts[i];
-
-		bool erase = false;
-		if (!c.used) {
-			// Was left behind in previous frame.
-			erase = true;
-		} else {
-			c.used = false;
+		prev_contacts[i] = contacts[i];
+		prev_contacts[i].matched = false;
+	}
+	prev_contact_count = contact_count;
+	contact_count = 0;
+}
 
-			Vector2 global_A = transform_A.basis_xform(c.local_A);
-			Vector2 global_B = transform_B.basis_xform(c.local_B) + offset_B;
-			Vector2 axis = global_A - global_B;
-			real_t depth = axis.dot(c.normal);
+int GodotBodyPair2D::_find_matching_contact(const Vector2 &p_local_A, const Vector2 &p_local_B, const Vector2 &p_normal) const {
+	// Contacts don't carry feature ids from the collision solver, so the feature is identified
+	// by the anchors on both bodies: the closest unmatched previous contact within the recycle
+	// radius on both bodies, whose normal still points the same way, is the same feature.
+	real_t recycle_radius_2 = space->get_contact_recycle_radius() * space->get_contact_recycle_radius();
 
-			if (depth < -max_separation || (global_B + c.normal * depth - global_A).length_squared() > max_separation2) {
-				erase = true;
-			}
+	int best = -1;
+	real_t best_distance = 0.0;
+	for (int i = 0; i < prev_contact_count; i++) {
+		const Contact &prev = prev_contacts[i];
+		if (prev.matched) {
+			continue;
 		}
 
-		if (erase) {
-			// Contact no longer needed, remove.
+		real_t distance_A = prev.local_A.distance_squared_to(p_local_A);
+		real_t distance_B = prev.local_B.distance_squared_to(p_local_B);
+		if (distance_A >= recycle_radius_2 || distance_B >= recycle_radius_2) {
+			continue;
+		}
 
-			if ((i + 1) < contact_count) {
-				// Swap with the last one.
-				SWAP(contacts[i], contacts[contact_count - 1]);
-			}
+		if (prev.normal.dot(p_normal) < CONTACT_NORMAL_MATCH_THRESHOLD && !prev.normal.is_zero_approx() && !p_normal.is_zero_approx()) {
+			continue;
+		}
 
-			i--;
-			contact_count--;
+		real_t distance = distance_A + distance_B;
+		if (best == -1 || distance < best_distance) {
+			best = i;
+			best_distance = distance;
 		}
 	}
+
+	return best;
 }
 
 // `_test_ccd` prevents tunneling by slowing down a high velocity body that is about to collide so
@@ -248,6 +271,109 @@ real_t combine_friction(GodotBody2D *A, GodotBody2D *B) {
 	return Math::abs(MIN(A->get_friction(), B->get_friction()));
 }
 
+GodotConstraint2D::SortKey GodotBodyPair2D::get_sort_key() const {
+	SortKey key;
+	key.objects[0] = A->get_self();
+	key.objects[1] = B->get_self();
+	key.shapes[0] = shape_A;
+	key.shapes[1] = shape_B;
+	return key;
+}
+
+void GodotBodyPair2D::save_snapshot(uint8_t *r_buffer) const {
+	SnapshotWriter writer;
+	writer.ptr = r_buffer;
+	writer.write(sep_axis);
+	writer.write(int32_t(contact_count));
+	// Unused contacts are written as new ones, so they don't carry leftovers from earlier steps into the snapshot.
+	const Contact unused_contact = Contact();
+	for (int i = 0; i < MAX_CONTACTS; i++) {
+		const Contact &c = i < contact_count ? contacts[i] : unused_contact;
+		writer.write(c.position);
+		writer.write(c.normal);
+		writer.write(c.local_A);
+		writer.write(c.local_B);
+		writer.write(c.acc_impulse);
+		writer.write(c.acc_normal_impulse);
+		writer.write(c.acc_tangent_impulse);
+		writer.write(c.acc_bias_impulse);
+		writer.write(c.acc_bias_impulse_center_of_mass);
+		writer.write(c.mass_normal);
+		writer.write(c.mass_tangent);
+		writer.write(c.bias);
+		writer.write(c.depth);
+		writer.write(uint8_t(c.active));
+		writer.write(uint8_t(c.matched));
+		writer.write(int32_t(c.prev_match));
+		writer.write(c.rA);
+		writer.write(c.rB);
+		writer.write(c.bounce);
+	}
+	writer.write(uint8_t(collided));
+	writer.write(uint8_t(oneway_disabled));
+	DEV_ASSERT(writer.ptr == r_buffer + SNAPSHOT_SIZE);
+}
+
+void GodotBodyPair2D::restore_snapshot(const uint8_t *p_buffer) {
+	sep_axis = Vector2();
+	contact_count = 0;
+	prev_contact_count = 0;
+	collided = false;
+	oneway_disabled = false;
+	if (!p_buffer) {
+		return;
+	}
+
+	SnapshotReader reader;
+	reader.ptr = p_buffer;
+	reader.end = p_buffer + SNAPSHOT_SIZE;
+	int32_t count = 0;
+	reader.read(sep_axis);
+	reader.read(count);
+	ERR_FAIL_COND(count < 0 || count > MAX_CONTACTS);
+
+	for (int i = 0; i < MAX_CONTACTS; i++) {
+		Contact &c = contacts[i];
+		if (i >= count) {
+			reader.skip(SNAPSHOT_CONTACT_SIZE);
+			continue;
+		}
+		uint8_t active = 0;
+		uint8_t matched = 0;
+		int32_t prev_match = -1;
+		reader.read(c.position);
+		reader.read(c.normal);
+		reader.read(c.local_A);
+		reader.read(c.local_B);
+		reader.read(c.acc_impulse);
+		reader.read(c.acc_normal_impulse);
+		reader.read(c.acc_tangent_impulse);
+		reader.read(c.acc_bias_impulse);
+		reader.read(c.acc_bias_impulse_center_of_mass);
+		reader.read(c.mass_normal);
+		reader.read(c.mass_tangent);
+		reader.read(c.bias);
+		reader.read(c.depth);
+		reader.read(active);
+		reader.read(matched);
+		reader.read(prev_match);
+		reader.read(c.rA);
+		reader.read(c.rB);
+		reader.read(c.bounce);
+		c.active = active != 0;
+		c.matched = matched != 0;
+		c.prev_match = prev_match;
+	}
+	contact_count = count;
+
+	uint8_t was_collided = 0;
+	uint8_t was_oneway_disabled = 0;
+	reader.read(was_collided);
+	reader.read(was_oneway_disabled);
+	collided = was_collided != 0;
+	oneway_disabled = was_oneway_disabled != 0;
+}
+
 bool GodotBodyPair2D::setup(real_t p_step) {
 	check_ccd = false;
 
@@ -272,7 +398,7 @@ bool GodotBodyPair2D::setup(real_t p_step) {
 	//use local A coordinates to avoid numerical issues on collision detection
 	offset_B = B->get_transform().get_origin() - A->get_transform().get_origin();
 
-	_validate_contacts();
+	_begin_manifold_update();
 
 	const Vector2 &offset_A = A->get_transform().get_origin();
 	Transform2D xform_Au = A->get_transform().untranslated();
@@ -459,6 +585,11 @@ bool GodotBodyPair2D::pre_solve(real_t p_step) {
 		c.bias = -bias * inv_dt * MIN(0.0f, -depth + max_penetration);
 		c.depth = depth;
 
+		// Biased velocities are reset every step, so position correction impulses
+		// must not be carried over like the normal and friction impulses are.
+		c.acc_bias_impulse = 0.0;
+		c.acc_bias_impulse_center_of_mass = 0.0;
+
 		Vector2 P = c.acc_normal_impulse * c.normal + c.acc_tangent_impulse * tangent;
 
 		c.acc_impulse -= P;
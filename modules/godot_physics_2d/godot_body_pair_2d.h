@@ -68,7 +68,8 @@ class GodotBodyPair2D : public GodotConstraint2D {
 
 		real_t depth = 0.0;
 		bool active = false;
-		bool used = false;
+		bool matched = false; // Already used to warm start a contact of the current manifold.
+		int prev_match = -1; // Previous contact this one was warm started from.
 		Vector2 rA, rB;
 		real_t bounce = 0.0;
 	};
@@ -78,17 +79,32 @@ class GodotBodyPair2D : public GodotConstraint2D {
 	Vector2 sep_axis;
 	Contact contacts[MAX_CONTACTS];
 	int contact_count = 0;
+	// Manifold from the previous step, new contacts are matched against it to inherit their impulses.
+	Contact prev_contacts[MAX_CONTACTS];
+	int prev_contact_count = 0;
 	bool collided = false;
 	bool check_ccd = false;
 	bool oneway_disabled = false;
 	bool report_contacts_only = false;
 
+	// Everything that setup() reads from the previous step: the separating axis, the contact count and every contact,
+	// whether the bodies collided and whether the one way collision was disabled.
+	static constexpr uint32_t SNAPSHOT_CONTACT_SIZE = 7 * SNAPSHOT_VECTOR2_SIZE + 9 * sizeof(real_t) + sizeof(int32_t) + 2 * sizeof(uint8_t);
+	static constexpr uint32_t SNAPSHOT_SIZE = SNAPSHOT_VECTOR2_SIZE + sizeof(int32_t) + MAX_CONTACTS * SNAPSHOT_CONTACT_SIZE + 2 * sizeof(uint8_t);
+
 	bool _test_ccd(real_t p_step, GodotBody2D *p_A, int p_shape_A, const Transform2D &p_xform_A, GodotBody2D *p_B, int p_shape_B, const Transform2D &p_xform_B);
-	void _validate_contacts();
+	void _begin_manifold_update();
+	int _find_matching_contact(const Vector2 &p_local_A, const Vector2 &p_local_B, const Vector2 &p_normal) const;
 	static void _add_contact(const Vector2 &p_point_A, const Vector2 &p_point_B, void *p_self);
 	_FORCE_INLINE_ void _contact_added_callback(const Vector2 &p_point_A, const Vector2 &p_point_B);
 
 public:
+	virtual SortKey get_sort_key() const override;
+
+	virtual uint32_t get_snapshot_size() const override { return SNAPSHOT_SIZE; }
+	virtual void save_snapshot(uint8_t *r_buffer) const override;
+	virtual void restore_snapshot(const uint8_t *p_buffer) override;
+
 	virtual bool setup(real_t p_step) override;
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
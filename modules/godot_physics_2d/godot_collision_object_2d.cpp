@@ -186,6 +186,22 @@ void GodotCollisionObject2D::_update_shapes() {
 	}
 }
 
+void GodotCollisionObject2D::_set_shape_aabbs(const Rect2 *p_aabbs) {
+	if (!space) {
+		return;
+	}
+
+	for (int i = 0; i < shapes.size(); i++) {
+		Shape &s = shapes.write[i];
+		s.aabb_cache = p_aabbs[i];
+		if (s.disabled || s.bpid == 0) {
+			continue;
+		}
+
+		space->get_broadphase()->move(s.bpid, s.aabb_cache);
+	}
+}
+
 void GodotCollisionObject2D::_update_shapes_with_motion(const Vector2 &p_motion) {
 	if (!space) {
 		return;
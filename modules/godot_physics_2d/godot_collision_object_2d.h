@@ -79,6 +79,8 @@ private:
 protected:
 	void _update_shapes_with_motion(const Vector2 &p_motion);
 	void _unregister_shapes();
+	// Moves the shapes back to the bounds saved in a space snapshot, motion expansion included.
+	void _set_shape_aabbs(const Rect2 *p_aabbs);
 
 	_FORCE_INLINE_ void _set_transform(const Transform2D &p_transform, bool p_update_shapes = true) {
 		transform = p_transform;
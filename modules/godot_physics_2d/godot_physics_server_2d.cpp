@@ -283,6 +283,43 @@ PhysicsDirectSpaceState2D *GodotPhysicsServer2D::space_get_direct_state(RID p_sp
 	return space->get_direct_state();
 }
 
+PackedByteArray GodotPhysicsServer2D::space_get_snapshot(RID p_space) const {
+	const GodotSpace2D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL_V(space, PackedByteArray());
+	ERR_FAIL_COND_V_MSG(space->is_locked(), PackedByteArray(), "Space state is inaccessible right now, wait for iteration or physics process notification.");
+
+	PackedByteArray snapshot;
+	space->save_snapshot(snapshot);
+	return snapshot;
+}
+
+bool GodotPhysicsServer2D::space_restore_snapshot(RID p_space, const PackedByteArray &p_snapshot) {
+	GodotSpace2D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL_V(space, false);
+	ERR_FAIL_COND_V_MSG(space->is_locked(), false, "Space state is inaccessible right now, wait for iteration or physics process notification.");
+
+	return space->restore_snapshot(p_snapshot);
+}
+
+void GodotPhysicsServer2D::space_set_deterministic(RID p_space, bool p_deterministic) {
+	GodotSpace2D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL(space);
+	space->set_deterministic(p_deterministic);
+}
+
+bool GodotPhysicsServer2D::space_is_deterministic(RID p_space) const {
+	const GodotSpace2D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL_V(space, false);
+	return space->is_deterministic();
+}
+
+uint32_t GodotPhysicsServer2D::space_get_state_hash(RID p_space) const {
+	const GodotSpace2D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL_V(space, 0);
+	ERR_FAIL_COND_V_MSG(space->is_locked(), 0, "Space state is inaccessible right now, wait for iteration or physics process notification.");
+	return space->get_state_hash();
+}
+
 RID GodotPhysicsServer2D::area_create() {
 	GodotArea2D *area = memnew(GodotArea2D);
 	RID rid = area_owner.make_rid(area);
@@ -118,6 +118,15 @@ public:
 	// this function only works on physics process, errors and returns null otherwise
 	virtual PhysicsDirectSpaceState2D *space_get_direct_state(RID p_space) override;
 
+	virtual PackedByteArray space_get_snapshot(RID p_space) const override;
+	virtual bool space_restore_snapshot(RID p_space, const PackedByteArray &p_snapshot) override;
+
+	// Deterministic mode should be set before objects are added to the space, as existing collision pairs keep their order.
+	virtual void space_set_deterministic(RID p_space, bool p_deterministic) override;
+	virtual bool space_is_deterministic(RID p_space) const override;
+	// Hash of the state of every body in the space, to check that two deterministic runs haven't diverged.
+	virtual uint32_t space_get_state_hash(RID p_space) const override;
+
 	/* AREA API */
 
 	virtual RID area_create() override;
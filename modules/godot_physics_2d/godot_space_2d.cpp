@@ -1022,6 +1022,12 @@ void *GodotSpace2D::_broadphase_pair(GodotCollisionObject2D *A, int p_subindex_A
 	GodotSpace2D *self = static_cast<GodotSpace2D *>(p_self);
 	self->collision_pairs++;
 
+	if (self->deterministic && type_A == type_B && B->get_self() < A->get_self()) {
+		// The broadphase reports pairs in whatever order its tree is in, but the solver isn't symmetric.
+		SWAP(A, B);
+		SWAP(p_subindex_A, p_subindex_B);
+	}
+
 	if (type_A == GodotCollisionObject2D::TYPE_AREA) {
 		GodotArea2D *area = static_cast<GodotArea2D *>(A);
 		if (type_B == GodotCollisionObject2D::TYPE_AREA) {
@@ -1200,6 +1206,320 @@ real_t GodotSpace2D::get_param(PhysicsServer2D::SpaceParameter p_param) const {
 	return 0;
 }
 
+uint32_t GodotSpace2D::get_state_hash() const {
+	LocalVector<const GodotBody2D *> bodies;
+	for (const GodotCollisionObject2D *E : objects) {
+		if (E->get_type() == GodotCollisionObject2D::TYPE_BODY) {
+			bodies.push_back(static_cast<const GodotBody2D *>(E));
+		}
+	}
+
+	// RIDs are handed out in creation order, so this is stable across runs even though the RIDs themselves aren't hashed.
+	struct BodyRIDCompare {
+		_FORCE_INLINE_ bool operator()(const GodotBody2D *p_a, const GodotBody2D *p_b) const { return p_a->get_self() < p_b->get_self(); }
+	};
+	bodies.sort_custom<BodyRIDCompare>();
+
+	uint32_t h = hash_murmur3_one_32(bodies.size());
+	for (const GodotBody2D *body : bodies) {
+		const Transform2D &transform = body->get_transform();
+		h = hash_murmur3_one_32(body->get_mode(), h);
+		h = hash_murmur3_one_32(body->is_active() ? 1 : 0, h);
+		for (int i = 0; i < 3; i++) {
+			h = hash_murmur3_one_real(transform.columns[i].x, h);
+			h = hash_murmur3_one_real(transform.columns[i].y, h);
+		}
+		const Vector2 linear_velocity = body->get_linear_velocity();
+		h = hash_murmur3_one_real(linear_velocity.x, h);
+		h = hash_murmur3_one_real(linear_velocity.y, h);
+		h = hash_murmur3_one_real(body->get_angular_velocity(), h);
+	}
+
+	return hash_fmix32(h);
+}
+
+// Snapshots are a header followed by the bodies sorted by RID, each with the bounds of its shapes,
+// the RIDs of the active bodies in activation order and the state of the pairs sorted by key.
+// Values are written one at a time in the byte order of the build, which is the only one meant to restore them.
+static constexpr uint32_t SNAPSHOT_MAGIC = 0x53533247; // "G2SS"
+static constexpr uint32_t SNAPSHOT_VERSION = 2;
+
+struct SnapshotHeader {
+	uint32_t magic = SNAPSHOT_MAGIC;
+	uint32_t version = SNAPSHOT_VERSION;
+	uint32_t real_size = sizeof(real_t);
+	uint32_t body_count = 0;
+	uint32_t active_count = 0;
+	uint32_t pair_count = 0;
+
+	static constexpr uint32_t SIZE = 6 * sizeof(uint32_t);
+};
+
+struct SnapshotBody {
+	uint64_t rid = 0;
+	uint32_t shape_count = 0;
+	GodotBody2D::SnapshotState state;
+
+	static constexpr uint32_t SIZE = sizeof(uint64_t) + sizeof(uint32_t) + 3 * GodotConstraint2D::SNAPSHOT_TRANSFORM_SIZE + 3 * GodotConstraint2D::SNAPSHOT_VECTOR2_SIZE + 4 * sizeof(real_t);
+};
+
+struct SnapshotPair {
+	uint64_t objects[2] = {};
+	int32_t shapes[2] = {};
+	uint32_t size = 0;
+
+	static constexpr uint32_t SIZE = 2 * sizeof(uint64_t) + 2 * sizeof(int32_t) + sizeof(uint32_t);
+};
+
+using SnapshotWriter = GodotConstraint2D::SnapshotWriter;
+using SnapshotReader = GodotConstraint2D::SnapshotReader;
+
+static void _write_snapshot_header(SnapshotWriter &p_writer, const SnapshotHeader &p_header) {
+	p_writer.write(p_header.magic);
+	p_writer.write(p_header.version);
+	p_writer.write(p_header.real_size);
+	p_writer.write(p_header.body_count);
+	p_writer.write(p_header.active_count);
+	p_writer.write(p_header.pair_count);
+}
+
+static bool _read_snapshot_header(SnapshotReader &p_reader, SnapshotHeader &r_header) {
+	return p_reader.read(r_header.magic) && p_reader.read(r_header.version) && p_reader.read(r_header.real_size) && p_reader.read(r_header.body_count) && p_reader.read(r_header.active_count) && p_reader.read(r_header.pair_count);
+}
+
+static void _write_snapshot_body(SnapshotWriter &p_writer, const SnapshotBody &p_body) {
+	p_writer.write(p_body.rid);
+	p_writer.write(p_body.shape_count);
+	p_writer.write(p_body.state.transform);
+	p_writer.write(p_body.state.inv_transform);
+	p_writer.write(p_body.state.new_transform);
+	p_writer.write(p_body.state.linear_velocity);
+	p_writer.write(p_body.state.applied_force);
+	p_writer.write(p_body.state.constant_force);
+	p_writer.write(p_body.state.angular_velocity);
+	p_writer.write(p_body.state.applied_torque);
+	p_writer.write(p_body.state.constant_torque);
+	p_writer.write(p_body.state.still_time);
+}
+
+static bool _read_snapshot_body(SnapshotReader &p_reader, SnapshotBody &r_body) {
+	return p_reader.read(r_body.rid) && p_reader.read(r_body.shape_count) &&
+			p_reader.read(r_body.state.transform) && p_reader.read(r_body.state.inv_transform) && p_reader.read(r_body.state.new_transform) &&
+			p_reader.read(r_body.state.linear_velocity) && p_reader.read(r_body.state.applied_force) && p_reader.read(r_body.state.constant_force) &&
+			p_reader.read(r_body.state.angular_velocity) && p_reader.read(r_body.state.applied_torque) && p_reader.read(r_body.state.constant_torque) &&
+			p_reader.read(r_body.state.still_time);
+}
+
+static void _write_snapshot_pair(SnapshotWriter &p_writer, const SnapshotPair &p_pair) {
+	p_writer.write(p_pair.objects[0]);
+	p_writer.write(p_pair.objects[1]);
+	p_writer.write(p_pair.shapes[0]);
+	p_writer.write(p_pair.shapes[1]);
+	p_writer.write(p_pair.size);
+}
+
+static bool _read_snapshot_pair(SnapshotReader &p_reader, SnapshotPair &r_pair) {
+	return p_reader.read(r_pair.objects[0]) && p_reader.read(r_pair.objects[1]) && p_reader.read(r_pair.shapes[0]) && p_reader.read(r_pair.shapes[1]) && p_reader.read(r_pair.size);
+}
+
+struct SnapshotBodyRIDCompare {
+	_FORCE_INLINE_ bool operator()(const GodotBody2D *p_a, const GodotBody2D *p_b) const { return p_a->get_self() < p_b->get_self(); }
+};
+
+struct SnapshotPairKeyCompare {
+	_FORCE_INLINE_ bool operator()(const GodotConstraint2D *p_a, const GodotConstraint2D *p_b) const { return p_a->get_sort_key() < p_b->get_sort_key(); }
+};
+
+static void _get_snapshot_pairs(const LocalVector<GodotBody2D *> &p_bodies, LocalVector<GodotConstraint2D *> &r_pairs) {
+	for (const GodotBody2D *body : p_bodies) {
+		for (const Pair<GodotConstraint2D *, int> &E : body->get_constraint_list()) {
+			// Each pair is listed by both of its bodies, only take it from the first one.
+			if (E.second == 0 && E.first->get_snapshot_size() > 0) {
+				r_pairs.push_back(E.first);
+			}
+		}
+	}
+	r_pairs.sort_custom<SnapshotPairKeyCompare>();
+}
+
+void GodotSpace2D::save_snapshot(Vector<uint8_t> &r_snapshot) const {
+	LocalVector<GodotBody2D *> bodies;
+	for (GodotCollisionObject2D *E : objects) {
+		if (E->get_type() == GodotCollisionObject2D::TYPE_BODY) {
+			bodies.push_back(static_cast<GodotBody2D *>(E));
+		}
+	}
+	bodies.sort_custom<SnapshotBodyRIDCompare>();
+
+	LocalVector<GodotConstraint2D *> pairs;
+	_get_snapshot_pairs(bodies, pairs);
+
+	SnapshotHeader header;
+	header.body_count = bodies.size();
+	for (const SelfList<GodotBody2D> *E = active_list.first(); E; E = E->next()) {
+		header.active_count++;
+	}
+	header.pair_count = pairs.size();
+
+	uint64_t size = SnapshotHeader::SIZE + bodies.size() * SnapshotBody::SIZE + header.active_count * sizeof(uint64_t) + pairs.size() * SnapshotPair::SIZE;
+	for (const GodotBody2D *body : bodies) {
+		size += body->get_shape_count() * GodotConstraint2D::SNAPSHOT_RECT_SIZE;
+	}
+	for (const GodotConstraint2D *pair : pairs) {
+		size += pair->get_snapshot_size();
+	}
+
+	r_snapshot.resize(size);
+	SnapshotWriter writer;
+	writer.ptr = r_snapshot.ptrw();
+
+	_write_snapshot_header(writer, header);
+
+	for (const GodotBody2D *body : bodies) {
+		SnapshotBody record;
+		record.rid = body->get_self().get_id();
+		record.shape_count = body->get_shape_count();
+		body->save_snapshot(record.state);
+		_write_snapshot_body(writer, record);
+		for (int i = 0; i < body->get_shape_count(); i++) {
+			writer.write(body->get_shape_aabb(i));
+		}
+	}
+
+	for (const SelfList<GodotBody2D> *E = active_list.first(); E; E = E->next()) {
+		writer.write(E->self()->get_self().get_id());
+	}
+
+	for (const GodotConstraint2D *pair : pairs) {
+		const GodotConstraint2D::SortKey key = pair->get_sort_key();
+		SnapshotPair record;
+		for (int i = 0; i < 2; i++) {
+			record.objects[i] = key.objects[i].get_id();
+			record.shapes[i] = key.shapes[i];
+		}
+		record.size = pair->get_snapshot_size();
+		_write_snapshot_pair(writer, record);
+		pair->save_snapshot(writer.ptr);
+		writer.ptr += record.size;
+	}
+
+	DEV_ASSERT(writer.ptr == r_snapshot.ptr() + size);
+}
+
+bool GodotSpace2D::restore_snapshot(const Vector<uint8_t> &p_snapshot) {
+	SnapshotReader reader;
+	reader.ptr = p_snapshot.ptr();
+	reader.end = p_snapshot.ptr() + p_snapshot.size();
+
+	SnapshotHeader header;
+	ERR_FAIL_COND_V_MSG(!_read_snapshot_header(reader, header) || header.magic != SNAPSHOT_MAGIC, false, "Invalid physics space snapshot.");
+	ERR_FAIL_COND_V_MSG(header.version != SNAPSHOT_VERSION || header.real_size != sizeof(real_t), false, "Physics space snapshot was taken by a different build of the engine.");
+
+	// Read everything before touching the space, so a truncated snapshot leaves it as it was.
+	LocalVector<SnapshotBody> body_records;
+	LocalVector<uint32_t> body_aabb_offsets;
+	LocalVector<Rect2> body_aabbs;
+	body_records.resize(header.body_count);
+	body_aabb_offsets.resize(header.body_count);
+	for (uint32_t i = 0; i < header.body_count; i++) {
+		ERR_FAIL_COND_V_MSG(!_read_snapshot_body(reader, body_records[i]), false, "Physics space snapshot is truncated.");
+		// Checked up front, so a corrupt shape count can't make the bounds allocate more than the snapshot holds.
+		ERR_FAIL_COND_V_MSG(uint64_t(body_records[i].shape_count) * GodotConstraint2D::SNAPSHOT_RECT_SIZE > uint64_t(reader.end - reader.ptr), false, "Physics space snapshot is truncated.");
+		body_aabb_offsets[i] = body_aabbs.size();
+		for (uint32_t j = 0; j < body_records[i].shape_count; j++) {
+			Rect2 aabb;
+			reader.read(aabb);
+			body_aabbs.push_back(aabb);
+		}
+	}
+
+	LocalVector<uint64_t> active_rids;
+	active_rids.resize(header.active_count);
+	for (uint32_t i = 0; i < header.active_count; i++) {
+		ERR_FAIL_COND_V_MSG(!reader.read(active_rids[i]), false, "Physics space snapshot is truncated.");
+	}
+
+	LocalVector<SnapshotPair> pair_records;
+	LocalVector<const uint8_t *> pair_data;
+	pair_records.resize(header.pair_count);
+	pair_data.resize(header.pair_count);
+	for (uint32_t i = 0; i < header.pair_count; i++) {
+		ERR_FAIL_COND_V_MSG(!_read_snapshot_pair(reader, pair_records[i]), false, "Physics space snapshot is truncated.");
+		pair_data[i] = reader.skip(pair_records[i].size);
+		ERR_FAIL_NULL_V_MSG(pair_data[i], false, "Physics space snapshot is truncated.");
+	}
+
+	HashMap<RID, GodotBody2D *> bodies_by_rid;
+	for (GodotCollisionObject2D *E : objects) {
+		if (E->get_type() == GodotCollisionObject2D::TYPE_BODY) {
+			bodies_by_rid.insert(E->get_self(), static_cast<GodotBody2D *>(E));
+		}
+	}
+
+	uint32_t missing_count = 0;
+	for (uint32_t i = 0; i < header.body_count; i++) {
+		const SnapshotBody &record = body_records[i];
+		GodotBody2D **body_ptr = bodies_by_rid.getptr(RID::from_uint64(record.rid));
+		if (!body_ptr) {
+			missing_count++;
+			continue;
+		}
+		GodotBody2D *body = *body_ptr;
+
+		const Rect2 *restored_aabbs = nullptr;
+		if (int(record.shape_count) == body->get_shape_count()) {
+			restored_aabbs = body_aabbs.ptr() + body_aabb_offsets[i];
+		}
+		body->restore_snapshot(record.state, restored_aabbs);
+		// Reactivated below, in the order the snapshot lists them.
+		body->set_active(false);
+	}
+
+	for (uint64_t rid : active_rids) {
+		GodotBody2D **body_ptr = bodies_by_rid.getptr(RID::from_uint64(rid));
+		if (body_ptr) {
+			(*body_ptr)->set_active(true);
+		}
+	}
+
+	// Let the broadphase create and remove pairs for the restored bounds, then put back the state of the pairs
+	// that existed when the snapshot was taken. Keys are sorted on both sides, so a single pass matches them.
+	update();
+
+	LocalVector<GodotBody2D *> bodies;
+	for (const KeyValue<RID, GodotBody2D *> &E : bodies_by_rid) {
+		bodies.push_back(E.value);
+	}
+	LocalVector<GodotConstraint2D *> pairs;
+	_get_snapshot_pairs(bodies, pairs);
+
+	uint32_t pair_index = 0;
+	for (GodotConstraint2D *pair : pairs) {
+		const GodotConstraint2D::SortKey key = pair->get_sort_key();
+		const uint8_t *data = nullptr;
+		while (pair_index < header.pair_count) {
+			const SnapshotPair &record = pair_records[pair_index];
+			GodotConstraint2D::SortKey record_key;
+			for (int i = 0; i < 2; i++) {
+				record_key.objects[i] = RID::from_uint64(record.objects[i]);
+				record_key.shapes[i] = record.shapes[i];
+			}
+			if (key < record_key) {
+				break;
+			}
+			pair_index++;
+			if (!(record_key < key) && record.size == pair->get_snapshot_size()) {
+				data = pair_data[pair_index - 1];
+				break;
+			}
+		}
+		pair->restore_snapshot(data);
+	}
+
+	ERR_FAIL_COND_V_MSG(missing_count > 0, false, vformat("%d bodies in the physics space snapshot no longer exist in the space, the rest of the snapshot was restored.", missing_count));
+	return true;
+}
+
 void GodotSpace2D::lock() {
 	locked = true;
 }
@@ -1226,6 +1546,7 @@ GodotSpace2D::GodotSpace2D() {
 	contact_max_allowed_penetration = GLOBAL_GET("physics/2d/solver/contact_max_allowed_penetration");
 	contact_bias = GLOBAL_GET("physics/2d/solver/default_contact_bias");
 	constraint_bias = GLOBAL_GET("physics/2d/solver/default_constraint_bias");
+	deterministic = GLOBAL_GET("physics/2d/solver/deterministic");
 
 	broadphase = GodotBroadPhase2D::create_func();
 	broadphase->set_pair_callback(_broadphase_pair, this);
@@ -111,6 +111,7 @@ private:
 	real_t body_time_to_sleep = 0.0;
 
 	bool locked = false;
+	bool deterministic = false;
 
 	real_t last_step = 0.001;
 
@@ -177,6 +178,17 @@ public:
 	void set_param(PhysicsServer2D::SpaceParameter p_param, real_t p_value);
 	real_t get_param(PhysicsServer2D::SpaceParameter p_param) const;
 
+	// Deterministic spaces step the same way whenever they are given the same inputs,
+	// regardless of the order objects were paired in or of thread scheduling.
+	void set_deterministic(bool p_deterministic) { deterministic = p_deterministic; }
+	bool is_deterministic() const { return deterministic; }
+
+	uint32_t get_state_hash() const;
+
+	// Compact copy of the simulation state (bodies, sleep state and contacts) to roll the space back to.
+	void save_snapshot(Vector<uint8_t> &r_snapshot) const;
+	bool restore_snapshot(const Vector<uint8_t> &p_snapshot);
+
 	void set_island_count(int p_island_count) { island_count = p_island_count; }
 	int get_island_count() const { return island_count; }
 
@@ -127,6 +127,24 @@ void GodotStep2D::_check_suspend(LocalVector<GodotBody2D *> &p_body_island) cons
 	}
 }
 
+void GodotStep2D::_sort_constraint_islands(uint32_t p_island_count) {
+	struct ConstraintKeyCompare {
+		_FORCE_INLINE_ bool operator()(const GodotConstraint2D *p_a, const GodotConstraint2D *p_b) const { return p_a->get_sort_key() < p_b->get_sort_key(); }
+	};
+
+	// Island contents and the islands themselves follow the order bodies were activated and paired in,
+	// which depends on the history of the space rather than on its current state.
+	island_order.resize(p_island_count);
+	for (uint32_t island_index = 0; island_index < p_island_count; ++island_index) {
+		LocalVector<GodotConstraint2D *> &constraint_island = constraint_islands[island_index];
+		constraint_island.sort_custom<ConstraintKeyCompare>();
+
+		island_order[island_index].key = constraint_island[0]->get_sort_key();
+		island_order[island_index].index = island_index;
+	}
+	island_order.sort();
+}
+
 void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 	p_space->lock(); // can't access space during this
 
@@ -239,11 +257,24 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 		profile_begtime = profile_endtime;
 	}
 
+	const bool deterministic = p_space->is_deterministic();
+	if (deterministic) {
+		_sort_constraint_islands(island_count);
+	}
+
 	/* SETUP CONSTRAINTS / PROCESS COLLISIONS */
 
-	uint32_t total_constraint_count = all_constraints.size();
-	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics2DConstraintSetup"));
-	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	if (deterministic) {
+		for (const IslandOrder &E : island_order) {
+			for (GodotConstraint2D *constraint : constraint_islands[E.index]) {
+				constraint->setup(delta);
+			}
+		}
+	} else {
+		uint32_t total_constraint_count = all_constraints.size();
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics2DConstraintSetup"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	}
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
@@ -254,16 +285,28 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 	/* PRE-SOLVE CONSTRAINT ISLANDS */
 
 	// WARNING: This doesn't run on threads, because it involves thread-unsafe processing.
-	for (uint32_t island_index = 0; island_index < island_count; ++island_index) {
-		_pre_solve_island(constraint_islands[island_index]);
+	if (deterministic) {
+		for (const IslandOrder &E : island_order) {
+			_pre_solve_island(constraint_islands[E.index]);
+		}
+	} else {
+		for (uint32_t island_index = 0; island_index < island_count; ++island_index) {
+			_pre_solve_island(constraint_islands[island_index]);
+		}
 	}
 
 	/* SOLVE CONSTRAINT ISLANDS */
 
 	// WARNING: `_solve_island` modifies the constraint islands for optimization purpose,
 	// their content is not reliable after these calls and shouldn't be used anymore.
-	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_solve_island, nullptr, island_count, -1, true, SNAME("Physics2DConstraintSolveIslands"));
-	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	if (deterministic) {
+		for (const IslandOrder &E : island_order) {
+			_solve_island(E.index);
+		}
+	} else {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_solve_island, nullptr, island_count, -1, true, SNAME("Physics2DConstraintSolveIslands"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	}
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
@@ -30,6 +30,7 @@
 
 #pragma once
 
+#include "godot_constraint_2d.h"
 #include "godot_space_2d.h"
 
 #include "core/templates/local_vector.h"
@@ -44,11 +45,22 @@ class GodotStep2D {
 	LocalVector<LocalVector<GodotConstraint2D *>> constraint_islands;
 	LocalVector<GodotConstraint2D *> all_constraints;
 
+	struct IslandOrder {
+		GodotConstraint2D::SortKey key;
+		uint32_t index = 0;
+
+		_FORCE_INLINE_ bool operator<(const IslandOrder &p_other) const { return key < p_other.key; }
+	};
+
+	// Only used by deterministic spaces.
+	LocalVector<IslandOrder> island_order;
+
 	void _populate_island(GodotBody2D *p_body, LocalVector<GodotBody2D *> &p_body_island, LocalVector<GodotConstraint2D *> &p_constraint_island);
 	void _setup_constraint(uint32_t p_constraint_index, void *p_userdata = nullptr);
 	void _pre_solve_island(LocalVector<GodotConstraint2D *> &p_constraint_island) const;
 	void _solve_island(uint32_t p_island_index, void *p_userdata = nullptr) const;
 	void _check_suspend(LocalVector<GodotBody2D *> &p_body_island) const;
+	void _sort_constraint_islands(uint32_t p_island_count);
 
 public:
 	void step(GodotSpace2D *p_space, real_t p_delta);
@@ -0,0 +1,129 @@
+/**************************************************************************/
+/*  test_godot_body_pair_2d.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../godot_physics_server_2d.h"
+
+#include "tests/physics_test_utils.h"
+#include "tests/test_macros.h"
+
+namespace TestGodotBodyPair2D {
+
+typedef TestUtils::PhysicsServer2DScope<GodotPhysicsServer2D> GodotPhysicsServer2DScope;
+
+struct StackResult {
+	int steps_to_rest = -1;
+	real_t top_height = 0.0;
+};
+
+// Stacks boxes on a static floor and steps until every box is asleep.
+static StackResult simulate_stack(GodotPhysicsServer2DScope &p_server, int p_box_count, int p_solver_iterations, int p_max_steps) {
+	const real_t box_size = 20.0;
+
+	RID space = p_server.track(p_server->space_create());
+	p_server->space_set_active(space, true);
+	p_server->space_set_param(space, PhysicsServer2D::SPACE_PARAM_SOLVER_ITERATIONS, p_solver_iterations);
+	p_server->area_set_param(space, PhysicsServer2D::AREA_PARAM_GRAVITY, 980.0);
+	p_server->area_set_param(space, PhysicsServer2D::AREA_PARAM_GRAVITY_VECTOR, Vector2(0, 1));
+	p_server->area_set_param(space, PhysicsServer2D::AREA_PARAM_LINEAR_DAMP, 0.1);
+	p_server->area_set_param(space, PhysicsServer2D::AREA_PARAM_ANGULAR_DAMP, 1.0);
+
+	RID floor_shape = p_server.track(p_server->rectangle_shape_create());
+	p_server->shape_set_data(floor_shape, Vector2(1000, 10));
+	RID floor = p_server.track(p_server->body_create());
+	p_server->body_set_mode(floor, PhysicsServer2D::BODY_MODE_STATIC);
+	p_server->body_set_space(floor, space);
+	p_server->body_add_shape(floor, floor_shape);
+	p_server->body_set_state(floor, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0, Vector2(0, 10)));
+
+	RID box_shape = p_server.track(p_server->rectangle_shape_create());
+	p_server->shape_set_data(box_shape, Vector2(box_size, box_size) * 0.5);
+
+	LocalVector<RID> boxes;
+	for (int i = 0; i < p_box_count; i++) {
+		RID box = p_server.track(p_server->body_create());
+		p_server->body_set_mode(box, PhysicsServer2D::BODY_MODE_RIGID);
+		p_server->body_set_space(box, space);
+		p_server->body_add_shape(box, box_shape);
+		// Start slightly apart so the boxes settle onto each other.
+		p_server->body_set_state(box, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0, Vector2(0, -box_size * 0.5 - i * (box_size + 0.5))));
+		boxes.push_back(box);
+	}
+
+	StackResult result;
+	for (int step = 0; step < p_max_steps; step++) {
+		p_server->step(1.0 / 60.0);
+
+		bool resting = true;
+		for (const RID &box : boxes) {
+			if (!p_server->body_get_state(box, PhysicsServer2D::BODY_STATE_SLEEPING)) {
+				resting = false;
+				break;
+			}
+		}
+		if (resting) {
+			result.steps_to_rest = step + 1;
+			break;
+		}
+	}
+
+	Transform2D top = p_server->body_get_state(boxes[boxes.size() - 1], PhysicsServer2D::BODY_STATE_TRANSFORM);
+	result.top_height = -top.get_origin().y;
+
+	p_server.free_tracked();
+	return result;
+}
+
+TEST_CASE("[SceneTree][GodotPhysics2D] Box stacks stay standing") {
+	GodotPhysicsServer2DScope server("GodotPhysics2D");
+	REQUIRE(server.get());
+
+	const int box_count = 12;
+	const int max_steps = 60 * 30;
+	const real_t box_size = 20.0;
+	const real_t expected_top_height = box_size * (box_count - 0.5);
+
+	static const int solver_iterations[] = { 4, 8, 16 };
+	for (int iterations : solver_iterations) {
+		StackResult result = simulate_stack(server, box_count, iterations, max_steps);
+
+		if (result.steps_to_rest > 0) {
+			MESSAGE(vformat("%d boxes, %d solver iterations: at rest after %d steps.", box_count, iterations, result.steps_to_rest));
+		} else {
+			MESSAGE(vformat("%d boxes, %d solver iterations: not at rest after %d steps.", box_count, iterations, max_steps));
+		}
+
+		// The stack must still be standing, whether it went to sleep or not.
+		CHECK_MESSAGE(result.top_height > expected_top_height * 0.9, vformat("The stack collapsed with %d solver iterations.", iterations));
+	}
+}
+
+} // namespace TestGodotBodyPair2D
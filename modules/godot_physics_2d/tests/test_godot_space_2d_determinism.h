@@ -0,0 +1,131 @@
+/**************************************************************************/
+/*  test_godot_space_2d_determinism.h                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../godot_physics_server_2d.h"
+
+#include "core/math/random_pcg.h"
+#include "tests/physics_test_utils.h"
+#include "tests/test_macros.h"
+
+namespace TestGodotSpace2DDeterminism {
+
+typedef TestUtils::PhysicsServer2DScope<GodotPhysicsServer2D> GodotPhysicsServer2DScope;
+
+// Drops a pile of boxes and circles with random initial velocities and returns the state hash after each step.
+static LocalVector<uint32_t> simulate_pile(GodotPhysicsServer2DScope &p_server, int p_step_count, int p_history_bodies) {
+	RID space = p_server.track(p_server->space_create());
+	p_server->space_set_deterministic(space, true);
+	p_server->space_set_active(space, true);
+	p_server->area_set_param(space, PhysicsServer2D::AREA_PARAM_GRAVITY, 980.0);
+	p_server->area_set_param(space, PhysicsServer2D::AREA_PARAM_GRAVITY_VECTOR, Vector2(0, 1));
+
+	RID box_shape = p_server.track(p_server->rectangle_shape_create());
+	p_server->shape_set_data(box_shape, Vector2(10, 10));
+	RID circle_shape = p_server.track(p_server->circle_shape_create());
+	p_server->shape_set_data(circle_shape, 8.0);
+
+	// Bodies that come and go before the scene is built leave the broadphase in a different state,
+	// which changes the order collision pairs are reported in, but must not change the simulation.
+	for (int i = 0; i < p_history_bodies; i++) {
+		RID body = p_server->body_create();
+		p_server->body_set_space(body, space);
+		p_server->body_add_shape(body, box_shape);
+		p_server->body_set_state(body, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0, Vector2(i * 7.0, -i * 13.0)));
+		p_server->step(1.0 / 60.0);
+		p_server->free_rid(body);
+	}
+
+	RID floor_shape = p_server.track(p_server->rectangle_shape_create());
+	p_server->shape_set_data(floor_shape, Vector2(1000, 10));
+	RID floor = p_server.track(p_server->body_create());
+	p_server->body_set_mode(floor, PhysicsServer2D::BODY_MODE_STATIC);
+	p_server->body_set_space(floor, space);
+	p_server->body_add_shape(floor, floor_shape);
+	p_server->body_set_state(floor, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0, Vector2(0, 10)));
+
+	RandomPCG rng(1234);
+	for (int i = 0; i < 96; i++) {
+		RID body = p_server.track(p_server->body_create());
+		p_server->body_set_mode(body, PhysicsServer2D::BODY_MODE_RIGID);
+		p_server->body_set_space(body, space);
+		p_server->body_add_shape(body, i % 3 == 0 ? circle_shape : box_shape);
+		p_server->body_set_state(body, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(rng.random(-1.0, 1.0), Vector2((i % 12) * 22.0 - 130.0, -20.0 - (i / 12) * 24.0)));
+		p_server->body_set_state(body, PhysicsServer2D::BODY_STATE_LINEAR_VELOCITY, Vector2(rng.random(-100.0, 100.0), rng.random(-100.0, 0.0)));
+		p_server->body_set_state(body, PhysicsServer2D::BODY_STATE_ANGULAR_VELOCITY, rng.random(-2.0, 2.0));
+	}
+
+	LocalVector<uint32_t> hashes;
+	for (int i = 0; i < p_step_count; i++) {
+		p_server->step(1.0 / 60.0);
+		hashes.push_back(p_server->space_get_state_hash(space));
+	}
+
+	p_server.free_tracked();
+	return hashes;
+}
+
+TEST_CASE("[SceneTree][GodotPhysics2D] Deterministic spaces produce identical state hashes") {
+	GodotPhysicsServer2DScope server("GodotPhysics2D");
+	REQUIRE(server.get());
+
+	const int step_count = 180;
+
+	const LocalVector<uint32_t> first_run = simulate_pile(server, step_count, 0);
+	const LocalVector<uint32_t> second_run = simulate_pile(server, step_count, 0);
+	const LocalVector<uint32_t> perturbed_run = simulate_pile(server, step_count, 16);
+
+	REQUIRE(first_run.size() == (uint32_t)step_count);
+	REQUIRE(second_run.size() == (uint32_t)step_count);
+	REQUIRE(perturbed_run.size() == (uint32_t)step_count);
+
+	int first_divergence = -1;
+	for (int i = 0; i < step_count; i++) {
+		if (first_run[i] != second_run[i]) {
+			first_divergence = i;
+			break;
+		}
+	}
+	CHECK_MESSAGE(first_divergence == -1, vformat("Running the same scene twice diverged at step %d.", first_divergence));
+
+	first_divergence = -1;
+	for (int i = 0; i < step_count; i++) {
+		if (first_run[i] != perturbed_run[i]) {
+			first_divergence = i;
+			break;
+		}
+	}
+	CHECK_MESSAGE(first_divergence == -1, vformat("The history of the space changed the simulation at step %d.", first_divergence));
+
+	CHECK_MESSAGE(first_run[0] != first_run[step_count - 1], "The state hash should change as bodies move.");
+}
+
+} // namespace TestGodotSpace2DDeterminism
@@ -0,0 +1,155 @@
+/**************************************************************************/
+/*  test_godot_space_2d_snapshot.h                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+#pragma once
+
+#include "../godot_physics_server_2d.h"
+
+#include "core/math/random_pcg.h"
+#include "core/os/os.h"
+#include "tests/physics_test_utils.h"
+#include "tests/test_macros.h"
+
+namespace TestGodotSpace2DSnapshot {
+
+typedef TestUtils::PhysicsServer2DScope<GodotPhysicsServer2D> GodotPhysicsServer2DScope;
+
+// Drops a pile of boxes and circles in rows of 20 onto a static floor, and returns its space.
+// Everything created is freed with the server scope.
+static RID create_pile(GodotPhysicsServer2DScope &p_server, int p_body_count) {
+	RID space = p_server.track(p_server->space_create());
+	p_server->space_set_deterministic(space, true);
+	p_server->space_set_active(space, true);
+	p_server->area_set_param(space, PhysicsServer2D::AREA_PARAM_GRAVITY, 980.0);
+	p_server->area_set_param(space, PhysicsServer2D::AREA_PARAM_GRAVITY_VECTOR, Vector2(0, 1));
+
+	RID box_shape = p_server.track(p_server->rectangle_shape_create());
+	p_server->shape_set_data(box_shape, Vector2(10, 10));
+	RID circle_shape = p_server.track(p_server->circle_shape_create());
+	p_server->shape_set_data(circle_shape, 8.0);
+
+	RID floor_shape = p_server.track(p_server->rectangle_shape_create());
+	p_server->shape_set_data(floor_shape, Vector2(1000, 10));
+	RID floor = p_server.track(p_server->body_create());
+	p_server->body_set_mode(floor, PhysicsServer2D::BODY_MODE_STATIC);
+	p_server->body_set_space(floor, space);
+	p_server->body_add_shape(floor, floor_shape);
+	p_server->body_set_state(floor, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0, Vector2(0, 10)));
+
+	RandomPCG rng(4321);
+	for (int i = 0; i < p_body_count; i++) {
+		RID body = p_server.track(p_server->body_create());
+		p_server->body_set_mode(body, PhysicsServer2D::BODY_MODE_RIGID);
+		p_server->body_set_space(body, space);
+		p_server->body_add_shape(body, i % 3 == 0 ? circle_shape : box_shape);
+		p_server->body_set_state(body, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(rng.random(-1.0, 1.0), Vector2((i % 20) * 22.0 - 220.0, -20.0 - (i / 20) * 24.0)));
+		p_server->body_set_state(body, PhysicsServer2D::BODY_STATE_LINEAR_VELOCITY, Vector2(rng.random(-100.0, 100.0), rng.random(-100.0, 0.0)));
+	}
+
+	return space;
+}
+
+TEST_CASE("[SceneTree][GodotPhysics2D] Restoring a space snapshot replays the same steps") {
+	GodotPhysicsServer2DScope server("GodotPhysics2D");
+	REQUIRE(server.get());
+
+	const RID space = create_pile(server, 96);
+
+	// Let the pile land first, so the snapshot has contacts to warm start from.
+	for (int i = 0; i < 30; i++) {
+		server->step(1.0 / 60.0);
+	}
+
+	const uint32_t snapshot_hash = server->space_get_state_hash(space);
+	const PackedByteArray snapshot = server->space_get_snapshot(space);
+	REQUIRE_FALSE(snapshot.is_empty());
+
+	const int step_count = 30;
+	LocalVector<uint32_t> hashes;
+	for (int i = 0; i < step_count; i++) {
+		server->step(1.0 / 60.0);
+		hashes.push_back(server->space_get_state_hash(space));
+	}
+	CHECK(hashes[step_count - 1] != snapshot_hash);
+
+	// Roll back twice to make sure restoring doesn't depend on where the space was left.
+	PackedByteArray replayed_snapshots[2];
+	for (int run = 0; run < 2; run++) {
+		REQUIRE(server->space_restore_snapshot(space, snapshot));
+		CHECK(server->space_get_state_hash(space) == snapshot_hash);
+
+		int first_divergence = -1;
+		for (int i = 0; i < step_count; i++) {
+			server->step(1.0 / 60.0);
+			if (first_divergence == -1 && server->space_get_state_hash(space) != hashes[i]) {
+				first_divergence = i;
+			}
+		}
+		CHECK_MESSAGE(first_divergence == -1, vformat("Stepping from the restored snapshot diverged at step %d.", first_divergence));
+		replayed_snapshots[run] = server->space_get_snapshot(space);
+	}
+
+	// Both runs end in the same state, so their snapshots should be the same down to the last byte.
+	CHECK(replayed_snapshots[0] == replayed_snapshots[1]);
+
+	ERR_PRINT_OFF;
+	PackedByteArray truncated = snapshot;
+	truncated.resize(snapshot.size() / 2);
+	CHECK_FALSE(server->space_restore_snapshot(space, truncated));
+	CHECK_FALSE(server->space_restore_snapshot(space, PackedByteArray()));
+	ERR_PRINT_ON;
+}
+
+TEST_CASE("[SceneTree][GodotPhysics2D][Benchmark] Space snapshot timing" * doctest::skip()) {
+	GodotPhysicsServer2DScope server("GodotPhysics2D");
+	REQUIRE(server.get());
+
+	const RID space = create_pile(server, 1000);
+	for (int i = 0; i < 30; i++) {
+		server->step(1.0 / 60.0);
+	}
+
+	const int iterations = 100;
+	PackedByteArray snapshot;
+	uint64_t snapshot_usec = 0;
+	uint64_t restore_usec = 0;
+	for (int i = 0; i < iterations; i++) {
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		snapshot = server->space_get_snapshot(space);
+		uint64_t middle = OS::get_singleton()->get_ticks_usec();
+		CHECK(server->space_restore_snapshot(space, snapshot));
+		uint64_t end = OS::get_singleton()->get_ticks_usec();
+		snapshot_usec += middle - begin;
+		restore_usec += end - middle;
+	}
+
+	MESSAGE(vformat("1000 bodies: %d byte snapshot, %.1f usec to save, %.1f usec to restore.", snapshot.size(), double(snapshot_usec) / iterations, double(restore_usec) / iterations));
+}
+
+} // namespace TestGodotSpace2DSnapshot
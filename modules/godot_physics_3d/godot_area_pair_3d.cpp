@@ -31,10 +31,63 @@
 #include "godot_area_pair_3d.h"
 
 #include "godot_collision_solver_3d.h"
+#include "godot_space_3d.h"
+
+GodotConstraint3D::SortKey GodotAreaPair3D::get_sort_key() const {
+	SortKey key;
+	key.objects[0] = area->get_self();
+	key.objects[1] = body->get_self();
+	key.shapes[0] = area_shape;
+	key.shapes[1] = body_shape;
+	return key;
+}
+
+void GodotAreaPair3D::save_snapshot(uint8_t *r_buffer) const {
+	SnapshotWriter writer;
+	writer.ptr = r_buffer;
+	writer.write(uint8_t(colliding));
+	writer.write(uint8_t(body_has_attached_area));
+}
+
+void GodotAreaPair3D::restore_snapshot(const uint8_t *p_buffer) {
+	uint8_t was_colliding = 0;
+	uint8_t had_attached_area = 0;
+	if (p_buffer) {
+		SnapshotReader reader;
+		reader.ptr = p_buffer;
+		reader.end = p_buffer + get_snapshot_size();
+		reader.read(was_colliding);
+		reader.read(had_attached_area);
+	}
+
+	// Same as pre_solve(), so the body and the area see the overlap end or start again.
+	if (bool(had_attached_area) != body_has_attached_area) {
+		body_has_attached_area = had_attached_area;
+		if (body_has_attached_area) {
+			body->add_area(area);
+		} else {
+			body->remove_area(area);
+		}
+	}
+
+	if (bool(was_colliding) != colliding) {
+		colliding = was_colliding;
+		if (area->has_monitor_callback()) {
+			if (colliding) {
+				area->add_body_to_query(body, body_shape, area_shape);
+			} else {
+				area->remove_body_from_query(body, body_shape, area_shape);
+			}
+		}
+	}
+
+	process_collision = false;
+	has_space_override = false;
+}
 
 bool GodotAreaPair3D::setup(real_t p_step) {
 	bool result = false;
-	if (area->collides_with(body) && GodotCollisionSolver3D::solve_static(body->get_shape(body_shape), body->get_transform() * body->get_shape_transform(body_shape), area->get_shape(area_shape), area->get_transform() * area->get_shape_transform(area_shape), nullptr, this)) {
+	if (area->collides_with(body) && GodotCollisionSolver3D::solve_static(body->get_shape(body_shape), body->get_transform() * body->get_shape_transform(body_shape), area->get_shape(area_shape), area->get_transform() * area->get_shape_transform(area_shape), nullptr, this, nullptr, 0, 0, area->get_space()->is_batched_axis_tests_enabled())) {
 		result = true;
 	}
 
@@ -123,7 +176,7 @@ GodotAreaPair3D::~GodotAreaPair3D() {
 bool GodotArea2Pair3D::setup(real_t p_step) {
 	bool result_a = area_a->collides_with(area_b);
 	bool result_b = area_b->collides_with(area_a);
-	if ((result_a || result_b) && !GodotCollisionSolver3D::solve_static(area_a->get_shape(shape_a), area_a->get_transform() * area_a->get_shape_transform(shape_a), area_b->get_shape(shape_b), area_b->get_transform() * area_b->get_shape_transform(shape_b), nullptr, this)) {
+	if ((result_a || result_b) && !GodotCollisionSolver3D::solve_static(area_a->get_shape(shape_a), area_a->get_transform() * area_a->get_shape_transform(shape_a), area_b->get_shape(shape_b), area_b->get_transform() * area_b->get_shape_transform(shape_b), nullptr, this, nullptr, 0, 0, area_a->get_space()->is_batched_axis_tests_enabled())) {
 		result_a = false;
 		result_b = false;
 	}
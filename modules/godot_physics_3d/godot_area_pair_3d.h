@@ -46,6 +46,13 @@ class GodotAreaPair3D : public GodotConstraint3D {
 	bool body_has_attached_area = false;
 
 public:
+	virtual SortKey get_sort_key() const override;
+
+	// Whether the body was inside the area, and so affected by its overrides and reported to its monitor.
+	virtual uint32_t get_snapshot_size() const override { return 2 * sizeof(uint8_t); }
+	virtual void save_snapshot(uint8_t *r_buffer) const override;
+	virtual void restore_snapshot(const uint8_t *p_buffer) override;
+
 	virtual bool setup(real_t p_step) override;
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
@@ -190,6 +190,37 @@ void GodotBody3D::set_active(bool p_active) {
 	}
 }
 
+void GodotBody3D::save_snapshot(SnapshotState &r_state) const {
+	r_state.transform = get_transform();
+	r_state.inv_transform = get_inv_transform();
+	r_state.new_transform = new_transform;
+	r_state.linear_velocity = linear_velocity;
+	r_state.angular_velocity = angular_velocity;
+	r_state.applied_force = applied_force;
+	r_state.applied_torque = applied_torque;
+	r_state.constant_force = constant_force;
+	r_state.constant_torque = constant_torque;
+	r_state.still_time = still_time;
+}
+
+void GodotBody3D::restore_snapshot(const SnapshotState &p_state, const AABB *p_shape_aabbs) {
+	_set_transform(p_state.transform, p_shape_aabbs == nullptr);
+	_set_inv_transform(p_state.inv_transform);
+	if (p_shape_aabbs) {
+		_set_shape_aabbs(p_shape_aabbs);
+	}
+	new_transform = p_state.new_transform;
+	linear_velocity = p_state.linear_velocity;
+	angular_velocity = p_state.angular_velocity;
+	applied_force = p_state.applied_force;
+	applied_torque = p_state.applied_torque;
+	constant_force = p_state.constant_force;
+	constant_torque = p_state.constant_torque;
+	still_time = p_state.still_time;
+
+	_update_transform_dependent();
+}
+
 void GodotBody3D::set_param(PhysicsServer3D::BodyParameter p_param, const Variant &p_value) {
 	switch (p_param) {
 		case PhysicsServer3D::BODY_PARAM_BOUNCE: {
@@ -671,17 +702,7 @@ void GodotBody3D::integrate_forces(real_t p_step) {
 	contact_count = 0;
 }
 
-void GodotBody3D::integrate_velocities(real_t p_step) {
-	if (mode == PhysicsServer3D::BODY_MODE_STATIC) {
-		return;
-	}
-
-	ERR_FAIL_NULL(get_space());
-
-	if (fi_callback_data || body_state_callback.is_valid()) {
-		get_space()->body_add_to_state_query_list(&direct_state_query_list);
-	}
-
+void GodotBody3D::_apply_axis_lock() {
 	//apply axis lock linear
 	for (int i = 0; i < 3; i++) {
 		if (is_axis_locked((PhysicsServer3D::BodyAxis)(1 << i))) {
@@ -697,8 +718,22 @@ void GodotBody3D::integrate_velocities(real_t p_step) {
 			biased_angular_velocity[i] = 0;
 		}
 	}
+}
+
+void GodotBody3D::integrate_velocities(real_t p_step) {
+	if (mode == PhysicsServer3D::BODY_MODE_STATIC) {
+		return;
+	}
+
+	ERR_FAIL_NULL(get_space());
 
 	if (mode == PhysicsServer3D::BODY_MODE_KINEMATIC) {
+		if (fi_callback_data || body_state_callback.is_valid()) {
+			get_space()->body_add_to_state_query_list(&direct_state_query_list);
+		}
+
+		_apply_axis_lock();
+
 		_set_transform(new_transform, false);
 		_set_inv_transform(new_transform.affine_inverse());
 		if (contacts.is_empty() && linear_velocity == Vector3() && angular_velocity == Vector3()) {
@@ -708,6 +743,15 @@ void GodotBody3D::integrate_velocities(real_t p_step) {
 		return;
 	}
 
+	integrate_velocities_local(p_step);
+	commit_integrated_velocities();
+}
+
+void GodotBody3D::integrate_velocities_local(real_t p_step) {
+	ERR_FAIL_COND(mode < PhysicsServer3D::BODY_MODE_RIGID);
+
+	_apply_axis_lock();
+
 	Vector3 total_angular_velocity = angular_velocity + biased_angular_velocity;
 
 	real_t ang_vel = total_angular_velocity.length();
@@ -723,20 +767,26 @@ void GodotBody3D::integrate_velocities(real_t p_step) {
 	}
 
 	Vector3 total_linear_velocity = linear_velocity + biased_linear_velocity;
-	/*for(int i=0;i<3;i++) {
-		if (axis_lock&(1<<i)) {
-			transform_new.origin[i]=0.0;
-		}
-	}*/
 
 	transform_new.origin += total_linear_velocity * p_step;
 
-	_set_transform(transform_new);
+	// Shapes are moved in the broadphase by commit_integrated_velocities().
+	_set_transform(transform_new, false);
 	_set_inv_transform(get_transform().inverse());
 
 	_update_transform_dependent();
 }
 
+void GodotBody3D::commit_integrated_velocities() {
+	ERR_FAIL_NULL(get_space());
+
+	if (fi_callback_data || body_state_callback.is_valid()) {
+		get_space()->body_add_to_state_query_list(&direct_state_query_list);
+	}
+
+	_update_shapes();
+}
+
 void GodotBody3D::wakeup_neighbours() {
 	for (const KeyValue<GodotConstraint3D *, int> &E : constraint_map) {
 		const GodotConstraint3D *c = E.key;
@@ -146,6 +146,7 @@ class GodotBody3D : public GodotCollisionObject3D {
 	uint64_t island_step = 0;
 
 	void _update_transform_dependent();
+	void _apply_axis_lock();
 
 	friend class GodotPhysicsDirectBodyState3D; // i give up, too many functions to expose
 
@@ -283,6 +284,25 @@ public:
 	void set_active(bool p_active);
 	_FORCE_INLINE_ bool is_active() const { return active; }
 
+	// State that changes while simulating, saved in space snapshots. Everything else is set by the user and left alone by a restore.
+	struct SnapshotState {
+		Transform3D transform;
+		Transform3D inv_transform;
+		Transform3D new_transform;
+		Vector3 linear_velocity;
+		Vector3 angular_velocity;
+		Vector3 applied_force;
+		Vector3 applied_torque;
+		Vector3 constant_force;
+		Vector3 constant_torque;
+		real_t still_time = 0.0;
+	};
+
+	void save_snapshot(SnapshotState &r_state) const;
+	// The sleep state is restored by the space, which also keeps track of the order bodies were activated in.
+	// Shape bounds can be null, in which case they are recomputed from the transform.
+	void restore_snapshot(const SnapshotState &p_state, const AABB *p_shape_aabbs);
+
 	_FORCE_INLINE_ void wakeup() {
 		if ((!get_space()) || mode == PhysicsServer3D::BODY_MODE_STATIC || mode == PhysicsServer3D::BODY_MODE_KINEMATIC) {
 			return;
@@ -319,6 +339,16 @@ public:
 	void integrate_forces(real_t p_step);
 	void integrate_velocities(real_t p_step);
 
+	// Rigid bodies without continuous collision detection don't touch the broadphase
+	// while integrating forces, so they can be integrated from several threads at once.
+	_FORCE_INLINE_ bool can_integrate_forces_in_parallel() const { return mode >= PhysicsServer3D::BODY_MODE_RIGID && !continuous_cd; }
+
+	// Split version of integrate_velocities() for rigid bodies: the local part only
+	// updates the body's own state and is thread-safe, the commit part updates the
+	// broadphase and the space's query list and must run on a single thread.
+	void integrate_velocities_local(real_t p_step);
+	void commit_integrated_velocities();
+
 	_FORCE_INLINE_ Vector3 get_velocity_in_local_point(const Vector3 &rel_pos) const {
 		return linear_velocity + angular_velocity.cross(rel_pos - center_of_mass);
 	}
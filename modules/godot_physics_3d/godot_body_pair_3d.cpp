@@ -260,6 +260,95 @@ real_t combine_friction(GodotBody3D *A, GodotBody3D *B) {
 	return Math::abs(MIN(A->get_friction(), B->get_friction()));
 }
 
+GodotConstraint3D::SortKey GodotBodyPair3D::get_sort_key() const {
+	SortKey key;
+	key.objects[0] = A->get_self();
+	key.objects[1] = B->get_self();
+	key.shapes[0] = shape_A;
+	key.shapes[1] = shape_B;
+	return key;
+}
+
+void GodotBodyPair3D::save_snapshot(uint8_t *r_buffer) const {
+	SnapshotWriter writer;
+	writer.ptr = r_buffer;
+	writer.write(sep_axis);
+	writer.write(int32_t(contact_count));
+	// Unused contacts are written as new ones, so they don't carry leftovers from earlier steps into the snapshot.
+	const Contact unused_contact = Contact();
+	for (int i = 0; i < MAX_CONTACTS; i++) {
+		const Contact &c = i < contact_count ? contacts[i] : unused_contact;
+		writer.write(c.position);
+		writer.write(c.normal);
+		writer.write(int32_t(c.index_A));
+		writer.write(int32_t(c.index_B));
+		writer.write(c.local_A);
+		writer.write(c.local_B);
+		writer.write(c.acc_impulse);
+		writer.write(c.acc_normal_impulse);
+		writer.write(c.acc_tangent_impulse);
+		writer.write(c.acc_bias_impulse);
+		writer.write(c.acc_bias_impulse_center_of_mass);
+		writer.write(c.mass_normal);
+		writer.write(c.bias);
+		writer.write(c.bounce);
+		writer.write(c.depth);
+		writer.write(uint8_t(c.active));
+		writer.write(uint8_t(c.used));
+		writer.write(c.rA);
+		writer.write(c.rB);
+	}
+	DEV_ASSERT(writer.ptr == r_buffer + SNAPSHOT_SIZE);
+}
+
+void GodotBodyPair3D::restore_snapshot(const uint8_t *p_buffer) {
+	sep_axis = Vector3();
+	contact_count = 0;
+	if (!p_buffer) {
+		return;
+	}
+
+	SnapshotReader reader;
+	reader.ptr = p_buffer;
+	reader.end = p_buffer + SNAPSHOT_SIZE;
+	int32_t count = 0;
+	reader.read(sep_axis);
+	reader.read(count);
+	ERR_FAIL_COND(count < 0 || count > MAX_CONTACTS);
+
+	for (int i = 0; i < count; i++) {
+		Contact &c = contacts[i];
+		int32_t index_A = 0;
+		int32_t index_B = 0;
+		uint8_t active = 0;
+		uint8_t used = 0;
+		reader.read(c.position);
+		reader.read(c.normal);
+		reader.read(index_A);
+		reader.read(index_B);
+		reader.read(c.local_A);
+		reader.read(c.local_B);
+		reader.read(c.acc_impulse);
+		reader.read(c.acc_normal_impulse);
+		reader.read(c.acc_tangent_impulse);
+		reader.read(c.acc_bias_impulse);
+		reader.read(c.acc_bias_impulse_center_of_mass);
+		reader.read(c.mass_normal);
+		reader.read(c.bias);
+		reader.read(c.bounce);
+		reader.read(c.depth);
+		reader.read(active);
+		reader.read(used);
+		reader.read(c.rA);
+		reader.read(c.rB);
+		c.index_A = index_A;
+		c.index_B = index_B;
+		c.active = active != 0;
+		c.used = used != 0;
+	}
+	contact_count = count;
+}
+
 bool GodotBodyPair3D::setup(real_t p_step) {
 	check_ccd = false;
 
@@ -296,7 +385,7 @@ bool GodotBodyPair3D::setup(real_t p_step) {
 	GodotShape3D *shape_A_ptr = A->get_shape(shape_A);
 	GodotShape3D *shape_B_ptr = B->get_shape(shape_B);
 
-	collided = GodotCollisionSolver3D::solve_static(shape_A_ptr, xform_A, shape_B_ptr, xform_B, _contact_added_callback, this, &sep_axis);
+	collided = GodotCollisionSolver3D::solve_static(shape_A_ptr, xform_A, shape_B_ptr, xform_B, _contact_added_callback, this, &sep_axis, 0, 0, space->is_batched_axis_tests_enabled());
 
 	if (!collided) {
 		if (A->is_continuous_collision_detection_enabled() && collide_A) {
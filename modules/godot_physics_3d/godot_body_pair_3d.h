@@ -96,6 +96,10 @@ class GodotBodyPair3D : public GodotBodyContact3D {
 	Contact contacts[MAX_CONTACTS];
 	int contact_count = 0;
 
+	// Everything that setup() reads from the previous step: the separating axis, the contact count and every contact.
+	static constexpr uint32_t SNAPSHOT_CONTACT_SIZE = 8 * SNAPSHOT_VECTOR3_SIZE + 7 * sizeof(real_t) + 2 * sizeof(int32_t) + 2 * sizeof(uint8_t);
+	static constexpr uint32_t SNAPSHOT_SIZE = SNAPSHOT_VECTOR3_SIZE + sizeof(int32_t) + MAX_CONTACTS * SNAPSHOT_CONTACT_SIZE;
+
 	static void _contact_added_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal, void *p_userdata);
 
 	void contact_added_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal);
@@ -104,6 +108,12 @@ class GodotBodyPair3D : public GodotBodyContact3D {
 	bool _test_ccd(real_t p_step, GodotBody3D *p_A, int p_shape_A, const Transform3D &p_xform_A, GodotBody3D *p_B, int p_shape_B, const Transform3D &p_xform_B);
 
 public:
+	virtual SortKey get_sort_key() const override;
+
+	virtual uint32_t get_snapshot_size() const override { return SNAPSHOT_SIZE; }
+	virtual void save_snapshot(uint8_t *r_buffer) const override;
+	virtual void restore_snapshot(const uint8_t *p_buffer) override;
+
 	virtual bool setup(real_t p_step) override;
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
@@ -182,6 +182,22 @@ void GodotCollisionObject3D::_update_shapes() {
 	}
 }
 
+void GodotCollisionObject3D::_set_shape_aabbs(const AABB *p_aabbs) {
+	if (!space) {
+		return;
+	}
+
+	for (int i = 0; i < shapes.size(); i++) {
+		Shape &s = shapes.write[i];
+		s.aabb_cache = p_aabbs[i];
+		if (s.disabled || s.bpid == 0) {
+			continue;
+		}
+
+		space->get_broadphase()->move(s.bpid, s.aabb_cache);
+	}
+}
+
 void GodotCollisionObject3D::_update_shapes_with_motion(const Vector3 &p_motion) {
 	if (!space) {
 		return;
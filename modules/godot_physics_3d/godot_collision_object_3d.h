@@ -77,11 +77,12 @@ private:
 
 	SelfList<GodotCollisionObject3D> pending_shape_update_list;
 
-	void _update_shapes();
-
 protected:
+	void _update_shapes();
 	void _update_shapes_with_motion(const Vector3 &p_motion);
 	void _unregister_shapes();
+	// Moves the shapes back to the bounds saved in a space snapshot, motion expansion included.
+	void _set_shape_aabbs(const AABB *p_aabbs);
 
 	_FORCE_INLINE_ void _set_transform(const Transform3D &p_transform, bool p_update_shapes = true) {
 #ifdef DEBUG_ENABLED
@@ -33,6 +33,7 @@
 #include "gjk_epa.h"
 
 #include "core/math/geometry_3d.h"
+#include "core/templates/local_vector.h"
 
 #define fallback_collision_solver gjk_epa_calculate_penetration
 
@@ -72,6 +73,7 @@ struct _CollectorCallback {
 	void *userdata = nullptr;
 	bool swap = false;
 	bool collided = false;
+	bool batched_axis_tests = true;
 	Vector3 normal;
 	Vector3 *prev_axis = nullptr;
 
@@ -614,6 +616,107 @@ static void _generate_contacts_from_supports(const Vector3 *p_points_A, int p_po
 	contacts_func(points_A, pointcount_A, points_B, pointcount_B, p_callback);
 }
 
+// Vertices of a convex shape transformed to world space once and stored as a
+// structure of arrays. Projecting them onto the many axes tested by SAT is then
+// a tight loop the compiler can vectorize, instead of a transform per vertex and axis.
+struct _WorldVertices {
+	LocalVector<real_t> x;
+	LocalVector<real_t> y;
+	LocalVector<real_t> z;
+	uint32_t count = 0;
+
+	void setup(const Vector3 *p_vertices, uint32_t p_count, const Transform3D &p_transform) {
+		if (x.size() < p_count) {
+			x.resize(p_count);
+			y.resize(p_count);
+			z.resize(p_count);
+		}
+		count = p_count;
+		for (uint32_t i = 0; i < p_count; i++) {
+			Vector3 v = p_transform.xform(p_vertices[i]);
+			x[i] = v.x;
+			y[i] = v.y;
+			z[i] = v.z;
+		}
+	}
+
+	_FORCE_INLINE_ void project_range(const Vector3 &p_axis, real_t &r_min, real_t &r_max) const {
+		const real_t *vx = x.ptr();
+		const real_t *vy = y.ptr();
+		const real_t *vz = z.ptr();
+		const real_t ax = p_axis.x;
+		const real_t ay = p_axis.y;
+		const real_t az = p_axis.z;
+
+		real_t min = ax * vx[0] + ay * vy[0] + az * vz[0];
+		real_t max = min;
+		for (uint32_t i = 1; i < count; i++) {
+			real_t d = ax * vx[i] + ay * vy[i] + az * vz[i];
+			min = MIN(min, d);
+			max = MAX(max, d);
+		}
+		r_min = min;
+		r_max = max;
+	}
+};
+
+// Sets up world vertices for a convex polygon if projecting them is equivalent to
+// GodotConvexPolygonShape3D::project_range(), which switches to support lookups for large meshes.
+static _FORCE_INLINE_ bool _setup_convex_world_vertices(const GodotConvexPolygonShape3D *p_convex, const Transform3D &p_transform, _WorldVertices &r_world_vertices) {
+	const Geometry3D::MeshData &mesh = p_convex->get_mesh();
+	uint32_t vertex_count = mesh.vertices.size();
+	if (vertex_count == 0 || vertex_count > 3 * p_convex->extreme_vertices.size()) {
+		return false;
+	}
+	r_world_vertices.setup(mesh.vertices.ptr(), vertex_count, p_transform);
+	return true;
+}
+
+// A small batch of separating axes stored as a structure of arrays, so shape
+// projections for all of them can be computed in one loop before testing.
+struct _AxisBatch {
+	static const int MAX_AXES = 16;
+
+	Vector3 axes[MAX_AXES];
+	real_t x[MAX_AXES];
+	real_t y[MAX_AXES];
+	real_t z[MAX_AXES];
+	int count = 0;
+
+	_FORCE_INLINE_ void add(const Vector3 &p_axis) {
+		// Same fallback as SeparatorAxisTest::test_axis().
+		Vector3 axis = p_axis.is_zero_approx() ? Vector3(0.0, 1.0, 0.0) : p_axis;
+		axes[count] = axis;
+		x[count] = axis.x;
+		y[count] = axis.y;
+		z[count] = axis.z;
+		count++;
+	}
+};
+
+// Projects a box onto every axis of a batch, one lane per axis.
+// Uses the same arithmetic as GodotBoxShape3D::project_range().
+static _FORCE_INLINE_ void _project_box_batch(const Vector3 &p_half_extents, const Transform3D &p_transform, const _AxisBatch &p_batch, real_t *r_min, real_t *r_max) {
+	const Basis &b = p_transform.basis;
+	const Vector3 &o = p_transform.origin;
+
+	for (int i = 0; i < p_batch.count; i++) {
+		const real_t nx = p_batch.x[i];
+		const real_t ny = p_batch.y[i];
+		const real_t nz = p_batch.z[i];
+
+		const real_t lx = (b.rows[0][0] * nx) + (b.rows[1][0] * ny) + (b.rows[2][0] * nz);
+		const real_t ly = (b.rows[0][1] * nx) + (b.rows[1][1] * ny) + (b.rows[2][1] * nz);
+		const real_t lz = (b.rows[0][2] * nx) + (b.rows[1][2] * ny) + (b.rows[2][2] * nz);
+
+		const real_t length = Math::abs(lx) * p_half_extents.x + Math::abs(ly) * p_half_extents.y + Math::abs(lz) * p_half_extents.z;
+		const real_t distance = nx * o.x + ny * o.y + nz * o.z;
+
+		r_min[i] = distance - length;
+		r_max[i] = distance + length;
+	}
+}
+
 template <typename ShapeA, typename ShapeB, bool withMargin = false>
 class SeparatorAxisTest {
 	const ShapeA *shape_A = nullptr;
@@ -625,10 +728,18 @@ class SeparatorAxisTest {
 	real_t margin_A = 0.0;
 	real_t margin_B = 0.0;
 	Vector3 separator_axis;
+	const _WorldVertices *world_vertices_A = nullptr;
+	const _WorldVertices *world_vertices_B = nullptr;
 
 public:
 	Vector3 best_axis;
 
+	// Project convex shapes through precomputed world vertices instead of project_range().
+	_FORCE_INLINE_ void set_world_vertices(const _WorldVertices *p_world_vertices_A, const _WorldVertices *p_world_vertices_B) {
+		world_vertices_A = p_world_vertices_A;
+		world_vertices_B = p_world_vertices_B;
+	}
+
 	_FORCE_INLINE_ bool test_previous_axis() {
 		if (callback && callback->prev_axis && *callback->prev_axis != Vector3()) {
 			return test_axis(*callback->prev_axis);
@@ -647,9 +758,32 @@ public:
 
 		real_t min_A = 0.0, max_A = 0.0, min_B = 0.0, max_B = 0.0;
 
-		shape_A->project_range(axis, *transform_A, min_A, max_A);
-		shape_B->project_range(axis, *transform_B, min_B, max_B);
+		if (world_vertices_A) {
+			world_vertices_A->project_range(axis, min_A, max_A);
+		} else {
+			shape_A->project_range(axis, *transform_A, min_A, max_A);
+		}
+		if (world_vertices_B) {
+			world_vertices_B->project_range(axis, min_B, max_B);
+		} else {
+			shape_B->project_range(axis, *transform_B, min_B, max_B);
+		}
+
+		return test_axis_range(axis, min_A, max_A, min_B, max_B);
+	}
+
+	// Tests every axis of a batch in order, with the shape projections already computed.
+	_FORCE_INLINE_ bool test_axis_batch(const _AxisBatch &p_batch, const real_t *p_min_A, const real_t *p_max_A, const real_t *p_min_B, const real_t *p_max_B) {
+		for (int i = 0; i < p_batch.count; i++) {
+			if (!test_axis_range(p_batch.axes[i], p_min_A[i], p_max_A[i], p_min_B[i], p_max_B[i])) {
+				return false;
+			}
+		}
+		return true;
+	}
 
+	// Same as test_axis(), with the projections of both shapes onto the axis already computed.
+	_FORCE_INLINE_ bool test_axis_range(const Vector3 &axis, real_t min_A, real_t max_A, real_t min_B, real_t max_B) {
 		if (withMargin) {
 			min_A -= margin_A;
 			max_A += margin_A;
@@ -1081,40 +1215,71 @@ static void _collision_box_box(const GodotShape3D *p_a, const Transform3D &p_tra
 		return;
 	}
 
-	// test faces of A
-
-	for (int i = 0; i < 3; i++) {
-		Vector3 axis = p_transform_a.basis.get_column(i).normalized();
+	if (p_collector->batched_axis_tests) {
+		// Faces of A, faces of B and combined edges, projected in one batch.
+		_AxisBatch axes;
 
-		if (!separator.test_axis(axis)) {
-			return;
+		for (int i = 0; i < 3; i++) {
+			axes.add(p_transform_a.basis.get_column(i).normalized());
 		}
-	}
+		for (int i = 0; i < 3; i++) {
+			axes.add(p_transform_b.basis.get_column(i).normalized());
+		}
+		for (int i = 0; i < 3; i++) {
+			for (int j = 0; j < 3; j++) {
+				Vector3 axis = p_transform_a.basis.get_column(i).cross(p_transform_b.basis.get_column(j));
 
-	// test faces of B
+				if (Math::is_zero_approx(axis.length_squared())) {
+					continue;
+				}
+				axes.add(axis.normalized());
+			}
+		}
 
-	for (int i = 0; i < 3; i++) {
-		Vector3 axis = p_transform_b.basis.get_column(i).normalized();
+		real_t min_A[_AxisBatch::MAX_AXES], max_A[_AxisBatch::MAX_AXES];
+		real_t min_B[_AxisBatch::MAX_AXES], max_B[_AxisBatch::MAX_AXES];
+		_project_box_batch(box_A->get_half_extents(), p_transform_a, axes, min_A, max_A);
+		_project_box_batch(box_B->get_half_extents(), p_transform_b, axes, min_B, max_B);
 
-		if (!separator.test_axis(axis)) {
+		if (!separator.test_axis_batch(axes, min_A, max_A, min_B, max_B)) {
 			return;
 		}
-	}
+	} else {
+		// test faces of A
 
-	// test combined edges
-	for (int i = 0; i < 3; i++) {
-		for (int j = 0; j < 3; j++) {
-			Vector3 axis = p_transform_a.basis.get_column(i).cross(p_transform_b.basis.get_column(j));
+		for (int i = 0; i < 3; i++) {
+			Vector3 axis = p_transform_a.basis.get_column(i).normalized();
 
-			if (Math::is_zero_approx(axis.length_squared())) {
-				continue;
+			if (!separator.test_axis(axis)) {
+				return;
 			}
-			axis.normalize();
+		}
+
+		// test faces of B
+
+		for (int i = 0; i < 3; i++) {
+			Vector3 axis = p_transform_b.basis.get_column(i).normalized();
 
 			if (!separator.test_axis(axis)) {
 				return;
 			}
 		}
+
+		// test combined edges
+		for (int i = 0; i < 3; i++) {
+			for (int j = 0; j < 3; j++) {
+				Vector3 axis = p_transform_a.basis.get_column(i).cross(p_transform_b.basis.get_column(j));
+
+				if (Math::is_zero_approx(axis.length_squared())) {
+					continue;
+				}
+				axis.normalize();
+
+				if (!separator.test_axis(axis)) {
+					return;
+				}
+			}
+		}
 	}
 
 	if (withMargin) {
@@ -1179,52 +1344,94 @@ static void _collision_box_capsule(const GodotShape3D *p_a, const Transform3D &p
 		return;
 	}
 
-	// faces of A
-	for (int i = 0; i < 3; i++) {
-		Vector3 axis = p_transform_a.basis.get_column(i).normalized();
+	Vector3 cyl_axis = p_transform_b.basis.get_column(1).normalized();
 
-		if (!separator.test_axis(axis)) {
-			return;
+	if (p_collector->batched_axis_tests) {
+		// Faces of A, edges of A against the capsule cylinder and points of A
+		// against the capsule cylinder don't depend on each other, test them in one batch.
+		_AxisBatch axes;
+
+		for (int i = 0; i < 3; i++) {
+			axes.add(p_transform_a.basis.get_column(i).normalized());
+		}
+		for (int i = 0; i < 3; i++) {
+			Vector3 axis = p_transform_a.basis.get_column(i).cross(cyl_axis);
+			if (Math::is_zero_approx(axis.length_squared())) {
+				continue;
+			}
+			axes.add(axis.normalized());
+		}
+		for (int i = 0; i < 2; i++) {
+			for (int j = 0; j < 2; j++) {
+				for (int k = 0; k < 2; k++) {
+					Vector3 he = box_A->get_half_extents();
+					he.x *= (i * 2 - 1);
+					he.y *= (j * 2 - 1);
+					he.z *= (k * 2 - 1);
+					Vector3 point = p_transform_a.origin;
+					for (int l = 0; l < 3; l++) {
+						point += p_transform_a.basis.get_column(l) * he[l];
+					}
+					axes.add(Plane(cyl_axis).project(point).normalized());
+				}
+			}
 		}
-	}
 
-	Vector3 cyl_axis = p_transform_b.basis.get_column(1).normalized();
+		real_t min_A[_AxisBatch::MAX_AXES], max_A[_AxisBatch::MAX_AXES];
+		real_t min_B[_AxisBatch::MAX_AXES], max_B[_AxisBatch::MAX_AXES];
+		_project_box_batch(box_A->get_half_extents(), p_transform_a, axes, min_A, max_A);
+		for (int i = 0; i < axes.count; i++) {
+			capsule_B->project_range(axes.axes[i], p_transform_b, min_B[i], max_B[i]);
+		}
 
-	// edges of A, capsule cylinder
+		if (!separator.test_axis_batch(axes, min_A, max_A, min_B, max_B)) {
+			return;
+		}
+	} else {
+		// faces of A
+		for (int i = 0; i < 3; i++) {
+			Vector3 axis = p_transform_a.basis.get_column(i).normalized();
 
-	for (int i = 0; i < 3; i++) {
-		// cylinder
-		Vector3 box_axis = p_transform_a.basis.get_column(i);
-		Vector3 axis = box_axis.cross(cyl_axis);
-		if (Math::is_zero_approx(axis.length_squared())) {
-			continue;
+			if (!separator.test_axis(axis)) {
+				return;
+			}
 		}
 
-		if (!separator.test_axis(axis.normalized())) {
-			return;
+		// edges of A, capsule cylinder
+
+		for (int i = 0; i < 3; i++) {
+			// cylinder
+			Vector3 box_axis = p_transform_a.basis.get_column(i);
+			Vector3 axis = box_axis.cross(cyl_axis);
+			if (Math::is_zero_approx(axis.length_squared())) {
+				continue;
+			}
+
+			if (!separator.test_axis(axis.normalized())) {
+				return;
+			}
 		}
-	}
 
-	// points of A, capsule cylinder
-	// this sure could be made faster somehow..
+		// points of A, capsule cylinder
 
-	for (int i = 0; i < 2; i++) {
-		for (int j = 0; j < 2; j++) {
-			for (int k = 0; k < 2; k++) {
-				Vector3 he = box_A->get_half_extents();
-				he.x *= (i * 2 - 1);
-				he.y *= (j * 2 - 1);
-				he.z *= (k * 2 - 1);
-				Vector3 point = p_transform_a.origin;
-				for (int l = 0; l < 3; l++) {
-					point += p_transform_a.basis.get_column(l) * he[l];
-				}
+		for (int i = 0; i < 2; i++) {
+			for (int j = 0; j < 2; j++) {
+				for (int k = 0; k < 2; k++) {
+					Vector3 he = box_A->get_half_extents();
+					he.x *= (i * 2 - 1);
+					he.y *= (j * 2 - 1);
+					he.z *= (k * 2 - 1);
+					Vector3 point = p_transform_a.origin;
+					for (int l = 0; l < 3; l++) {
+						point += p_transform_a.basis.get_column(l) * he[l];
+					}
 
-				//Vector3 axis = (point - cyl_axis * cyl_axis.dot(point)).normalized();
-				Vector3 axis = Plane(cyl_axis).project(point).normalized();
+					//Vector3 axis = (point - cyl_axis * cyl_axis.dot(point)).normalized();
+					Vector3 axis = Plane(cyl_axis).project(point).normalized();
 
-				if (!separator.test_axis(axis)) {
-					return;
+					if (!separator.test_axis(axis)) {
+						return;
+					}
 				}
 			}
 		}
@@ -1386,6 +1593,11 @@ static void _collision_box_convex_polygon(const GodotShape3D *p_a, const Transfo
 
 	SeparatorAxisTest<GodotBoxShape3D, GodotConvexPolygonShape3D, withMargin> separator(box_A, p_transform_a, convex_polygon_B, p_transform_b, p_collector, p_margin_a, p_margin_b);
 
+	thread_local _WorldVertices world_vertices_B;
+	if (p_collector->batched_axis_tests && _setup_convex_world_vertices(convex_polygon_B, p_transform_b, world_vertices_B)) {
+		separator.set_world_vertices(nullptr, &world_vertices_B);
+	}
+
 	if (!separator.test_previous_axis()) {
 		return;
 	}
@@ -2037,6 +2249,98 @@ static _FORCE_INLINE_ bool is_minkowski_face(const Vector3 &A, const Vector3 &B,
 	return (CBA * DBA < 0.0f) && (ADC * BDC < 0.0f) && (CBA * BDC > 0.0f);
 }
 
+// Edges of B in world space, stored as a structure of arrays.
+struct _WorldEdges {
+	LocalVector<real_t> e[3]; // Edge direction.
+	LocalVector<real_t> u[3]; // Normal of the first adjacent face.
+	LocalVector<real_t> v[3]; // Normal of the second adjacent face.
+	LocalVector<uint8_t> minkowski_face;
+
+	void setup(const Transform3D &p_transform, const Geometry3D::MeshData &p_mesh) {
+		uint32_t edge_count = p_mesh.edges.size();
+		if (minkowski_face.size() < edge_count) {
+			for (int k = 0; k < 3; k++) {
+				e[k].resize(edge_count);
+				u[k].resize(edge_count);
+				v[k].resize(edge_count);
+			}
+			minkowski_face.resize(edge_count);
+		}
+
+		const Geometry3D::MeshData::Edge *edges = p_mesh.edges.ptr();
+		const Geometry3D::MeshData::Face *faces = p_mesh.faces.ptr();
+		const Vector3 *vertices = p_mesh.vertices.ptr();
+		for (uint32_t j = 0; j < edge_count; j++) {
+			Vector3 p2 = p_transform.xform(vertices[edges[j].vertex_a]);
+			Vector3 q2 = p_transform.xform(vertices[edges[j].vertex_b]);
+			Vector3 e2 = q2 - p2;
+			Vector3 u2 = p_transform.basis.xform(faces[edges[j].face_a].plane.normal).normalized();
+			Vector3 v2 = p_transform.basis.xform(faces[edges[j].face_b].plane.normal).normalized();
+			for (int k = 0; k < 3; k++) {
+				e[k][j] = e2[k];
+				u[k][j] = u2[k];
+				v[k][j] = v2[k];
+			}
+		}
+	}
+};
+
+// Batched version of the edge-edge axes of _collision_convex_polygon_convex_polygon().
+// B's edges are transformed once instead of once per edge of A, and the Minkowski face
+// test for one edge of A against all edges of B runs as a single loop over arrays.
+template <typename Separator>
+static bool _test_convex_polygon_edges_batch(Separator &p_separator, const Transform3D &p_transform_a, const Geometry3D::MeshData &p_mesh_A, const Transform3D &p_transform_b, const Geometry3D::MeshData &p_mesh_B) {
+	thread_local _WorldEdges world_edges_B;
+	world_edges_B.setup(p_transform_b, p_mesh_B);
+
+	const Geometry3D::MeshData::Edge *edges_A = p_mesh_A.edges.ptr();
+	const Geometry3D::MeshData::Face *faces_A = p_mesh_A.faces.ptr();
+	const Vector3 *vertices_A = p_mesh_A.vertices.ptr();
+	uint32_t edge_count_A = p_mesh_A.edges.size();
+	uint32_t edge_count_B = p_mesh_B.edges.size();
+
+	const real_t *ex = world_edges_B.e[0].ptr();
+	const real_t *ey = world_edges_B.e[1].ptr();
+	const real_t *ez = world_edges_B.e[2].ptr();
+	const real_t *ux = world_edges_B.u[0].ptr();
+	const real_t *uy = world_edges_B.u[1].ptr();
+	const real_t *uz = world_edges_B.u[2].ptr();
+	const real_t *vx = world_edges_B.v[0].ptr();
+	const real_t *vy = world_edges_B.v[1].ptr();
+	const real_t *vz = world_edges_B.v[2].ptr();
+	uint8_t *minkowski_face = world_edges_B.minkowski_face.ptr();
+
+	for (uint32_t i = 0; i < edge_count_A; i++) {
+		Vector3 p1 = p_transform_a.xform(vertices_A[edges_A[i].vertex_a]);
+		Vector3 q1 = p_transform_a.xform(vertices_A[edges_A[i].vertex_b]);
+		Vector3 e1 = q1 - p1;
+		Vector3 u1 = p_transform_a.basis.xform(faces_A[edges_A[i].face_a].plane.normal).normalized();
+		Vector3 v1 = p_transform_a.basis.xform(faces_A[edges_A[i].face_b].plane.normal).normalized();
+
+		// Same as is_minkowski_face(u1, v1, -e1, -u2, -v2, -e2), with the negations folded in.
+		for (uint32_t j = 0; j < edge_count_B; j++) {
+			real_t CBA = ux[j] * e1.x + uy[j] * e1.y + uz[j] * e1.z;
+			real_t DBA = vx[j] * e1.x + vy[j] * e1.y + vz[j] * e1.z;
+			real_t ADC = -(u1.x * ex[j] + u1.y * ey[j] + u1.z * ez[j]);
+			real_t BDC = -(v1.x * ex[j] + v1.y * ey[j] + v1.z * ez[j]);
+			minkowski_face[j] = (CBA * DBA < 0.0f) & (ADC * BDC < 0.0f) & (CBA * BDC > 0.0f);
+		}
+
+		for (uint32_t j = 0; j < edge_count_B; j++) {
+			if (!minkowski_face[j]) {
+				continue;
+			}
+			Vector3 axis = e1.cross(Vector3(ex[j], ey[j], ez[j])).normalized();
+
+			if (!p_separator.test_axis(axis)) {
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
 template <bool withMargin>
 static void _collision_convex_polygon_convex_polygon(const GodotShape3D *p_a, const Transform3D &p_transform_a, const GodotShape3D *p_b, const Transform3D &p_transform_b, _CollectorCallback *p_collector, real_t p_margin_a, real_t p_margin_b) {
 	const GodotConvexPolygonShape3D *convex_polygon_A = static_cast<const GodotConvexPolygonShape3D *>(p_a);
@@ -2044,6 +2348,14 @@ static void _collision_convex_polygon_convex_polygon(const GodotShape3D *p_a, co
 
 	SeparatorAxisTest<GodotConvexPolygonShape3D, GodotConvexPolygonShape3D, withMargin> separator(convex_polygon_A, p_transform_a, convex_polygon_B, p_transform_b, p_collector, p_margin_a, p_margin_b);
 
+	thread_local _WorldVertices world_vertices_A;
+	thread_local _WorldVertices world_vertices_B;
+	if (p_collector->batched_axis_tests) {
+		bool use_world_vertices_A = _setup_convex_world_vertices(convex_polygon_A, p_transform_a, world_vertices_A);
+		bool use_world_vertices_B = _setup_convex_world_vertices(convex_polygon_B, p_transform_b, world_vertices_B);
+		separator.set_world_vertices(use_world_vertices_A ? &world_vertices_A : nullptr, use_world_vertices_B ? &world_vertices_B : nullptr);
+	}
+
 	if (!separator.test_previous_axis()) {
 		return;
 	}
@@ -2092,25 +2404,31 @@ static void _collision_convex_polygon_convex_polygon(const GodotShape3D *p_a, co
 
 	// A<->B edges
 
-	for (int i = 0; i < edge_count_A; i++) {
-		Vector3 p1 = p_transform_a.xform(vertices_A[edges_A[i].vertex_a]);
-		Vector3 q1 = p_transform_a.xform(vertices_A[edges_A[i].vertex_b]);
-		Vector3 e1 = q1 - p1;
-		Vector3 u1 = p_transform_a.basis.xform(faces_A[edges_A[i].face_a].plane.normal).normalized();
-		Vector3 v1 = p_transform_a.basis.xform(faces_A[edges_A[i].face_b].plane.normal).normalized();
-
-		for (int j = 0; j < edge_count_B; j++) {
-			Vector3 p2 = p_transform_b.xform(vertices_B[edges_B[j].vertex_a]);
-			Vector3 q2 = p_transform_b.xform(vertices_B[edges_B[j].vertex_b]);
-			Vector3 e2 = q2 - p2;
-			Vector3 u2 = p_transform_b.basis.xform(faces_B[edges_B[j].face_a].plane.normal).normalized();
-			Vector3 v2 = p_transform_b.basis.xform(faces_B[edges_B[j].face_b].plane.normal).normalized();
-
-			if (is_minkowski_face(u1, v1, -e1, -u2, -v2, -e2)) {
-				Vector3 axis = e1.cross(e2).normalized();
-
-				if (!separator.test_axis(axis)) {
-					return;
+	if (p_collector->batched_axis_tests) {
+		if (!_test_convex_polygon_edges_batch(separator, p_transform_a, mesh_A, p_transform_b, mesh_B)) {
+			return;
+		}
+	} else {
+		for (int i = 0; i < edge_count_A; i++) {
+			Vector3 p1 = p_transform_a.xform(vertices_A[edges_A[i].vertex_a]);
+			Vector3 q1 = p_transform_a.xform(vertices_A[edges_A[i].vertex_b]);
+			Vector3 e1 = q1 - p1;
+			Vector3 u1 = p_transform_a.basis.xform(faces_A[edges_A[i].face_a].plane.normal).normalized();
+			Vector3 v1 = p_transform_a.basis.xform(faces_A[edges_A[i].face_b].plane.normal).normalized();
+
+			for (int j = 0; j < edge_count_B; j++) {
+				Vector3 p2 = p_transform_b.xform(vertices_B[edges_B[j].vertex_a]);
+				Vector3 q2 = p_transform_b.xform(vertices_B[edges_B[j].vertex_b]);
+				Vector3 e2 = q2 - p2;
+				Vector3 u2 = p_transform_b.basis.xform(faces_B[edges_B[j].face_a].plane.normal).normalized();
+				Vector3 v2 = p_transform_b.basis.xform(faces_B[edges_B[j].face_b].plane.normal).normalized();
+
+				if (is_minkowski_face(u1, v1, -e1, -u2, -v2, -e2)) {
+					Vector3 axis = e1.cross(e2).normalized();
+
+					if (!separator.test_axis(axis)) {
+						return;
+					}
 				}
 			}
 		}
@@ -2291,7 +2609,7 @@ static void _collision_convex_polygon_face(const GodotShape3D *p_a, const Transf
 	separator.generate_contacts();
 }
 
-bool sat_calculate_penetration(const GodotShape3D *p_shape_A, const Transform3D &p_transform_A, const GodotShape3D *p_shape_B, const Transform3D &p_transform_B, GodotCollisionSolver3D::CallbackResult p_result_callback, void *p_userdata, bool p_swap, Vector3 *r_prev_axis, real_t p_margin_a, real_t p_margin_b) {
+bool sat_calculate_penetration(const GodotShape3D *p_shape_A, const Transform3D &p_transform_A, const GodotShape3D *p_shape_B, const Transform3D &p_transform_B, GodotCollisionSolver3D::CallbackResult p_result_callback, void *p_userdata, bool p_swap, Vector3 *r_prev_axis, real_t p_margin_a, real_t p_margin_b, bool p_batched_axis_tests) {
 	PhysicsServer3D::ShapeType type_A = p_shape_A->get_type();
 
 	ERR_FAIL_COND_V(type_A == PhysicsServer3D::SHAPE_WORLD_BOUNDARY, false);
@@ -2388,6 +2706,7 @@ bool sat_calculate_penetration(const GodotShape3D *p_shape_A, const Transform3D
 	callback.userdata = p_userdata;
 	callback.collided = false;
 	callback.prev_axis = r_prev_axis;
+	callback.batched_axis_tests = p_batched_axis_tests;
 
 	const GodotShape3D *A = p_shape_A;
 	const GodotShape3D *B = p_shape_B;
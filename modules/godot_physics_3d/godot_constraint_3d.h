@@ -30,6 +30,8 @@
 
 #pragma once
 
+#include "core/math/aabb.h"
+#include "core/math/transform_3d.h"
 #include "core/templates/rid.h"
 #include "core/typedefs.h"
 
@@ -55,6 +57,105 @@ protected:
 	}
 
 public:
+	// Identifies a constraint by the objects it links rather than by its address,
+	// so space snapshots can find the same pair again after it was recreated.
+	struct SortKey {
+		RID objects[2];
+		int shapes[2] = { -1, -1 };
+
+		_FORCE_INLINE_ bool operator<(const SortKey &p_other) const {
+			for (int i = 0; i < 2; i++) {
+				if (objects[i] != p_other.objects[i]) {
+					return objects[i] < p_other.objects[i];
+				}
+			}
+			if (shapes[0] != p_other.shapes[0]) {
+				return shapes[0] < p_other.shapes[0];
+			}
+			return shapes[1] < p_other.shapes[1];
+		}
+	};
+
+	virtual SortKey get_sort_key() const {
+		// Joints have their own RID, which is enough to tell them apart.
+		SortKey key;
+		key.objects[0] = self;
+		return key;
+	}
+
+	// Space snapshots are written one value at a time rather than as copies of structs,
+	// so padding can't make two snapshots of the same state differ.
+	struct SnapshotWriter {
+		uint8_t *ptr = nullptr;
+
+		template <typename T>
+		_FORCE_INLINE_ void write(T p_value) {
+			static_assert(std::is_arithmetic_v<T>);
+			memcpy(ptr, &p_value, sizeof(T));
+			ptr += sizeof(T);
+		}
+		_FORCE_INLINE_ void write(const Vector3 &p_value) {
+			write(p_value.x);
+			write(p_value.y);
+			write(p_value.z);
+		}
+		_FORCE_INLINE_ void write(const Transform3D &p_value) {
+			for (int i = 0; i < 3; i++) {
+				write(p_value.basis.rows[i]);
+			}
+			write(p_value.origin);
+		}
+		_FORCE_INLINE_ void write(const AABB &p_value) {
+			write(p_value.position);
+			write(p_value.size);
+		}
+	};
+
+	// Reads fail without moving past the end of the buffer.
+	struct SnapshotReader {
+		const uint8_t *ptr = nullptr;
+		const uint8_t *end = nullptr;
+
+		_FORCE_INLINE_ const uint8_t *skip(uint64_t p_size) {
+			if (p_size > uint64_t(end - ptr)) {
+				return nullptr;
+			}
+			const uint8_t *data = ptr;
+			ptr += p_size;
+			return data;
+		}
+
+		template <typename T>
+		_FORCE_INLINE_ bool read(T &r_value) {
+			static_assert(std::is_arithmetic_v<T>);
+			const uint8_t *data = skip(sizeof(T));
+			if (!data) {
+				return false;
+			}
+			memcpy(&r_value, data, sizeof(T));
+			return true;
+		}
+		_FORCE_INLINE_ bool read(Vector3 &r_value) {
+			return read(r_value.x) && read(r_value.y) && read(r_value.z);
+		}
+		_FORCE_INLINE_ bool read(Transform3D &r_value) {
+			return read(r_value.basis.rows[0]) && read(r_value.basis.rows[1]) && read(r_value.basis.rows[2]) && read(r_value.origin);
+		}
+		_FORCE_INLINE_ bool read(AABB &r_value) {
+			return read(r_value.position) && read(r_value.size);
+		}
+	};
+
+	static constexpr uint32_t SNAPSHOT_VECTOR3_SIZE = 3 * sizeof(real_t);
+	static constexpr uint32_t SNAPSHOT_TRANSFORM_SIZE = 4 * SNAPSHOT_VECTOR3_SIZE;
+	static constexpr uint32_t SNAPSHOT_AABB_SIZE = 2 * SNAPSHOT_VECTOR3_SIZE;
+
+	// State that carries over from one step to the next, saved in space snapshots.
+	// Restoring from null puts the constraint back in the state it was created in.
+	virtual uint32_t get_snapshot_size() const { return 0; }
+	virtual void save_snapshot(uint8_t *r_buffer) const {}
+	virtual void restore_snapshot(const uint8_t *p_buffer) {}
+
 	_FORCE_INLINE_ void set_self(const RID &p_self) { self = p_self; }
 	_FORCE_INLINE_ RID get_self() const { return self; }
 
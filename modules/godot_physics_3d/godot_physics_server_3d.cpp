@@ -196,6 +196,24 @@ PhysicsDirectSpaceState3D *GodotPhysicsServer3D::space_get_direct_state(RID p_sp
 	return space->get_direct_state();
 }
 
+PackedByteArray GodotPhysicsServer3D::space_get_snapshot(RID p_space) const {
+	const GodotSpace3D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL_V(space, PackedByteArray());
+	ERR_FAIL_COND_V_MSG(space->is_locked(), PackedByteArray(), "Space state is inaccessible right now, wait for iteration or physics process notification.");
+
+	PackedByteArray snapshot;
+	space->save_snapshot(snapshot);
+	return snapshot;
+}
+
+bool GodotPhysicsServer3D::space_restore_snapshot(RID p_space, const PackedByteArray &p_snapshot) {
+	GodotSpace3D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL_V(space, false);
+	ERR_FAIL_COND_V_MSG(space->is_locked(), false, "Space state is inaccessible right now, wait for iteration or physics process notification.");
+
+	return space->restore_snapshot(p_snapshot);
+}
+
 void GodotPhysicsServer3D::space_set_debug_contacts(RID p_space, int p_max_contacts) {
 	GodotSpace3D *space = space_owner.get_or_null(p_space);
 	ERR_FAIL_NULL(space);
@@ -214,6 +232,13 @@ int GodotPhysicsServer3D::space_get_contact_count(RID p_space) const {
 	return space->get_debug_contact_count();
 }
 
+uint64_t GodotPhysicsServer3D::space_get_elapsed_time(RID p_space, GodotSpace3D::ElapsedTime p_time) const {
+	GodotSpace3D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL_V(space, 0);
+	ERR_FAIL_INDEX_V(p_time, GodotSpace3D::ELAPSED_TIME_MAX, 0);
+	return space->get_elapsed_time(p_time);
+}
+
 RID GodotPhysicsServer3D::area_create() {
 	GodotArea3D *area = memnew(GodotArea3D);
 	RID rid = area_owner.make_rid(area);
@@ -1713,6 +1738,7 @@ void GodotPhysicsServer3D::flush_queries() {
 		uint64_t total_time[GodotSpace3D::ELAPSED_TIME_MAX];
 		static const char *time_name[GodotSpace3D::ELAPSED_TIME_MAX] = {
 			"integrate_forces",
+			"update_broadphase",
 			"generate_islands",
 			"setup_constraints",
 			"solve_constraints",
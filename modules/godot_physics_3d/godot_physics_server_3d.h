@@ -112,10 +112,15 @@ public:
 	// this function only works on physics process, errors and returns null otherwise
 	virtual PhysicsDirectSpaceState3D *space_get_direct_state(RID p_space) override;
 
+	virtual PackedByteArray space_get_snapshot(RID p_space) const override;
+	virtual bool space_restore_snapshot(RID p_space, const PackedByteArray &p_snapshot) override;
+
 	virtual void space_set_debug_contacts(RID p_space, int p_max_contacts) override;
 	virtual Vector<Vector3> space_get_contacts(RID p_space) const override;
 	virtual int space_get_contact_count(RID p_space) const override;
 
+	uint64_t space_get_elapsed_time(RID p_space, GodotSpace3D::ElapsedTime p_time) const;
+
 	/* AREA API */
 
 	virtual RID area_create() override;
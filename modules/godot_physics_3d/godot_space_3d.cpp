@@ -36,6 +36,7 @@
 #include "godot_physics_server_3d.h"
 
 #include "core/config/project_settings.h"
+#include "core/object/worker_thread_pool.h"
 
 #define TEST_MOTION_MARGIN_MIN_VALUE 0.0001
 #define TEST_MOTION_MIN_CONTACT_DEPTH_FACTOR 0.05
@@ -110,13 +111,17 @@ int GodotPhysicsDirectSpaceState3D::intersect_point(const PointParameters &p_par
 bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
 	ERR_FAIL_COND_V(space->locked, false);
 
+	return _intersect_ray(p_parameters, p_parameters.from, p_parameters.to, space->intersection_query_results, space->intersection_query_subindex_results, r_result);
+}
+
+bool GodotPhysicsDirectSpaceState3D::_intersect_ray(const RayParameters &p_parameters, const Vector3 &p_from, const Vector3 &p_to, GodotCollisionObject3D **r_query_results, int *r_query_subindex_results, RayResult &r_result) const {
 	Vector3 begin, end;
 	Vector3 normal;
-	begin = p_parameters.from;
-	end = p_parameters.to;
+	begin = p_from;
+	end = p_to;
 	normal = (end - begin).normalized();
 
-	int amount = space->broadphase->cull_segment(begin, end, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	int amount = space->broadphase->cull_segment(begin, end, r_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, r_query_subindex_results);
 
 	//todo, create another array that references results, compute AABBs and check closest point to ray origin, sort, and stop evaluating results when beyond first collision
 
@@ -128,21 +133,21 @@ bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parame
 	real_t min_d = 1e10;
 
 	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+		if (!_can_collide_with(r_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
-		if (p_parameters.pick_ray && !(space->intersection_query_results[i]->is_ray_pickable())) {
+		if (p_parameters.pick_ray && !(r_query_results[i]->is_ray_pickable())) {
 			continue;
 		}
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(r_query_results[i]->get_self())) {
 			continue;
 		}
 
-		const GodotCollisionObject3D *col_obj = space->intersection_query_results[i];
+		const GodotCollisionObject3D *col_obj = r_query_results[i];
 
-		int shape_idx = space->intersection_query_subindex_results[i];
+		int shape_idx = r_query_subindex_results[i];
 		Transform3D inv_xform = col_obj->get_shape_inv_transform(shape_idx) * col_obj->get_inv_transform();
 
 		Vector3 local_from = inv_xform.xform(begin);
@@ -207,6 +212,46 @@ bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parame
 	return true;
 }
 
+// Worker threads cull into their own buffers, as the ones of the space are shared by every query.
+static thread_local LocalVector<GodotCollisionObject3D *> _thread_query_results;
+static thread_local LocalVector<int> _thread_query_subindex_results;
+
+void GodotPhysicsDirectSpaceState3D::_ensure_thread_query_buffers() {
+	if (unlikely(_thread_query_results.is_empty())) {
+		_thread_query_results.resize(GodotSpace3D::INTERSECTION_QUERY_MAX);
+		_thread_query_subindex_results.resize(GodotSpace3D::INTERSECTION_QUERY_MAX);
+	}
+}
+
+void GodotPhysicsDirectSpaceState3D::_intersect_ray_batch_task(uint32_t p_index, RayBatch *p_batch) {
+	_ensure_thread_query_buffers();
+	p_batch->hits[p_index] = _intersect_ray(*p_batch->parameters, p_batch->from[p_index], p_batch->to[p_index], _thread_query_results.ptr(), _thread_query_subindex_results.ptr(), p_batch->results[p_index]);
+}
+
+void GodotPhysicsDirectSpaceState3D::intersect_ray_batch(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results, bool *r_hits) {
+	for (int i = 0; i < p_count; i++) {
+		r_hits[i] = false;
+	}
+	ERR_FAIL_COND(space->locked);
+
+	if (p_count < BATCH_PARALLEL_THRESHOLD) {
+		for (int i = 0; i < p_count; i++) {
+			r_hits[i] = _intersect_ray(p_parameters, p_from[i], p_to[i], space->intersection_query_results, space->intersection_query_subindex_results, r_results[i]);
+		}
+		return;
+	}
+
+	RayBatch batch;
+	batch.parameters = &p_parameters;
+	batch.from = p_from;
+	batch.to = p_to;
+	batch.results = r_results;
+	batch.hits = r_hits;
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsDirectSpaceState3D::_intersect_ray_batch_task, &batch, p_count, -1, true, SNAME("Physics3DIntersectRayBatch"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
 int GodotPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
 	if (p_result_max <= 0) {
 		return 0;
@@ -241,7 +286,7 @@ int GodotPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_par
 		const GodotCollisionObject3D *col_obj = space->intersection_query_results[i];
 		int shape_idx = space->intersection_query_subindex_results[i];
 
-		if (!GodotCollisionSolver3D::solve_static(shape, p_parameters.transform, col_obj->get_shape(shape_idx), col_obj->get_transform() * col_obj->get_shape_transform(shape_idx), nullptr, nullptr, nullptr, p_parameters.margin, 0)) {
+		if (!GodotCollisionSolver3D::solve_static(shape, p_parameters.transform, col_obj->get_shape(shape_idx), col_obj->get_transform() * col_obj->get_shape_transform(shape_idx), nullptr, nullptr, nullptr, p_parameters.margin, 0, space->is_batched_axis_tests_enabled())) {
 			continue;
 		}
 
@@ -266,51 +311,57 @@ bool GodotPhysicsDirectSpaceState3D::cast_motion(const ShapeParameters &p_parame
 	GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
 	ERR_FAIL_NULL_V(shape, false);
 
-	AABB aabb = p_parameters.transform.xform(shape->get_aabb());
-	aabb = aabb.merge(AABB(aabb.position + p_parameters.motion, aabb.size)); //motion
+	_cast_motion(shape, p_parameters, p_parameters.transform, p_parameters.motion, space->intersection_query_results, space->intersection_query_subindex_results, p_closest_safe, p_closest_unsafe, r_info);
+
+	return true;
+}
+
+void GodotPhysicsDirectSpaceState3D::_cast_motion(GodotShape3D *p_shape, const ShapeParameters &p_parameters, const Transform3D &p_transform, const Vector3 &p_motion, GodotCollisionObject3D **r_query_results, int *r_query_subindex_results, real_t &p_closest_safe, real_t &p_closest_unsafe, ShapeRestInfo *r_info) const {
+	AABB aabb = p_transform.xform(p_shape->get_aabb());
+	aabb = aabb.merge(AABB(aabb.position + p_motion, aabb.size)); //motion
 	aabb = aabb.grow(p_parameters.margin);
 
-	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	int amount = space->broadphase->cull_aabb(aabb, r_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, r_query_subindex_results);
 
 	real_t best_safe = 1;
 	real_t best_unsafe = 1;
 
-	Transform3D xform_inv = p_parameters.transform.affine_inverse();
+	Transform3D xform_inv = p_transform.affine_inverse();
 	GodotMotionShape3D mshape;
-	mshape.shape = shape;
-	mshape.motion = xform_inv.basis.xform(p_parameters.motion);
+	mshape.shape = p_shape;
+	mshape.motion = xform_inv.basis.xform(p_motion);
 
 	bool best_first = true;
 
-	Vector3 motion_normal = p_parameters.motion.normalized();
+	Vector3 motion_normal = p_motion.normalized();
 
 	Vector3 closest_A, closest_B;
 
 	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+		if (!_can_collide_with(r_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(r_query_results[i]->get_self())) {
 			continue; //ignore excluded
 		}
 
-		const GodotCollisionObject3D *col_obj = space->intersection_query_results[i];
-		int shape_idx = space->intersection_query_subindex_results[i];
+		const GodotCollisionObject3D *col_obj = r_query_results[i];
+		int shape_idx = r_query_subindex_results[i];
 
 		Vector3 point_A, point_B;
 		Vector3 sep_axis = motion_normal;
 
 		Transform3D col_obj_xform = col_obj->get_transform() * col_obj->get_shape_transform(shape_idx);
 		//test initial overlap, does it collide if going all the way?
-		if (GodotCollisionSolver3D::solve_distance(&mshape, p_parameters.transform, col_obj->get_shape(shape_idx), col_obj_xform, point_A, point_B, aabb, &sep_axis)) {
+		if (GodotCollisionSolver3D::solve_distance(&mshape, p_transform, col_obj->get_shape(shape_idx), col_obj_xform, point_A, point_B, aabb, &sep_axis)) {
 			continue;
 		}
 
 		//test initial overlap, ignore objects it's inside of.
 		sep_axis = motion_normal;
 
-		if (!GodotCollisionSolver3D::solve_distance(shape, p_parameters.transform, col_obj->get_shape(shape_idx), col_obj_xform, point_A, point_B, aabb, &sep_axis)) {
+		if (!GodotCollisionSolver3D::solve_distance(p_shape, p_transform, col_obj->get_shape(shape_idx), col_obj_xform, point_A, point_B, aabb, &sep_axis)) {
 			continue;
 		}
 
@@ -321,11 +372,11 @@ bool GodotPhysicsDirectSpaceState3D::cast_motion(const ShapeParameters &p_parame
 		for (int j = 0; j < 8; j++) { //steps should be customizable..
 			real_t fraction = low + (hi - low) * fraction_coeff;
 
-			mshape.motion = xform_inv.basis.xform(p_parameters.motion * fraction);
+			mshape.motion = xform_inv.basis.xform(p_motion * fraction);
 
 			Vector3 lA, lB;
 			Vector3 sep = motion_normal; //important optimization for this to work fast enough
-			bool collided = !GodotCollisionSolver3D::solve_distance(&mshape, p_parameters.transform, col_obj->get_shape(shape_idx), col_obj_xform, lA, lB, aabb, &sep);
+			bool collided = !GodotCollisionSolver3D::solve_distance(&mshape, p_transform, col_obj->get_shape(shape_idx), col_obj_xform, lA, lB, aabb, &sep);
 
 			if (collided) {
 				hi = fraction;
@@ -377,6 +428,39 @@ bool GodotPhysicsDirectSpaceState3D::cast_motion(const ShapeParameters &p_parame
 
 	p_closest_safe = best_safe;
 	p_closest_unsafe = best_unsafe;
+}
+
+void GodotPhysicsDirectSpaceState3D::_cast_motion_batch_task(uint32_t p_index, MotionBatch *p_batch) {
+	_ensure_thread_query_buffers();
+	_cast_motion(p_batch->shape, *p_batch->parameters, p_batch->transforms[p_index], p_batch->motions[p_index], _thread_query_results.ptr(), _thread_query_subindex_results.ptr(), p_batch->closest_safe[p_index], p_batch->closest_unsafe[p_index], nullptr);
+}
+
+bool GodotPhysicsDirectSpaceState3D::cast_motion_batch(const ShapeParameters &p_parameters, const Transform3D *p_transforms, const Vector3 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe) {
+	for (int i = 0; i < p_count; i++) {
+		r_closest_safe[i] = 1.0;
+		r_closest_unsafe[i] = 1.0;
+	}
+
+	GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
+	ERR_FAIL_NULL_V(shape, false);
+
+	if (p_count < BATCH_PARALLEL_THRESHOLD) {
+		for (int i = 0; i < p_count; i++) {
+			_cast_motion(shape, p_parameters, p_transforms[i], p_motions[i], space->intersection_query_results, space->intersection_query_subindex_results, r_closest_safe[i], r_closest_unsafe[i], nullptr);
+		}
+		return true;
+	}
+
+	MotionBatch batch;
+	batch.shape = shape;
+	batch.parameters = &p_parameters;
+	batch.transforms = p_transforms;
+	batch.motions = p_motions;
+	batch.closest_safe = r_closest_safe;
+	batch.closest_unsafe = r_closest_unsafe;
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsDirectSpaceState3D::_cast_motion_batch_task, &batch, p_count, -1, true, SNAME("Physics3DCastMotionBatch"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 
 	return true;
 }
@@ -418,7 +502,7 @@ bool GodotPhysicsDirectSpaceState3D::collide_shape(const ShapeParameters &p_para
 
 		int shape_idx = space->intersection_query_subindex_results[i];
 
-		if (GodotCollisionSolver3D::solve_static(shape, p_parameters.transform, col_obj->get_shape(shape_idx), col_obj->get_transform() * col_obj->get_shape_transform(shape_idx), cbkres, cbkptr, nullptr, p_parameters.margin)) {
+		if (GodotCollisionSolver3D::solve_static(shape, p_parameters.transform, col_obj->get_shape(shape_idx), col_obj->get_transform() * col_obj->get_shape_transform(shape_idx), cbkres, cbkptr, nullptr, p_parameters.margin, 0, space->is_batched_axis_tests_enabled())) {
 			collided = true;
 		}
 	}
@@ -544,7 +628,7 @@ bool GodotPhysicsDirectSpaceState3D::rest_info(const ShapeParameters &p_paramete
 
 		rcd.object = col_obj;
 		rcd.shape = shape_idx;
-		bool sc = GodotCollisionSolver3D::solve_static(shape, p_parameters.transform, col_obj->get_shape(shape_idx), col_obj->get_transform() * col_obj->get_shape_transform(shape_idx), _rest_cbk_result, &rcd, nullptr, margin);
+		bool sc = GodotCollisionSolver3D::solve_static(shape, p_parameters.transform, col_obj->get_shape(shape_idx), col_obj->get_transform() * col_obj->get_shape_transform(shape_idx), _rest_cbk_result, &rcd, nullptr, margin, 0, space->is_batched_axis_tests_enabled());
 		if (!sc) {
 			continue;
 		}
@@ -743,7 +827,7 @@ bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::
 
 					int shape_idx = intersection_query_subindex_results[i];
 
-					if (GodotCollisionSolver3D::solve_static(body_shape, body_shape_xform, col_obj->get_shape(shape_idx), col_obj->get_transform() * col_obj->get_shape_transform(shape_idx), cbkres, cbkptr, nullptr, margin)) {
+					if (GodotCollisionSolver3D::solve_static(body_shape, body_shape_xform, col_obj->get_shape(shape_idx), col_obj->get_transform() * col_obj->get_shape_transform(shape_idx), cbkres, cbkptr, nullptr, margin, 0, is_batched_axis_tests_enabled())) {
 						collided = cbk.amount > 0;
 					}
 					while (cbk.amount > priority_amount) {
@@ -973,7 +1057,7 @@ bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::
 				rcd.object = col_obj;
 				rcd.shape = shape_idx;
 				rcd.local_shape = j;
-				bool sc = GodotCollisionSolver3D::solve_static(body_shape, body_shape_xform, col_obj->get_shape(shape_idx), col_obj->get_transform() * col_obj->get_shape_transform(shape_idx), _rest_cbk_result, &rcd, nullptr, margin);
+				bool sc = GodotCollisionSolver3D::solve_static(body_shape, body_shape_xform, col_obj->get_shape(shape_idx), col_obj->get_transform() * col_obj->get_shape_transform(shape_idx), _rest_cbk_result, &rcd, nullptr, margin, 0, is_batched_axis_tests_enabled());
 				if (!sc) {
 					continue;
 				}
@@ -1240,6 +1324,290 @@ real_t GodotSpace3D::get_param(PhysicsServer3D::SpaceParameter p_param) const {
 	return 0;
 }
 
+// Snapshots are a header followed by the bodies sorted by RID, each with the bounds of its shapes,
+// the RIDs of the active bodies in activation order and the state of the pairs sorted by key.
+// Values are written one at a time in the byte order of the build, which is the only one meant to restore them.
+// Soft bodies aren't saved, their state is too large to copy every frame.
+static constexpr uint32_t SNAPSHOT_MAGIC = 0x53533347; // "G3SS"
+static constexpr uint32_t SNAPSHOT_VERSION = 2;
+
+struct SnapshotHeader {
+	uint32_t magic = SNAPSHOT_MAGIC;
+	uint32_t version = SNAPSHOT_VERSION;
+	uint32_t real_size = sizeof(real_t);
+	uint32_t body_count = 0;
+	uint32_t active_count = 0;
+	uint32_t pair_count = 0;
+
+	static constexpr uint32_t SIZE = 6 * sizeof(uint32_t);
+};
+
+struct SnapshotBody {
+	uint64_t rid = 0;
+	uint32_t shape_count = 0;
+	GodotBody3D::SnapshotState state;
+
+	static constexpr uint32_t SIZE = sizeof(uint64_t) + sizeof(uint32_t) + 3 * GodotConstraint3D::SNAPSHOT_TRANSFORM_SIZE + 6 * GodotConstraint3D::SNAPSHOT_VECTOR3_SIZE + sizeof(real_t);
+};
+
+struct SnapshotPair {
+	uint64_t objects[2] = {};
+	int32_t shapes[2] = {};
+	uint32_t size = 0;
+
+	static constexpr uint32_t SIZE = 2 * sizeof(uint64_t) + 2 * sizeof(int32_t) + sizeof(uint32_t);
+};
+
+using SnapshotWriter = GodotConstraint3D::SnapshotWriter;
+using SnapshotReader = GodotConstraint3D::SnapshotReader;
+
+static void _write_snapshot_header(SnapshotWriter &p_writer, const SnapshotHeader &p_header) {
+	p_writer.write(p_header.magic);
+	p_writer.write(p_header.version);
+	p_writer.write(p_header.real_size);
+	p_writer.write(p_header.body_count);
+	p_writer.write(p_header.active_count);
+	p_writer.write(p_header.pair_count);
+}
+
+static bool _read_snapshot_header(SnapshotReader &p_reader, SnapshotHeader &r_header) {
+	return p_reader.read(r_header.magic) && p_reader.read(r_header.version) && p_reader.read(r_header.real_size) && p_reader.read(r_header.body_count) && p_reader.read(r_header.active_count) && p_reader.read(r_header.pair_count);
+}
+
+static void _write_snapshot_body(SnapshotWriter &p_writer, const SnapshotBody &p_body) {
+	p_writer.write(p_body.rid);
+	p_writer.write(p_body.shape_count);
+	p_writer.write(p_body.state.transform);
+	p_writer.write(p_body.state.inv_transform);
+	p_writer.write(p_body.state.new_transform);
+	p_writer.write(p_body.state.linear_velocity);
+	p_writer.write(p_body.state.angular_velocity);
+	p_writer.write(p_body.state.applied_force);
+	p_writer.write(p_body.state.applied_torque);
+	p_writer.write(p_body.state.constant_force);
+	p_writer.write(p_body.state.constant_torque);
+	p_writer.write(p_body.state.still_time);
+}
+
+static bool _read_snapshot_body(SnapshotReader &p_reader, SnapshotBody &r_body) {
+	return p_reader.read(r_body.rid) && p_reader.read(r_body.shape_count) &&
+			p_reader.read(r_body.state.transform) && p_reader.read(r_body.state.inv_transform) && p_reader.read(r_body.state.new_transform) &&
+			p_reader.read(r_body.state.linear_velocity) && p_reader.read(r_body.state.angular_velocity) &&
+			p_reader.read(r_body.state.applied_force) && p_reader.read(r_body.state.applied_torque) &&
+			p_reader.read(r_body.state.constant_force) && p_reader.read(r_body.state.constant_torque) &&
+			p_reader.read(r_body.state.still_time);
+}
+
+static void _write_snapshot_pair(SnapshotWriter &p_writer, const SnapshotPair &p_pair) {
+	p_writer.write(p_pair.objects[0]);
+	p_writer.write(p_pair.objects[1]);
+	p_writer.write(p_pair.shapes[0]);
+	p_writer.write(p_pair.shapes[1]);
+	p_writer.write(p_pair.size);
+}
+
+static bool _read_snapshot_pair(SnapshotReader &p_reader, SnapshotPair &r_pair) {
+	return p_reader.read(r_pair.objects[0]) && p_reader.read(r_pair.objects[1]) && p_reader.read(r_pair.shapes[0]) && p_reader.read(r_pair.shapes[1]) && p_reader.read(r_pair.size);
+}
+
+struct SnapshotBodyRIDCompare {
+	_FORCE_INLINE_ bool operator()(const GodotBody3D *p_a, const GodotBody3D *p_b) const { return p_a->get_self() < p_b->get_self(); }
+};
+
+struct SnapshotPairKeyCompare {
+	_FORCE_INLINE_ bool operator()(const GodotConstraint3D *p_a, const GodotConstraint3D *p_b) const { return p_a->get_sort_key() < p_b->get_sort_key(); }
+};
+
+static void _get_snapshot_pairs(const LocalVector<GodotBody3D *> &p_bodies, LocalVector<GodotConstraint3D *> &r_pairs) {
+	for (const GodotBody3D *body : p_bodies) {
+		for (const KeyValue<GodotConstraint3D *, int> &E : body->get_constraint_map()) {
+			// Each pair is listed by both of its bodies, only take it from the first one.
+			if (E.value == 0 && E.key->get_snapshot_size() > 0) {
+				r_pairs.push_back(E.key);
+			}
+		}
+	}
+	r_pairs.sort_custom<SnapshotPairKeyCompare>();
+}
+
+void GodotSpace3D::save_snapshot(Vector<uint8_t> &r_snapshot) const {
+	LocalVector<GodotBody3D *> bodies;
+	for (GodotCollisionObject3D *E : objects) {
+		if (E->get_type() == GodotCollisionObject3D::TYPE_BODY) {
+			bodies.push_back(static_cast<GodotBody3D *>(E));
+		}
+	}
+	bodies.sort_custom<SnapshotBodyRIDCompare>();
+
+	LocalVector<GodotConstraint3D *> pairs;
+	_get_snapshot_pairs(bodies, pairs);
+
+	SnapshotHeader header;
+	header.body_count = bodies.size();
+	for (const SelfList<GodotBody3D> *E = active_list.first(); E; E = E->next()) {
+		header.active_count++;
+	}
+	header.pair_count = pairs.size();
+
+	uint64_t size = SnapshotHeader::SIZE + bodies.size() * SnapshotBody::SIZE + header.active_count * sizeof(uint64_t) + pairs.size() * SnapshotPair::SIZE;
+	for (const GodotBody3D *body : bodies) {
+		size += body->get_shape_count() * GodotConstraint3D::SNAPSHOT_AABB_SIZE;
+	}
+	for (const GodotConstraint3D *pair : pairs) {
+		size += pair->get_snapshot_size();
+	}
+
+	r_snapshot.resize(size);
+	SnapshotWriter writer;
+	writer.ptr = r_snapshot.ptrw();
+
+	_write_snapshot_header(writer, header);
+
+	for (const GodotBody3D *body : bodies) {
+		SnapshotBody record;
+		record.rid = body->get_self().get_id();
+		record.shape_count = body->get_shape_count();
+		body->save_snapshot(record.state);
+		_write_snapshot_body(writer, record);
+		for (int i = 0; i < body->get_shape_count(); i++) {
+			writer.write(body->get_shape_aabb(i));
+		}
+	}
+
+	for (const SelfList<GodotBody3D> *E = active_list.first(); E; E = E->next()) {
+		writer.write(E->self()->get_self().get_id());
+	}
+
+	for (const GodotConstraint3D *pair : pairs) {
+		const GodotConstraint3D::SortKey key = pair->get_sort_key();
+		SnapshotPair record;
+		for (int i = 0; i < 2; i++) {
+			record.objects[i] = key.objects[i].get_id();
+			record.shapes[i] = key.shapes[i];
+		}
+		record.size = pair->get_snapshot_size();
+		_write_snapshot_pair(writer, record);
+		pair->save_snapshot(writer.ptr);
+		writer.ptr += record.size;
+	}
+
+	DEV_ASSERT(writer.ptr == r_snapshot.ptr() + size);
+}
+
+bool GodotSpace3D::restore_snapshot(const Vector<uint8_t> &p_snapshot) {
+	SnapshotReader reader;
+	reader.ptr = p_snapshot.ptr();
+	reader.end = p_snapshot.ptr() + p_snapshot.size();
+
+	SnapshotHeader header;
+	ERR_FAIL_COND_V_MSG(!_read_snapshot_header(reader, header) || header.magic != SNAPSHOT_MAGIC, false, "Invalid physics space snapshot.");
+	ERR_FAIL_COND_V_MSG(header.version != SNAPSHOT_VERSION || header.real_size != sizeof(real_t), false, "Physics space snapshot was taken by a different build of the engine.");
+
+	// Read everything before touching the space, so a truncated snapshot leaves it as it was.
+	LocalVector<SnapshotBody> body_records;
+	LocalVector<uint32_t> body_aabb_offsets;
+	LocalVector<AABB> body_aabbs;
+	body_records.resize(header.body_count);
+	body_aabb_offsets.resize(header.body_count);
+	for (uint32_t i = 0; i < header.body_count; i++) {
+		ERR_FAIL_COND_V_MSG(!_read_snapshot_body(reader, body_records[i]), false, "Physics space snapshot is truncated.");
+		// Checked up front, so a corrupt shape count can't make the bounds allocate more than the snapshot holds.
+		ERR_FAIL_COND_V_MSG(uint64_t(body_records[i].shape_count) * GodotConstraint3D::SNAPSHOT_AABB_SIZE > uint64_t(reader.end - reader.ptr), false, "Physics space snapshot is truncated.");
+		body_aabb_offsets[i] = body_aabbs.size();
+		for (uint32_t j = 0; j < body_records[i].shape_count; j++) {
+			AABB aabb;
+			reader.read(aabb);
+			body_aabbs.push_back(aabb);
+		}
+	}
+
+	LocalVector<uint64_t> active_rids;
+	active_rids.resize(header.active_count);
+	for (uint32_t i = 0; i < header.active_count; i++) {
+		ERR_FAIL_COND_V_MSG(!reader.read(active_rids[i]), false, "Physics space snapshot is truncated.");
+	}
+
+	LocalVector<SnapshotPair> pair_records;
+	LocalVector<const uint8_t *> pair_data;
+	pair_records.resize(header.pair_count);
+	pair_data.resize(header.pair_count);
+	for (uint32_t i = 0; i < header.pair_count; i++) {
+		ERR_FAIL_COND_V_MSG(!_read_snapshot_pair(reader, pair_records[i]), false, "Physics space snapshot is truncated.");
+		pair_data[i] = reader.skip(pair_records[i].size);
+		ERR_FAIL_NULL_V_MSG(pair_data[i], false, "Physics space snapshot is truncated.");
+	}
+
+	HashMap<RID, GodotBody3D *> bodies_by_rid;
+	for (GodotCollisionObject3D *E : objects) {
+		if (E->get_type() == GodotCollisionObject3D::TYPE_BODY) {
+			bodies_by_rid.insert(E->get_self(), static_cast<GodotBody3D *>(E));
+		}
+	}
+
+	uint32_t missing_count = 0;
+	for (uint32_t i = 0; i < header.body_count; i++) {
+		const SnapshotBody &record = body_records[i];
+		GodotBody3D **body_ptr = bodies_by_rid.getptr(RID::from_uint64(record.rid));
+		if (!body_ptr) {
+			missing_count++;
+			continue;
+		}
+		GodotBody3D *body = *body_ptr;
+
+		const AABB *restored_aabbs = nullptr;
+		if (int(record.shape_count) == body->get_shape_count()) {
+			restored_aabbs = body_aabbs.ptr() + body_aabb_offsets[i];
+		}
+		body->restore_snapshot(record.state, restored_aabbs);
+		// Reactivated below, in the order the snapshot lists them.
+		body->set_active(false);
+	}
+
+	for (uint64_t rid : active_rids) {
+		GodotBody3D **body_ptr = bodies_by_rid.getptr(RID::from_uint64(rid));
+		if (body_ptr) {
+			(*body_ptr)->set_active(true);
+		}
+	}
+
+	// Let the broadphase create and remove pairs for the restored bounds, then put back the state of the pairs
+	// that existed when the snapshot was taken. Keys are sorted on both sides, so a single pass matches them.
+	update();
+
+	LocalVector<GodotBody3D *> bodies;
+	for (const KeyValue<RID, GodotBody3D *> &E : bodies_by_rid) {
+		bodies.push_back(E.value);
+	}
+	LocalVector<GodotConstraint3D *> pairs;
+	_get_snapshot_pairs(bodies, pairs);
+
+	uint32_t pair_index = 0;
+	for (GodotConstraint3D *pair : pairs) {
+		const GodotConstraint3D::SortKey key = pair->get_sort_key();
+		const uint8_t *data = nullptr;
+		while (pair_index < header.pair_count) {
+			const SnapshotPair &record = pair_records[pair_index];
+			GodotConstraint3D::SortKey record_key;
+			for (int i = 0; i < 2; i++) {
+				record_key.objects[i] = RID::from_uint64(record.objects[i]);
+				record_key.shapes[i] = record.shapes[i];
+			}
+			if (key < record_key) {
+				break;
+			}
+			pair_index++;
+			if (!(record_key < key) && record.size == pair->get_snapshot_size()) {
+				data = pair_data[pair_index - 1];
+				break;
+			}
+		}
+		pair->restore_snapshot(data);
+	}
+
+	ERR_FAIL_COND_V_MSG(missing_count > 0, false, vformat("%d bodies in the physics space snapshot no longer exist in the space, the rest of the snapshot was restored.", missing_count));
+	return true;
+}
+
 void GodotSpace3D::lock() {
 	locked = true;
 }
@@ -1265,6 +1633,7 @@ GodotSpace3D::GodotSpace3D() {
 	contact_max_separation = GLOBAL_GET("physics/3d/solver/contact_max_separation");
 	contact_max_allowed_penetration = GLOBAL_GET("physics/3d/solver/contact_max_allowed_penetration");
 	contact_bias = GLOBAL_GET("physics/3d/solver/default_contact_bias");
+	batched_axis_tests = GLOBAL_GET("physics/3d/solver/batched_separating_axis_tests");
 
 	broadphase = GodotBroadPhase3D::create_func();
 	broadphase->set_pair_callback(_broadphase_pair, this);
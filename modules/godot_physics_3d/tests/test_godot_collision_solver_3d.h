@@ -0,0 +1,141 @@
+/**************************************************************************/
+/*  test_godot_collision_solver_3d.h                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../godot_collision_solver_3d.h"
+
+#include "core/math/random_pcg.h"
+#include "tests/test_macros.h"
+
+namespace TestGodotCollisionSolver3D {
+
+struct ContactResult {
+	bool collided = false;
+	LocalVector<Vector3> points;
+};
+
+static void collect_contacts(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal, void *p_userdata) {
+	ContactResult *result = static_cast<ContactResult *>(p_userdata);
+	result->points.push_back(p_point_A);
+	result->points.push_back(p_point_B);
+}
+
+// The batched paths evaluate the same expressions in the same order as the scalar ones, and the build
+// disables floating-point contraction, so the contacts have to be bit-identical.
+static bool contacts_match(const ContactResult &p_a, const ContactResult &p_b) {
+	if (p_a.collided != p_b.collided || p_a.points.size() != p_b.points.size()) {
+		return false;
+	}
+	for (uint32_t i = 0; i < p_a.points.size(); i++) {
+		if (p_a.points[i] != p_b.points[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static Vector3 random_vector(RandomPCG &p_rng, real_t p_from, real_t p_to) {
+	return Vector3(p_rng.random(p_from, p_to), p_rng.random(p_from, p_to), p_rng.random(p_from, p_to));
+}
+
+static Transform3D random_transform(RandomPCG &p_rng) {
+	Basis basis;
+	if (p_rng.rand(4) != 0) {
+		// Leave some axis aligned cases in, those hit the degenerate edge axes.
+		basis = Basis(random_vector(p_rng, -1.0, 1.0).normalized(), p_rng.random(0.0, Math::TAU));
+	}
+	return Transform3D(basis, random_vector(p_rng, -1.5, 1.5));
+}
+
+static GodotShape3D *create_random_shape(RandomPCG &p_rng) {
+	switch (p_rng.rand(3)) {
+		case 0: {
+			GodotBoxShape3D *box = memnew(GodotBoxShape3D);
+			box->set_data(random_vector(p_rng, 0.1, 1.0));
+			return box;
+		}
+		case 1: {
+			GodotCapsuleShape3D *capsule = memnew(GodotCapsuleShape3D);
+			Dictionary d;
+			real_t radius = p_rng.random(0.1, 0.6);
+			d["radius"] = radius;
+			d["height"] = radius * 2.0 + p_rng.random(0.0, 1.5);
+			capsule->set_data(d);
+			return capsule;
+		}
+		default: {
+			GodotConvexPolygonShape3D *convex = memnew(GodotConvexPolygonShape3D);
+			Vector<Vector3> points;
+			int point_count = 8 + p_rng.rand(24);
+			for (int i = 0; i < point_count; i++) {
+				points.push_back(random_vector(p_rng, -0.8, 0.8));
+			}
+			convex->set_data(points);
+			return convex;
+		}
+	}
+}
+
+TEST_CASE("[GodotPhysics3D][CollisionSolver] Batched SAT axes match the scalar solver") {
+	const int iterations = 3000;
+	RandomPCG rng(20251019);
+
+	int collisions = 0;
+	int mismatches = 0;
+	for (int i = 0; i < iterations; i++) {
+		GodotShape3D *shape_A = create_random_shape(rng);
+		GodotShape3D *shape_B = create_random_shape(rng);
+		Transform3D transform_A = random_transform(rng);
+		Transform3D transform_B = random_transform(rng);
+		real_t margin = rng.rand(2) ? rng.random(0.0, 0.1) : 0.0;
+
+		ContactResult scalar;
+		scalar.collided = GodotCollisionSolver3D::solve_static(shape_A, transform_A, shape_B, transform_B, collect_contacts, &scalar, nullptr, margin, margin, false);
+
+		ContactResult batched;
+		batched.collided = GodotCollisionSolver3D::solve_static(shape_A, transform_A, shape_B, transform_B, collect_contacts, &batched, nullptr, margin, margin, true);
+
+		if (scalar.collided) {
+			collisions++;
+		}
+		if (!contacts_match(scalar, batched)) {
+			mismatches++;
+		}
+
+		memdelete(shape_A);
+		memdelete(shape_B);
+	}
+
+	CHECK_MESSAGE(collisions > iterations / 10, "The fuzzer should generate a fair amount of colliding pairs.");
+	CHECK_MESSAGE(mismatches == 0, vformat("%d of %d pairs differ between the batched and scalar solvers.", mismatches, iterations));
+}
+
+} // namespace TestGodotCollisionSolver3D
@@ -0,0 +1,190 @@
+/**************************************************************************/
+/*  test_godot_space_3d_queries.h                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../godot_physics_server_3d.h"
+
+#include "core/math/random_pcg.h"
+#include "tests/physics_test_utils.h"
+#include "tests/test_macros.h"
+
+namespace TestGodotSpace3DQueries {
+
+typedef TestUtils::PhysicsServer3DScope<GodotPhysicsServer3D> GodotPhysicsServer3DScope;
+
+struct QueryScene {
+	RID space;
+	RID sphere_shape;
+};
+
+// Everything created is freed with the server scope.
+static QueryScene create_query_scene(GodotPhysicsServer3DScope &p_server) {
+	QueryScene scene;
+
+	scene.space = p_server.track(p_server->space_create());
+	p_server->space_set_active(scene.space, true);
+
+	RID box_shape = p_server.track(p_server->box_shape_create());
+	p_server->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+	scene.sphere_shape = p_server.track(p_server->sphere_shape_create());
+	p_server->shape_set_data(scene.sphere_shape, 0.25);
+
+	// A field of static pillars of varying height, so rays and casts hit different objects.
+	const int side = 32;
+	for (int i = 0; i < side * side; i++) {
+		const int x = i % side;
+		const int z = i / side;
+
+		RID body = p_server.track(p_server->body_create());
+		p_server->body_set_mode(body, PhysicsServer3D::BODY_MODE_STATIC);
+		p_server->body_set_space(body, scene.space);
+		p_server->body_add_shape(body, box_shape);
+		p_server->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3((x - side / 2) * 2.0, (i % 7) * 0.5, (z - side / 2) * 2.0)));
+	}
+
+	// Let the broadphase settle before querying.
+	p_server->step(1.0 / 60.0);
+
+	return scene;
+}
+
+TEST_CASE("[SceneTree][GodotPhysics3D] Batched ray queries match single queries") {
+	GodotPhysicsServer3DScope server("GodotPhysics3D");
+	REQUIRE(server.get());
+
+	QueryScene scene = create_query_scene(server);
+	PhysicsDirectSpaceState3D *space_state = server->space_get_direct_state(scene.space);
+	REQUIRE(space_state);
+
+	const int ray_count = 4096;
+	RandomPCG rng(42);
+
+	LocalVector<Vector3> from;
+	LocalVector<Vector3> to;
+	from.resize(ray_count);
+	to.resize(ray_count);
+	for (int i = 0; i < ray_count; i++) {
+		from[i] = Vector3(rng.random(-32.0, 32.0), 10.0, rng.random(-32.0, 32.0));
+		to[i] = from[i] + Vector3(rng.random(-4.0, 4.0), -20.0, rng.random(-4.0, 4.0));
+	}
+
+	PhysicsDirectSpaceState3D::RayParameters parameters;
+
+	LocalVector<PhysicsDirectSpaceState3D::RayResult> single_results;
+	LocalVector<bool> single_hits;
+	single_results.resize(ray_count);
+	single_hits.resize(ray_count);
+
+	for (int i = 0; i < ray_count; i++) {
+		parameters.from = from[i];
+		parameters.to = to[i];
+		single_hits[i] = space_state->intersect_ray(parameters, single_results[i]);
+	}
+
+	LocalVector<PhysicsDirectSpaceState3D::RayResult> batch_results;
+	LocalVector<bool> batch_hits;
+	batch_results.resize(ray_count);
+	batch_hits.resize(ray_count);
+
+	space_state->intersect_ray_batch(parameters, from.ptr(), to.ptr(), ray_count, batch_results.ptr(), batch_hits.ptr());
+
+	int hit_count = 0;
+	int mismatches = 0;
+	for (int i = 0; i < ray_count; i++) {
+		if (single_hits[i]) {
+			hit_count++;
+		}
+		if (single_hits[i] != batch_hits[i]) {
+			mismatches++;
+		} else if (single_hits[i] && (single_results[i].rid != batch_results[i].rid || single_results[i].shape != batch_results[i].shape || !single_results[i].position.is_equal_approx(batch_results[i].position) || !single_results[i].normal.is_equal_approx(batch_results[i].normal))) {
+			mismatches++;
+		}
+	}
+	CHECK_MESSAGE(hit_count > 0, "The rays should hit the pillars.");
+	CHECK_MESSAGE(mismatches == 0, "Batched rays should return the same hits as single rays.");
+}
+
+TEST_CASE("[SceneTree][GodotPhysics3D] Batched shape casts match single casts") {
+	GodotPhysicsServer3DScope server("GodotPhysics3D");
+	REQUIRE(server.get());
+
+	QueryScene scene = create_query_scene(server);
+	PhysicsDirectSpaceState3D *space_state = server->space_get_direct_state(scene.space);
+	REQUIRE(space_state);
+
+	const int cast_count = 1024;
+	RandomPCG rng(7);
+
+	LocalVector<Transform3D> transforms;
+	LocalVector<Vector3> motions;
+	transforms.resize(cast_count);
+	motions.resize(cast_count);
+	for (int i = 0; i < cast_count; i++) {
+		transforms[i] = Transform3D(Basis(), Vector3(rng.random(-32.0, 32.0), 10.0, rng.random(-32.0, 32.0)));
+		motions[i] = Vector3(rng.random(-2.0, 2.0), -20.0, rng.random(-2.0, 2.0));
+	}
+
+	PhysicsDirectSpaceState3D::ShapeParameters parameters;
+	parameters.shape_rid = scene.sphere_shape;
+
+	LocalVector<real_t> single_safe;
+	LocalVector<real_t> single_unsafe;
+	single_safe.resize(cast_count);
+	single_unsafe.resize(cast_count);
+
+	for (int i = 0; i < cast_count; i++) {
+		parameters.transform = transforms[i];
+		parameters.motion = motions[i];
+		REQUIRE(space_state->cast_motion(parameters, single_safe[i], single_unsafe[i]));
+	}
+
+	LocalVector<real_t> batch_safe;
+	LocalVector<real_t> batch_unsafe;
+	batch_safe.resize(cast_count);
+	batch_unsafe.resize(cast_count);
+
+	REQUIRE(space_state->cast_motion_batch(parameters, transforms.ptr(), motions.ptr(), cast_count, batch_safe.ptr(), batch_unsafe.ptr()));
+
+	int blocked_count = 0;
+	int mismatches = 0;
+	for (int i = 0; i < cast_count; i++) {
+		if (single_safe[i] < 1.0) {
+			blocked_count++;
+		}
+		if (single_safe[i] != batch_safe[i] || single_unsafe[i] != batch_unsafe[i]) {
+			mismatches++;
+		}
+	}
+	CHECK_MESSAGE(blocked_count > 0, "The casts should be blocked by the pillars.");
+	CHECK_MESSAGE(mismatches == 0, "Batched casts should return the same fractions as single casts.");
+}
+
+} // namespace TestGodotSpace3DQueries
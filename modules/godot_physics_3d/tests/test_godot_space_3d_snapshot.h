@@ -0,0 +1,209 @@
+/**************************************************************************/
+/*  test_godot_space_3d_snapshot.h                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../godot_physics_server_3d.h"
+
+#include "core/math/random_pcg.h"
+#include "core/os/os.h"
+#include "tests/physics_test_utils.h"
+#include "tests/test_macros.h"
+
+namespace TestGodotSpace3DSnapshot {
+
+typedef TestUtils::PhysicsServer3DScope<GodotPhysicsServer3D> GodotPhysicsServer3DScope;
+
+struct Scene {
+	RID space;
+	LocalVector<RID> bodies;
+};
+
+// Drops boxes and spheres from various heights onto a static floor, through a band of sideways gravity.
+// Bodies are far enough apart not to touch each other, as GodotPhysics3D only steps the same way twice
+// when its pairs are created in the same order, which a restore doesn't guarantee for bodies touching each other.
+// Everything created is freed with the server scope.
+static Scene create_grid(GodotPhysicsServer3DScope &p_server, int p_body_count) {
+	Scene scene;
+	scene.space = p_server.track(p_server->space_create());
+	p_server->space_set_active(scene.space, true);
+	p_server->area_set_param(scene.space, PhysicsServer3D::AREA_PARAM_GRAVITY, 9.8);
+	p_server->area_set_param(scene.space, PhysicsServer3D::AREA_PARAM_GRAVITY_VECTOR, Vector3(0, -1, 0));
+
+	RID box_shape = p_server.track(p_server->box_shape_create());
+	p_server->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+	RID sphere_shape = p_server.track(p_server->sphere_shape_create());
+	p_server->shape_set_data(sphere_shape, 0.4);
+
+	const int side = int(Math::ceil(Math::sqrt(double(p_body_count))));
+	const real_t extent = side * 2.5 + 5.0;
+
+	RID floor_shape = p_server.track(p_server->box_shape_create());
+	p_server->shape_set_data(floor_shape, Vector3(extent, 1, extent));
+	RID floor = p_server.track(p_server->body_create());
+	p_server->body_set_mode(floor, PhysicsServer3D::BODY_MODE_STATIC);
+	p_server->body_set_space(floor, scene.space);
+	p_server->body_add_shape(floor, floor_shape);
+	p_server->body_set_state(floor, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(0, -1, 0)));
+
+	RID band_shape = p_server.track(p_server->box_shape_create());
+	p_server->shape_set_data(band_shape, Vector3(extent, 1, extent));
+	RID band = p_server.track(p_server->area_create());
+	p_server->area_set_space(band, scene.space);
+	p_server->area_add_shape(band, band_shape);
+	p_server->area_set_transform(band, Transform3D(Basis(), Vector3(0, 2.5, 0)));
+	p_server->area_set_param(band, PhysicsServer3D::AREA_PARAM_GRAVITY_OVERRIDE_MODE, PhysicsServer3D::AREA_SPACE_OVERRIDE_REPLACE);
+	p_server->area_set_param(band, PhysicsServer3D::AREA_PARAM_GRAVITY, 9.8);
+	p_server->area_set_param(band, PhysicsServer3D::AREA_PARAM_GRAVITY_VECTOR, Vector3(0.2, -1, 0).normalized());
+
+	RandomPCG rng(4321);
+	for (int i = 0; i < p_body_count; i++) {
+		RID body = p_server.track(p_server->body_create());
+		p_server->body_set_mode(body, PhysicsServer3D::BODY_MODE_RIGID);
+		p_server->body_set_space(body, scene.space);
+		p_server->body_add_shape(body, i % 3 == 0 ? sphere_shape : box_shape);
+		const Basis basis = Basis::from_euler(Vector3(rng.random(-1.0, 1.0), rng.random(-1.0, 1.0), rng.random(-1.0, 1.0)));
+		const Vector3 origin = Vector3((i % side - side / 2) * 5.0, rng.random(1.0, 9.0), (i / side - side / 2) * 5.0);
+		p_server->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(basis, origin));
+		p_server->body_set_state(body, PhysicsServer3D::BODY_STATE_ANGULAR_VELOCITY, Vector3(rng.random(-2.0, 2.0), rng.random(-2.0, 2.0), rng.random(-2.0, 2.0)));
+		scene.bodies.push_back(body);
+	}
+
+	return scene;
+}
+
+static uint32_t get_state_hash(GodotPhysicsServer3D *p_server, const Scene &p_scene) {
+	uint32_t h = HASH_MURMUR3_SEED;
+	for (const RID &body : p_scene.bodies) {
+		const Transform3D transform = p_server->body_get_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM);
+		const Vector3 linear_velocity = p_server->body_get_state(body, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY);
+		const Vector3 angular_velocity = p_server->body_get_state(body, PhysicsServer3D::BODY_STATE_ANGULAR_VELOCITY);
+		const bool sleeping = p_server->body_get_state(body, PhysicsServer3D::BODY_STATE_SLEEPING);
+		for (int i = 0; i < 3; i++) {
+			for (int j = 0; j < 3; j++) {
+				h = hash_murmur3_one_real(transform.basis.rows[i][j], h);
+			}
+			h = hash_murmur3_one_real(transform.origin[i], h);
+			h = hash_murmur3_one_real(linear_velocity[i], h);
+			h = hash_murmur3_one_real(angular_velocity[i], h);
+		}
+		h = hash_murmur3_one_32(sleeping ? 1 : 0, h);
+	}
+	return hash_fmix32(h);
+}
+
+TEST_CASE("[SceneTree][GodotPhysics3D] Restoring a space snapshot replays the same steps") {
+	GodotPhysicsServer3DScope server("GodotPhysics3D");
+	REQUIRE(server.get());
+
+	const Scene scene = create_grid(server, 64);
+
+	// Let the lowest bodies land and the others reach the band first, so the snapshot has contacts
+	// to warm start from and bodies affected by the area.
+	for (int i = 0; i < 45; i++) {
+		server->step(1.0 / 60.0);
+	}
+
+	int in_band_count = 0;
+	for (const RID &body : scene.bodies) {
+		const Transform3D transform = server->body_get_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM);
+		if (transform.origin.y > 1.5 && transform.origin.y < 3.5) {
+			in_band_count++;
+		}
+	}
+	CHECK_MESSAGE(in_band_count > 0, "Some bodies should be inside the area when the snapshot is taken.");
+
+	const uint32_t snapshot_hash = get_state_hash(server.get(), scene);
+	const PackedByteArray snapshot = server->space_get_snapshot(scene.space);
+	REQUIRE_FALSE(snapshot.is_empty());
+
+	const int step_count = 60;
+	LocalVector<uint32_t> hashes;
+	for (int i = 0; i < step_count; i++) {
+		server->step(1.0 / 60.0);
+		hashes.push_back(get_state_hash(server.get(), scene));
+	}
+	CHECK(hashes[step_count - 1] != snapshot_hash);
+
+	// Roll back twice to make sure restoring doesn't depend on where the space was left.
+	PackedByteArray replayed_snapshots[2];
+	for (int run = 0; run < 2; run++) {
+		REQUIRE(server->space_restore_snapshot(scene.space, snapshot));
+		CHECK(get_state_hash(server.get(), scene) == snapshot_hash);
+
+		int first_divergence = -1;
+		for (int i = 0; i < step_count; i++) {
+			server->step(1.0 / 60.0);
+			if (first_divergence == -1 && get_state_hash(server.get(), scene) != hashes[i]) {
+				first_divergence = i;
+			}
+		}
+		CHECK_MESSAGE(first_divergence == -1, vformat("Stepping from the restored snapshot diverged at step %d.", first_divergence));
+		replayed_snapshots[run] = server->space_get_snapshot(scene.space);
+	}
+
+	// Both runs end in the same state, so their snapshots should be the same down to the last byte.
+	CHECK(replayed_snapshots[0] == replayed_snapshots[1]);
+
+	ERR_PRINT_OFF;
+	PackedByteArray truncated = snapshot;
+	truncated.resize(snapshot.size() / 2);
+	CHECK_FALSE(server->space_restore_snapshot(scene.space, truncated));
+	CHECK_FALSE(server->space_restore_snapshot(scene.space, PackedByteArray()));
+	ERR_PRINT_ON;
+}
+
+TEST_CASE("[SceneTree][GodotPhysics3D][Benchmark] Space snapshot timing" * doctest::skip()) {
+	GodotPhysicsServer3DScope server("GodotPhysics3D");
+	REQUIRE(server.get());
+
+	const Scene scene = create_grid(server, 1000);
+	for (int i = 0; i < 45; i++) {
+		server->step(1.0 / 60.0);
+	}
+
+	const int iterations = 100;
+	PackedByteArray snapshot;
+	uint64_t snapshot_usec = 0;
+	uint64_t restore_usec = 0;
+	for (int i = 0; i < iterations; i++) {
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		snapshot = server->space_get_snapshot(scene.space);
+		uint64_t middle = OS::get_singleton()->get_ticks_usec();
+		CHECK(server->space_restore_snapshot(scene.space, snapshot));
+		uint64_t end = OS::get_singleton()->get_ticks_usec();
+		snapshot_usec += middle - begin;
+		restore_usec += end - middle;
+	}
+
+	MESSAGE(vformat("1000 bodies: %d byte snapshot, %.1f usec to save, %.1f usec to restore.", snapshot.size(), double(snapshot_usec) / iterations, double(restore_usec) / iterations));
+}
+
+} // namespace TestGodotSpace3DSnapshot
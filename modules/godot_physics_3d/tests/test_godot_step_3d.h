@@ -0,0 +1,163 @@
+/**************************************************************************/
+/*  test_godot_step_3d.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../godot_physics_server_3d.h"
+
+#include "core/os/os.h"
+#include "tests/physics_test_utils.h"
+#include "tests/test_macros.h"
+
+namespace TestGodotStep3D {
+
+typedef TestUtils::PhysicsServer3DScope<GodotPhysicsServer3D> GodotPhysicsServer3DScope;
+
+struct StackScene {
+	RID space;
+	LocalVector<RID> bodies;
+};
+
+// Everything created is freed with the server scope.
+static StackScene create_stack_scene(GodotPhysicsServer3DScope &p_server, int p_body_count) {
+	StackScene scene;
+
+	scene.space = p_server.track(p_server->space_create());
+	p_server->space_set_active(scene.space, true);
+
+	RID ground_shape = p_server.track(p_server->box_shape_create());
+	p_server->shape_set_data(ground_shape, Vector3(100, 1, 100));
+	RID ground = p_server.track(p_server->body_create());
+	p_server->body_set_mode(ground, PhysicsServer3D::BODY_MODE_STATIC);
+	p_server->body_set_space(ground, scene.space);
+	p_server->body_add_shape(ground, ground_shape);
+	p_server->body_set_state(ground, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(0, -1, 0)));
+
+	RID box_shape = p_server.track(p_server->box_shape_create());
+	p_server->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+
+	// Columns of boxes slightly apart so they fall, touch the ground and stack up.
+	const int side = 16;
+	for (int i = 0; i < p_body_count; i++) {
+		const int x = i % side;
+		const int z = (i / side) % side;
+		const int y = i / (side * side);
+
+		RID body = p_server.track(p_server->body_create());
+		p_server->body_set_mode(body, PhysicsServer3D::BODY_MODE_RIGID);
+		p_server->body_set_space(body, scene.space);
+		p_server->body_add_shape(body, box_shape);
+		p_server->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3((x - side / 2) * 1.5, 0.75 + y * 1.25, (z - side / 2) * 1.5)));
+		scene.bodies.push_back(body);
+	}
+
+	return scene;
+}
+
+TEST_CASE("[SceneTree][GodotPhysics3D] Parallel step is deterministic") {
+	GodotPhysicsServer3DScope server("GodotPhysics3D");
+	REQUIRE(server.get());
+
+	const int body_count = 512;
+	const int step_count = 60;
+
+	Vector<Transform3D> results[2];
+	for (int run = 0; run < 2; run++) {
+		StackScene scene = create_stack_scene(server, body_count);
+		for (int i = 0; i < step_count; i++) {
+			server->step(1.0 / 60.0);
+		}
+		for (const RID &body : scene.bodies) {
+			results[run].push_back(server->body_get_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM));
+		}
+		server.free_tracked();
+	}
+
+	REQUIRE(results[0].size() == body_count);
+	REQUIRE(results[1].size() == body_count);
+
+	int mismatches = 0;
+	bool resting = true;
+	for (int i = 0; i < body_count; i++) {
+		if (results[0][i] != results[1][i]) {
+			mismatches++;
+		}
+		if (results[0][i].origin.y < -1.0) {
+			resting = false;
+		}
+	}
+	CHECK_MESSAGE(mismatches == 0, "Running the same scene twice should produce bit-identical transforms.");
+	CHECK_MESSAGE(resting, "Boxes should come to rest on the ground instead of falling through.");
+}
+
+TEST_CASE("[SceneTree][GodotPhysics3D][Benchmark] Stress benchmark" * doctest::skip()) {
+	GodotPhysicsServer3DScope server("GodotPhysics3D");
+	REQUIRE(server.get());
+
+	const int body_count = 1024;
+	const int step_count = 120;
+
+	static const char *phase_names[GodotSpace3D::ELAPSED_TIME_MAX] = {
+		"integrate_forces",
+		"update_broadphase",
+		"generate_islands",
+		"setup_constraints",
+		"solve_constraints",
+		"integrate_velocities"
+	};
+
+	StackScene scene = create_stack_scene(server, body_count);
+
+	uint64_t phase_time[GodotSpace3D::ELAPSED_TIME_MAX] = {};
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < step_count; i++) {
+		server->step(1.0 / 60.0);
+		for (int j = 0; j < GodotSpace3D::ELAPSED_TIME_MAX; j++) {
+			phase_time[j] += server->space_get_elapsed_time(scene.space, GodotSpace3D::ElapsedTime(j));
+		}
+	}
+	uint64_t total = OS::get_singleton()->get_ticks_usec() - begin;
+
+	MESSAGE(vformat("Stepped %d bodies %d times in %.2f ms.", body_count, step_count, total / 1000.0));
+	for (int j = 0; j < GodotSpace3D::ELAPSED_TIME_MAX; j++) {
+		MESSAGE(vformat("  %s: %.2f ms", phase_names[j], phase_time[j] / 1000.0));
+	}
+
+	int fallen = 0;
+	for (const RID &body : scene.bodies) {
+		const Transform3D transform = server->body_get_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM);
+		if (transform.origin.y < -1.0) {
+			fallen++;
+		}
+	}
+	CHECK_MESSAGE(fallen == 0, "Boxes should rest on the ground instead of falling through.");
+}
+
+} // namespace TestGodotStep3D
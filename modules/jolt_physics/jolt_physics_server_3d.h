@@ -446,6 +446,8 @@ public:
 	JoltShape3D *get_shape(RID p_rid) const { return shape_owner.get_or_null(p_rid); }
 	JoltJoint3D *get_joint(RID p_rid) const { return joint_owner.get_or_null(p_rid); }
 
+	JoltJobSystem *get_job_system() const { return job_system; }
+
 #ifdef DEBUG_ENABLED
 	void dump_debug_snapshots(const String &p_dir);
 
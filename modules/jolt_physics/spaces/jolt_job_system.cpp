@@ -30,6 +30,8 @@
 
 #include "jolt_job_system.h"
 
+#include "../jolt_project_settings.h"
+
 #include "core/debugger/engine_debugger.h"
 #include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
@@ -37,27 +39,6 @@
 
 #include <Jolt/Physics/PhysicsSettings.h>
 
-void JoltJobSystem::Job::_execute(void *p_user_data) {
-	Job *job = static_cast<Job *>(p_user_data);
-
-#ifdef DEBUG_ENABLED
-	const uint64_t time_start = Time::get_singleton()->get_ticks_usec();
-#endif
-
-	job->Execute();
-
-#ifdef DEBUG_ENABLED
-	const uint64_t time_end = Time::get_singleton()->get_ticks_usec();
-	const uint64_t time_elapsed = time_end - time_start;
-
-	timings_lock.lock();
-	timings_by_job[job->name] += time_elapsed;
-	timings_lock.unlock();
-#endif
-
-	job->Release();
-}
-
 JoltJobSystem::Job::Job(const char *p_name, JPH::ColorArg p_color, JPH::JobSystem *p_job_system, const JPH::JobSystem::JobFunction &p_job_function, JPH::uint32 p_dependency_count) :
 		JPH::JobSystem::Job(p_name, p_color, p_job_system, p_job_function, p_dependency_count)
 #ifdef DEBUG_ENABLED
@@ -67,12 +48,6 @@ JoltJobSystem::Job::Job(const char *p_name, JPH::ColorArg p_color, JPH::JobSyste
 {
 }
 
-JoltJobSystem::Job::~Job() {
-	if (task_id != -1) {
-		WorkerThreadPool::get_singleton()->wait_for_task_completion(task_id);
-	}
-}
-
 void JoltJobSystem::Job::push_completed(Job *p_job) {
 	Job *prev_head = nullptr;
 
@@ -95,18 +70,8 @@ JoltJobSystem::Job *JoltJobSystem::Job::pop_completed() {
 	return prev_head;
 }
 
-void JoltJobSystem::Job::queue() {
-	AddRef();
-
-	// Ideally we would use Jolt's actual job name here, but I'd rather not incur the overhead of a memory allocation or
-	// thread-safe lookup every time we create/queue a task. So instead we use the same cached description for all of them.
-	static const String task_name("Jolt Physics");
-
-	task_id = WorkerThreadPool::get_singleton()->add_native_task(&_execute, this, true, task_name);
-}
-
 int JoltJobSystem::GetMaxConcurrency() const {
-	return thread_count;
+	return max_concurrency;
 }
 
 JPH::JobHandle JoltJobSystem::CreateJob(const char *p_name, JPH::ColorArg p_color, const JPH::JobSystem::JobFunction &p_job_function, JPH::uint32 p_dependency_count) {
@@ -138,19 +103,167 @@ JPH::JobHandle JoltJobSystem::CreateJob(const char *p_name, JPH::ColorArg p_colo
 }
 
 void JoltJobSystem::QueueJob(JPH::JobSystem::Job *p_job) {
-	static_cast<Job *>(p_job)->queue();
+	QueueJobs(&p_job, 1);
 }
 
 void JoltJobSystem::QueueJobs(JPH::JobSystem::Job **p_jobs, JPH::uint p_job_count) {
+	if (p_job_count == 0) {
+		return;
+	}
+
+	// Dependent jobs that become ready together are pushed under a single lock.
+	ready_lock.lock();
+
 	for (JPH::uint i = 0; i < p_job_count; ++i) {
-		QueueJob(p_jobs[i]);
+		// The reference is released by whichever runner executes the job.
+		p_jobs[i]->AddRef();
+
+		ready_jobs[(ready_head + ready_count) % ready_jobs.size()] = static_cast<Job *>(p_jobs[i]);
+		ready_count++;
 	}
+
+	ready_lock.unlock();
+
+	_wake_runners((int)p_job_count);
 }
 
 void JoltJobSystem::FreeJob(JPH::JobSystem::Job *p_job) {
 	Job::push_completed(static_cast<Job *>(p_job));
 }
 
+JoltJobSystem::Job *JoltJobSystem::_pop_ready_job() {
+	Job *job = nullptr;
+
+	ready_lock.lock();
+
+	if (ready_count > 0) {
+		job = ready_jobs[ready_head];
+		ready_head = (ready_head + 1) % ready_jobs.size();
+		ready_count--;
+	}
+
+	ready_lock.unlock();
+
+	return job;
+}
+
+bool JoltJobSystem::_has_ready_jobs() {
+	ready_lock.lock();
+	const bool has_ready_jobs = ready_count > 0;
+	ready_lock.unlock();
+
+	return has_ready_jobs;
+}
+
+bool JoltJobSystem::_try_acquire_runner() {
+	int active = active_runners.load();
+
+	do {
+		if (active >= max_concurrency) {
+			return false;
+		}
+	} while (!active_runners.compare_exchange_weak(active, active + 1));
+
+	return true;
+}
+
+void JoltJobSystem::_wake_runners(int p_job_count) {
+	// Ideally we would use Jolt's actual job name here, but I'd rather not incur the overhead of a memory allocation or
+	// thread-safe lookup every time we create/queue a task. So instead we use the same cached description for all of them.
+	static const String task_name("Jolt Physics");
+
+	for (int i = 0; i < p_job_count; ++i) {
+		if (!_try_acquire_runner()) {
+			// Every runner is busy and will pick up the remaining jobs.
+			return;
+		}
+
+		const int64_t task_id = WorkerThreadPool::get_singleton()->add_native_task(&_run, this, true, task_name);
+
+		runner_tasks_lock.lock();
+		runner_tasks.push_back(task_id);
+		runner_tasks_lock.unlock();
+	}
+}
+
+void JoltJobSystem::_run(void *p_user_data) {
+	static_cast<JoltJobSystem *>(p_user_data)->_run_jobs();
+}
+
+void JoltJobSystem::_run_jobs() {
+#ifdef DEBUG_ENABLED
+	LocalVector<const char *> timing_names;
+	LocalVector<uint64_t> timing_values;
+	uint64_t timed_jobs = 0;
+#endif
+
+	while (true) {
+		while (Job *job = _pop_ready_job()) {
+#ifdef DEBUG_ENABLED
+			const uint64_t time_start = Time::get_singleton()->get_ticks_usec();
+#endif
+
+			// This is a no-op if the job was already executed by a thread waiting on a barrier.
+			job->Execute();
+
+#ifdef DEBUG_ENABLED
+			const uint64_t time_elapsed = Time::get_singleton()->get_ticks_usec() - time_start;
+
+			// There are only a handful of distinct job names, so a linear search beats hashing here.
+			int64_t timing_index = timing_names.find(job->get_name());
+			if (timing_index == -1) {
+				timing_index = timing_names.size();
+				timing_names.push_back(job->get_name());
+				timing_values.push_back(0);
+			}
+			timing_values[timing_index] += time_elapsed;
+			timed_jobs++;
+#endif
+
+			job->Release();
+		}
+
+		active_runners.fetch_sub(1);
+
+		// A job may have been queued after we found the queue empty but before we stopped counting as
+		// active, in which case no runner was woken for it, so we check again before leaving.
+		if (!_has_ready_jobs() || !_try_acquire_runner()) {
+			break;
+		}
+	}
+
+#ifdef DEBUG_ENABLED
+	if (!timing_names.is_empty()) {
+		timings_lock.lock();
+		for (uint32_t i = 0; i < timing_names.size(); ++i) {
+			timings_by_job[timing_names[i]] += timing_values[i];
+		}
+		timed_job_count += timed_jobs;
+		timings_lock.unlock();
+	}
+#endif
+}
+
+void JoltJobSystem::_wait_for_runners() {
+	// Runners are only spawned while a job is being queued, so once the step has finished nothing can add to this list.
+	runner_tasks_lock.lock();
+	LocalVector<int64_t> tasks = std::move(runner_tasks);
+	runner_tasks_lock.unlock();
+
+	for (const int64_t task_id : tasks) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(task_id);
+	}
+
+	tasks.clear();
+
+	runner_tasks_lock.lock();
+	if (runner_tasks.is_empty()) {
+		// Hand back the allocation so the next step doesn't have to grow the list again.
+		runner_tasks = std::move(tasks);
+	}
+	runner_tasks_lock.unlock();
+}
+
 void JoltJobSystem::_reclaim_jobs() {
 	while (Job *job = Job::pop_completed()) {
 		jobs.DestructObject(job);
@@ -161,13 +274,26 @@ JoltJobSystem::JoltJobSystem() :
 		JPH::JobSystemWithBarrier(JPH::cMaxPhysicsBarriers),
 		thread_count(MAX(1, WorkerThreadPool::get_singleton()->get_thread_count())) {
 	jobs.Init(JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsJobs);
+	ready_jobs.resize(JPH::cMaxPhysicsJobs);
+	runner_tasks.reserve(thread_count);
+	max_concurrency = thread_count;
+}
+
+JoltJobSystem::~JoltJobSystem() {
+	_wait_for_runners();
+	_reclaim_jobs();
+}
+
+void JoltJobSystem::set_max_concurrency(int p_max_concurrency) {
+	max_concurrency = CLAMP(p_max_concurrency, 1, thread_count);
 }
 
 void JoltJobSystem::pre_step() {
-	// Nothing to do.
+	set_max_concurrency(JoltProjectSettings::max_threads > 0 ? JoltProjectSettings::max_threads : thread_count);
 }
 
 void JoltJobSystem::post_step() {
+	_wait_for_runners();
 	_reclaim_jobs();
 }
 
@@ -194,6 +320,8 @@ void JoltJobSystem::flush_timings() {
 	for (KeyValue<const void *, uint64_t> &E : timings_by_job) {
 		E.value = 0;
 	}
+
+	timed_job_count = 0;
 }
 
 #endif
@@ -32,6 +32,7 @@
 
 #include "core/os/spin_lock.h"
 #include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
 
 #include <Jolt/Jolt.h>
 
@@ -48,22 +49,19 @@ class JoltJobSystem final : public JPH::JobSystemWithBarrier {
 		const char *name = nullptr;
 #endif
 
-		int64_t task_id = -1;
-
 		std::atomic<Job *> completed_next = nullptr;
 
-		static void _execute(void *p_user_data);
-
 	public:
 		Job(const char *p_name, JPH::ColorArg p_color, JPH::JobSystem *p_job_system, const JPH::JobSystem::JobFunction &p_job_function, JPH::uint32 p_dependency_count);
 		Job(const Job &p_other) = delete;
 		Job(Job &&p_other) = delete;
-		~Job();
 
 		static void push_completed(Job *p_job);
 		static Job *pop_completed();
 
-		void queue();
+#ifdef DEBUG_ENABLED
+		const char *get_name() const { return name; }
+#endif
 
 		Job &operator=(const Job &p_other) = delete;
 		Job &operator=(Job &&p_other) = delete;
@@ -74,13 +72,30 @@ class JoltJobSystem final : public JPH::JobSystemWithBarrier {
 	// are always literals and as such will point to the same address every time.
 	inline static HashMap<const void *, uint64_t> timings_by_job;
 
-	// TODO: Check whether the usage of SpinLock is justified or if this should be a mutex instead.
+	// Number of jobs run since the timings were last flushed.
+	inline static uint64_t timed_job_count = 0;
+
+	// Runners accumulate their timings locally and only take this lock once when they finish.
 	inline static SpinLock timings_lock;
 #endif
 
 	JPH::FixedSizeFreeList<Job> jobs;
 
+	// Jobs that are ready to execute. Rather than spawning a task per job, a bounded number of runner
+	// tasks drain this queue, so jobs that become ready while a runner is active don't pay for a
+	// task allocation and a thread wake-up. It can never hold more than `cMaxPhysicsJobs` entries.
+	LocalVector<Job *> ready_jobs;
+	uint32_t ready_head = 0;
+	uint32_t ready_count = 0;
+	SpinLock ready_lock;
+
+	std::atomic<int> active_runners = 0;
+
+	LocalVector<int64_t> runner_tasks;
+	SpinLock runner_tasks_lock;
+
 	int thread_count = 0;
+	int max_concurrency = 0;
 
 	virtual int GetMaxConcurrency() const override;
 
@@ -89,15 +104,33 @@ class JoltJobSystem final : public JPH::JobSystemWithBarrier {
 	virtual void QueueJobs(JPH::JobSystem::Job **p_jobs, JPH::uint p_job_count) override;
 	virtual void FreeJob(JPH::JobSystem::Job *p_job) override;
 
+	Job *_pop_ready_job();
+	bool _has_ready_jobs();
+	bool _try_acquire_runner();
+	void _wake_runners(int p_job_count);
+
+	static void _run(void *p_user_data);
+	void _run_jobs();
+
+	void _wait_for_runners();
 	void _reclaim_jobs();
 
 public:
 	JoltJobSystem();
+	~JoltJobSystem();
+
+	int get_thread_count() const { return thread_count; }
+
+	// Limits how many threads a step is split across. Must not be called while a space is being stepped.
+	void set_max_concurrency(int p_max_concurrency);
+	int get_max_concurrency() const { return max_concurrency; }
 
 	void pre_step();
 	void post_step();
 
 #ifdef DEBUG_ENABLED
+	uint64_t get_timed_job_count() const { return timed_job_count; }
+
 	void flush_timings();
 #endif
 };
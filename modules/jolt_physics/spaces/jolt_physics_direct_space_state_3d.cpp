@@ -44,6 +44,8 @@
 #include "jolt_query_filter_3d.h"
 #include "jolt_space_3d.h"
 
+#include "core/object/worker_thread_pool.h"
+
 #include <Jolt/Geometry/GJKClosestPoint.h>
 #include <Jolt/Physics/Body/Body.h>
 #include <Jolt/Physics/Body/BodyFilter.h>
@@ -468,8 +470,14 @@ bool JoltPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_paramet
 
 	const JoltQueryFilter3D query_filter(*this, p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas, p_parameters.exclude, p_parameters.pick_ray);
 
-	const JPH::RVec3 from = to_jolt_r(p_parameters.from);
-	const JPH::RVec3 to = to_jolt_r(p_parameters.to);
+	return _intersect_ray_impl(p_parameters, p_parameters.from, p_parameters.to, query_filter, r_result);
+}
+
+bool JoltPhysicsDirectSpaceState3D::_intersect_ray_impl(const RayParameters &p_parameters, const Vector3 &p_from, const Vector3 &p_to, const JoltQueryFilter3D &p_query_filter, RayResult &r_result) {
+	const JoltQueryFilter3D &query_filter = p_query_filter;
+
+	const JPH::RVec3 from = to_jolt_r(p_from);
+	const JPH::RVec3 to = to_jolt_r(p_to);
 	const JPH::Vec3 vector = JPH::Vec3(to - from);
 	const JPH::RRayCast ray(from, vector);
 
@@ -524,6 +532,41 @@ bool JoltPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_paramet
 	return true;
 }
 
+void JoltPhysicsDirectSpaceState3D::_intersect_ray_batch_task(uint32_t p_index, RayBatch *p_batch) {
+	p_batch->hits[p_index] = _intersect_ray_impl(*p_batch->parameters, p_batch->from[p_index], p_batch->to[p_index], *p_batch->query_filter, p_batch->results[p_index]);
+}
+
+void JoltPhysicsDirectSpaceState3D::intersect_ray_batch(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results, bool *r_hits) {
+	for (int i = 0; i < p_count; i++) {
+		r_hits[i] = false;
+	}
+
+	ERR_FAIL_COND_MSG(space->is_stepping(), "intersect_ray_batch must not be called while the physics space is being stepped.");
+
+	// Flushing once up front leaves the narrow-phase read-only for the rest of the batch.
+	space->flush_pending_objects();
+
+	const JoltQueryFilter3D query_filter(*this, p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas, p_parameters.exclude, p_parameters.pick_ray);
+
+	if (p_count < BATCH_PARALLEL_THRESHOLD) {
+		for (int i = 0; i < p_count; i++) {
+			r_hits[i] = _intersect_ray_impl(p_parameters, p_from[i], p_to[i], query_filter, r_results[i]);
+		}
+		return;
+	}
+
+	RayBatch batch;
+	batch.parameters = &p_parameters;
+	batch.query_filter = &query_filter;
+	batch.from = p_from;
+	batch.to = p_to;
+	batch.results = r_results;
+	batch.hits = r_hits;
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &JoltPhysicsDirectSpaceState3D::_intersect_ray_batch_task, &batch, p_count, -1, true, SNAME("JoltIntersectRayBatch"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
 int JoltPhysicsDirectSpaceState3D::intersect_point(const PointParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
 	ERR_FAIL_COND_V_MSG(space->is_stepping(), false, "intersect_point must not be called while the physics space is being stepped.");
 
@@ -631,21 +674,71 @@ bool JoltPhysicsDirectSpaceState3D::cast_motion(const ShapeParameters &p_paramet
 	const JPH::ShapeRefC jolt_shape = shape->try_build();
 	ERR_FAIL_NULL_V(jolt_shape, false);
 
-	Transform3D transform = p_parameters.transform;
+	const JoltQueryFilter3D query_filter(*this, p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas, p_parameters.exclude);
+
+	return _cast_motion_query(*jolt_shape, p_parameters, p_parameters.transform, p_parameters.motion, query_filter, r_closest_safe, r_closest_unsafe);
+}
+
+bool JoltPhysicsDirectSpaceState3D::_cast_motion_query(const JPH::Shape &p_jolt_shape, const ShapeParameters &p_parameters, const Transform3D &p_transform, const Vector3 &p_motion, const JoltQueryFilter3D &p_query_filter, real_t &r_closest_safe, real_t &r_closest_unsafe) const {
+	Transform3D transform = p_transform;
 	JOLT_ENSURE_SCALE_NOT_ZERO(transform, "cast_motion (maybe from ShapeCast3D?) was passed an invalid transform.");
 
 	Vector3 scale;
 	JoltMath::decompose(transform, scale);
-	JOLT_ENSURE_SCALE_VALID(jolt_shape, scale, "cast_motion (maybe from ShapeCast3D?) was passed an invalid transform.");
+	JOLT_ENSURE_SCALE_VALID(&p_jolt_shape, scale, "cast_motion (maybe from ShapeCast3D?) was passed an invalid transform.");
 
-	const Vector3 com_scaled = to_godot(jolt_shape->GetCenterOfMass());
+	const Vector3 com_scaled = to_godot(p_jolt_shape.GetCenterOfMass());
 	Transform3D transform_com = transform.translated_local(com_scaled);
 
 	JPH::CollideShapeSettings settings;
 	settings.mMaxSeparationDistance = (float)p_parameters.margin;
 
+	_cast_motion_impl(p_jolt_shape, transform_com, scale, p_motion, JoltProjectSettings::use_enhanced_internal_edge_removal_for_queries, true, settings, p_query_filter, p_query_filter, p_query_filter, JPH::ShapeFilter(), r_closest_safe, r_closest_unsafe);
+
+	return true;
+}
+
+void JoltPhysicsDirectSpaceState3D::_cast_motion_batch_task(uint32_t p_index, MotionBatch *p_batch) {
+	_cast_motion_query(*p_batch->jolt_shape, *p_batch->parameters, p_batch->transforms[p_index], p_batch->motions[p_index], *p_batch->query_filter, p_batch->closest_safe[p_index], p_batch->closest_unsafe[p_index]);
+}
+
+bool JoltPhysicsDirectSpaceState3D::cast_motion_batch(const ShapeParameters &p_parameters, const Transform3D *p_transforms, const Vector3 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe) {
+	for (int i = 0; i < p_count; i++) {
+		r_closest_safe[i] = 1.0;
+		r_closest_unsafe[i] = 1.0;
+	}
+
+	ERR_FAIL_COND_V_MSG(space->is_stepping(), false, "cast_motion_batch must not be called while the physics space is being stepped.");
+
+	space->flush_pending_objects();
+
+	JoltShape3D *shape = JoltPhysicsServer3D::get_singleton()->get_shape(p_parameters.shape_rid);
+	ERR_FAIL_NULL_V(shape, false);
+
+	// Building the shape is not thread-safe, so it's done once here and shared by every cast.
+	const JPH::ShapeRefC jolt_shape = shape->try_build();
+	ERR_FAIL_NULL_V(jolt_shape, false);
+
 	const JoltQueryFilter3D query_filter(*this, p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas, p_parameters.exclude);
-	_cast_motion_impl(*jolt_shape, transform_com, scale, p_parameters.motion, JoltProjectSettings::use_enhanced_internal_edge_removal_for_queries, true, settings, query_filter, query_filter, query_filter, JPH::ShapeFilter(), r_closest_safe, r_closest_unsafe);
+
+	if (p_count < BATCH_PARALLEL_THRESHOLD) {
+		for (int i = 0; i < p_count; i++) {
+			_cast_motion_query(*jolt_shape, p_parameters, p_transforms[i], p_motions[i], query_filter, r_closest_safe[i], r_closest_unsafe[i]);
+		}
+		return true;
+	}
+
+	MotionBatch batch;
+	batch.jolt_shape = jolt_shape.GetPtr();
+	batch.parameters = &p_parameters;
+	batch.query_filter = &query_filter;
+	batch.transforms = p_transforms;
+	batch.motions = p_motions;
+	batch.closest_safe = r_closest_safe;
+	batch.closest_unsafe = r_closest_unsafe;
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &JoltPhysicsDirectSpaceState3D::_cast_motion_batch_task, &batch, p_count, -1, true, SNAME("JoltCastMotionBatch"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 
 	return true;
 }
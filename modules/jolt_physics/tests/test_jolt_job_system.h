@@ -0,0 +1,209 @@
+/**************************************************************************/
+/*  test_jolt_job_system.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../jolt_physics_server_3d.h"
+#include "../jolt_project_settings.h"
+#include "../spaces/jolt_job_system.h"
+
+#include "core/config/project_settings.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/os/os.h"
+#include "tests/physics_test_utils.h"
+#include "tests/test_macros.h"
+
+namespace TestJoltJobSystem {
+
+typedef TestUtils::PhysicsServer3DScope<JoltPhysicsServer3D> JoltPhysicsServer3DScope;
+
+struct BoxPileScene {
+	RID space;
+	LocalVector<RID> bodies;
+};
+
+// Everything created is freed with the server scope, or with `free_tracked()`.
+static BoxPileScene create_box_pile_scene(JoltPhysicsServer3DScope &p_server, int p_body_count) {
+	BoxPileScene scene;
+
+	scene.space = p_server.track(p_server->space_create());
+	p_server->space_set_active(scene.space, true);
+
+	RID ground_shape = p_server.track(p_server->box_shape_create());
+	p_server->shape_set_data(ground_shape, Vector3(100, 1, 100));
+	RID ground = p_server.track(p_server->body_create());
+	p_server->body_set_mode(ground, PhysicsServer3D::BODY_MODE_STATIC);
+	p_server->body_set_space(ground, scene.space);
+	p_server->body_add_shape(ground, ground_shape, Transform3D(), false);
+	p_server->body_set_state(ground, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(0, -1, 0)));
+
+	RID box_shape = p_server.track(p_server->box_shape_create());
+	p_server->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+
+	// Layers of boxes dropped on top of each other, so there are plenty of contacts and islands to split.
+	const int side = 16;
+	for (int i = 0; i < p_body_count; i++) {
+		const int x = i % side;
+		const int z = (i / side) % side;
+		const int y = i / (side * side);
+
+		RID body = p_server.track(p_server->body_create());
+		p_server->body_set_mode(body, PhysicsServer3D::BODY_MODE_RIGID);
+		p_server->body_set_space(body, scene.space);
+		p_server->body_add_shape(body, box_shape, Transform3D(), false);
+		p_server->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3((x - side / 2) * 1.1, 0.75 + y * 1.25, (z - side / 2) * 1.1)));
+		scene.bodies.push_back(body);
+	}
+
+	return scene;
+}
+
+static LocalVector<int> get_thread_counts() {
+	const int thread_count = MAX(1, WorkerThreadPool::get_singleton()->get_thread_count());
+
+	LocalVector<int> thread_counts;
+	for (int threads = 1; threads < thread_count; threads *= 2) {
+		thread_counts.push_back(threads);
+	}
+	thread_counts.push_back(thread_count);
+	return thread_counts;
+}
+
+static void set_max_threads(int p_threads) {
+	ProjectSettings::get_singleton()->set_setting("physics/jolt_physics_3d/simulation/max_threads", p_threads);
+	JoltProjectSettings::read_settings();
+}
+
+static int count_fallen(JoltPhysicsServer3DScope &p_server, const BoxPileScene &p_scene) {
+	int fallen = 0;
+	for (const RID &body : p_scene.bodies) {
+		const Transform3D transform = p_server->body_get_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM);
+		if (transform.origin.y < -1.0) {
+			fallen++;
+		}
+	}
+	return fallen;
+}
+
+TEST_CASE("[SceneTree][JoltPhysics] Stepping gives the same results on any thread count") {
+	JoltPhysicsServer3DScope server("Jolt Physics");
+	REQUIRE(server.get());
+
+	const Variant previous_max_threads = GLOBAL_GET("physics/jolt_physics_3d/simulation/max_threads");
+
+	const int body_count = 512;
+	const int step_count = 30;
+
+	LocalVector<Transform3D> expected;
+
+	for (const int threads : get_thread_counts()) {
+		set_max_threads(threads);
+
+		// Each run gets a new space, so bodies get the same IDs and are solved in the same order.
+		BoxPileScene scene = create_box_pile_scene(server, body_count);
+		REQUIRE(server->get_space(scene.space));
+
+		// Flushing the queries also resets the profiler timings.
+		server->flush_queries();
+
+		for (int i = 0; i < step_count; i++) {
+			server->step(1.0 / 60.0);
+		}
+
+		CHECK(server->get_job_system()->get_max_concurrency() == threads);
+#ifdef DEBUG_ENABLED
+		CHECK_MESSAGE(server->get_job_system()->get_timed_job_count() > 0, vformat("Jobs should be reported to the profiler when stepping on %d threads.", threads));
+#endif
+		server->flush_queries();
+
+		CHECK_MESSAGE(count_fallen(server, scene) == 0, vformat("Boxes should rest on the ground when stepping on %d threads.", threads));
+
+		LocalVector<Transform3D> transforms;
+		for (const RID &body : scene.bodies) {
+			transforms.push_back(server->body_get_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM));
+		}
+
+		if (expected.is_empty()) {
+			expected = transforms;
+		} else {
+			int mismatches = 0;
+			for (uint32_t i = 0; i < transforms.size(); i++) {
+				if (transforms[i] != expected[i]) {
+					mismatches++;
+				}
+			}
+			CHECK_MESSAGE(mismatches == 0, vformat("Stepping on %d threads should give the same transforms as on one thread.", threads));
+		}
+
+		server.free_tracked();
+	}
+
+	ProjectSettings::get_singleton()->set_setting("physics/jolt_physics_3d/simulation/max_threads", previous_max_threads);
+	JoltProjectSettings::read_settings();
+}
+
+TEST_CASE("[SceneTree][JoltPhysics][Benchmark] Step scaling with thread count" * doctest::skip()) {
+	JoltPhysicsServer3DScope server("Jolt Physics");
+	REQUIRE(server.get());
+
+	const Variant previous_max_threads = GLOBAL_GET("physics/jolt_physics_3d/simulation/max_threads");
+
+	const int body_count = 2048;
+	const int step_count = 60;
+
+	uint64_t single_thread_time = 0;
+
+	for (const int threads : get_thread_counts()) {
+		set_max_threads(threads);
+
+		BoxPileScene scene = create_box_pile_scene(server, body_count);
+
+		const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < step_count; i++) {
+			server->step(1.0 / 60.0);
+		}
+		const uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+
+		if (single_thread_time == 0) {
+			single_thread_time = MAX(elapsed, (uint64_t)1);
+		}
+
+		MESSAGE(vformat("%d threads: %d bodies stepped %d times in %.2f ms (%.2fx).", threads, body_count, step_count, elapsed / 1000.0, (double)single_thread_time / MAX(elapsed, (uint64_t)1)));
+
+		CHECK_MESSAGE(count_fallen(server, scene) == 0, vformat("Boxes should rest on the ground when stepping on %d threads.", threads));
+
+		server.free_tracked();
+	}
+
+	ProjectSettings::get_singleton()->set_setting("physics/jolt_physics_3d/simulation/max_threads", previous_max_threads);
+	JoltProjectSettings::read_settings();
+}
+
+} // namespace TestJoltJobSystem
@@ -106,7 +106,6 @@ Node *MultiplayerSynchronizer::get_root_node() {
 
 void MultiplayerSynchronizer::reset() {
 	net_id = 0;
-	last_sync_usec = 0;
 	last_inbound_sync = 0;
 	last_watch_usec = 0;
 	sync_started = false;
@@ -121,17 +120,9 @@ void MultiplayerSynchronizer::set_net_id(uint32_t p_net_id) {
 	net_id = p_net_id;
 }
 
-bool MultiplayerSynchronizer::update_outbound_sync_time(uint64_t p_usec) {
-	if (last_sync_usec == p_usec) {
-		// last_sync_usec has been updated in this frame.
-		return true;
-	}
-	if (p_usec < last_sync_usec + sync_interval_usec) {
-		// Too soon, should skip this synchronization frame.
-		return false;
-	}
-	last_sync_usec = p_usec;
-	return true;
+bool MultiplayerSynchronizer::is_outbound_sync_due(uint64_t p_usec, uint64_t p_last_sync_usec) const {
+	// Too soon, should skip this synchronization frame.
+	return p_usec >= p_last_sync_usec + sync_interval_usec;
 }
 
 bool MultiplayerSynchronizer::update_inbound_sync_time(uint16_t p_network_time) {
@@ -253,6 +244,12 @@ void MultiplayerSynchronizer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_delta_interval", "milliseconds"), &MultiplayerSynchronizer::set_delta_interval);
 	ClassDB::bind_method(D_METHOD("get_delta_interval"), &MultiplayerSynchronizer::get_delta_interval);
 
+	ClassDB::bind_method(D_METHOD("set_replication_priority", "priority"), &MultiplayerSynchronizer::set_replication_priority);
+	ClassDB::bind_method(D_METHOD("get_replication_priority"), &MultiplayerSynchronizer::get_replication_priority);
+
+	ClassDB::bind_method(D_METHOD("set_spatial_interest_enabled", "enabled"), &MultiplayerSynchronizer::set_spatial_interest_enabled);
+	ClassDB::bind_method(D_METHOD("is_spatial_interest_enabled"), &MultiplayerSynchronizer::is_spatial_interest_enabled);
+
 	ClassDB::bind_method(D_METHOD("set_replication_config", "config"), &MultiplayerSynchronizer::set_replication_config);
 	ClassDB::bind_method(D_METHOD("get_replication_config"), &MultiplayerSynchronizer::get_replication_config);
 
@@ -271,6 +268,8 @@ void MultiplayerSynchronizer::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::NODE_PATH, "root_path"), "set_root_path", "get_root_path");
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "replication_interval", PROPERTY_HINT_RANGE, "0,5,0.001,suffix:s"), "set_replication_interval", "get_replication_interval");
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "delta_interval", PROPERTY_HINT_RANGE, "0,5,0.001,suffix:s"), "set_delta_interval", "get_delta_interval");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "replication_priority", PROPERTY_HINT_RANGE, "0,10,0.01,or_greater"), "set_replication_priority", "get_replication_priority");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "spatial_interest"), "set_spatial_interest_enabled", "is_spatial_interest_enabled");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "replication_config", PROPERTY_HINT_RESOURCE_TYPE, SceneReplicationConfig::get_class_static(), PROPERTY_USAGE_NO_EDITOR | PROPERTY_USAGE_EDITOR_INSTANTIATE_OBJECT), "set_replication_config", "get_replication_config");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "visibility_update_mode", PROPERTY_HINT_ENUM, "Idle,Physics,None"), "set_visibility_update_mode", "get_visibility_update_mode");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "public_visibility"), "set_visibility_public", "is_visibility_public");
@@ -328,6 +327,23 @@ double MultiplayerSynchronizer::get_delta_interval() const {
 	return double(delta_interval_usec) / 1000.0 / 1000.0;
 }
 
+void MultiplayerSynchronizer::set_replication_priority(real_t p_priority) {
+	ERR_FAIL_COND_MSG(p_priority < 0, "Priority must be greater or equal to 0.");
+	replication_priority = p_priority;
+}
+
+real_t MultiplayerSynchronizer::get_replication_priority() const {
+	return replication_priority;
+}
+
+void MultiplayerSynchronizer::set_spatial_interest_enabled(bool p_enabled) {
+	spatial_interest = p_enabled;
+}
+
+bool MultiplayerSynchronizer::is_spatial_interest_enabled() const {
+	return spatial_interest;
+}
+
 void MultiplayerSynchronizer::set_replication_config(Ref<SceneReplicationConfig> p_config) {
 	replication_config = p_config;
 }
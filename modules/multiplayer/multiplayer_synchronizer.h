@@ -55,6 +55,8 @@ private:
 	NodePath root_path = NodePath(".."); // Start with parent, like with AnimationPlayer.
 	uint64_t sync_interval_usec = 0;
 	uint64_t delta_interval_usec = 0;
+	real_t replication_priority = 1.0;
+	bool spatial_interest = true;
 	VisibilityUpdateMode visibility_update_mode = VISIBILITY_PROCESS_IDLE;
 	HashSet<Callable> visibility_filters;
 	HashSet<int> peer_visibility;
@@ -62,7 +64,6 @@ private:
 	uint64_t last_watch_usec = 0;
 
 	ObjectID root_node_cache;
-	uint64_t last_sync_usec = 0;
 	uint16_t last_inbound_sync = 0;
 	uint32_t net_id = 0;
 	bool sync_started = false;
@@ -87,7 +88,8 @@ public:
 	uint32_t get_net_id() const;
 	void set_net_id(uint32_t p_net_id);
 
-	bool update_outbound_sync_time(uint64_t p_usec);
+	// The last send time is tracked per peer by the replication interface.
+	bool is_outbound_sync_due(uint64_t p_usec, uint64_t p_last_sync_usec) const;
 	bool update_inbound_sync_time(uint16_t p_network_time);
 
 	PackedStringArray get_configuration_warnings() const override;
@@ -98,6 +100,12 @@ public:
 	void set_delta_interval(double p_interval);
 	double get_delta_interval() const;
 
+	void set_replication_priority(real_t p_priority);
+	real_t get_replication_priority() const;
+
+	void set_spatial_interest_enabled(bool p_enabled);
+	bool is_spatial_interest_enabled() const;
+
 	void set_replication_config(Ref<SceneReplicationConfig> p_config);
 	Ref<SceneReplicationConfig> get_replication_config();
 
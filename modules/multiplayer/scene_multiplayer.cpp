@@ -635,6 +635,30 @@ int SceneMultiplayer::get_max_delta_packet_size() const {
 	return replicator->get_max_delta_packet_size();
 }
 
+void SceneMultiplayer::set_interest_radius(real_t p_radius) {
+	replicator->set_interest_radius(p_radius);
+}
+
+real_t SceneMultiplayer::get_interest_radius() const {
+	return replicator->get_interest_radius();
+}
+
+void SceneMultiplayer::set_sync_bandwidth_limit(int p_bytes_per_second) {
+	replicator->set_sync_bandwidth_limit(p_bytes_per_second);
+}
+
+int SceneMultiplayer::get_sync_bandwidth_limit() const {
+	return replicator->get_sync_bandwidth_limit();
+}
+
+void SceneMultiplayer::set_peer_interest_origin(int p_peer, Node *p_node) {
+	replicator->set_peer_interest_origin(p_peer, p_node);
+}
+
+Node *SceneMultiplayer::get_peer_interest_origin(int p_peer) const {
+	return replicator->get_peer_interest_origin(p_peer);
+}
+
 void SceneMultiplayer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_root_path", "path"), &SceneMultiplayer::set_root_path);
 	ClassDB::bind_method(D_METHOD("get_root_path"), &SceneMultiplayer::get_root_path);
@@ -663,6 +687,12 @@ void SceneMultiplayer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_max_sync_packet_size", "size"), &SceneMultiplayer::set_max_sync_packet_size);
 	ClassDB::bind_method(D_METHOD("get_max_delta_packet_size"), &SceneMultiplayer::get_max_delta_packet_size);
 	ClassDB::bind_method(D_METHOD("set_max_delta_packet_size", "size"), &SceneMultiplayer::set_max_delta_packet_size);
+	ClassDB::bind_method(D_METHOD("get_interest_radius"), &SceneMultiplayer::get_interest_radius);
+	ClassDB::bind_method(D_METHOD("set_interest_radius", "radius"), &SceneMultiplayer::set_interest_radius);
+	ClassDB::bind_method(D_METHOD("get_sync_bandwidth_limit"), &SceneMultiplayer::get_sync_bandwidth_limit);
+	ClassDB::bind_method(D_METHOD("set_sync_bandwidth_limit", "bytes_per_second"), &SceneMultiplayer::set_sync_bandwidth_limit);
+	ClassDB::bind_method(D_METHOD("set_peer_interest_origin", "peer", "node"), &SceneMultiplayer::set_peer_interest_origin);
+	ClassDB::bind_method(D_METHOD("get_peer_interest_origin", "peer"), &SceneMultiplayer::get_peer_interest_origin);
 
 	ADD_PROPERTY(PropertyInfo(Variant::NODE_PATH, "root_path"), "set_root_path", "get_root_path");
 	ADD_PROPERTY(PropertyInfo(Variant::CALLABLE, "auth_callback"), "set_auth_callback", "get_auth_callback");
@@ -672,6 +702,8 @@ void SceneMultiplayer::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "server_relay"), "set_server_relay_enabled", "is_server_relay_enabled");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "max_sync_packet_size"), "set_max_sync_packet_size", "get_max_sync_packet_size");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "max_delta_packet_size"), "set_max_delta_packet_size", "get_max_delta_packet_size");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "interest_radius", PROPERTY_HINT_RANGE, "0,1000,0.01,or_greater"), "set_interest_radius", "get_interest_radius");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "sync_bandwidth_limit", PROPERTY_HINT_RANGE, "0,1000000,1,or_greater,suffix:B/s"), "set_sync_bandwidth_limit", "get_sync_bandwidth_limit");
 
 	ADD_PROPERTY_DEFAULT("refuse_new_connections", false);
 
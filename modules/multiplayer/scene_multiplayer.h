@@ -200,6 +200,15 @@ public:
 	void set_max_delta_packet_size(int p_size);
 	int get_max_delta_packet_size() const;
 
+	void set_interest_radius(real_t p_radius);
+	real_t get_interest_radius() const;
+
+	void set_sync_bandwidth_limit(int p_bytes_per_second);
+	int get_sync_bandwidth_limit() const;
+
+	void set_peer_interest_origin(int p_peer, Node *p_node);
+	Node *get_peer_interest_origin(int p_peer) const;
+
 	SceneMultiplayer();
 	~SceneMultiplayer();
 };
@@ -30,6 +30,8 @@
 
 #include "scene_replication_config.h"
 
+#include "scene_replication_encoder.h"
+
 #include "core/object/class_db.h"
 
 bool SceneReplicationConfig::_set(const StringName &p_name, const Variant &p_value) {
@@ -55,6 +57,31 @@ bool SceneReplicationConfig::_set(const StringName &p_name, const Variant &p_val
 			property_set_replication_mode(prop.name, mode);
 			return true;
 		}
+		if (what == "type") {
+			ERR_FAIL_COND_V(p_value.get_type() != Variant::INT, false);
+			int type = p_value;
+			ERR_FAIL_INDEX_V(type, Variant::VARIANT_MAX, false);
+			property_set_type(prop.name, (Variant::Type)type);
+			return true;
+		} else if (what == "quantization_bits") {
+			ERR_FAIL_COND_V(p_value.get_type() != Variant::INT, false);
+			// The range is validated by the encoder, as it is loaded after the bits.
+			int bits = p_value;
+			ERR_FAIL_COND_V(bits < 0 || bits > 32, false);
+			properties.get(idx).schema.quantization_bits = bits;
+			dirty = true;
+			return true;
+		} else if (what == "quantization_min") {
+			ERR_FAIL_COND_V(p_value.get_type() != Variant::FLOAT && p_value.get_type() != Variant::INT, false);
+			properties.get(idx).schema.quantization_min = p_value;
+			dirty = true;
+			return true;
+		} else if (what == "quantization_max") {
+			ERR_FAIL_COND_V(p_value.get_type() != Variant::FLOAT && p_value.get_type() != Variant::INT, false);
+			properties.get(idx).schema.quantization_max = p_value;
+			dirty = true;
+			return true;
+		}
 		ERR_FAIL_COND_V(p_value.get_type() != Variant::BOOL, false);
 		if (what == "spawn") {
 			property_set_spawn(prop.name, p_value);
@@ -89,16 +116,38 @@ bool SceneReplicationConfig::_get(const StringName &p_name, Variant &r_ret) cons
 		} else if (what == "replication_mode") {
 			r_ret = prop.mode;
 			return true;
+		} else if (what == "type") {
+			r_ret = prop.schema.type;
+			return true;
+		} else if (what == "quantization_bits") {
+			r_ret = prop.schema.quantization_bits;
+			return true;
+		} else if (what == "quantization_min") {
+			r_ret = prop.schema.quantization_min;
+			return true;
+		} else if (what == "quantization_max") {
+			r_ret = prop.schema.quantization_max;
+			return true;
 		}
 	}
 	return false;
 }
 
 void SceneReplicationConfig::_get_property_list(List<PropertyInfo> *p_list) const {
-	for (int i = 0; i < properties.size(); i++) {
+	int i = 0;
+	for (List<ReplicationProperty>::ConstIterator itr = properties.begin(); itr != properties.end(); ++itr, ++i) {
 		p_list->push_back(PropertyInfo(Variant::STRING, "properties/" + itos(i) + "/path", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NO_EDITOR | PROPERTY_USAGE_INTERNAL));
 		p_list->push_back(PropertyInfo(Variant::STRING, "properties/" + itos(i) + "/spawn", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NO_EDITOR | PROPERTY_USAGE_INTERNAL));
 		p_list->push_back(PropertyInfo(Variant::INT, "properties/" + itos(i) + "/replication_mode", PROPERTY_HINT_ENUM, "Never,Always,On Change", PROPERTY_USAGE_NO_EDITOR | PROPERTY_USAGE_INTERNAL));
+		// Only stored when used, so configs without a schema are saved as before.
+		if (itr->schema.type != Variant::NIL) {
+			p_list->push_back(PropertyInfo(Variant::INT, "properties/" + itos(i) + "/type", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NO_EDITOR | PROPERTY_USAGE_INTERNAL));
+		}
+		if (itr->schema.quantization_bits > 0) {
+			p_list->push_back(PropertyInfo(Variant::INT, "properties/" + itos(i) + "/quantization_bits", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NO_EDITOR | PROPERTY_USAGE_INTERNAL));
+			p_list->push_back(PropertyInfo(Variant::FLOAT, "properties/" + itos(i) + "/quantization_min", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NO_EDITOR | PROPERTY_USAGE_INTERNAL));
+			p_list->push_back(PropertyInfo(Variant::FLOAT, "properties/" + itos(i) + "/quantization_max", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NO_EDITOR | PROPERTY_USAGE_INTERNAL));
+		}
 	}
 }
 
@@ -108,6 +157,9 @@ void SceneReplicationConfig::reset_state() {
 	sync_props.clear();
 	spawn_props.clear();
 	watch_props.clear();
+	sync_schema.clear();
+	watch_schema.clear();
+	schema = false;
 }
 
 TypedArray<NodePath> SceneReplicationConfig::get_properties() const {
@@ -224,6 +276,55 @@ void SceneReplicationConfig::property_set_replication_mode(const NodePath &p_pat
 	dirty = true;
 }
 
+Variant::Type SceneReplicationConfig::property_get_type(const NodePath &p_path) {
+	List<ReplicationProperty>::Element *E = properties.find(p_path);
+	ERR_FAIL_COND_V(!E, Variant::NIL);
+	return E->get().schema.type;
+}
+
+void SceneReplicationConfig::property_set_type(const NodePath &p_path, Variant::Type p_type) {
+	ERR_FAIL_INDEX(p_type, Variant::VARIANT_MAX);
+	List<ReplicationProperty>::Element *E = properties.find(p_path);
+	ERR_FAIL_COND(!E);
+	if (E->get().schema.type == p_type) {
+		return;
+	}
+	E->get().schema.type = p_type;
+	dirty = true;
+}
+
+int SceneReplicationConfig::property_get_quantization_bits(const NodePath &p_path) {
+	List<ReplicationProperty>::Element *E = properties.find(p_path);
+	ERR_FAIL_COND_V(!E, 0);
+	return E->get().schema.quantization_bits;
+}
+
+double SceneReplicationConfig::property_get_quantization_min(const NodePath &p_path) {
+	List<ReplicationProperty>::Element *E = properties.find(p_path);
+	ERR_FAIL_COND_V(!E, 0.0);
+	return E->get().schema.quantization_min;
+}
+
+double SceneReplicationConfig::property_get_quantization_max(const NodePath &p_path) {
+	List<ReplicationProperty>::Element *E = properties.find(p_path);
+	ERR_FAIL_COND_V(!E, 0.0);
+	return E->get().schema.quantization_max;
+}
+
+void SceneReplicationConfig::property_set_quantization(const NodePath &p_path, int p_bits, double p_min, double p_max) {
+	ERR_FAIL_COND_MSG(p_bits < 0 || p_bits > 32, "Quantization bits must be between 0 (disabled) and 32.");
+	ERR_FAIL_COND_MSG(p_bits > 0 && p_min >= p_max, "Quantization minimum must be less than the maximum.");
+	List<ReplicationProperty>::Element *E = properties.find(p_path);
+	ERR_FAIL_COND(!E);
+	PropertySchema prop_schema = E->get().schema;
+	prop_schema.quantization_bits = p_bits;
+	prop_schema.quantization_min = p_min;
+	prop_schema.quantization_max = p_max;
+	ERR_FAIL_COND_MSG(!SceneReplicationEncoder::is_schema_valid(prop_schema), vformat("The quantization range of an integer property can be at most %d wide with %d bits.", (int64_t(1) << p_bits) - 1, p_bits));
+	E->get().schema = prop_schema;
+	dirty = true;
+}
+
 void SceneReplicationConfig::_update() {
 	if (!dirty) {
 		return;
@@ -232,16 +333,22 @@ void SceneReplicationConfig::_update() {
 	sync_props.clear();
 	spawn_props.clear();
 	watch_props.clear();
+	sync_schema.clear();
+	watch_schema.clear();
+	schema = false;
 	for (const ReplicationProperty &prop : properties) {
 		if (prop.spawn) {
 			spawn_props.push_back(prop.name);
 		}
+		schema = schema || prop.schema.type != Variant::NIL;
 		switch (prop.mode) {
 			case REPLICATION_MODE_ALWAYS:
 				sync_props.push_back(prop.name);
+				sync_schema.push_back(prop.schema);
 				break;
 			case REPLICATION_MODE_ON_CHANGE:
 				watch_props.push_back(prop.name);
+				watch_schema.push_back(prop.schema);
 				break;
 			default:
 				break;
@@ -270,6 +377,27 @@ const List<NodePath> &SceneReplicationConfig::get_watch_properties() {
 	return watch_props;
 }
 
+bool SceneReplicationConfig::has_schema() {
+	if (dirty) {
+		_update();
+	}
+	return schema;
+}
+
+const LocalVector<SceneReplicationConfig::PropertySchema> &SceneReplicationConfig::get_sync_schema() {
+	if (dirty) {
+		_update();
+	}
+	return sync_schema;
+}
+
+const LocalVector<SceneReplicationConfig::PropertySchema> &SceneReplicationConfig::get_watch_schema() {
+	if (dirty) {
+		_update();
+	}
+	return watch_schema;
+}
+
 void SceneReplicationConfig::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_properties"), &SceneReplicationConfig::get_properties);
 	ClassDB::bind_method(D_METHOD("add_property", "path", "index"), &SceneReplicationConfig::add_property, DEFVAL(-1));
@@ -280,6 +408,12 @@ void SceneReplicationConfig::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("property_set_spawn", "path", "enabled"), &SceneReplicationConfig::property_set_spawn);
 	ClassDB::bind_method(D_METHOD("property_get_replication_mode", "path"), &SceneReplicationConfig::property_get_replication_mode);
 	ClassDB::bind_method(D_METHOD("property_set_replication_mode", "path", "mode"), &SceneReplicationConfig::property_set_replication_mode);
+	ClassDB::bind_method(D_METHOD("property_get_type", "path"), &SceneReplicationConfig::property_get_type);
+	ClassDB::bind_method(D_METHOD("property_set_type", "path", "type"), &SceneReplicationConfig::property_set_type);
+	ClassDB::bind_method(D_METHOD("property_get_quantization_bits", "path"), &SceneReplicationConfig::property_get_quantization_bits);
+	ClassDB::bind_method(D_METHOD("property_get_quantization_min", "path"), &SceneReplicationConfig::property_get_quantization_min);
+	ClassDB::bind_method(D_METHOD("property_get_quantization_max", "path"), &SceneReplicationConfig::property_get_quantization_max);
+	ClassDB::bind_method(D_METHOD("property_set_quantization", "path", "bits", "min", "max"), &SceneReplicationConfig::property_set_quantization);
 
 	BIND_ENUM_CONSTANT(REPLICATION_MODE_NEVER);
 	BIND_ENUM_CONSTANT(REPLICATION_MODE_ALWAYS);
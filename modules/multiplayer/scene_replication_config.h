@@ -31,6 +31,7 @@
 #pragma once
 
 #include "core/io/resource.h"
+#include "core/templates/local_vector.h"
 #include "core/variant/typed_array.h"
 
 class SceneReplicationConfig : public Resource {
@@ -45,11 +46,20 @@ public:
 		REPLICATION_MODE_ON_CHANGE,
 	};
 
+	// How a property is packed by the schema encoder, see SceneReplicationEncoder.
+	struct PropertySchema {
+		Variant::Type type = Variant::NIL; // NIL means the value is sent as a full Variant.
+		int quantization_bits = 0; // Zero means full precision.
+		double quantization_min = 0.0;
+		double quantization_max = 0.0;
+	};
+
 private:
 	struct ReplicationProperty {
 		NodePath name;
 		bool spawn = true;
 		ReplicationMode mode = REPLICATION_MODE_ALWAYS;
+		PropertySchema schema;
 
 		bool operator==(const ReplicationProperty &p_to) {
 			return name == p_to.name;
@@ -66,6 +76,9 @@ private:
 	List<NodePath> spawn_props;
 	List<NodePath> sync_props;
 	List<NodePath> watch_props;
+	LocalVector<PropertySchema> sync_schema;
+	LocalVector<PropertySchema> watch_schema;
+	bool schema = false;
 	bool dirty = false;
 
 	void _update();
@@ -99,10 +112,23 @@ public:
 	ReplicationMode property_get_replication_mode(const NodePath &p_path);
 	void property_set_replication_mode(const NodePath &p_path, ReplicationMode p_mode);
 
+	Variant::Type property_get_type(const NodePath &p_path);
+	void property_set_type(const NodePath &p_path, Variant::Type p_type);
+
+	int property_get_quantization_bits(const NodePath &p_path);
+	double property_get_quantization_min(const NodePath &p_path);
+	double property_get_quantization_max(const NodePath &p_path);
+	void property_set_quantization(const NodePath &p_path, int p_bits, double p_min, double p_max);
+
 	const List<NodePath> &get_spawn_properties();
 	const List<NodePath> &get_sync_properties();
 	const List<NodePath> &get_watch_properties();
 
+	// True if any property declares a type, in which case synchronizers using this config are sent with the schema encoder.
+	bool has_schema();
+	const LocalVector<PropertySchema> &get_sync_schema();
+	const LocalVector<PropertySchema> &get_watch_schema();
+
 	SceneReplicationConfig() {}
 };
 
@@ -0,0 +1,490 @@
+/**************************************************************************/
+/*  scene_replication_encoder.cpp                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "scene_replication_encoder.h"
+
+#include "core/io/marshalls.h"
+
+void SceneReplicationEncoder::BitWriter::write(uint32_t p_value, int p_bits) {
+	DEV_ASSERT(p_bits > 0 && p_bits <= 32);
+	bits |= (uint64_t(p_value) & ((uint64_t(1) << p_bits) - 1)) << bit_count;
+	bit_count += p_bits;
+	while (bit_count >= 8) {
+		buffer.push_back(bits & 0xFF);
+		bits >>= 8;
+		bit_count -= 8;
+	}
+}
+
+void SceneReplicationEncoder::BitWriter::write_u64(uint64_t p_value) {
+	write(p_value & 0xFFFFFFFF, 32);
+	write(p_value >> 32, 32);
+}
+
+void SceneReplicationEncoder::BitWriter::flush() {
+	if (bit_count > 0) {
+		buffer.push_back(bits & 0xFF);
+		bits = 0;
+		bit_count = 0;
+	}
+}
+
+uint32_t SceneReplicationEncoder::BitReader::read(int p_bits) {
+	DEV_ASSERT(p_bits > 0 && p_bits <= 32);
+	while (bit_count < p_bits) {
+		if (pos >= size) {
+			overflow = true;
+			return 0;
+		}
+		bits |= uint64_t(buffer[pos++]) << bit_count;
+		bit_count += 8;
+	}
+	uint32_t value = bits & ((uint64_t(1) << p_bits) - 1);
+	bits >>= p_bits;
+	bit_count -= p_bits;
+	return value;
+}
+
+uint64_t SceneReplicationEncoder::BitReader::read_u64() {
+	uint64_t low = read(32);
+	return low | (uint64_t(read(32)) << 32);
+}
+
+static void _write_varuint(SceneReplicationEncoder::BitWriter &p_writer, uint64_t p_value) {
+	do {
+		uint32_t group = p_value & 0x7F;
+		p_value >>= 7;
+		p_writer.write(group | (p_value ? 0x80 : 0), 8);
+	} while (p_value);
+}
+
+static uint64_t _read_varuint(SceneReplicationEncoder::BitReader &p_reader) {
+	uint64_t value = 0;
+	for (int shift = 0; shift < 64; shift += 7) {
+		uint32_t group = p_reader.read(8);
+		value |= uint64_t(group & 0x7F) << shift;
+		if (!(group & 0x80) || p_reader.has_overflowed()) {
+			break;
+		}
+	}
+	return value;
+}
+
+static uint64_t _get_quantization_steps(const SceneReplicationEncoder::PropertySchema &p_schema) {
+	return (uint64_t(1) << p_schema.quantization_bits) - 1;
+}
+
+static uint32_t _quantize_real(const SceneReplicationEncoder::PropertySchema &p_schema, double p_value) {
+	if (Math::is_nan(p_value)) {
+		p_value = p_schema.quantization_min;
+	}
+	double weight = (CLAMP(p_value, p_schema.quantization_min, p_schema.quantization_max) - p_schema.quantization_min) / (p_schema.quantization_max - p_schema.quantization_min);
+	return uint32_t(Math::round(weight * _get_quantization_steps(p_schema)));
+}
+
+static double _dequantize_real(const SceneReplicationEncoder::PropertySchema &p_schema, uint32_t p_value) {
+	return p_schema.quantization_min + (p_schema.quantization_max - p_schema.quantization_min) * (double(p_value) / _get_quantization_steps(p_schema));
+}
+
+static uint32_t _quantize_int(const SceneReplicationEncoder::PropertySchema &p_schema, int64_t p_value) {
+	int64_t min = int64_t(p_schema.quantization_min);
+	int64_t max = int64_t(p_schema.quantization_max);
+	return MIN(uint64_t(CLAMP(p_value, min, max) - min), _get_quantization_steps(p_schema));
+}
+
+// Reals are written quantized when the schema asks for it. Otherwise as 32 bits if that is lossless, or 64 bits.
+static void _write_real(SceneReplicationEncoder::BitWriter &p_writer, const SceneReplicationEncoder::PropertySchema &p_schema, double p_value) {
+	if (p_schema.quantization_bits > 0) {
+		p_writer.write(_quantize_real(p_schema, p_value), p_schema.quantization_bits);
+		return;
+	}
+	float single = p_value;
+	if (double(single) == p_value || Math::is_nan(p_value)) {
+		uint32_t single_bits;
+		memcpy(&single_bits, &single, sizeof(single_bits));
+		p_writer.write(1, 1);
+		p_writer.write(single_bits, 32);
+	} else {
+		uint64_t double_bits;
+		memcpy(&double_bits, &p_value, sizeof(double_bits));
+		p_writer.write(0, 1);
+		p_writer.write_u64(double_bits);
+	}
+}
+
+static double _read_real(SceneReplicationEncoder::BitReader &p_reader, const SceneReplicationEncoder::PropertySchema &p_schema) {
+	if (p_schema.quantization_bits > 0) {
+		return _dequantize_real(p_schema, p_reader.read(p_schema.quantization_bits));
+	}
+	if (p_reader.read(1)) {
+		uint32_t single_bits = p_reader.read(32);
+		float single;
+		memcpy(&single, &single_bits, sizeof(single));
+		return single;
+	}
+	uint64_t double_bits = p_reader.read_u64();
+	double value;
+	memcpy(&value, &double_bits, sizeof(value));
+	return value;
+}
+
+// Integers are written in the quantization range when set, otherwise as zigzag variable length integers.
+static void _write_int(SceneReplicationEncoder::BitWriter &p_writer, const SceneReplicationEncoder::PropertySchema &p_schema, int64_t p_value) {
+	if (p_schema.quantization_bits > 0) {
+		p_writer.write(_quantize_int(p_schema, p_value), p_schema.quantization_bits);
+		return;
+	}
+	_write_varuint(p_writer, (uint64_t(p_value) << 1) ^ uint64_t(p_value >> 63));
+}
+
+static int64_t _read_int(SceneReplicationEncoder::BitReader &p_reader, const SceneReplicationEncoder::PropertySchema &p_schema) {
+	if (p_schema.quantization_bits > 0) {
+		return int64_t(p_schema.quantization_min) + p_reader.read(p_schema.quantization_bits);
+	}
+	uint64_t zigzag = _read_varuint(p_reader);
+	return int64_t(zigzag >> 1) ^ -int64_t(zigzag & 1);
+}
+
+static int _get_real_components(const Variant &p_value, double *r_components) {
+	switch (p_value.get_type()) {
+		case Variant::FLOAT: {
+			r_components[0] = p_value;
+			return 1;
+		}
+		case Variant::VECTOR2: {
+			Vector2 v = p_value;
+			r_components[0] = v.x;
+			r_components[1] = v.y;
+			return 2;
+		}
+		case Variant::VECTOR3: {
+			Vector3 v = p_value;
+			r_components[0] = v.x;
+			r_components[1] = v.y;
+			r_components[2] = v.z;
+			return 3;
+		}
+		case Variant::VECTOR4: {
+			Vector4 v = p_value;
+			r_components[0] = v.x;
+			r_components[1] = v.y;
+			r_components[2] = v.z;
+			r_components[3] = v.w;
+			return 4;
+		}
+		case Variant::QUATERNION: {
+			Quaternion q = p_value;
+			r_components[0] = q.x;
+			r_components[1] = q.y;
+			r_components[2] = q.z;
+			r_components[3] = q.w;
+			return 4;
+		}
+		case Variant::COLOR: {
+			Color c = p_value;
+			r_components[0] = c.r;
+			r_components[1] = c.g;
+			r_components[2] = c.b;
+			r_components[3] = c.a;
+			return 4;
+		}
+		default:
+			return 0;
+	}
+}
+
+static int _get_real_component_count(Variant::Type p_type) {
+	switch (p_type) {
+		case Variant::FLOAT:
+			return 1;
+		case Variant::VECTOR2:
+			return 2;
+		case Variant::VECTOR3:
+			return 3;
+		case Variant::VECTOR4:
+		case Variant::QUATERNION:
+		case Variant::COLOR:
+			return 4;
+		default:
+			return 0;
+	}
+}
+
+static Variant _make_real_value(Variant::Type p_type, const double *p_components) {
+	switch (p_type) {
+		case Variant::FLOAT:
+			return p_components[0];
+		case Variant::VECTOR2:
+			return Vector2(p_components[0], p_components[1]);
+		case Variant::VECTOR3:
+			return Vector3(p_components[0], p_components[1], p_components[2]);
+		case Variant::VECTOR4:
+			return Vector4(p_components[0], p_components[1], p_components[2], p_components[3]);
+		case Variant::QUATERNION:
+			return Quaternion(p_components[0], p_components[1], p_components[2], p_components[3]);
+		case Variant::COLOR:
+			return Color(p_components[0], p_components[1], p_components[2], p_components[3]);
+		default:
+			return Variant();
+	}
+}
+
+static int _get_int_components(const Variant &p_value, int64_t *r_components) {
+	switch (p_value.get_type()) {
+		case Variant::INT: {
+			r_components[0] = p_value;
+			return 1;
+		}
+		case Variant::VECTOR2I: {
+			Vector2i v = p_value;
+			r_components[0] = v.x;
+			r_components[1] = v.y;
+			return 2;
+		}
+		case Variant::VECTOR3I: {
+			Vector3i v = p_value;
+			r_components[0] = v.x;
+			r_components[1] = v.y;
+			r_components[2] = v.z;
+			return 3;
+		}
+		case Variant::VECTOR4I: {
+			Vector4i v = p_value;
+			r_components[0] = v.x;
+			r_components[1] = v.y;
+			r_components[2] = v.z;
+			r_components[3] = v.w;
+			return 4;
+		}
+		default:
+			return 0;
+	}
+}
+
+static int _get_int_component_count(Variant::Type p_type) {
+	switch (p_type) {
+		case Variant::INT:
+			return 1;
+		case Variant::VECTOR2I:
+			return 2;
+		case Variant::VECTOR3I:
+			return 3;
+		case Variant::VECTOR4I:
+			return 4;
+		default:
+			return 0;
+	}
+}
+
+static Variant _make_int_value(Variant::Type p_type, const int64_t *p_components) {
+	switch (p_type) {
+		case Variant::INT:
+			return p_components[0];
+		case Variant::VECTOR2I:
+			return Vector2i(p_components[0], p_components[1]);
+		case Variant::VECTOR3I:
+			return Vector3i(p_components[0], p_components[1], p_components[2]);
+		case Variant::VECTOR4I:
+			return Vector4i(p_components[0], p_components[1], p_components[2], p_components[3]);
+		default:
+			return Variant();
+	}
+}
+
+static Error _write_variant(SceneReplicationEncoder::BitWriter &p_writer, const Variant &p_value) {
+	int len = 0;
+	Error err = encode_variant(p_value, nullptr, len, false);
+	ERR_FAIL_COND_V(err != OK, err);
+	LocalVector<uint8_t> data;
+	data.resize(len);
+	encode_variant(p_value, data.ptr(), len, false);
+	_write_varuint(p_writer, len);
+	for (uint8_t byte : data) {
+		p_writer.write(byte, 8);
+	}
+	return OK;
+}
+
+static Error _read_variant(SceneReplicationEncoder::BitReader &p_reader, int p_size, Variant &r_value) {
+	uint64_t len = _read_varuint(p_reader);
+	ERR_FAIL_COND_V(p_reader.has_overflowed() || len > uint64_t(p_size), ERR_INVALID_DATA);
+	LocalVector<uint8_t> data;
+	data.resize(len);
+	for (uint8_t &byte : data) {
+		byte = p_reader.read(8);
+	}
+	ERR_FAIL_COND_V(p_reader.has_overflowed(), ERR_INVALID_DATA);
+	int consumed = 0;
+	Error err = decode_variant(r_value, data.ptr(), len, &consumed, false);
+	ERR_FAIL_COND_V(err != OK, err);
+	ERR_FAIL_COND_V(uint64_t(consumed) != len, ERR_INVALID_DATA);
+	return OK;
+}
+
+static Error _write_value(SceneReplicationEncoder::BitWriter &p_writer, const SceneReplicationEncoder::PropertySchema &p_schema, const Variant &p_value) {
+	if (p_schema.type == Variant::NIL) {
+		return _write_variant(p_writer, p_value);
+	}
+	ERR_FAIL_COND_V_MSG(p_value.get_type() != p_schema.type, ERR_INVALID_DATA, vformat("Replicated value of type %s does not match the schema type %s.", Variant::get_type_name(p_value.get_type()), Variant::get_type_name(p_schema.type)));
+
+	if (p_schema.type == Variant::BOOL) {
+		p_writer.write(p_value.operator bool(), 1);
+		return OK;
+	}
+	double reals[4];
+	int count = _get_real_components(p_value, reals);
+	for (int i = 0; i < count; i++) {
+		_write_real(p_writer, p_schema, reals[i]);
+	}
+	if (count) {
+		return OK;
+	}
+	int64_t ints[4];
+	count = _get_int_components(p_value, ints);
+	for (int i = 0; i < count; i++) {
+		_write_int(p_writer, p_schema, ints[i]);
+	}
+	if (count) {
+		return OK;
+	}
+	// No packed representation for this type.
+	return _write_variant(p_writer, p_value);
+}
+
+static Error _read_value(SceneReplicationEncoder::BitReader &p_reader, int p_size, const SceneReplicationEncoder::PropertySchema &p_schema, Variant &r_value) {
+	if (p_schema.type == Variant::BOOL) {
+		r_value = p_reader.read(1) != 0;
+		return OK;
+	}
+	int count = _get_real_component_count(p_schema.type);
+	if (count) {
+		double reals[4];
+		for (int i = 0; i < count; i++) {
+			reals[i] = _read_real(p_reader, p_schema);
+		}
+		r_value = _make_real_value(p_schema.type, reals);
+		return OK;
+	}
+	count = _get_int_component_count(p_schema.type);
+	if (count) {
+		int64_t ints[4];
+		for (int i = 0; i < count; i++) {
+			ints[i] = _read_int(p_reader, p_schema);
+		}
+		r_value = _make_int_value(p_schema.type, ints);
+		return OK;
+	}
+	Error err = _read_variant(p_reader, p_size, r_value);
+	ERR_FAIL_COND_V(err != OK, err);
+	ERR_FAIL_COND_V(p_schema.type != Variant::NIL && r_value.get_type() != p_schema.type, ERR_INVALID_DATA);
+	return OK;
+}
+
+bool SceneReplicationEncoder::is_schema_valid(const PropertySchema &p_schema) {
+	if (p_schema.quantization_bits == 0) {
+		return true;
+	}
+	if (p_schema.quantization_bits > 32 || !(p_schema.quantization_min < p_schema.quantization_max)) {
+		return false;
+	}
+	// Integers are sent as offsets from the minimum, so every value in the range needs its own step.
+	return _get_int_component_count(p_schema.type) == 0 || std::trunc(p_schema.quantization_max) - std::trunc(p_schema.quantization_min) <= double(_get_quantization_steps(p_schema));
+}
+
+Error SceneReplicationEncoder::encode_state(const LocalVector<PropertySchema> &p_schema, const Vector<Variant> &p_values, const Vector<Variant> *p_baseline, LocalVector<uint8_t> &r_buffer) {
+	ERR_FAIL_COND_V(p_values.size() != int(p_schema.size()), ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V(p_baseline && p_baseline->size() != p_values.size(), ERR_INVALID_PARAMETER);
+	BitWriter writer(r_buffer);
+	for (uint32_t i = 0; i < p_schema.size(); i++) {
+		ERR_FAIL_COND_V_MSG(!is_schema_valid(p_schema[i]), ERR_INVALID_PARAMETER, "Invalid quantization range in replication schema.");
+		if (p_baseline) {
+			bool changed = !is_value_equal(p_schema[i], p_values[i], (*p_baseline)[i]);
+			writer.write(changed, 1);
+			if (!changed) {
+				continue;
+			}
+		}
+		Error err = _write_value(writer, p_schema[i], p_values[i]);
+		ERR_FAIL_COND_V(err != OK, err);
+	}
+	writer.flush();
+	return OK;
+}
+
+Error SceneReplicationEncoder::decode_state(const LocalVector<PropertySchema> &p_schema, const uint8_t *p_buffer, int p_size, const Vector<Variant> *p_baseline, Vector<Variant> &r_values) {
+	ERR_FAIL_COND_V(p_baseline && p_baseline->size() != int(p_schema.size()), ERR_INVALID_PARAMETER);
+	r_values.resize(p_schema.size());
+	BitReader reader(p_buffer, p_size);
+	for (uint32_t i = 0; i < p_schema.size(); i++) {
+		ERR_FAIL_COND_V_MSG(!is_schema_valid(p_schema[i]), ERR_INVALID_PARAMETER, "Invalid quantization range in replication schema.");
+		if (p_baseline && !reader.read(1)) {
+			r_values.write[i] = (*p_baseline)[i];
+			continue;
+		}
+		Error err = _read_value(reader, p_size, p_schema[i], r_values.write[i]);
+		ERR_FAIL_COND_V(err != OK, err);
+	}
+	ERR_FAIL_COND_V(reader.has_overflowed() || reader.get_bytes_read() != p_size, ERR_INVALID_DATA);
+	return OK;
+}
+
+bool SceneReplicationEncoder::is_value_equal(const PropertySchema &p_schema, const Variant &p_a, const Variant &p_b) {
+	if (p_a.get_type() != p_b.get_type()) {
+		return false;
+	}
+	if (p_schema.quantization_bits == 0 || p_schema.type == Variant::NIL || p_a.get_type() != p_schema.type) {
+		return p_a == p_b;
+	}
+	double reals_a[4];
+	double reals_b[4];
+	int count = _get_real_components(p_a, reals_a);
+	_get_real_components(p_b, reals_b);
+	for (int i = 0; i < count; i++) {
+		if (_quantize_real(p_schema, reals_a[i]) != _quantize_real(p_schema, reals_b[i])) {
+			return false;
+		}
+	}
+	if (count) {
+		return true;
+	}
+	int64_t ints_a[4];
+	int64_t ints_b[4];
+	count = _get_int_components(p_a, ints_a);
+	_get_int_components(p_b, ints_b);
+	for (int i = 0; i < count; i++) {
+		if (_quantize_int(p_schema, ints_a[i]) != _quantize_int(p_schema, ints_b[i])) {
+			return false;
+		}
+	}
+	if (count) {
+		return true;
+	}
+	return p_a == p_b;
+}
@@ -0,0 +1,87 @@
+/**************************************************************************/
+/*  scene_replication_encoder.h                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "scene_replication_config.h"
+
+#include "core/templates/local_vector.h"
+
+// Packs replicated state using the property schema of a SceneReplicationConfig.
+// Values are written with fixed types and optional quantization into a bit stream, instead of as self-describing Variants.
+// When a baseline state known to the receiver is given, unchanged properties only take a single bit.
+class SceneReplicationEncoder {
+public:
+	typedef SceneReplicationConfig::PropertySchema PropertySchema;
+
+	class BitWriter {
+		LocalVector<uint8_t> &buffer;
+		uint64_t bits = 0;
+		int bit_count = 0;
+
+	public:
+		void write(uint32_t p_value, int p_bits);
+		void write_u64(uint64_t p_value);
+		// Pads the last byte with zeros.
+		void flush();
+
+		BitWriter(LocalVector<uint8_t> &r_buffer) :
+				buffer(r_buffer) {}
+	};
+
+	class BitReader {
+		const uint8_t *buffer = nullptr;
+		int size = 0;
+		int pos = 0;
+		uint64_t bits = 0;
+		int bit_count = 0;
+		bool overflow = false;
+
+	public:
+		uint32_t read(int p_bits);
+		uint64_t read_u64();
+		bool has_overflowed() const { return overflow; }
+		int get_bytes_read() const { return pos; }
+
+		BitReader(const uint8_t *p_buffer, int p_size) {
+			buffer = p_buffer;
+			size = p_size;
+		}
+	};
+
+	// False if the quantization range is empty, or too wide for an integer type to be sent without saturating.
+	static bool is_schema_valid(const PropertySchema &p_schema);
+
+	static Error encode_state(const LocalVector<PropertySchema> &p_schema, const Vector<Variant> &p_values, const Vector<Variant> *p_baseline, LocalVector<uint8_t> &r_buffer);
+	static Error decode_state(const LocalVector<PropertySchema> &p_schema, const uint8_t *p_buffer, int p_size, const Vector<Variant> *p_baseline, Vector<Variant> &r_values);
+
+	// True if both values are sent the same way, i.e. they only differ below the quantization step.
+	static bool is_value_equal(const PropertySchema &p_schema, const Variant &p_a, const Variant &p_b);
+};
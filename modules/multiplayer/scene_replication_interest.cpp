@@ -0,0 +1,91 @@
+/**************************************************************************/
+/*  scene_replication_interest.cpp                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "scene_replication_interest.h"
+
+void SceneReplicationInterestGrid::_insert_in_cell(const ObjectID &p_id, const Vector3i &p_cell) {
+	LocalVector<ObjectID> *cell = cells.getptr(p_cell);
+	if (!cell) {
+		cell = &cells.insert(p_cell, LocalVector<ObjectID>())->value;
+	}
+	cell->push_back(p_id);
+}
+
+void SceneReplicationInterestGrid::_remove_from_cell(const ObjectID &p_id, const Vector3i &p_cell) {
+	LocalVector<ObjectID> *cell = cells.getptr(p_cell);
+	ERR_FAIL_NULL(cell); // Bug.
+	ERR_FAIL_COND(!cell->erase_unordered(p_id)); // Bug.
+	if (cell->is_empty()) {
+		cells.erase(p_cell);
+	}
+}
+
+void SceneReplicationInterestGrid::set_cell_size(real_t p_size) {
+	ERR_FAIL_COND_MSG(p_size <= 0, "The interest grid cell size must be greater than zero.");
+	if (cell_size == p_size) {
+		return;
+	}
+	cell_size = p_size;
+	cells.clear();
+	for (KeyValue<ObjectID, Entry> &E : entries) {
+		E.value.cell = _get_cell(E.value.position);
+		_insert_in_cell(E.key, E.value.cell);
+	}
+}
+
+void SceneReplicationInterestGrid::update(const ObjectID &p_id, const Vector3 &p_position) {
+	const Vector3i cell = _get_cell(p_position);
+	Entry *entry = entries.getptr(p_id);
+	if (!entry) {
+		entries.insert(p_id, Entry{ p_position, cell });
+		_insert_in_cell(p_id, cell);
+		return;
+	}
+	entry->position = p_position;
+	if (entry->cell != cell) {
+		_remove_from_cell(p_id, entry->cell);
+		entry->cell = cell;
+		_insert_in_cell(p_id, cell);
+	}
+}
+
+void SceneReplicationInterestGrid::remove(const ObjectID &p_id) {
+	const Entry *entry = entries.getptr(p_id);
+	if (!entry) {
+		return;
+	}
+	_remove_from_cell(p_id, entry->cell);
+	entries.erase(p_id);
+}
+
+void SceneReplicationInterestGrid::clear() {
+	entries.clear();
+	cells.clear();
+}
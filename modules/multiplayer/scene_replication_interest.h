@@ -0,0 +1,108 @@
+/**************************************************************************/
+/*  scene_replication_interest.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/math/vector3.h"
+#include "core/math/vector3i.h"
+#include "core/object/object_id.h"
+#include "core/templates/a_hash_map.h"
+#include "core/templates/local_vector.h"
+
+// Uniform grid used to find the synchronizers close to the interest origin of each peer.
+// Entries only move between cells when their position crosses a cell boundary.
+class SceneReplicationInterestGrid {
+	struct Entry {
+		Vector3 position;
+		Vector3i cell;
+	};
+
+	real_t cell_size = 1.0;
+	AHashMap<ObjectID, Entry> entries;
+	AHashMap<Vector3i, LocalVector<ObjectID>> cells;
+
+	_FORCE_INLINE_ Vector3i _get_cell(const Vector3 &p_position) const {
+		const Vector3 cell = (p_position / cell_size).floor();
+		return Vector3i(cell.x, cell.y, cell.z);
+	}
+
+	void _insert_in_cell(const ObjectID &p_id, const Vector3i &p_cell);
+	void _remove_from_cell(const ObjectID &p_id, const Vector3i &p_cell);
+
+public:
+	// Sorts all entries into cells again.
+	void set_cell_size(real_t p_size);
+	real_t get_cell_size() const { return cell_size; }
+
+	void update(const ObjectID &p_id, const Vector3 &p_position);
+	void remove(const ObjectID &p_id);
+	bool has(const ObjectID &p_id) const { return entries.has(p_id); }
+	uint32_t size() const { return entries.size(); }
+	void clear();
+
+	// Calls p_callback with the ID and distance of every entry within p_radius of p_position.
+	template <typename F>
+	void query(const Vector3 &p_position, real_t p_radius, F &&p_callback) const {
+		if (entries.is_empty()) {
+			return;
+		}
+		const real_t radius_squared = p_radius * p_radius;
+		const Vector3 range = Vector3(p_radius, p_radius, p_radius);
+		const Vector3i from = _get_cell(p_position - range);
+		const Vector3i to = _get_cell(p_position + range);
+		// A radius much larger than the cells would visit more empty cells than there are entries.
+		const uint64_t cell_count = uint64_t(to.x - from.x + 1) * uint64_t(to.y - from.y + 1) * uint64_t(to.z - from.z + 1);
+		if (cell_count >= cells.size()) {
+			for (const KeyValue<ObjectID, Entry> &E : entries) {
+				const real_t distance_squared = E.value.position.distance_squared_to(p_position);
+				if (distance_squared <= radius_squared) {
+					p_callback(E.key, Math::sqrt(distance_squared));
+				}
+			}
+			return;
+		}
+		for (int x = from.x; x <= to.x; x++) {
+			for (int y = from.y; y <= to.y; y++) {
+				for (int z = from.z; z <= to.z; z++) {
+					const LocalVector<ObjectID> *cell = cells.getptr(Vector3i(x, y, z));
+					if (!cell) {
+						continue;
+					}
+					for (const ObjectID &id : *cell) {
+						const real_t distance_squared = entries.get(id).position.distance_squared_to(p_position);
+						if (distance_squared <= radius_squared) {
+							p_callback(id, Math::sqrt(distance_squared));
+						}
+					}
+				}
+			}
+		}
+	}
+};
@@ -31,13 +31,19 @@
 #include "scene_replication_interface.h"
 
 #include "scene_multiplayer.h"
+#include "scene_replication_encoder.h"
 
 #include "core/debugger/engine_debugger.h"
 #include "core/io/marshalls.h"
 #include "core/object/callable_mp.h"
 #include "core/os/os.h"
+#include "scene/2d/node_2d.h"
 #include "scene/main/node.h"
 
+#ifndef _3D_DISABLED
+#include "scene/3d/node_3d.h"
+#endif // _3D_DISABLED
+
 #define MAKE_ROOM(m_amount) \
 	if (packet_cache.size() < m_amount) \
 		packet_cache.resize(m_amount);
@@ -112,6 +118,9 @@ void SceneReplicationInterface::on_reset() {
 		_free_remotes(E.value);
 	}
 	peers_info.clear();
+	interest_grid.clear();
+	interest_global_nodes.clear();
+	last_process_usec = 0;
 	// Tracked nodes are cleared on deletion, here we only reset the ids so they can be later re-assigned.
 	for (KeyValue<ObjectID, TrackedNode> &E : tracked_nodes) {
 		TrackedNode &tobj = E.value;
@@ -142,15 +151,28 @@ void SceneReplicationInterface::on_network_process() {
 
 	// Process syncs.
 	uint64_t usec = OS::get_singleton()->get_ticks_usec();
+	const uint64_t elapsed_usec = last_process_usec ? usec - last_process_usec : 1000000;
+	last_process_usec = usec;
+	if (interest_radius > 0) {
+		_update_interest();
+	}
+	schema_state_cache.clear();
+	LocalVector<ObjectID> to_sync;
 	for (KeyValue<int, PeerInfo> &E : peers_info) {
-		const HashSet<ObjectID> to_sync(E.value.sync_nodes);
+		if (E.value.schema_ack_pending) {
+			_send_schema_ack(E.key, E.value);
+		}
+		to_sync.clear();
+		_get_sync_candidates(E.value, elapsed_usec, to_sync);
 		if (to_sync.is_empty()) {
 			continue; // Nothing to sync
 		}
 		uint16_t sync_net_time = ++E.value.last_sent_sync;
 		_send_sync(E.key, to_sync, sync_net_time, usec);
+		_send_schema_sync(E.key, to_sync, sync_net_time, usec);
 		_send_delta(E.key, to_sync, usec, E.value.last_watch_usecs);
 	}
+	schema_state_cache.clear();
 }
 
 Error SceneReplicationInterface::on_spawn(Object *p_obj, Variant p_config) {
@@ -279,11 +301,17 @@ Error SceneReplicationInterface::on_replication_stop(Object *p_obj, Variant p_co
 	TrackedNode &tobj = _track(oid);
 	tobj.synchronizers.erase(sid);
 	sync_nodes.erase(sid);
+	interest_grid.remove(sid);
 	for (KeyValue<int, PeerInfo> &E : peers_info) {
 		E.value.sync_nodes.erase(sid);
 		E.value.last_watch_usecs.erase(sid);
+		E.value.schema_baselines.erase(sid);
+		E.value.schema_received.erase(sid);
+		E.value.sync_priorities.erase(sid);
+		E.value.last_sync_usecs.erase(sid);
 		if (sync->get_net_id()) {
 			E.value.recv_sync_ids.erase(sync->get_net_id());
+			E.value.schema_sent_ids.erase(sync->get_net_id());
 		}
 	}
 	return OK;
@@ -360,6 +388,9 @@ Error SceneReplicationInterface::_update_sync_visibility(int p_peer, Multiplayer
 			} else {
 				E.value.sync_nodes.erase(sid);
 				E.value.last_watch_usecs.erase(sid);
+				E.value.schema_baselines.erase(sid);
+				E.value.sync_priorities.erase(sid);
+				E.value.last_sync_usecs.erase(sid);
 			}
 		}
 		return OK;
@@ -373,6 +404,9 @@ Error SceneReplicationInterface::_update_sync_visibility(int p_peer, Multiplayer
 		} else {
 			peers_info[p_peer].sync_nodes.erase(sid);
 			peers_info[p_peer].last_watch_usecs.erase(sid);
+			peers_info[p_peer].schema_baselines.erase(sid);
+			peers_info[p_peer].sync_priorities.erase(sid);
+			peers_info[p_peer].last_sync_usecs.erase(sid);
 		}
 		return OK;
 	}
@@ -454,6 +488,111 @@ Error SceneReplicationInterface::_update_spawn_visibility(int p_peer, const Obje
 	return OK;
 }
 
+bool SceneReplicationInterface::_get_interest_position(const Node *p_node, Vector3 &r_position) {
+	if (!p_node || !p_node->is_inside_tree()) {
+		return false;
+	}
+#ifndef _3D_DISABLED
+	const Node3D *node_3d = Object::cast_to<Node3D>(p_node);
+	if (node_3d) {
+		r_position = node_3d->get_global_position();
+		return true;
+	}
+#endif // _3D_DISABLED
+	const Node2D *node_2d = Object::cast_to<Node2D>(p_node);
+	if (node_2d) {
+		const Vector2 position = node_2d->get_global_position();
+		r_position = Vector3(position.x, position.y, 0);
+		return true;
+	}
+	return false;
+}
+
+void SceneReplicationInterface::_update_interest() {
+	// Runs once per network process, so the cost of moving synchronizers is not multiplied by the number of peers.
+	interest_global_nodes.clear();
+	for (const ObjectID &sid : sync_nodes) {
+		MultiplayerSynchronizer *sync = get_id_as<MultiplayerSynchronizer>(sid);
+		ERR_CONTINUE(!sync);
+		if (!_has_authority(sync)) {
+			interest_grid.remove(sid);
+			continue;
+		}
+		Vector3 position;
+		if (sync->is_spatial_interest_enabled() && _get_interest_position(sync->get_root_node(), position)) {
+			interest_grid.update(sid, position);
+		} else {
+			interest_grid.remove(sid);
+			interest_global_nodes.push_back(sid);
+		}
+	}
+}
+
+void SceneReplicationInterface::_get_sync_candidates(PeerInfo &p_info, uint64_t p_elapsed_usec, LocalVector<ObjectID> &r_synchronizers) {
+	sync_candidates.clear();
+	Vector3 origin;
+	if (interest_radius > 0 && _get_interest_position(get_id_as<Node>(p_info.interest_origin), origin)) {
+		// Only visit the synchronizers near the peer, closer ones gain priority up to twice as fast.
+		interest_grid.query(origin, interest_radius, [&](const ObjectID &p_id, real_t p_distance) {
+			if (p_info.sync_nodes.has(p_id)) {
+				sync_candidates.push_back({ p_id, 2 - p_distance / interest_radius });
+			}
+		});
+		for (const ObjectID &sid : interest_global_nodes) {
+			if (p_info.sync_nodes.has(sid)) {
+				sync_candidates.push_back({ sid, 1 });
+			}
+		}
+	} else {
+		for (const ObjectID &sid : p_info.sync_nodes) {
+			sync_candidates.push_back({ sid, 1 });
+		}
+	}
+
+	if (sync_bandwidth_limit > 0 && !sync_candidates.is_empty()) {
+		// Refill the budget, allowing bursts of a tenth of a second. Synchronizers that don't fit in the budget
+		// keep accumulating priority until they are sent, so the least recently sent ones are never starved.
+		const int64_t burst = MAX(int64_t(sync_mtu), int64_t(sync_bandwidth_limit) / 10);
+		p_info.sync_budget = MIN(burst, p_info.sync_budget + int64_t(sync_bandwidth_limit) * int64_t(MIN(p_elapsed_usec, uint64_t(1000000))) / 1000000);
+		for (SyncCandidate &candidate : sync_candidates) {
+			MultiplayerSynchronizer *sync = get_id_as<MultiplayerSynchronizer>(candidate.id);
+			ERR_CONTINUE(!sync);
+			real_t &priority = p_info.sync_priorities[candidate.id];
+			priority += candidate.priority * sync->get_replication_priority();
+			candidate.priority = priority;
+		}
+		sync_candidates.sort_custom<SyncCandidateSort>();
+	}
+
+	r_synchronizers.reserve(sync_candidates.size());
+	for (const SyncCandidate &candidate : sync_candidates) {
+		r_synchronizers.push_back(candidate.id);
+	}
+}
+
+bool SceneReplicationInterface::_is_sync_due(const PeerInfo &p_info, const MultiplayerSynchronizer *p_sync, uint64_t p_usec) const {
+	// Send times are per peer, a synchronizer held back by one peer's budget can still be sent to the others.
+	const uint64_t *last_usec = p_info.last_sync_usecs.getptr(p_sync->get_instance_id());
+	return !last_usec || p_sync->is_outbound_sync_due(p_usec, *last_usec);
+}
+
+bool SceneReplicationInterface::_has_sync_budget(const PeerInfo &p_info, int p_size) const {
+	return sync_bandwidth_limit <= 0 || p_size <= p_info.sync_budget;
+}
+
+bool SceneReplicationInterface::_consume_sync_budget(PeerInfo &p_info, const ObjectID &p_oid, int p_size, uint64_t p_usec) {
+	if (!_has_sync_budget(p_info, p_size)) {
+		return false;
+	}
+	if (sync_bandwidth_limit > 0) {
+		p_info.sync_budget -= p_size;
+		p_info.sync_priorities.erase(p_oid);
+	}
+	// Only record the send time once the state is going out, so budget skips don't wait for another interval.
+	p_info.last_sync_usecs[p_oid] = p_usec;
+	return true;
+}
+
 Error SceneReplicationInterface::_send_raw(const uint8_t *p_buffer, int p_size, int p_peer, bool p_reliable) {
 	ERR_FAIL_COND_V(!p_buffer || p_size < 1, ERR_INVALID_PARAMETER);
 
@@ -707,7 +846,7 @@ MultiplayerSynchronizer *SceneReplicationInterface::_find_synchronizer(int p_pee
 	return sync;
 }
 
-void SceneReplicationInterface::_send_delta(int p_peer, const HashSet<ObjectID> &p_synchronizers, uint64_t p_usec, const HashMap<ObjectID, uint64_t> &p_last_watch_usecs) {
+void SceneReplicationInterface::_send_delta(int p_peer, const LocalVector<ObjectID> &p_synchronizers, uint64_t p_usec, const HashMap<ObjectID, uint64_t> &p_last_watch_usecs) {
 	MAKE_ROOM(/* header */ 1 + /* element */ 4 + 8 + 4 + delta_mtu);
 	uint8_t *ptr = packet_cache.ptrw();
 	ptr[0] = SceneMultiplayer::NETWORK_COMMAND_SYNC | (1 << SceneMultiplayer::CMD_FLAG_0_SHIFT);
@@ -727,6 +866,36 @@ void SceneReplicationInterface::_send_delta(int p_peer, const HashSet<ObjectID>
 			continue; // Nothing to update.
 		}
 
+		if (sync->get_replication_config_ptr()->has_schema()) {
+			// Schema encoded entries are marked with the highest bit of their size.
+			LocalVector<SceneReplicationEncoder::PropertySchema> schema;
+			_get_delta_schema(sync->get_replication_config_ptr()->get_watch_schema(), indexes, schema);
+			Vector<Variant> values;
+			for (const Variant &v : delta) {
+				values.push_back(v);
+			}
+			LocalVector<uint8_t> state;
+			Error err = SceneReplicationEncoder::encode_state(schema, values, nullptr, state);
+			ERR_CONTINUE_MSG(err != OK, "Unable to encode delta state.");
+			int size = state.size();
+			ERR_CONTINUE_MSG(size > delta_mtu, vformat("Synchronizer delta bigger than MTU will not be sent (%d > %d): %s", size, delta_mtu, sync->get_path()));
+			if (ofs + 4 + 8 + 4 + size > delta_mtu) {
+				// Send what we got, and reset write.
+				_send_raw(packet_cache.ptr(), ofs, p_peer, true);
+				ofs = 1;
+			}
+			ofs += encode_uint32(sync->get_net_id(), &ptr[ofs]);
+			ofs += encode_uint64(indexes, &ptr[ofs]);
+			ofs += encode_uint32(uint32_t(size) | 0x80000000, &ptr[ofs]);
+			memcpy(&ptr[ofs], state.ptr(), size);
+			ofs += size;
+#ifdef DEBUG_ENABLED
+			_profile_node_data("delta_out", oid, size);
+#endif
+			peers_info[p_peer].last_watch_usecs[oid] = p_usec;
+			continue;
+		}
+
 		Vector<const Variant *> varp;
 		varp.resize(delta.size());
 		const Variant **vptr = varp.ptrw();
@@ -773,6 +942,8 @@ Error SceneReplicationInterface::on_delta_receive(int p_from, const uint8_t *p_b
 		ofs += 8;
 		uint32_t size = decode_uint32(&p_buffer[ofs]);
 		ofs += 4;
+		const bool is_schema = size & 0x80000000;
+		size &= 0x7FFFFFFF;
 		ERR_FAIL_COND_V(size > uint32_t(p_buffer_len - ofs), ERR_INVALID_DATA);
 		MultiplayerSynchronizer *sync = _find_synchronizer(p_from, net_id);
 		Node *node = sync ? sync->get_root_node() : nullptr;
@@ -783,11 +954,21 @@ Error SceneReplicationInterface::on_delta_receive(int p_from, const uint8_t *p_b
 		List<NodePath> props = sync->get_delta_properties(indexes);
 		ERR_FAIL_COND_V(props.is_empty(), ERR_INVALID_DATA);
 		Vector<Variant> vars;
-		vars.resize(props.size());
-		int consumed = 0;
-		Error err = MultiplayerAPI::decode_and_decompress_variants(vars, p_buffer + ofs, size, consumed);
-		ERR_FAIL_COND_V(err != OK, err);
-		ERR_FAIL_COND_V(uint32_t(consumed) != size, ERR_INVALID_DATA);
+		Error err = OK;
+		if (is_schema) {
+			ERR_FAIL_COND_V(!sync->get_replication_config_ptr(), ERR_UNCONFIGURED);
+			LocalVector<SceneReplicationEncoder::PropertySchema> schema;
+			_get_delta_schema(sync->get_replication_config_ptr()->get_watch_schema(), indexes, schema);
+			ERR_FAIL_COND_V(int(schema.size()) != props.size(), ERR_INVALID_DATA);
+			err = SceneReplicationEncoder::decode_state(schema, p_buffer + ofs, size, nullptr, vars);
+			ERR_FAIL_COND_V(err != OK, err);
+		} else {
+			vars.resize(props.size());
+			int consumed = 0;
+			err = MultiplayerAPI::decode_and_decompress_variants(vars, p_buffer + ofs, size, consumed);
+			ERR_FAIL_COND_V(err != OK, err);
+			ERR_FAIL_COND_V(uint32_t(consumed) != size, ERR_INVALID_DATA);
+		}
 		err = MultiplayerSynchronizer::set_state(props, node, vars);
 		ERR_FAIL_COND_V(err != OK, err);
 		ofs += size;
@@ -799,18 +980,25 @@ Error SceneReplicationInterface::on_delta_receive(int p_from, const uint8_t *p_b
 	return OK;
 }
 
-void SceneReplicationInterface::_send_sync(int p_peer, const HashSet<ObjectID> &p_synchronizers, uint16_t p_sync_net_time, uint64_t p_usec) {
+void SceneReplicationInterface::_send_sync(int p_peer, const LocalVector<ObjectID> &p_synchronizers, uint16_t p_sync_net_time, uint64_t p_usec) {
 	MAKE_ROOM(/* header */ 3 + /* element */ 4 + 4 + sync_mtu);
 	uint8_t *ptr = packet_cache.ptrw();
 	ptr[0] = SceneMultiplayer::NETWORK_COMMAND_SYNC;
 	int ofs = 1;
 	ofs += encode_uint16(p_sync_net_time, &ptr[1]);
+	PeerInfo &info = peers_info[p_peer];
 	// Can only send updates for already notified nodes.
 	// This is a lazy implementation, we could optimize much more here with by grouping by replication config.
 	for (const ObjectID &oid : p_synchronizers) {
+		if (!_has_sync_budget(info, 4 + 4)) {
+			break; // Not even an empty state fits in what is left of the budget, skip reading the remaining states.
+		}
 		MultiplayerSynchronizer *sync = get_id_as<MultiplayerSynchronizer>(oid);
 		ERR_CONTINUE(!sync || !sync->get_replication_config_ptr() || !_has_authority(sync));
-		if (!sync->update_outbound_sync_time(p_usec)) {
+		if (sync->get_replication_config_ptr()->has_schema()) {
+			continue; // Sent by _send_schema_sync().
+		}
+		if (!_is_sync_due(info, sync, p_usec)) {
 			continue; // nothing to sync.
 		}
 
@@ -831,6 +1019,9 @@ void SceneReplicationInterface::_send_sync(int p_peer, const HashSet<ObjectID> &
 		ERR_CONTINUE_MSG(err != OK, "Unable to encode sync state.");
 		// TODO Handle single state above MTU.
 		ERR_CONTINUE_MSG(size > sync_mtu, vformat("Node states bigger than MTU will not be sent (%d > %d): %s", size, sync_mtu, node->get_path()));
+		if (!_consume_sync_budget(info, oid, 4 + 4 + size, p_usec)) {
+			continue; // Over the bandwidth budget, its accumulated priority will get it sent in a later frame.
+		}
 		if (ofs + 4 + 4 + size > sync_mtu) {
 			// Send what we got, and reset write.
 			_send_raw(packet_cache.ptr(), ofs, p_peer, false);
@@ -853,11 +1044,17 @@ void SceneReplicationInterface::_send_sync(int p_peer, const HashSet<ObjectID> &
 }
 
 Error SceneReplicationInterface::on_sync_receive(int p_from, const uint8_t *p_buffer, int p_buffer_len) {
+	if (p_buffer[0] & (1 << SceneMultiplayer::CMD_FLAG_2_SHIFT)) {
+		return _on_schema_ack_receive(p_from, p_buffer, p_buffer_len);
+	}
 	ERR_FAIL_COND_V_MSG(p_buffer_len < 11, ERR_INVALID_DATA, "Invalid sync packet received");
 	bool is_delta = (p_buffer[0] & (1 << SceneMultiplayer::CMD_FLAG_0_SHIFT)) != 0;
 	if (is_delta) {
 		return on_delta_receive(p_from, p_buffer, p_buffer_len);
 	}
+	if (p_buffer[0] & (1 << SceneMultiplayer::CMD_FLAG_1_SHIFT)) {
+		return _on_schema_sync_receive(p_from, p_buffer, p_buffer_len);
+	}
 	uint16_t time = decode_uint16(&p_buffer[1]);
 	int ofs = 3;
 	while (ofs + 8 < p_buffer_len) {
@@ -900,6 +1097,277 @@ Error SceneReplicationInterface::on_sync_receive(int p_from, const uint8_t *p_bu
 	return OK;
 }
 
+SceneReplicationInterface::SchemaPacket *SceneReplicationInterface::_begin_schema_packet(PeerInfo &p_info) {
+	const uint16_t seq = ++p_info.schema_seq;
+	SchemaPacket *packet = &p_info.schema_sent[seq % SCHEMA_HISTORY_SIZE];
+	packet->seq = seq;
+	packet->valid = true;
+	packet->states.clear();
+	return packet;
+}
+
+const SceneReplicationInterface::SchemaState *SceneReplicationInterface::_get_schema_baseline(PeerInfo &p_info, const ObjectID &p_oid, uint16_t p_seq) {
+	// Baselines too old for the history kept by the peer can't be used. Leave room for the state to end up in the next packet.
+	// Invalid baselines come from nacks, and are kept until the packets sent before the nack are out of the history.
+	const SchemaState *baseline = p_info.schema_baselines.getptr(p_oid);
+	if (baseline && uint16_t(p_seq - baseline->seq) >= (baseline->valid ? SCHEMA_HISTORY_SIZE - 1 : SCHEMA_HISTORY_SIZE)) {
+		p_info.schema_baselines.erase(p_oid);
+		return nullptr;
+	}
+	return baseline && baseline->valid ? baseline : nullptr;
+}
+
+// Schema sync packets: command, network time (2 bytes) and sequence number (2 bytes), followed by entries of
+// net ID (4 bytes), size (2 bytes), and the distance to the baseline sequence number (1 byte, 0 if no baseline).
+// Receivers acknowledge the sequence numbers they got, so senders can diff against the states in them.
+void SceneReplicationInterface::_send_schema_sync(int p_peer, const LocalVector<ObjectID> &p_synchronizers, uint16_t p_sync_net_time, uint64_t p_usec) {
+	MAKE_ROOM(/* header */ 5 + /* element */ 4 + 2 + 1 + sync_mtu);
+	uint8_t *ptr = packet_cache.ptrw();
+	ptr[0] = SceneMultiplayer::NETWORK_COMMAND_SYNC | (1 << SceneMultiplayer::CMD_FLAG_1_SHIFT);
+	encode_uint16(p_sync_net_time, &ptr[1]);
+	int ofs = 5;
+
+	PeerInfo &info = peers_info[p_peer];
+	SchemaPacket *packet = _begin_schema_packet(info);
+	uint16_t seq = packet->seq;
+
+	LocalVector<uint8_t> state;
+	for (const ObjectID &oid : p_synchronizers) {
+		if (!_has_sync_budget(info, 4 + 2 + 1)) {
+			break; // Not even an empty state fits in what is left of the budget, skip reading the remaining states.
+		}
+		MultiplayerSynchronizer *sync = get_id_as<MultiplayerSynchronizer>(oid);
+		ERR_CONTINUE(!sync || !sync->get_replication_config_ptr() || !_has_authority(sync));
+		SceneReplicationConfig *config = sync->get_replication_config_ptr();
+		if (!config->has_schema() || config->get_sync_properties().is_empty()) {
+			continue;
+		}
+		if (!_is_sync_due(info, sync, p_usec)) {
+			continue; // nothing to sync.
+		}
+
+		Node *node = sync->get_root_node();
+		ERR_CONTINUE(!node);
+		uint32_t net_id = sync->get_net_id();
+		if (!_verify_synchronizer(p_peer, sync, net_id)) {
+			// The path based sync is not yet confirmed, skipping.
+			continue;
+		}
+
+		// The state is read once per network process, and shared by all peers.
+		Vector<Variant> *values = schema_state_cache.getptr(oid);
+		if (!values) {
+			Vector<Variant> vars;
+			Vector<const Variant *> varp;
+			Error err = MultiplayerSynchronizer::get_state(config->get_sync_properties(), node, vars, varp);
+			ERR_CONTINUE_MSG(err != OK, "Unable to retrieve sync state.");
+			values = &schema_state_cache.insert(oid, vars)->value;
+		}
+
+		const SchemaState *baseline = _get_schema_baseline(info, oid, seq);
+		state.clear();
+		Error err = SceneReplicationEncoder::encode_state(config->get_sync_schema(), *values, baseline ? &baseline->values : nullptr, state);
+		ERR_CONTINUE_MSG(err != OK, "Unable to encode sync state.");
+		int size = state.size();
+		ERR_CONTINUE_MSG(size > MIN(sync_mtu, UINT16_MAX), vformat("Node states bigger than MTU will not be sent (%d > %d): %s", size, sync_mtu, node->get_path()));
+		if (!_consume_sync_budget(info, oid, 4 + 2 + 1 + size, p_usec)) {
+			continue; // Over the bandwidth budget, its accumulated priority will get it sent in a later frame.
+		}
+		if (ofs + 4 + 2 + 1 + size > sync_mtu) {
+			// Send what we got, and start a new packet.
+			encode_uint16(seq, &ptr[3]);
+			_send_raw(packet_cache.ptr(), ofs, p_peer, false);
+			ofs = 5;
+			packet = _begin_schema_packet(info);
+			seq = packet->seq;
+		}
+		ofs += encode_uint32(net_id, &ptr[ofs]);
+		ofs += encode_uint16(size, &ptr[ofs]);
+		ptr[ofs++] = baseline ? uint8_t(seq - baseline->seq) : 0;
+		memcpy(&ptr[ofs], state.ptr(), size);
+		ofs += size;
+		packet->states.push_back(Pair<ObjectID, Vector<Variant>>(oid, *values));
+		info.schema_sent_ids[net_id] = oid;
+#ifdef DEBUG_ENABLED
+		_profile_node_data("sync_out", oid, size);
+#endif
+	}
+	if (ofs > 5) {
+		// Got some left over to send.
+		encode_uint16(seq, &ptr[3]);
+		_send_raw(packet_cache.ptr(), ofs, p_peer, false);
+	} else {
+		// Nothing was written, reuse the sequence number.
+		packet->valid = false;
+		info.schema_seq--;
+	}
+}
+
+Error SceneReplicationInterface::_on_schema_sync_receive(int p_from, const uint8_t *p_buffer, int p_buffer_len) {
+	ERR_FAIL_COND_V_MSG(p_buffer_len < 5, ERR_INVALID_DATA, "Invalid sync packet received");
+	ERR_FAIL_COND_V(!peers_info.has(p_from), ERR_UNAVAILABLE);
+	PeerInfo &info = peers_info[p_from];
+	uint16_t time = decode_uint16(&p_buffer[1]);
+	uint16_t seq = decode_uint16(&p_buffer[3]);
+	int ofs = 5;
+	while (ofs + 7 <= p_buffer_len) {
+		uint32_t net_id = decode_uint32(&p_buffer[ofs]);
+		ofs += 4;
+		uint16_t size = decode_uint16(&p_buffer[ofs]);
+		ofs += 2;
+		uint8_t baseline_distance = p_buffer[ofs];
+		ofs += 1;
+		ERR_FAIL_COND_V(size > p_buffer_len - ofs, ERR_INVALID_DATA);
+		MultiplayerSynchronizer *sync = _find_synchronizer(p_from, net_id);
+		if (!sync || !sync->get_replication_config_ptr() || !sync->get_replication_config_ptr()->has_schema()) {
+			// Not received yet. Make sure the next state we get does not depend on this one.
+			info.schema_nacks.insert(net_id);
+			ofs += size;
+			continue;
+		}
+		Node *node = sync->get_root_node();
+		if (sync->get_multiplayer_authority() != p_from || !node) {
+			// Not valid for me.
+			ofs += size;
+			ERR_CONTINUE_MSG(true, "Ignoring sync data from non-authority or for missing node.");
+		}
+
+		LocalVector<SchemaState> &history = info.schema_received[sync->get_instance_id()];
+		if (history.size() != SCHEMA_HISTORY_SIZE) {
+			history.resize(SCHEMA_HISTORY_SIZE);
+		}
+		const Vector<Variant> *baseline = nullptr;
+		if (baseline_distance) {
+			uint16_t baseline_seq = seq - baseline_distance;
+			const SchemaState &baseline_state = history[baseline_seq % SCHEMA_HISTORY_SIZE];
+			if (!baseline_state.valid || baseline_state.seq != baseline_seq) {
+				// We don't know this baseline, ask for a full state.
+				info.schema_nacks.insert(net_id);
+				ofs += size;
+				continue;
+			}
+			baseline = &baseline_state.values;
+		}
+		Vector<Variant> vars;
+		Error err = SceneReplicationEncoder::decode_state(sync->get_replication_config_ptr()->get_sync_schema(), &p_buffer[ofs], size, baseline, vars);
+		ERR_FAIL_COND_V(err != OK, err);
+		ofs += size;
+
+		// Old states are still kept, since the sender may use them as baselines.
+		SchemaState &received = history[seq % SCHEMA_HISTORY_SIZE];
+		received.seq = seq;
+		received.valid = true;
+		received.values = vars;
+		if (!sync->update_inbound_sync_time(time)) {
+			// State is too old.
+			continue;
+		}
+		err = MultiplayerSynchronizer::set_state(sync->get_replication_config_ptr()->get_sync_properties(), node, vars);
+		ERR_FAIL_COND_V(err, err);
+		sync->emit_signal(SNAME("synchronized"));
+#ifdef DEBUG_ENABLED
+		_profile_node_data("sync_in", sync->get_instance_id(), size);
+#endif
+	}
+	// Every received packet is acknowledged in the next few acks, so losing one of them does not lose the baselines.
+	const int16_t distance = int16_t(seq - info.schema_ack_seq);
+	if (!info.schema_ack_valid || distance > int16_t(SCHEMA_HISTORY_SIZE)) {
+		info.schema_ack_seq = seq;
+		info.schema_ack_bits = 0;
+		info.schema_ack_valid = true;
+	} else if (distance > 0) {
+		info.schema_ack_bits = (distance < int16_t(SCHEMA_HISTORY_SIZE) ? info.schema_ack_bits << distance : 0) | (1U << (distance - 1));
+		info.schema_ack_seq = seq;
+	} else if (distance < 0 && distance >= -int16_t(SCHEMA_HISTORY_SIZE)) {
+		info.schema_ack_bits |= 1U << (-distance - 1);
+	}
+	info.schema_ack_pending = true;
+	return OK;
+}
+
+// Schema ack packets: command, newest received sequence number (2 bytes), a mask of the SCHEMA_HISTORY_SIZE
+// sequence numbers before it that were received too (4 bytes, lowest bit first), and the count (2 bytes) and
+// net IDs (4 bytes each) of synchronizers that could not be decoded, which must be sent without a baseline.
+void SceneReplicationInterface::_send_schema_ack(int p_peer, PeerInfo &p_info) {
+	const int nack_count = MIN(p_info.schema_nacks.size(), uint32_t(UINT16_MAX));
+	MAKE_ROOM(9 + nack_count * 4);
+	uint8_t *ptr = packet_cache.ptrw();
+	ptr[0] = SceneMultiplayer::NETWORK_COMMAND_SYNC | (1 << SceneMultiplayer::CMD_FLAG_2_SHIFT);
+	int ofs = 1;
+	ofs += encode_uint16(p_info.schema_ack_seq, &ptr[ofs]);
+	ofs += encode_uint32(p_info.schema_ack_bits, &ptr[ofs]);
+	ofs += encode_uint16(nack_count, &ptr[ofs]);
+	int count = 0;
+	for (const uint32_t &net_id : p_info.schema_nacks) {
+		if (count++ == nack_count) {
+			break;
+		}
+		ofs += encode_uint32(net_id, &ptr[ofs]);
+	}
+	_send_raw(packet_cache.ptr(), ofs, p_peer, false);
+	p_info.schema_nacks.clear();
+	p_info.schema_ack_pending = false;
+}
+
+// The states in an acknowledged packet become the baselines, unless newer ones are known already, or
+// the peer nacked the synchronizer after the packet was sent.
+void SceneReplicationInterface::_promote_schema_baselines(PeerInfo &p_info, uint16_t p_seq) {
+	const SchemaPacket &packet = p_info.schema_sent[p_seq % SCHEMA_HISTORY_SIZE];
+	if (!packet.valid || packet.seq != p_seq) {
+		return;
+	}
+	for (const Pair<ObjectID, Vector<Variant>> &E : packet.states) {
+		SchemaState *baseline = p_info.schema_baselines.getptr(E.first);
+		if (!baseline) {
+			baseline = &p_info.schema_baselines.insert(E.first, SchemaState())->value;
+		} else if (int16_t(p_seq - baseline->seq) <= 0) {
+			continue;
+		}
+		baseline->seq = p_seq;
+		baseline->valid = true;
+		baseline->values = E.second;
+	}
+}
+
+Error SceneReplicationInterface::_on_schema_ack_receive(int p_from, const uint8_t *p_buffer, int p_buffer_len) {
+	ERR_FAIL_COND_V_MSG(p_buffer_len < 9, ERR_INVALID_DATA, "Invalid sync ack packet received");
+	ERR_FAIL_COND_V(!peers_info.has(p_from), ERR_UNAVAILABLE);
+	PeerInfo &info = peers_info[p_from];
+	uint16_t seq = decode_uint16(&p_buffer[1]);
+	uint32_t ack_bits = decode_uint32(&p_buffer[3]);
+	uint16_t nack_count = decode_uint16(&p_buffer[7]);
+	ERR_FAIL_COND_V(9 + nack_count * 4 > p_buffer_len, ERR_INVALID_DATA);
+
+	// Oldest first, the newest acknowledged state of each synchronizer wins.
+	for (int i = SCHEMA_HISTORY_SIZE - 1; i >= 0; i--) {
+		if (ack_bits & (1U << i)) {
+			_promote_schema_baselines(info, seq - i - 1);
+		}
+	}
+	_promote_schema_baselines(info, seq);
+
+	for (int i = 0; i < nack_count; i++) {
+		uint32_t net_id = decode_uint32(&p_buffer[9 + i * 4]);
+		const ObjectID *oid = info.schema_sent_ids.getptr(net_id);
+		if (oid) {
+			// Acks of packets sent so far must not bring back a baseline the peer could not decode.
+			SchemaState &baseline = info.schema_baselines[*oid];
+			baseline.seq = info.schema_seq;
+			baseline.valid = false;
+			baseline.values.clear();
+		}
+	}
+	return OK;
+}
+
+void SceneReplicationInterface::_get_delta_schema(const LocalVector<SceneReplicationConfig::PropertySchema> &p_schema, uint64_t p_indexes, LocalVector<SceneReplicationConfig::PropertySchema> &r_schema) {
+	for (uint32_t i = 0; i < p_schema.size() && i < 64; i++) {
+		if (p_indexes & (1ULL << i)) {
+			r_schema.push_back(p_schema[i]);
+		}
+	}
+}
+
 void SceneReplicationInterface::set_max_sync_packet_size(int p_size) {
 	ERR_FAIL_COND_MSG(p_size < 128, "Sync maximum packet size must be at least 128 bytes.");
 	sync_mtu = p_size;
@@ -917,3 +1385,44 @@ void SceneReplicationInterface::set_max_delta_packet_size(int p_size) {
 int SceneReplicationInterface::get_max_delta_packet_size() const {
 	return delta_mtu;
 }
+
+void SceneReplicationInterface::set_interest_radius(real_t p_radius) {
+	ERR_FAIL_COND_MSG(p_radius < 0, "Interest radius must be greater or equal to 0 (where 0 disables spatial interest management).");
+	interest_radius = p_radius;
+	if (interest_radius > 0) {
+		// Queries then visit at most 27 cells.
+		interest_grid.set_cell_size(interest_radius);
+	} else {
+		interest_grid.clear();
+		interest_global_nodes.clear();
+	}
+}
+
+real_t SceneReplicationInterface::get_interest_radius() const {
+	return interest_radius;
+}
+
+void SceneReplicationInterface::set_sync_bandwidth_limit(int p_bytes_per_second) {
+	ERR_FAIL_COND_MSG(p_bytes_per_second < 0, "Sync bandwidth limit must be greater or equal to 0 (where 0 means unlimited).");
+	sync_bandwidth_limit = p_bytes_per_second;
+	if (!sync_bandwidth_limit) {
+		for (KeyValue<int, PeerInfo> &E : peers_info) {
+			E.value.sync_priorities.clear();
+			E.value.sync_budget = 0;
+		}
+	}
+}
+
+int SceneReplicationInterface::get_sync_bandwidth_limit() const {
+	return sync_bandwidth_limit;
+}
+
+void SceneReplicationInterface::set_peer_interest_origin(int p_peer, Node *p_node) {
+	ERR_FAIL_COND_MSG(!peers_info.has(p_peer), vformat("Unknown peer ID: %d.", p_peer));
+	peers_info[p_peer].interest_origin = p_node ? p_node->get_instance_id() : ObjectID();
+}
+
+Node *SceneReplicationInterface::get_peer_interest_origin(int p_peer) const {
+	ERR_FAIL_COND_V_MSG(!peers_info.has(p_peer), nullptr, vformat("Unknown peer ID: %d.", p_peer));
+	return get_id_as<Node>(peers_info[p_peer].interest_origin);
+}
@@ -32,8 +32,11 @@
 
 #include "multiplayer_spawner.h"
 #include "multiplayer_synchronizer.h"
+#include "scene_replication_interest.h"
 
 #include "core/object/ref_counted.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/pair.h"
 #include "core/templates/rb_set.h"
 
 class SceneMultiplayer;
@@ -41,6 +44,7 @@ class SceneCacheInterface;
 
 class SceneReplicationInterface : public RefCounted {
 	GDCLASS(SceneReplicationInterface, RefCounted);
+	friend class TestSceneReplicationInterfaceAccessor;
 
 private:
 	struct TrackedNode {
@@ -60,6 +64,24 @@ private:
 		}
 	};
 
+	enum {
+		// Number of schema sync packets a baseline can be behind. Receivers keep this many states per synchronizer.
+		SCHEMA_HISTORY_SIZE = 32,
+	};
+
+	struct SchemaState {
+		uint16_t seq = 0;
+		bool valid = false;
+		Vector<Variant> values;
+	};
+
+	// Synchronizer states sent in a schema sync packet, which become baselines once the peer acknowledges the packet.
+	struct SchemaPacket {
+		uint16_t seq = 0;
+		bool valid = false;
+		LocalVector<Pair<ObjectID, Vector<Variant>>> states;
+	};
+
 	struct PeerInfo {
 		HashSet<ObjectID> sync_nodes;
 		HashSet<ObjectID> spawn_nodes;
@@ -67,6 +89,36 @@ private:
 		HashMap<uint32_t, ObjectID> recv_sync_ids;
 		HashMap<uint32_t, ObjectID> recv_nodes;
 		uint16_t last_sent_sync = 0;
+
+		// Schema sync, sending side.
+		uint16_t schema_seq = 0;
+		SchemaPacket schema_sent[SCHEMA_HISTORY_SIZE];
+		HashMap<ObjectID, SchemaState> schema_baselines;
+		HashMap<uint32_t, ObjectID> schema_sent_ids;
+		// Schema sync, receiving side. Each history is indexed by sequence number modulo SCHEMA_HISTORY_SIZE.
+		HashMap<ObjectID, LocalVector<SchemaState>> schema_received;
+		bool schema_ack_pending = false;
+		bool schema_ack_valid = false;
+		// Newest sequence number received, and which of the SCHEMA_HISTORY_SIZE ones before it were received too (bit 0 is seq - 1).
+		uint16_t schema_ack_seq = 0;
+		uint32_t schema_ack_bits = 0;
+		HashSet<uint32_t> schema_nacks;
+
+		// Interest management.
+		ObjectID interest_origin;
+		HashMap<ObjectID, real_t> sync_priorities;
+		HashMap<ObjectID, uint64_t> last_sync_usecs;
+		int64_t sync_budget = 0;
+	};
+
+	struct SyncCandidate {
+		ObjectID id;
+		real_t priority = 0;
+	};
+
+	struct SyncCandidateSort {
+		// Highest priority first.
+		_FORCE_INLINE_ bool operator()(const SyncCandidate &p_a, const SyncCandidate &p_b) const { return p_a.priority > p_b.priority; }
 	};
 
 	// Replication state.
@@ -75,6 +127,16 @@ private:
 	HashMap<ObjectID, TrackedNode> tracked_nodes;
 	RBSet<ObjectID> spawned_nodes;
 	HashSet<ObjectID> sync_nodes;
+	// States of schema synchronizers collected during the current network process, shared by all peers.
+	HashMap<ObjectID, Vector<Variant>> schema_state_cache;
+
+	// Spatial interest management. Synchronizers with a position are stored in the grid, the others are relevant to every peer.
+	SceneReplicationInterestGrid interest_grid;
+	LocalVector<ObjectID> interest_global_nodes;
+	LocalVector<SyncCandidate> sync_candidates;
+	real_t interest_radius = 0;
+	int sync_bandwidth_limit = 0; // Bytes per second sent to each peer, 0 means unlimited.
+	uint64_t last_process_usec = 0;
 
 	// Pending local spawn information (handles spawning nested nodes during ready).
 	HashSet<ObjectID> spawn_queue;
@@ -101,8 +163,23 @@ private:
 	bool _verify_synchronizer(int p_peer, MultiplayerSynchronizer *p_sync, uint32_t &r_net_id);
 	MultiplayerSynchronizer *_find_synchronizer(int p_peer, uint32_t p_net_ida);
 
-	void _send_sync(int p_peer, const HashSet<ObjectID> &p_synchronizers, uint16_t p_sync_net_time, uint64_t p_usec);
-	void _send_delta(int p_peer, const HashSet<ObjectID> &p_synchronizers, uint64_t p_usec, const HashMap<ObjectID, uint64_t> &p_last_watch_usecs);
+	static bool _get_interest_position(const Node *p_node, Vector3 &r_position);
+	void _update_interest();
+	void _get_sync_candidates(PeerInfo &p_info, uint64_t p_elapsed_usec, LocalVector<ObjectID> &r_synchronizers);
+	bool _is_sync_due(const PeerInfo &p_info, const MultiplayerSynchronizer *p_sync, uint64_t p_usec) const;
+	bool _has_sync_budget(const PeerInfo &p_info, int p_size) const;
+	bool _consume_sync_budget(PeerInfo &p_info, const ObjectID &p_oid, int p_size, uint64_t p_usec);
+
+	void _send_sync(int p_peer, const LocalVector<ObjectID> &p_synchronizers, uint16_t p_sync_net_time, uint64_t p_usec);
+	void _send_delta(int p_peer, const LocalVector<ObjectID> &p_synchronizers, uint64_t p_usec, const HashMap<ObjectID, uint64_t> &p_last_watch_usecs);
+	void _send_schema_sync(int p_peer, const LocalVector<ObjectID> &p_synchronizers, uint16_t p_sync_net_time, uint64_t p_usec);
+	SchemaPacket *_begin_schema_packet(PeerInfo &p_info);
+	const SchemaState *_get_schema_baseline(PeerInfo &p_info, const ObjectID &p_oid, uint16_t p_seq);
+	void _send_schema_ack(int p_peer, PeerInfo &p_info);
+	void _promote_schema_baselines(PeerInfo &p_info, uint16_t p_seq);
+	Error _on_schema_sync_receive(int p_from, const uint8_t *p_buffer, int p_buffer_len);
+	Error _on_schema_ack_receive(int p_from, const uint8_t *p_buffer, int p_buffer_len);
+	static void _get_delta_schema(const LocalVector<SceneReplicationConfig::PropertySchema> &p_schema, uint64_t p_indexes, LocalVector<SceneReplicationConfig::PropertySchema> &r_schema);
 	Error _make_spawn_packet(Node *p_node, MultiplayerSpawner *p_spawner, int &r_len);
 	Error _make_despawn_packet(Node *p_node, int &r_len);
 	Error _send_raw(const uint8_t *p_buffer, int p_size, int p_peer, bool p_reliable);
@@ -146,6 +223,15 @@ public:
 	void set_max_delta_packet_size(int p_size);
 	int get_max_delta_packet_size() const;
 
+	void set_interest_radius(real_t p_radius);
+	real_t get_interest_radius() const;
+
+	void set_sync_bandwidth_limit(int p_bytes_per_second);
+	int get_sync_bandwidth_limit() const;
+
+	void set_peer_interest_origin(int p_peer, Node *p_node);
+	Node *get_peer_interest_origin(int p_peer) const;
+
 	SceneReplicationInterface(SceneMultiplayer *p_multiplayer, SceneCacheInterface *p_cache) {
 		multiplayer = p_multiplayer;
 		multiplayer_cache = p_cache;
@@ -0,0 +1,275 @@
+/**************************************************************************/
+/*  test_scene_replication_encoder.h                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../scene_replication_encoder.h"
+
+#include "core/os/os.h"
+#include "scene/main/multiplayer_api.h"
+#include "tests/test_macros.h"
+
+namespace TestSceneReplicationEncoder {
+
+static SceneReplicationEncoder::PropertySchema make_schema(Variant::Type p_type, int p_bits = 0, double p_min = 0.0, double p_max = 0.0) {
+	SceneReplicationEncoder::PropertySchema schema;
+	schema.type = p_type;
+	schema.quantization_bits = p_bits;
+	schema.quantization_min = p_min;
+	schema.quantization_max = p_max;
+	return schema;
+}
+
+TEST_CASE("[Multiplayer][SceneReplicationEncoder] Bit packing round trip") {
+	LocalVector<SceneReplicationEncoder::PropertySchema> schema;
+	Vector<Variant> values;
+	schema.push_back(make_schema(Variant::BOOL));
+	values.push_back(true);
+	schema.push_back(make_schema(Variant::INT));
+	values.push_back(-1234567890123LL);
+	schema.push_back(make_schema(Variant::INT, 7, -10, 100));
+	values.push_back(42);
+	schema.push_back(make_schema(Variant::FLOAT));
+	values.push_back(0.5);
+	schema.push_back(make_schema(Variant::FLOAT));
+	values.push_back(0.1);
+	schema.push_back(make_schema(Variant::VECTOR3));
+	values.push_back(Vector3(1.25, -2.5, 1e6));
+	schema.push_back(make_schema(Variant::VECTOR2I));
+	values.push_back(Vector2i(-3, 70000));
+	schema.push_back(make_schema(Variant::COLOR, 8, 0, 1));
+	values.push_back(Color(1, 0, 0, 1));
+	schema.push_back(make_schema(Variant::STRING));
+	values.push_back("Player");
+	schema.push_back(make_schema(Variant::NIL));
+	values.push_back(Array({ 1, "two" }));
+
+	LocalVector<uint8_t> buffer;
+	REQUIRE(SceneReplicationEncoder::encode_state(schema, values, nullptr, buffer) == OK);
+	Vector<Variant> decoded;
+	REQUIRE(SceneReplicationEncoder::decode_state(schema, buffer.ptr(), buffer.size(), nullptr, decoded) == OK);
+	CHECK(decoded == values);
+
+	SUBCASE("Values must match the schema type") {
+		values.write[3] = 1;
+		buffer.clear();
+		ERR_PRINT_OFF;
+		CHECK(SceneReplicationEncoder::encode_state(schema, values, nullptr, buffer) == ERR_INVALID_DATA);
+		ERR_PRINT_ON;
+	}
+
+	SUBCASE("Truncated data is rejected") {
+		ERR_PRINT_OFF;
+		CHECK(SceneReplicationEncoder::decode_state(schema, buffer.ptr(), buffer.size() - 1, nullptr, decoded) != OK);
+		ERR_PRINT_ON;
+	}
+}
+
+TEST_CASE("[Multiplayer][SceneReplicationEncoder] Quantization") {
+	LocalVector<SceneReplicationEncoder::PropertySchema> schema;
+	schema.push_back(make_schema(Variant::VECTOR3, 16, -1024, 1024));
+	const double step = 2048.0 / 65535.0;
+
+	Vector<Variant> values;
+	values.push_back(Vector3(-1023.7, 0.001, 511.3));
+	LocalVector<uint8_t> buffer;
+	REQUIRE(SceneReplicationEncoder::encode_state(schema, values, nullptr, buffer) == OK);
+	CHECK(buffer.size() == 6);
+	Vector<Variant> decoded;
+	REQUIRE(SceneReplicationEncoder::decode_state(schema, buffer.ptr(), buffer.size(), nullptr, decoded) == OK);
+	const Vector3 original = values[0];
+	const Vector3 result = decoded[0];
+	CHECK(Math::abs(result.x - original.x) <= step * 0.5 + CMP_EPSILON);
+	CHECK(Math::abs(result.y - original.y) <= step * 0.5 + CMP_EPSILON);
+	CHECK(Math::abs(result.z - original.z) <= step * 0.5 + CMP_EPSILON);
+
+	// Out of range values are clamped.
+	values.write[0] = Vector3(5000, -5000, 0);
+	buffer.clear();
+	REQUIRE(SceneReplicationEncoder::encode_state(schema, values, nullptr, buffer) == OK);
+	REQUIRE(SceneReplicationEncoder::decode_state(schema, buffer.ptr(), buffer.size(), nullptr, decoded) == OK);
+	CHECK(Math::is_equal_approx(Vector3(decoded[0]).x, (real_t)1024));
+	CHECK(Math::is_equal_approx(Vector3(decoded[0]).y, (real_t)-1024));
+
+	// Changes below the quantization step are not considered changes.
+	CHECK(SceneReplicationEncoder::is_value_equal(schema[0], Vector3(1.3, 2, 3), Vector3(1.3 + step * 0.1, 2, 3)));
+	CHECK_FALSE(SceneReplicationEncoder::is_value_equal(schema[0], Vector3(1.3, 2, 3), Vector3(1.3 + step * 2, 2, 3)));
+}
+
+TEST_CASE("[Multiplayer][SceneReplicationEncoder] Integer quantization ranges must fit in the bits") {
+	LocalVector<SceneReplicationEncoder::PropertySchema> schema;
+	schema.push_back(make_schema(Variant::VECTOR2I, 8, -128, 127));
+	Vector<Variant> values = { Vector2i(-128, 127) };
+	LocalVector<uint8_t> buffer;
+	REQUIRE(SceneReplicationEncoder::encode_state(schema, values, nullptr, buffer) == OK);
+	Vector<Variant> decoded;
+	REQUIRE(SceneReplicationEncoder::decode_state(schema, buffer.ptr(), buffer.size(), nullptr, decoded) == OK);
+	CHECK(decoded == values);
+
+	// One more value would saturate at the top of the range instead of being sent.
+	schema[0].quantization_max = 128;
+	CHECK_FALSE(SceneReplicationEncoder::is_schema_valid(schema[0]));
+	buffer.clear();
+	ERR_PRINT_OFF;
+	CHECK(SceneReplicationEncoder::encode_state(schema, values, nullptr, buffer) == ERR_INVALID_PARAMETER);
+	ERR_PRINT_ON;
+
+	// Real types are rounded to the steps, so any range is valid.
+	schema[0].type = Variant::VECTOR2;
+	CHECK(SceneReplicationEncoder::is_schema_valid(schema[0]));
+
+	Ref<SceneReplicationConfig> config;
+	config.instantiate();
+	config->add_property(NodePath(".:frame"));
+	config->property_set_type(NodePath(".:frame"), Variant::INT);
+	config->property_set_quantization(NodePath(".:frame"), 4, 0, 15);
+	ERR_PRINT_OFF;
+	config->property_set_quantization(NodePath(".:frame"), 4, 0, 16);
+	ERR_PRINT_ON;
+	CHECK(config->property_get_quantization_max(NodePath(".:frame")) == 15);
+}
+
+TEST_CASE("[Multiplayer][SceneReplicationEncoder] Baseline diffing") {
+	LocalVector<SceneReplicationEncoder::PropertySchema> schema;
+	schema.push_back(make_schema(Variant::VECTOR3, 16, -1024, 1024));
+	schema.push_back(make_schema(Variant::INT, 8, 0, 255));
+	schema.push_back(make_schema(Variant::STRING));
+	Vector<Variant> baseline = { Vector3(1, 2, 3), 100, "Player" };
+	Vector<Variant> values = { Vector3(1, 2, 3), 99, "Player" };
+
+	LocalVector<uint8_t> buffer;
+	REQUIRE(SceneReplicationEncoder::encode_state(schema, values, &baseline, buffer) == OK);
+	// One bit per property, plus the changed integer.
+	CHECK(buffer.size() == 2);
+	Vector<Variant> decoded;
+	REQUIRE(SceneReplicationEncoder::decode_state(schema, buffer.ptr(), buffer.size(), &baseline, decoded) == OK);
+	CHECK(decoded == values);
+
+	buffer.clear();
+	REQUIRE(SceneReplicationEncoder::encode_state(schema, baseline, &baseline, buffer) == OK);
+	CHECK(buffer.size() == 1);
+}
+
+TEST_CASE("[Multiplayer][SceneReplicationConfig] Schema is stored with the configuration") {
+	Ref<SceneReplicationConfig> config;
+	config.instantiate();
+	config->add_property(NodePath(".:position"));
+	config->add_property(NodePath(".:name"));
+	CHECK_FALSE(config->has_schema());
+
+	config->property_set_type(NodePath(".:position"), Variant::VECTOR3);
+	config->property_set_quantization(NodePath(".:position"), 20, -4096, 4096);
+	CHECK(config->has_schema());
+	REQUIRE(config->get_sync_schema().size() == 2);
+	CHECK(config->get_sync_schema()[0].type == Variant::VECTOR3);
+	CHECK(config->get_sync_schema()[0].quantization_bits == 20);
+	CHECK(config->get_sync_schema()[1].type == Variant::NIL);
+
+	Ref<SceneReplicationConfig> copy = config->duplicate();
+	CHECK(copy->property_get_type(NodePath(".:position")) == Variant::VECTOR3);
+	CHECK(copy->property_get_quantization_bits(NodePath(".:position")) == 20);
+	CHECK(copy->property_get_quantization_min(NodePath(".:position")) == -4096);
+	CHECK(copy->property_get_quantization_max(NodePath(".:position")) == 4096);
+	CHECK(copy->property_get_type(NodePath(".:name")) == Variant::NIL);
+
+	ERR_PRINT_OFF;
+	config->property_set_quantization(NodePath(".:position"), 8, 1, -1);
+	ERR_PRINT_ON;
+	CHECK(config->property_get_quantization_bits(NodePath(".:position")) == 20);
+}
+
+TEST_CASE("[Multiplayer][SceneReplicationEncoder][Benchmark] Bandwidth and encode time for 200 players") {
+	const int players = 200;
+	LocalVector<SceneReplicationEncoder::PropertySchema> schema;
+	schema.push_back(make_schema(Variant::VECTOR3, 20, -4096, 4096)); // Position.
+	schema.push_back(make_schema(Variant::VECTOR3, 12, -64, 64)); // Velocity.
+	schema.push_back(make_schema(Variant::FLOAT, 10, -Math::PI, Math::PI)); // Yaw.
+	schema.push_back(make_schema(Variant::INT, 7, 0, 100)); // Health.
+	schema.push_back(make_schema(Variant::BOOL)); // Crouching.
+
+	Vector<Vector<Variant>> previous;
+	Vector<Vector<Variant>> current;
+	for (int i = 0; i < players; i++) {
+		const Vector3 position(i * 10.5, 0.5, -i * 3.25);
+		const Vector3 velocity(Math::sin(i * 0.3) * 5, 0, Math::cos(i * 0.3) * 5);
+		previous.push_back({ position, velocity, i * 0.01, 100, false });
+		// Most players moved a bit, some also turned, few took damage.
+		current.push_back({ position + velocity / 60.0, velocity, i % 4 ? i * 0.01 : i * 0.01 + 0.2, i % 20 ? 100 : 90, false });
+	}
+
+	int variant_bytes = 0;
+	int schema_bytes = 0;
+	int delta_bytes = 0;
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (const Vector<Variant> &state : current) {
+		const Variant *ptrs[5];
+		for (int j = 0; j < 5; j++) {
+			ptrs[j] = &state[j];
+		}
+		int size = 0;
+		MultiplayerAPI::encode_and_compress_variants(ptrs, 5, nullptr, size);
+		LocalVector<uint8_t> buffer;
+		buffer.resize(size);
+		MultiplayerAPI::encode_and_compress_variants(ptrs, 5, buffer.ptr(), size);
+		variant_bytes += size;
+	}
+	const uint64_t variant_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	LocalVector<uint8_t> buffer;
+	for (const Vector<Variant> &state : current) {
+		buffer.clear();
+		SceneReplicationEncoder::encode_state(schema, state, nullptr, buffer);
+		schema_bytes += buffer.size();
+	}
+	const uint64_t schema_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	bool decoded_matches = true;
+	for (int i = 0; i < players; i++) {
+		buffer.clear();
+		SceneReplicationEncoder::encode_state(schema, current[i], &previous[i], buffer);
+		delta_bytes += buffer.size();
+		Vector<Variant> decoded;
+		Error err = SceneReplicationEncoder::decode_state(schema, buffer.ptr(), buffer.size(), &previous[i], decoded);
+		for (int j = 0; j < 5 && err == OK; j++) {
+			decoded_matches = decoded_matches && SceneReplicationEncoder::is_value_equal(schema[j], decoded[j], current[i][j]);
+		}
+		decoded_matches = decoded_matches && err == OK;
+	}
+	const uint64_t delta_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	CHECK(decoded_matches);
+	CHECK(schema_bytes * 3 < variant_bytes);
+	CHECK(delta_bytes < schema_bytes);
+	MESSAGE(vformat("%d players: Variant encoding %d bytes in %d usec, schema encoding %d bytes in %d usec, against baselines %d bytes in %d usec (including decoding).", players, variant_bytes, variant_usec, schema_bytes, schema_usec, delta_bytes, delta_usec));
+}
+
+} // namespace TestSceneReplicationEncoder
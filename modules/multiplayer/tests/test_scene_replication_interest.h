@@ -0,0 +1,534 @@
+/**************************************************************************/
+/*  test_scene_replication_interest.h                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../scene_multiplayer.h"
+#include "../scene_replication_interest.h"
+#include "../scene_replication_interface.h"
+
+#include "core/io/marshalls.h"
+#include "core/math/random_number_generator.h"
+#include "core/os/os.h"
+#include "scene/2d/node_2d.h"
+#include "scene/main/scene_tree.h"
+#include "scene/main/window.h"
+#include "tests/test_macros.h"
+
+class TestSceneReplicationInterfaceAccessor {
+public:
+	static void add_peer(SceneReplicationInterface *p_replicator, int p_peer) {
+		p_replicator->peers_info[p_peer] = SceneReplicationInterface::PeerInfo();
+	}
+
+	static void add_synchronizer(SceneReplicationInterface *p_replicator, int p_peer, const MultiplayerSynchronizer *p_sync) {
+		p_replicator->peers_info[p_peer].sync_nodes.insert(p_sync->get_instance_id());
+	}
+
+	// Stands in for _update_interest(), which needs the synchronizers to have authority.
+	static void set_interest_position(SceneReplicationInterface *p_replicator, const MultiplayerSynchronizer *p_sync, const Vector3 &p_position) {
+		p_replicator->interest_grid.update(p_sync->get_instance_id(), p_position);
+	}
+
+	static void set_interest_global(SceneReplicationInterface *p_replicator, const MultiplayerSynchronizer *p_sync) {
+		p_replicator->interest_global_nodes.push_back(p_sync->get_instance_id());
+	}
+
+	static LocalVector<ObjectID> get_sync_candidates(SceneReplicationInterface *p_replicator, int p_peer, uint64_t p_elapsed_usec) {
+		LocalVector<ObjectID> candidates;
+		p_replicator->_get_sync_candidates(p_replicator->peers_info[p_peer], p_elapsed_usec, candidates);
+		return candidates;
+	}
+
+	static bool consume_sync_budget(SceneReplicationInterface *p_replicator, int p_peer, const ObjectID &p_oid, int p_size, uint64_t p_usec = 0) {
+		return p_replicator->_consume_sync_budget(p_replicator->peers_info[p_peer], p_oid, p_size, p_usec);
+	}
+
+	static bool is_sync_due(SceneReplicationInterface *p_replicator, int p_peer, const MultiplayerSynchronizer *p_sync, uint64_t p_usec) {
+		return p_replicator->_is_sync_due(p_replicator->peers_info[p_peer], p_sync, p_usec);
+	}
+
+	static int64_t get_sync_budget(SceneReplicationInterface *p_replicator, int p_peer) {
+		return p_replicator->peers_info[p_peer].sync_budget;
+	}
+
+	// Stands in for the bookkeeping of _send_schema_sync(), which needs a connected peer. Sends the state in a packet of its own,
+	// and returns the sequence number of that packet, and in r_baseline_distance the one written to the entry (0 for a full state).
+	static uint16_t send_schema_state(SceneReplicationInterface *p_replicator, int p_peer, const ObjectID &p_oid, uint32_t p_net_id, const Vector<Variant> &p_values, int &r_baseline_distance) {
+		SceneReplicationInterface::PeerInfo &info = p_replicator->peers_info[p_peer];
+		SceneReplicationInterface::SchemaPacket *packet = p_replicator->_begin_schema_packet(info);
+		const SceneReplicationInterface::SchemaState *baseline = p_replicator->_get_schema_baseline(info, p_oid, packet->seq);
+		r_baseline_distance = baseline ? uint8_t(packet->seq - baseline->seq) : 0;
+		packet->states.push_back(Pair<ObjectID, Vector<Variant>>(p_oid, p_values));
+		info.schema_sent_ids[p_net_id] = p_oid;
+		return packet->seq;
+	}
+
+	static Error receive_schema_ack(SceneReplicationInterface *p_replicator, int p_peer, uint16_t p_seq, uint32_t p_ack_bits, const LocalVector<uint32_t> &p_nacks = LocalVector<uint32_t>()) {
+		PackedByteArray packet;
+		packet.resize(9 + p_nacks.size() * 4);
+		uint8_t *ptr = packet.ptrw();
+		ptr[0] = SceneMultiplayer::NETWORK_COMMAND_SYNC | (1 << SceneMultiplayer::CMD_FLAG_2_SHIFT);
+		encode_uint16(p_seq, &ptr[1]);
+		encode_uint32(p_ack_bits, &ptr[3]);
+		encode_uint16(p_nacks.size(), &ptr[7]);
+		for (uint32_t i = 0; i < p_nacks.size(); i++) {
+			encode_uint32(p_nacks[i], &ptr[9 + i * 4]);
+		}
+		return p_replicator->_on_schema_ack_receive(p_peer, packet.ptr(), packet.size());
+	}
+
+	// Empty if the synchronizer has no usable baseline.
+	static Vector<Variant> get_schema_baseline(SceneReplicationInterface *p_replicator, int p_peer, const ObjectID &p_oid) {
+		const SceneReplicationInterface::SchemaState *baseline = p_replicator->peers_info[p_peer].schema_baselines.getptr(p_oid);
+		return baseline && baseline->valid ? baseline->values : Vector<Variant>();
+	}
+
+	static int get_schema_history_size() {
+		return SceneReplicationInterface::SCHEMA_HISTORY_SIZE;
+	}
+
+	static real_t get_sync_priority(SceneReplicationInterface *p_replicator, int p_peer, const ObjectID &p_oid) {
+		const real_t *priority = p_replicator->peers_info[p_peer].sync_priorities.getptr(p_oid);
+		return priority ? *priority : 0;
+	}
+};
+
+namespace TestSceneReplicationInterest {
+
+typedef TestSceneReplicationInterfaceAccessor Accessor;
+
+static LocalVector<ObjectID> query_sorted(const SceneReplicationInterestGrid &p_grid, const Vector3 &p_position, real_t p_radius) {
+	LocalVector<ObjectID> result;
+	p_grid.query(p_position, p_radius, [&](const ObjectID &p_id, real_t p_distance) {
+		result.push_back(p_id);
+	});
+	result.sort();
+	return result;
+}
+
+TEST_CASE("[Multiplayer][SceneReplicationInterestGrid] Query") {
+	SceneReplicationInterestGrid grid;
+	grid.set_cell_size(10);
+	grid.update(ObjectID(uint64_t(1)), Vector3(0, 0, 0));
+	grid.update(ObjectID(uint64_t(2)), Vector3(9, 0, 0));
+	grid.update(ObjectID(uint64_t(3)), Vector3(-11, 0, 0));
+	grid.update(ObjectID(uint64_t(4)), Vector3(0, 0, 25));
+	CHECK(grid.size() == 4);
+
+	LocalVector<ObjectID> result = query_sorted(grid, Vector3(), 10);
+	REQUIRE(result.size() == 2);
+	CHECK(result[0] == ObjectID(uint64_t(1)));
+	CHECK(result[1] == ObjectID(uint64_t(2)));
+
+	real_t distance = -1;
+	grid.query(Vector3(0, 0, 21), 5, [&](const ObjectID &p_id, real_t p_distance) {
+		CHECK(p_id == ObjectID(uint64_t(4)));
+		distance = p_distance;
+	});
+	CHECK(distance == doctest::Approx(4));
+
+	SUBCASE("Moving and removing entries") {
+		grid.update(ObjectID(uint64_t(4)), Vector3(3, 0, 0));
+		grid.update(ObjectID(uint64_t(2)), Vector3(50, 50, 50));
+		grid.remove(ObjectID(uint64_t(1)));
+		CHECK_FALSE(grid.has(ObjectID(uint64_t(1))));
+		result = query_sorted(grid, Vector3(), 10);
+		REQUIRE(result.size() == 1);
+		CHECK(result[0] == ObjectID(uint64_t(4)));
+	}
+
+	SUBCASE("Changing the cell size") {
+		grid.set_cell_size(1);
+		result = query_sorted(grid, Vector3(), 10);
+		CHECK(result.size() == 2);
+		// Large radii visit the entries instead of the cells.
+		result = query_sorted(grid, Vector3(), 1000);
+		CHECK(result.size() == 4);
+	}
+
+	grid.clear();
+	CHECK(grid.size() == 0);
+	CHECK(query_sorted(grid, Vector3(), 1000).is_empty());
+}
+
+TEST_CASE("[Multiplayer][SceneReplicationInterestGrid][Benchmark] 100 peers and 10000 synchronizers") {
+	const int peers = 100;
+	const int objects = 10000;
+	const real_t radius = 100;
+	Ref<RandomNumberGenerator> rng;
+	rng.instantiate();
+	rng->set_seed(42);
+
+	LocalVector<Vector3> positions;
+	SceneReplicationInterestGrid grid;
+	grid.set_cell_size(radius);
+	for (int i = 0; i < objects; i++) {
+		positions.push_back(Vector3(rng->randf_range(-2000, 2000), rng->randf_range(0, 50), rng->randf_range(-2000, 2000)));
+		grid.update(ObjectID(uint64_t(i + 1)), positions[i]);
+	}
+	LocalVector<Vector3> origins;
+	for (int i = 0; i < peers; i++) {
+		origins.push_back(positions[rng->randi_range(0, objects - 1)]);
+	}
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	int brute_force_count = 0;
+	for (const Vector3 &origin : origins) {
+		for (const Vector3 &position : positions) {
+			if (position.distance_squared_to(origin) <= radius * radius) {
+				brute_force_count++;
+			}
+		}
+	}
+	const uint64_t brute_force_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	int grid_count = 0;
+	for (const Vector3 &origin : origins) {
+		grid.query(origin, radius, [&](const ObjectID &p_id, real_t p_distance) {
+			grid_count++;
+		});
+	}
+	const uint64_t grid_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	// Every synchronizer moves a little each frame, only the ones crossing a cell boundary move in the grid.
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < objects; i++) {
+		positions[i] += Vector3(0.1, 0, 0.1);
+		grid.update(ObjectID(uint64_t(i + 1)), positions[i]);
+	}
+	const uint64_t update_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	CHECK(grid_count == brute_force_count);
+	MESSAGE(vformat("%d relevant pairs: checking every synchronizer for every peer took %d usec, grid queries took %d usec, moving all synchronizers took %d usec.", grid_count, brute_force_usec, grid_usec, update_usec));
+}
+
+static Ref<SceneReplicationInterface> make_replicator() {
+	Ref<SceneReplicationInterface> replicator = memnew(SceneReplicationInterface(nullptr, nullptr));
+	Accessor::add_peer(replicator.ptr(), 2);
+	return replicator;
+}
+
+TEST_CASE("[Multiplayer][SceneReplicationInterface] Sync budget refills as a token bucket") {
+	Ref<SceneReplicationInterface> replicator = make_replicator();
+	MultiplayerSynchronizer *sync = memnew(MultiplayerSynchronizer);
+	Accessor::add_synchronizer(replicator.ptr(), 2, sync);
+
+	SUBCASE("Unlimited by default") {
+		CHECK(Accessor::get_sync_candidates(replicator.ptr(), 2, 100000).size() == 1);
+		CHECK(Accessor::consume_sync_budget(replicator.ptr(), 2, sync->get_instance_id(), 1000000));
+		CHECK(Accessor::get_sync_budget(replicator.ptr(), 2) == 0);
+	}
+
+	SUBCASE("Limited") {
+		// Bursts are capped to the larger of the sync MTU and a tenth of a second.
+		replicator->set_sync_bandwidth_limit(20000);
+		Accessor::get_sync_candidates(replicator.ptr(), 2, 50000);
+		CHECK(Accessor::get_sync_budget(replicator.ptr(), 2) == 1000);
+		CHECK(Accessor::consume_sync_budget(replicator.ptr(), 2, sync->get_instance_id(), 600));
+		CHECK(Accessor::get_sync_budget(replicator.ptr(), 2) == 400);
+		CHECK_FALSE(Accessor::consume_sync_budget(replicator.ptr(), 2, sync->get_instance_id(), 600));
+		CHECK(Accessor::get_sync_budget(replicator.ptr(), 2) == 400);
+
+		Accessor::get_sync_candidates(replicator.ptr(), 2, 10000);
+		CHECK(Accessor::get_sync_budget(replicator.ptr(), 2) == 600);
+		CHECK(Accessor::consume_sync_budget(replicator.ptr(), 2, sync->get_instance_id(), 600));
+		CHECK(Accessor::get_sync_budget(replicator.ptr(), 2) == 0);
+
+		Accessor::get_sync_candidates(replicator.ptr(), 2, 10000000);
+		CHECK(Accessor::get_sync_budget(replicator.ptr(), 2) == 2000);
+
+		// Disabling the limit drops the accumulated budget.
+		replicator->set_sync_bandwidth_limit(0);
+		CHECK(Accessor::get_sync_budget(replicator.ptr(), 2) == 0);
+	}
+
+	memdelete(sync);
+}
+
+TEST_CASE("[Multiplayer][SceneReplicationInterface] Sync candidates are ordered by priority") {
+	Ref<SceneReplicationInterface> replicator = make_replicator();
+	replicator->set_sync_bandwidth_limit(10000);
+	MultiplayerSynchronizer *syncs[3];
+	const real_t priorities[3] = { 1, 3, 2 };
+	for (int i = 0; i < 3; i++) {
+		syncs[i] = memnew(MultiplayerSynchronizer);
+		syncs[i]->set_replication_priority(priorities[i]);
+		Accessor::add_synchronizer(replicator.ptr(), 2, syncs[i]);
+	}
+
+	LocalVector<ObjectID> candidates = Accessor::get_sync_candidates(replicator.ptr(), 2, 10000);
+	REQUIRE(candidates.size() == 3);
+	CHECK(candidates[0] == syncs[1]->get_instance_id());
+	CHECK(candidates[1] == syncs[2]->get_instance_id());
+	CHECK(candidates[2] == syncs[0]->get_instance_id());
+
+	// Priorities accumulate until sent, and sending resets them.
+	CHECK(Accessor::consume_sync_budget(replicator.ptr(), 2, syncs[1]->get_instance_id(), 100));
+	candidates = Accessor::get_sync_candidates(replicator.ptr(), 2, 10000);
+	CHECK(Accessor::get_sync_priority(replicator.ptr(), 2, syncs[0]->get_instance_id()) == doctest::Approx(2));
+	CHECK(Accessor::get_sync_priority(replicator.ptr(), 2, syncs[1]->get_instance_id()) == doctest::Approx(3));
+	CHECK(Accessor::get_sync_priority(replicator.ptr(), 2, syncs[2]->get_instance_id()) == doctest::Approx(4));
+	REQUIRE(candidates.size() == 3);
+	CHECK(candidates[0] == syncs[2]->get_instance_id());
+	CHECK(candidates[1] == syncs[1]->get_instance_id());
+	CHECK(candidates[2] == syncs[0]->get_instance_id());
+
+	for (MultiplayerSynchronizer *sync : syncs) {
+		memdelete(sync);
+	}
+}
+
+TEST_CASE("[Multiplayer][SceneReplicationInterface][SceneTree] Sync priority is weighted by distance to the interest origin") {
+	Ref<SceneReplicationInterface> replicator = make_replicator();
+	replicator->set_sync_bandwidth_limit(10000);
+	replicator->set_interest_radius(100);
+	Node2D *origin = memnew(Node2D);
+	SceneTree::get_singleton()->get_root()->add_child(origin);
+	origin->set_global_position(Vector2(10, 0));
+	replicator->set_peer_interest_origin(2, origin);
+
+	MultiplayerSynchronizer *far_sync = memnew(MultiplayerSynchronizer);
+	MultiplayerSynchronizer *near_sync = memnew(MultiplayerSynchronizer);
+	MultiplayerSynchronizer *outside_sync = memnew(MultiplayerSynchronizer);
+	MultiplayerSynchronizer *global_sync = memnew(MultiplayerSynchronizer);
+	for (MultiplayerSynchronizer *sync : { far_sync, near_sync, outside_sync, global_sync }) {
+		Accessor::add_synchronizer(replicator.ptr(), 2, sync);
+	}
+	Accessor::set_interest_position(replicator.ptr(), far_sync, Vector3(85, 0, 0));
+	Accessor::set_interest_position(replicator.ptr(), near_sync, Vector3(0, 0, 0));
+	Accessor::set_interest_position(replicator.ptr(), outside_sync, Vector3(200, 0, 0));
+	Accessor::set_interest_global(replicator.ptr(), global_sync);
+
+	LocalVector<ObjectID> candidates = Accessor::get_sync_candidates(replicator.ptr(), 2, 10000);
+	REQUIRE(candidates.size() == 3);
+	CHECK(candidates[0] == near_sync->get_instance_id());
+	CHECK(candidates[1] == far_sync->get_instance_id());
+	CHECK(candidates[2] == global_sync->get_instance_id());
+	CHECK(Accessor::get_sync_priority(replicator.ptr(), 2, near_sync->get_instance_id()) == doctest::Approx(1.9));
+	CHECK(Accessor::get_sync_priority(replicator.ptr(), 2, far_sync->get_instance_id()) == doctest::Approx(1.25));
+	CHECK(Accessor::get_sync_priority(replicator.ptr(), 2, global_sync->get_instance_id()) == doctest::Approx(1));
+	CHECK(Accessor::get_sync_priority(replicator.ptr(), 2, outside_sync->get_instance_id()) == 0);
+
+	for (MultiplayerSynchronizer *sync : { far_sync, near_sync, outside_sync, global_sync }) {
+		memdelete(sync);
+	}
+	memdelete(origin);
+}
+
+TEST_CASE("[Multiplayer][SceneReplicationInterface] Low priority synchronizers are not starved by the sync budget") {
+	Ref<SceneReplicationInterface> replicator = make_replicator();
+	// Exactly one state fits in the budget refilled each frame.
+	const int size = replicator->get_max_sync_packet_size();
+	replicator->set_sync_bandwidth_limit(size * 10);
+	const int count = 4;
+	MultiplayerSynchronizer *syncs[count];
+	for (int i = 0; i < count; i++) {
+		syncs[i] = memnew(MultiplayerSynchronizer);
+		syncs[i]->set_replication_priority(i == 0 ? 10 : 1);
+		Accessor::add_synchronizer(replicator.ptr(), 2, syncs[i]);
+	}
+
+	int sent[count] = {};
+	int last_sent_frame[count] = {};
+	int longest_wait = 0;
+	const int frames = 100;
+	for (int frame = 1; frame <= frames; frame++) {
+		int sent_this_frame = 0;
+		for (const ObjectID &oid : Accessor::get_sync_candidates(replicator.ptr(), 2, 100000)) {
+			if (!Accessor::consume_sync_budget(replicator.ptr(), 2, oid, size)) {
+				continue;
+			}
+			sent_this_frame++;
+			for (int i = 0; i < count; i++) {
+				if (syncs[i]->get_instance_id() == oid) {
+					sent[i]++;
+					longest_wait = MAX(longest_wait, frame - last_sent_frame[i]);
+					last_sent_frame[i] = frame;
+				}
+			}
+		}
+		CHECK(sent_this_frame == 1);
+	}
+
+	for (int i = 1; i < count; i++) {
+		CHECK(sent[i] > 0);
+		CHECK(sent[0] > sent[i]);
+		longest_wait = MAX(longest_wait, frames + 1 - last_sent_frame[i]);
+	}
+	// The high priority synchronizer gets sent 10 times as often as each of the others, which still regularly get their turn.
+	CHECK(longest_wait <= 2 * (10 + count));
+
+	for (MultiplayerSynchronizer *sync : syncs) {
+		memdelete(sync);
+	}
+}
+
+TEST_CASE("[Multiplayer][SceneReplicationInterface] Sync intervals are tracked per peer") {
+	Ref<SceneReplicationInterface> replicator = make_replicator();
+	Accessor::add_peer(replicator.ptr(), 3);
+	const int size = replicator->get_max_sync_packet_size();
+	replicator->set_sync_bandwidth_limit(size * 10);
+	MultiplayerSynchronizer *sync = memnew(MultiplayerSynchronizer);
+	sync->set_replication_interval(0.1);
+	Accessor::add_synchronizer(replicator.ptr(), 2, sync);
+	Accessor::add_synchronizer(replicator.ptr(), 3, sync);
+	const ObjectID oid = sync->get_instance_id();
+
+	// Both peers get a full budget, then peer 3 spends it elsewhere before the synchronizer's turn.
+	uint64_t usec = 1000000;
+	Accessor::get_sync_candidates(replicator.ptr(), 2, 100000);
+	Accessor::get_sync_candidates(replicator.ptr(), 3, 100000);
+	CHECK(Accessor::consume_sync_budget(replicator.ptr(), 3, ObjectID(), size, usec));
+	CHECK(Accessor::is_sync_due(replicator.ptr(), 2, sync, usec));
+	CHECK(Accessor::is_sync_due(replicator.ptr(), 3, sync, usec));
+	CHECK(Accessor::consume_sync_budget(replicator.ptr(), 2, oid, size, usec));
+	CHECK_FALSE(Accessor::consume_sync_budget(replicator.ptr(), 3, oid, size, usec));
+
+	// Peer 3 gets it as soon as its budget allows, while peer 2 waits for the interval.
+	usec += 10000;
+	Accessor::get_sync_candidates(replicator.ptr(), 2, 10000);
+	Accessor::get_sync_candidates(replicator.ptr(), 3, 100000);
+	CHECK_FALSE(Accessor::is_sync_due(replicator.ptr(), 2, sync, usec));
+	CHECK(Accessor::is_sync_due(replicator.ptr(), 3, sync, usec));
+	CHECK(Accessor::consume_sync_budget(replicator.ptr(), 3, oid, size, usec));
+
+	usec += 90000;
+	CHECK(Accessor::is_sync_due(replicator.ptr(), 2, sync, usec));
+	CHECK_FALSE(Accessor::is_sync_due(replicator.ptr(), 3, sync, usec));
+
+	usec += 10000;
+	CHECK(Accessor::is_sync_due(replicator.ptr(), 3, sync, usec));
+
+	memdelete(sync);
+}
+
+TEST_CASE("[Multiplayer][SceneReplicationInterface] Schema baselines are only used once acknowledged") {
+	Ref<SceneReplicationInterface> replicator = make_replicator();
+	const ObjectID oid = ObjectID(uint64_t(1));
+	int distance = -1;
+
+	const uint16_t first = Accessor::send_schema_state(replicator.ptr(), 2, oid, 1, { 1 }, distance);
+	CHECK(distance == 0);
+	Accessor::send_schema_state(replicator.ptr(), 2, oid, 1, { 2 }, distance);
+	CHECK(distance == 0);
+	CHECK(Accessor::get_schema_baseline(replicator.ptr(), 2, oid).is_empty());
+
+	REQUIRE(Accessor::receive_schema_ack(replicator.ptr(), 2, first, 0) == OK);
+	CHECK(Accessor::get_schema_baseline(replicator.ptr(), 2, oid) == Vector<Variant>{ 1 });
+	const uint16_t seq = Accessor::send_schema_state(replicator.ptr(), 2, oid, 1, { 3 }, distance);
+	CHECK(distance == seq - first);
+}
+
+TEST_CASE("[Multiplayer][SceneReplicationInterface] Out of order and lost acks promote the newest acknowledged states") {
+	Ref<SceneReplicationInterface> replicator = make_replicator();
+	const ObjectID oid_a = ObjectID(uint64_t(1));
+	const ObjectID oid_b = ObjectID(uint64_t(2));
+	int distance = -1;
+
+	const uint16_t seq_a1 = Accessor::send_schema_state(replicator.ptr(), 2, oid_a, 1, { 1 }, distance);
+	const uint16_t seq_b = Accessor::send_schema_state(replicator.ptr(), 2, oid_b, 2, { 10 }, distance);
+	const uint16_t seq_a2 = Accessor::send_schema_state(replicator.ptr(), 2, oid_a, 1, { 2 }, distance);
+	REQUIRE(seq_b == seq_a1 + 1);
+	REQUIRE(seq_a2 == seq_b + 1);
+
+	// The peer got the first and last packets, the ack of the first one was lost.
+	REQUIRE(Accessor::receive_schema_ack(replicator.ptr(), 2, seq_a2, 0b10) == OK);
+	CHECK(Accessor::get_schema_baseline(replicator.ptr(), 2, oid_a) == Vector<Variant>{ 2 });
+	CHECK(Accessor::get_schema_baseline(replicator.ptr(), 2, oid_b).is_empty());
+
+	// An older ack arriving late still promotes the packets it adds, without replacing newer baselines.
+	REQUIRE(Accessor::receive_schema_ack(replicator.ptr(), 2, seq_b, 0b1) == OK);
+	CHECK(Accessor::get_schema_baseline(replicator.ptr(), 2, oid_a) == Vector<Variant>{ 2 });
+	CHECK(Accessor::get_schema_baseline(replicator.ptr(), 2, oid_b) == Vector<Variant>{ 10 });
+
+	uint16_t seq = Accessor::send_schema_state(replicator.ptr(), 2, oid_a, 1, { 3 }, distance);
+	CHECK(distance == seq - seq_a2);
+	seq = Accessor::send_schema_state(replicator.ptr(), 2, oid_b, 2, { 11 }, distance);
+	CHECK(distance == seq - seq_b);
+}
+
+TEST_CASE("[Multiplayer][SceneReplicationInterface] Nacks force a full state until a newer one is acknowledged") {
+	Ref<SceneReplicationInterface> replicator = make_replicator();
+	const ObjectID oid = ObjectID(uint64_t(1));
+	int distance = -1;
+
+	const uint16_t first = Accessor::send_schema_state(replicator.ptr(), 2, oid, 1, { 1 }, distance);
+	REQUIRE(Accessor::receive_schema_ack(replicator.ptr(), 2, first, 0) == OK);
+	const uint16_t nacked = Accessor::send_schema_state(replicator.ptr(), 2, oid, 1, { 2 }, distance);
+	CHECK(distance == 1);
+
+	// The peer could not decode the state, e.g. as it did not have the synchronizer yet.
+	REQUIRE(Accessor::receive_schema_ack(replicator.ptr(), 2, nacked, 0b1, { 1 }) == OK);
+	CHECK(Accessor::get_schema_baseline(replicator.ptr(), 2, oid).is_empty());
+	const uint16_t full = Accessor::send_schema_state(replicator.ptr(), 2, oid, 1, { 3 }, distance);
+	CHECK(distance == 0);
+
+	// Acks of packets sent before the nack don't bring back the old baseline.
+	REQUIRE(Accessor::receive_schema_ack(replicator.ptr(), 2, nacked, 0b1) == OK);
+	CHECK(Accessor::get_schema_baseline(replicator.ptr(), 2, oid).is_empty());
+	Accessor::send_schema_state(replicator.ptr(), 2, oid, 1, { 4 }, distance);
+	CHECK(distance == 0);
+
+	REQUIRE(Accessor::receive_schema_ack(replicator.ptr(), 2, full, 0b1) == OK);
+	CHECK(Accessor::get_schema_baseline(replicator.ptr(), 2, oid) == Vector<Variant>{ 3 });
+	const uint16_t seq = Accessor::send_schema_state(replicator.ptr(), 2, oid, 1, { 5 }, distance);
+	CHECK(distance == seq - full);
+}
+
+TEST_CASE("[Multiplayer][SceneReplicationInterface] Schema baselines older than the peer history are dropped") {
+	Ref<SceneReplicationInterface> replicator = make_replicator();
+	const ObjectID oid = ObjectID(uint64_t(1));
+	const int history = Accessor::get_schema_history_size();
+	int distance = -1;
+
+	const uint16_t first = Accessor::send_schema_state(replicator.ptr(), 2, oid, 1, { 0 }, distance);
+	REQUIRE(Accessor::receive_schema_ack(replicator.ptr(), 2, first, 0) == OK);
+	bool distances_match = true;
+	for (int i = 1; i < history - 1; i++) {
+		const uint16_t seq = Accessor::send_schema_state(replicator.ptr(), 2, oid, 1, { i }, distance);
+		distances_match = distances_match && distance == seq - first;
+	}
+	CHECK(distances_match);
+	CHECK(distance == history - 2);
+
+	// The state could end up in a packet after this one, which would be out of the history kept by the peer.
+	Accessor::send_schema_state(replicator.ptr(), 2, oid, 1, { history }, distance);
+	CHECK(distance == 0);
+	CHECK(Accessor::get_schema_baseline(replicator.ptr(), 2, oid).is_empty());
+
+	// Acks of packets that are no longer in the send history are ignored.
+	Accessor::send_schema_state(replicator.ptr(), 2, oid, 1, { history + 1 }, distance);
+	REQUIRE(Accessor::receive_schema_ack(replicator.ptr(), 2, first, 0) == OK);
+	CHECK(Accessor::get_schema_baseline(replicator.ptr(), 2, oid).is_empty());
+}
+
+} // namespace TestSceneReplicationInterest
@@ -33,6 +33,7 @@
 #include "nav_mesh_generator_3d.h"
 
 #include "core/os/mutex.h"
+#include "core/os/os.h"
 #include "scene/main/node.h"
 
 using namespace NavigationDefaults3D;
@@ -1430,6 +1431,19 @@ void GodotNavigationServer3D::physics_process(double p_delta_time) {
 	pm_edge_connection_count = _new_pm_edge_connection_count;
 	pm_edge_free_count = _new_pm_edge_free_count;
 	pm_obstacle_count = _new_pm_obstacle_count;
+
+	const uint64_t ticks_usec = OS::get_singleton()->get_ticks_usec();
+	const uint64_t path_query_stats_usec = ticks_usec - path_query_stats_start_usec;
+	if (path_query_stats_usec >= 1000000) {
+		const uint64_t new_path_query_count = path_query_count.get();
+		const uint64_t new_path_query_time_usec = path_query_time_usec.get();
+		path_query_count.sub(new_path_query_count);
+		path_query_time_usec.sub(new_path_query_time_usec);
+
+		pm_path_queries_per_second = new_path_query_count * 1000000 / path_query_stats_usec;
+		pm_path_query_time_usec = new_path_query_time_usec * 1000000 / path_query_stats_usec;
+		path_query_stats_start_usec = ticks_usec;
+	}
 }
 
 void GodotNavigationServer3D::init() {
@@ -1454,7 +1468,41 @@ void GodotNavigationServer3D::query_path(const Ref<NavigationPathQueryParameters
 	NavMap3D *map = map_owner.get_or_null(p_query_parameters->get_map());
 	ERR_FAIL_NULL(map);
 
+	const uint64_t query_start_usec = OS::get_singleton()->get_ticks_usec();
+
 	NavMeshQueries3D::map_query_path(map, p_query_parameters, p_query_result, p_callback);
+
+	path_query_count.increment();
+	path_query_time_usec.add(OS::get_singleton()->get_ticks_usec() - query_start_usec);
+}
+
+void GodotNavigationServer3D::query_paths(const TypedArray<NavigationPathQueryParameters3D> &p_query_parameters, const TypedArray<NavigationPathQueryResult3D> &p_query_results) {
+	ERR_FAIL_COND_MSG(p_query_parameters.size() != p_query_results.size(), "The number of query parameters and query results must match.");
+
+	const uint64_t query_start_usec = OS::get_singleton()->get_ticks_usec();
+
+	// Queries are grouped by map so each map iteration is only locked once for its queries.
+	HashMap<NavMap3D *, LocalVector<Ref<NavigationPathQueryParameters3D>>> map_query_parameters;
+	HashMap<NavMap3D *, LocalVector<Ref<NavigationPathQueryResult3D>>> map_query_results;
+	for (int i = 0; i < p_query_parameters.size(); i++) {
+		Ref<NavigationPathQueryParameters3D> query_parameters = p_query_parameters[i];
+		Ref<NavigationPathQueryResult3D> query_result = p_query_results[i];
+		ERR_CONTINUE(query_parameters.is_null());
+		ERR_CONTINUE(query_result.is_null());
+
+		NavMap3D *map = map_owner.get_or_null(query_parameters->get_map());
+		ERR_CONTINUE(map == nullptr);
+
+		map_query_parameters[map].push_back(query_parameters);
+		map_query_results[map].push_back(query_result);
+	}
+
+	for (const KeyValue<NavMap3D *, LocalVector<Ref<NavigationPathQueryParameters3D>>> &E : map_query_parameters) {
+		NavMeshQueries3D::map_query_paths(E.key, E.value, map_query_results[E.key]);
+	}
+
+	path_query_count.add(p_query_parameters.size());
+	path_query_time_usec.add(OS::get_singleton()->get_ticks_usec() - query_start_usec);
 }
 
 RID GodotNavigationServer3D::source_geometry_parser_create() {
@@ -1544,6 +1592,12 @@ int GodotNavigationServer3D::get_process_info(ProcessInfo p_info) const {
 		case INFO_OBSTACLE_COUNT: {
 			return pm_obstacle_count;
 		} break;
+		case INFO_PATH_QUERIES_PER_SECOND: {
+			return pm_path_queries_per_second;
+		} break;
+		case INFO_PATH_QUERY_TIME_USEC: {
+			return pm_path_query_time_usec;
+		} break;
 	}
 
 	return 0;
@@ -92,6 +92,13 @@ class GodotNavigationServer3D : public NavigationServer3D {
 	int pm_edge_connection_count = 0;
 	int pm_edge_free_count = 0;
 	int pm_obstacle_count = 0;
+	int pm_path_queries_per_second = 0;
+	int pm_path_query_time_usec = 0;
+
+	// Path queries can run on any thread, they are summed up here and turned into the per second values above.
+	SafeNumeric<uint64_t> path_query_count;
+	SafeNumeric<uint64_t> path_query_time_usec;
+	uint64_t path_query_stats_start_usec = 0;
 
 public:
 	GodotNavigationServer3D();
@@ -293,6 +300,7 @@ public:
 	virtual void finish() override;
 
 	virtual void query_path(const Ref<NavigationPathQueryParameters3D> &p_query_parameters, Ref<NavigationPathQueryResult3D> p_query_result, const Callable &p_callback = Callable()) override;
+	virtual void query_paths(const TypedArray<NavigationPathQueryParameters3D> &p_query_parameters, const TypedArray<NavigationPathQueryResult3D> &p_query_results) override;
 
 	int get_process_info(ProcessInfo p_info) const override;
 
@@ -0,0 +1,100 @@
+/**************************************************************************/
+/*  nav_avoidance_grid_3d.cpp                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "nav_avoidance_grid_3d.h"
+
+bool NavAvoidanceGrid3D::update(const LocalVector<Vector3> &p_positions, real_t p_cell_size, bool p_use_height) {
+	ERR_FAIL_COND_V(p_cell_size <= 0.0, false);
+
+	bool rebuild = cell_size != p_cell_size || use_height != p_use_height || agent_cells.size() != p_positions.size();
+
+	cell_size = p_cell_size;
+	use_height = p_use_height;
+
+	if (rebuild) {
+		agent_cells.resize(p_positions.size());
+	}
+
+	for (uint32_t i = 0; i < p_positions.size(); i++) {
+		const Vector3i cell = _get_cell(p_positions[i]);
+		if (agent_cells[i] != cell) {
+			agent_cells[i] = cell;
+			rebuild = true;
+		}
+	}
+
+	if (rebuild) {
+		_rebuild();
+	}
+	return rebuild;
+}
+
+void NavAvoidanceGrid3D::_rebuild() {
+	cell_indices.clear();
+	cell_offsets.clear();
+
+	// Count the agents per cell, then turn the counts into offsets and place the agents.
+	for (const Vector3i &cell : agent_cells) {
+		uint32_t *cell_index = cell_indices.getptr(cell);
+		if (cell_index) {
+			cell_offsets[*cell_index]++;
+		} else {
+			cell_indices.insert(cell, cell_offsets.size());
+			cell_offsets.push_back(1);
+		}
+	}
+
+	uint32_t offset = 0;
+	for (uint32_t &cell_offset : cell_offsets) {
+		const uint32_t count = cell_offset;
+		cell_offset = offset;
+		offset += count;
+	}
+	cell_offsets.push_back(offset);
+
+	LocalVector<uint32_t> cell_ends;
+	cell_ends.resize(cell_offsets.size() - 1);
+	for (uint32_t i = 0; i < cell_ends.size(); i++) {
+		cell_ends[i] = cell_offsets[i];
+	}
+
+	cell_agents.resize(agent_cells.size());
+	for (uint32_t i = 0; i < agent_cells.size(); i++) {
+		const uint32_t cell_index = cell_indices[agent_cells[i]];
+		cell_agents[cell_ends[cell_index]++] = i;
+	}
+}
+
+void NavAvoidanceGrid3D::clear() {
+	agent_cells.clear();
+	cell_indices.clear();
+	cell_offsets.clear();
+	cell_agents.clear();
+}
@@ -0,0 +1,96 @@
+/**************************************************************************/
+/*  nav_avoidance_grid_3d.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/math/vector3.h"
+#include "core/math/vector3i.h"
+#include "core/templates/a_hash_map.h"
+#include "core/templates/local_vector.h"
+
+// Uniform grid used to find the avoidance neighbors of agents.
+// Agents are referenced by their index in the positions passed to update().
+class NavAvoidanceGrid3D {
+	real_t cell_size = 1.0;
+	bool use_height = true;
+
+	LocalVector<Vector3i> agent_cells;
+
+	// The agents of each cell are stored next to each other, cell_offsets has one more entry than there are cells.
+	AHashMap<Vector3i, uint32_t> cell_indices;
+	LocalVector<uint32_t> cell_offsets;
+	LocalVector<uint32_t> cell_agents;
+
+	_FORCE_INLINE_ Vector3i _get_cell(const Vector3 &p_position) const {
+		const Vector3 cell = (p_position / cell_size).floor();
+		return Vector3i(cell.x, use_height ? cell.y : 0, cell.z);
+	}
+
+	void _rebuild();
+
+public:
+	// Only sorts the agents into cells again when one of them moved to another cell since the last update.
+	// Returns true if the grid was rebuilt.
+	bool update(const LocalVector<Vector3> &p_positions, real_t p_cell_size, bool p_use_height);
+
+	// Calls p_callback with the index of every agent in the cells overlapping the range around p_position.
+	template <typename F>
+	void query(const Vector3 &p_position, real_t p_range, F &&p_callback) const {
+		if (cell_offsets.is_empty()) {
+			return;
+		}
+		const Vector3 range = Vector3(p_range, use_height ? p_range : 0.0, p_range);
+		const Vector3i from = _get_cell(p_position - range);
+		const Vector3i to = _get_cell(p_position + range);
+		// A range much larger than the cells would visit more empty cells than there are agents.
+		const uint64_t cell_count = uint64_t(to.x - from.x + 1) * uint64_t(to.y - from.y + 1) * uint64_t(to.z - from.z + 1);
+		if (cell_count >= cell_agents.size()) {
+			for (uint32_t agent_index : cell_agents) {
+				p_callback(agent_index);
+			}
+			return;
+		}
+		for (int x = from.x; x <= to.x; x++) {
+			for (int y = from.y; y <= to.y; y++) {
+				for (int z = from.z; z <= to.z; z++) {
+					const uint32_t *cell_index = cell_indices.getptr(Vector3i(x, y, z));
+					if (!cell_index) {
+						continue;
+					}
+					for (uint32_t i = cell_offsets[*cell_index]; i < cell_offsets[*cell_index + 1]; i++) {
+						p_callback(cell_agents[i]);
+					}
+				}
+			}
+		}
+	}
+
+	void clear();
+};
@@ -70,6 +70,8 @@ void NavMapBuilder3D::build_navmap_iteration(NavMapIterationBuild3D &r_build) {
 
 	_build_step_navlink_connections(r_build);
 
+	_build_step_cluster_graph(r_build);
+
 	_build_update_map_iteration(r_build);
 }
 
@@ -392,6 +394,146 @@ void NavMapBuilder3D::_build_step_navlink_connections(NavMapIterationBuild3D &r_
 	r_build.polygon_count = polygon_count;
 }
 
+static uint32_t _find_cluster_root(LocalVector<uint32_t> &p_parents, uint32_t p_index) {
+	while (p_parents[p_index] != p_index) {
+		p_parents[p_index] = p_parents[p_parents[p_index]];
+		p_index = p_parents[p_index];
+	}
+	return p_index;
+}
+
+void NavMapBuilder3D::_build_step_cluster_graph(NavMapIterationBuild3D &r_build) {
+	NavMapIteration3D *map_iteration = r_build.map_iteration;
+	NavMapClusterGraph3D &cluster_graph = map_iteration->cluster_graph;
+
+	cluster_graph.clear();
+
+	if (r_build.path_search_cluster_size <= 0.0) {
+		return;
+	}
+
+	// Same order as the polygons of the path query slots.
+	LocalVector<const Polygon *> polygons;
+	polygons.reserve(r_build.polygon_count);
+	for (const Ref<NavRegionIteration3D> &region : map_iteration->region_iterations) {
+		for (const Polygon &polygon : region->navmesh_polygons) {
+			polygons.push_back(&polygon);
+		}
+	}
+	for (const Polygon &polygon : map_iteration->navlink_polygons) {
+		polygons.push_back(&polygon);
+	}
+
+	const uint32_t polygon_count = polygons.size();
+	if (polygon_count == 0) {
+		return;
+	}
+
+	AHashMap<const Polygon *, uint32_t> polygon_ids;
+	polygon_ids.reserve(polygon_count);
+	for (uint32_t i = 0; i < polygon_count; i++) {
+		polygon_ids.insert(polygons[i], i);
+	}
+
+	const Vector3 cluster_cell_size = Vector3(1.0, 1.0, 1.0) * r_build.path_search_cluster_size;
+	LocalVector<Vector3> centers;
+	LocalVector<uint64_t> cell_keys;
+	centers.resize(polygon_count);
+	cell_keys.resize(polygon_count);
+	for (uint32_t i = 0; i < polygon_count; i++) {
+		Vector3 center;
+		for (const Vector3 &vertex : polygons[i]->vertices) {
+			center += vertex;
+		}
+		if (!polygons[i]->vertices.is_empty()) {
+			center /= polygons[i]->vertices.size();
+		}
+		centers[i] = center;
+		cell_keys[i] = get_point_key(center, cluster_cell_size).key;
+	}
+
+	// Every connection a path search can follow, as pairs of polygon ids.
+	LocalVector<Pair<uint32_t, uint32_t>> edges;
+	for (uint32_t i = 0; i < polygon_count; i++) {
+		const Polygon *polygon = polygons[i];
+		const LocalVector<LocalVector<Connection>> &internal_connections = polygon->owner->get_internal_connections();
+		if (polygon->id < internal_connections.size()) {
+			for (const Connection &connection : internal_connections[polygon->id]) {
+				edges.push_back(Pair<uint32_t, uint32_t>(i, polygon_ids[connection.polygon]));
+			}
+		}
+		const LocalVector<LocalVector<Connection>> *external_connections = map_iteration->navbases_polygons_external_connections.getptr(polygon->owner);
+		if (external_connections && polygon->id < external_connections->size()) {
+			for (const Connection &connection : (*external_connections)[polygon->id]) {
+				edges.push_back(Pair<uint32_t, uint32_t>(i, polygon_ids[connection.polygon]));
+			}
+		}
+	}
+
+	// Polygons in the same cell only share a cluster when they are connected within it,
+	// so a wall running through a cell doesn't make the coarse route go through it.
+	LocalVector<uint32_t> parents;
+	parents.resize(polygon_count);
+	for (uint32_t i = 0; i < polygon_count; i++) {
+		parents[i] = i;
+	}
+	for (const Pair<uint32_t, uint32_t> &edge : edges) {
+		if (cell_keys[edge.first] != cell_keys[edge.second]) {
+			continue;
+		}
+		const uint32_t root_a = _find_cluster_root(parents, edge.first);
+		const uint32_t root_b = _find_cluster_root(parents, edge.second);
+		if (root_a != root_b) {
+			parents[MAX(root_a, root_b)] = MIN(root_a, root_b);
+		}
+	}
+
+	LocalVector<uint32_t> root_clusters;
+	root_clusters.resize(polygon_count);
+	LocalVector<uint32_t> cluster_polygon_counts;
+	cluster_graph.polygon_clusters.resize(polygon_count);
+	for (uint32_t i = 0; i < polygon_count; i++) {
+		const uint32_t root = _find_cluster_root(parents, i);
+		if (root == i) {
+			root_clusters[i] = cluster_graph.clusters.size();
+			cluster_graph.clusters.push_back(NavMapClusterGraph3D::Cluster());
+			cluster_polygon_counts.push_back(0);
+		}
+		// Roots always have the lowest index of their set, so they were assigned a cluster already.
+		const uint32_t cluster = root_clusters[root];
+		cluster_graph.polygon_clusters[i] = cluster;
+		cluster_graph.clusters[cluster].position += centers[i];
+		cluster_polygon_counts[cluster]++;
+	}
+	for (uint32_t i = 0; i < cluster_graph.clusters.size(); i++) {
+		cluster_graph.clusters[i].position /= cluster_polygon_counts[i];
+	}
+
+	LocalVector<uint64_t> cluster_links;
+	for (const Pair<uint32_t, uint32_t> &edge : edges) {
+		const uint64_t cluster_a = cluster_graph.polygon_clusters[edge.first];
+		const uint64_t cluster_b = cluster_graph.polygon_clusters[edge.second];
+		if (cluster_a != cluster_b) {
+			cluster_links.push_back((cluster_a << 32) | cluster_b);
+		}
+	}
+	cluster_links.sort();
+
+	uint64_t previous_link = UINT64_MAX;
+	for (uint64_t link : cluster_links) {
+		if (link == previous_link) {
+			continue;
+		}
+		previous_link = link;
+		NavMapClusterGraph3D::Cluster &cluster = cluster_graph.clusters[link >> 32];
+		if (cluster.neighbor_count == 0) {
+			cluster.first_neighbor = cluster_graph.neighbors.size();
+		}
+		cluster.neighbor_count++;
+		cluster_graph.neighbors.push_back(uint32_t(link & UINT32_MAX));
+	}
+}
+
 void NavMapBuilder3D::_build_update_map_iteration(NavMapIterationBuild3D &r_build) {
 	NavMapIteration3D *map_iteration = r_build.map_iteration;
 
@@ -407,6 +549,17 @@ void NavMapBuilder3D::_build_update_map_iteration(NavMapIterationBuild3D &r_buil
 		p_path_query_slot.path_corridor.clear();
 
 		p_path_query_slot.path_corridor.resize(total_polygon_count);
+		for (NavigationPoly &polygon : p_path_query_slot.path_corridor) {
+			polygon.reset();
+		}
+		p_path_query_slot.touched_poly_ids.clear();
+
+		p_path_query_slot.traversable_clusters.clear();
+		p_path_query_slot.cluster_nodes.clear();
+		p_path_query_slot.cluster_nodes.resize(map_iteration->cluster_graph.clusters.size());
+		p_path_query_slot.cluster_corridor.clear();
+		p_path_query_slot.cluster_corridor.resize_initialized(map_iteration->cluster_graph.clusters.size());
+		p_path_query_slot.cluster_search_id = 0;
 
 		p_path_query_slot.poly_to_id.clear();
 		p_path_query_slot.poly_to_id.reserve(total_polygon_count);
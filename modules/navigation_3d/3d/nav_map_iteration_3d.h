@@ -34,6 +34,7 @@
 #include "nav_mesh_queries_3d.h"
 
 #include "core/math/math_defs.h"
+#include "core/os/mutex.h"
 #include "core/os/rw_lock.h"
 #include "core/os/semaphore.h"
 
@@ -47,6 +48,7 @@ struct NavMapIterationBuild3D {
 	bool use_edge_connections = true;
 	real_t edge_connection_margin;
 	real_t link_connection_radius;
+	real_t path_search_cluster_size = 0.0;
 	Nav3D::PerformanceData performance_data;
 	int polygon_count = 0;
 	int free_edge_count = 0;
@@ -70,6 +72,37 @@ struct NavMapIterationBuild3D {
 	}
 };
 
+// Coarse graph over clusters of connected polygons that share a cell of the cluster grid. Long path queries are first
+// routed from cluster to cluster, and the polygon search then only visits the clusters along that route.
+struct NavMapClusterGraph3D {
+	struct Cluster {
+		Vector3 position;
+		uint32_t first_neighbor = 0;
+		uint32_t neighbor_count = 0;
+	};
+
+	LocalVector<Cluster> clusters;
+	// The neighbors of each cluster are stored next to each other.
+	LocalVector<uint32_t> neighbors;
+	// Indexed like the polygons of the path query slots.
+	LocalVector<uint32_t> polygon_clusters;
+
+	// Routes of previous queries keyed by their begin and end clusters. They only depend on the graph,
+	// so they stay valid as long as the map iteration does.
+	mutable HashMap<uint64_t, LocalVector<uint32_t>> route_cache;
+	mutable Mutex route_cache_mutex;
+
+	bool is_empty() const { return clusters.is_empty(); }
+
+	void clear() {
+		clusters.clear();
+		neighbors.clear();
+		polygon_clusters.clear();
+		MutexLock lock(route_cache_mutex);
+		route_cache.clear();
+	}
+};
+
 struct NavMapIteration3D {
 	mutable SafeNumeric<uint32_t> users;
 	RWLock rwlock;
@@ -89,6 +122,8 @@ struct NavMapIteration3D {
 
 	HashMap<NavRegion3D *, Ref<NavRegionIteration3D>> region_ptr_to_region_iteration;
 
+	NavMapClusterGraph3D cluster_graph;
+
 	LocalVector<NavMeshQueries3D::PathQuerySlot> path_query_slots;
 	Mutex path_query_slots_mutex;
 	Semaphore path_query_slots_semaphore;
@@ -103,6 +138,7 @@ struct NavMapIteration3D {
 		navbases_polygons_external_connections.clear();
 		navlink_polygons.clear();
 		region_ptr_to_region_iteration.clear();
+		cluster_graph.clear();
 	}
 };
 
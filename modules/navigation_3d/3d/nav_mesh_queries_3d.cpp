@@ -145,18 +145,12 @@ void NavMeshQueries3D::_query_task_push_back_point_with_metadata(NavMeshPathQuer
 	p_query_task.path_points.push_back(p_point);
 }
 
-void NavMeshQueries3D::map_query_path(NavMap3D *map, const Ref<NavigationPathQueryParameters3D> &p_query_parameters, Ref<NavigationPathQueryResult3D> p_query_result, const Callable &p_callback) {
-	ERR_FAIL_NULL(map);
-	ERR_FAIL_COND(p_query_parameters.is_null());
-	ERR_FAIL_COND(p_query_result.is_null());
-
+void NavMeshQueries3D::_query_task_setup(NavMeshPathQueryTask3D &r_query_task, const Ref<NavigationPathQueryParameters3D> &p_query_parameters) {
 	using namespace NavigationDefaults3D;
 
-	NavMeshQueries3D::NavMeshPathQueryTask3D query_task;
-	query_task.start_position = p_query_parameters->get_start_position();
-	query_task.target_position = p_query_parameters->get_target_position();
-	query_task.navigation_layers = p_query_parameters->get_navigation_layers();
-	query_task.callback = p_callback;
+	r_query_task.start_position = p_query_parameters->get_start_position();
+	r_query_task.target_position = p_query_parameters->get_target_position();
+	r_query_task.navigation_layers = p_query_parameters->get_navigation_layers();
 
 	const TypedArray<RID> &_excluded_regions = p_query_parameters->get_excluded_regions();
 	const TypedArray<RID> &_included_regions = p_query_parameters->get_included_regions();
@@ -164,66 +158,80 @@ void NavMeshQueries3D::map_query_path(NavMap3D *map, const Ref<NavigationPathQue
 	uint32_t _excluded_region_count = _excluded_regions.size();
 	uint32_t _included_region_count = _included_regions.size();
 
-	query_task.exclude_regions = _excluded_region_count > 0;
-	query_task.include_regions = _included_region_count > 0;
+	r_query_task.exclude_regions = _excluded_region_count > 0;
+	r_query_task.include_regions = _included_region_count > 0;
 
-	if (query_task.exclude_regions) {
-		query_task.excluded_regions.resize(_excluded_region_count);
+	if (r_query_task.exclude_regions) {
+		r_query_task.excluded_regions.resize(_excluded_region_count);
 		for (uint32_t i = 0; i < _excluded_region_count; i++) {
-			query_task.excluded_regions[i] = _excluded_regions[i];
+			r_query_task.excluded_regions[i] = _excluded_regions[i];
 		}
 	}
 
-	if (query_task.include_regions) {
-		query_task.included_regions.resize(_included_region_count);
+	if (r_query_task.include_regions) {
+		r_query_task.included_regions.resize(_included_region_count);
 		for (uint32_t i = 0; i < _included_region_count; i++) {
-			query_task.included_regions[i] = _included_regions[i];
+			r_query_task.included_regions[i] = _included_regions[i];
 		}
 	}
 
 	switch (p_query_parameters->get_pathfinding_algorithm()) {
 		case NavigationPathQueryParameters3D::PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR: {
-			query_task.pathfinding_algorithm = PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR;
+			r_query_task.pathfinding_algorithm = PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR;
 		} break;
 		default: {
 			WARN_PRINT("No match for used PathfindingAlgorithm - fallback to default");
-			query_task.pathfinding_algorithm = PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR;
+			r_query_task.pathfinding_algorithm = PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR;
 		} break;
 	}
 
 	switch (p_query_parameters->get_path_postprocessing()) {
 		case NavigationPathQueryParameters3D::PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL: {
-			query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL;
+			r_query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL;
 		} break;
 		case NavigationPathQueryParameters3D::PathPostProcessing::PATH_POSTPROCESSING_EDGECENTERED: {
-			query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_EDGECENTERED;
+			r_query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_EDGECENTERED;
 		} break;
 		case NavigationPathQueryParameters3D::PathPostProcessing::PATH_POSTPROCESSING_NONE: {
-			query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_NONE;
+			r_query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_NONE;
 		} break;
 		default: {
 			WARN_PRINT("No match for used PathPostProcessing - fallback to default");
-			query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL;
+			r_query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL;
 		} break;
 	}
 
-	query_task.metadata_flags = (int64_t)p_query_parameters->get_metadata_flags();
-	query_task.simplify_path = p_query_parameters->get_simplify_path();
-	query_task.simplify_epsilon = p_query_parameters->get_simplify_epsilon();
-	query_task.path_return_max_length = p_query_parameters->get_path_return_max_length();
-	query_task.path_return_max_radius = p_query_parameters->get_path_return_max_radius();
-	query_task.path_search_max_polygons = p_query_parameters->get_path_search_max_polygons();
-	query_task.path_search_max_distance = p_query_parameters->get_path_search_max_distance();
-	query_task.status = NavMeshPathQueryTask3D::TaskStatus::QUERY_STARTED;
+	r_query_task.metadata_flags = (int64_t)p_query_parameters->get_metadata_flags();
+	r_query_task.simplify_path = p_query_parameters->get_simplify_path();
+	r_query_task.simplify_epsilon = p_query_parameters->get_simplify_epsilon();
+	r_query_task.path_return_max_length = p_query_parameters->get_path_return_max_length();
+	r_query_task.path_return_max_radius = p_query_parameters->get_path_return_max_radius();
+	r_query_task.path_search_max_polygons = p_query_parameters->get_path_search_max_polygons();
+	r_query_task.path_search_max_distance = p_query_parameters->get_path_search_max_distance();
+	r_query_task.status = NavMeshPathQueryTask3D::TaskStatus::QUERY_STARTED;
+}
+
+void NavMeshQueries3D::_query_task_write_result(const NavMeshPathQueryTask3D &p_query_task, Ref<NavigationPathQueryResult3D> p_query_result) {
+	p_query_result->set_data(
+			p_query_task.path_points,
+			p_query_task.path_meta_point_types,
+			p_query_task.path_meta_point_rids,
+			p_query_task.path_meta_point_owners);
+	p_query_result->set_path_length(p_query_task.path_length);
+}
+
+void NavMeshQueries3D::map_query_path(NavMap3D *map, const Ref<NavigationPathQueryParameters3D> &p_query_parameters, Ref<NavigationPathQueryResult3D> p_query_result, const Callable &p_callback) {
+	ERR_FAIL_NULL(map);
+	ERR_FAIL_COND(p_query_parameters.is_null());
+	ERR_FAIL_COND(p_query_result.is_null());
+
+	NavMeshQueries3D::NavMeshPathQueryTask3D query_task;
+	_query_task_setup(query_task, p_query_parameters);
+	query_task.callback = p_callback;
 
 	map->query_path(query_task);
 
-	p_query_result->set_data(
-			query_task.path_points,
-			query_task.path_meta_point_types,
-			query_task.path_meta_point_rids,
-			query_task.path_meta_point_owners);
-	p_query_result->set_path_length(query_task.path_length);
+	_query_task_write_result(query_task, p_query_result);
 
 	if (query_task.callback.is_valid()) {
 		if (emit_callback(query_task.callback)) {
@@ -234,6 +242,23 @@ void NavMeshQueries3D::map_query_path(NavMap3D *map, const Ref<NavigationPathQue
 	}
 }
 
+void NavMeshQueries3D::map_query_paths(NavMap3D *map, const LocalVector<Ref<NavigationPathQueryParameters3D>> &p_query_parameters, const LocalVector<Ref<NavigationPathQueryResult3D>> &p_query_results) {
+	ERR_FAIL_NULL(map);
+	ERR_FAIL_COND(p_query_parameters.size() != p_query_results.size());
+
+	LocalVector<NavMeshQueries3D::NavMeshPathQueryTask3D> query_tasks;
+	query_tasks.resize(p_query_parameters.size());
+	for (uint32_t i = 0; i < query_tasks.size(); i++) {
+		_query_task_setup(query_tasks[i], p_query_parameters[i]);
+	}
+
+	map->query_paths(query_tasks.ptr(), query_tasks.size());
+
+	for (uint32_t i = 0; i < query_tasks.size(); i++) {
+		_query_task_write_result(query_tasks[i], p_query_results[i]);
+	}
+}
+
 void NavMeshQueries3D::_query_task_find_start_end_positions(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration) {
 	real_t begin_d = FLT_MAX;
 	real_t end_d = FLT_MAX;
@@ -293,9 +318,20 @@ void NavMeshQueries3D::_query_task_search_polygon_connections(NavMeshPathQueryTa
 	Vector3 new_entry = Geometry3D::get_closest_point_to_segment(p_least_cost_poly.entry, p_connection.pathway_start, p_connection.pathway_end);
 	real_t new_traveled_distance = p_least_cost_poly.entry.distance_to(new_entry) * poly_travel_cost + p_poly_enter_cost + p_least_cost_poly.traveled_distance;
 
+	const uint32_t neighbor_poly_id = p_query_task.path_query_slot->poly_to_id[p_connection.polygon];
+
+	// Stay inside the corridor of the coarse cluster route, if there is one.
+	if (p_query_task.use_cluster_corridor && p_query_task.path_query_slot->cluster_corridor[(*p_query_task.polygon_clusters)[neighbor_poly_id]] != p_query_task.path_query_slot->cluster_search_id) {
+		return;
+	}
+
 	// Check if the neighbor polygon has already been processed.
-	NavigationPoly &neighbor_poly = navigation_polys[p_query_task.path_query_slot->poly_to_id[p_connection.polygon]];
+	NavigationPoly &neighbor_poly = navigation_polys[neighbor_poly_id];
 	if (new_traveled_distance < neighbor_poly.traveled_distance) {
+		if (neighbor_poly.poly == nullptr) {
+			p_query_task.path_query_slot->touched_poly_ids.push_back(neighbor_poly_id);
+		}
+
 		// Add the polygon to the heap of polygons to traverse next.
 		neighbor_poly.back_navigation_poly_id = p_least_cost_id;
 		neighbor_poly.back_navigation_edge = p_connection.edge;
@@ -328,10 +364,14 @@ void NavMeshQueries3D::_query_task_build_path_corridor(NavMeshPathQueryTask3D &p
 			&traversable_polys = p_query_task.path_query_slot->traversable_polys;
 	traversable_polys.clear();
 
+	// Only the polygons reached by the previous search need to be reset.
 	LocalVector<NavigationPoly> &navigation_polys = p_query_task.path_query_slot->path_corridor;
-	for (NavigationPoly &polygon : navigation_polys) {
-		polygon.reset();
+	LocalVector<uint32_t> &touched_poly_ids = p_query_task.path_query_slot->touched_poly_ids;
+	for (uint32_t touched_poly_id : touched_poly_ids) {
+		navigation_polys[touched_poly_id].reset();
 	}
+	touched_poly_ids.clear();
+	touched_poly_ids.push_back(p_query_task.path_query_slot->poly_to_id[begin_poly]);
 
 	// Initialize the matching navigation polygon.
 	NavigationPoly &begin_navigation_poly = navigation_polys[p_query_task.path_query_slot->poly_to_id[begin_poly]];
@@ -446,9 +486,9 @@ void NavMeshQueries3D::_query_task_build_path_corridor(NavMeshPathQueryTask3D &p
 				return;
 			}
 
-			for (NavigationPoly &nav_poly : navigation_polys) {
-				nav_poly.poly = nullptr;
-				nav_poly.traveled_distance = FLT_MAX;
+			for (uint32_t touched_poly_id : touched_poly_ids) {
+				navigation_polys[touched_poly_id].poly = nullptr;
+				navigation_polys[touched_poly_id].traveled_distance = FLT_MAX;
 			}
 			uint32_t _bp_id = p_query_task.path_query_slot->poly_to_id[begin_poly];
 			navigation_polys[_bp_id].poly = begin_poly;
@@ -511,6 +551,139 @@ void NavMeshQueries3D::_query_task_build_path_corridor(NavMeshPathQueryTask3D &p
 	}
 }
 
+bool NavMeshQueries3D::_query_task_mark_cluster_corridor(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration) {
+	const NavMapClusterGraph3D &cluster_graph = p_map_iteration.cluster_graph;
+	if (cluster_graph.is_empty()) {
+		return false;
+	}
+
+	PathQuerySlot *path_query_slot = p_query_task.path_query_slot;
+	const uint32_t begin_cluster = cluster_graph.polygon_clusters[path_query_slot->poly_to_id[p_query_task.begin_polygon]];
+	const uint32_t end_cluster = cluster_graph.polygon_clusters[path_query_slot->poly_to_id[p_query_task.end_polygon]];
+	if (begin_cluster == end_cluster) {
+		return false;
+	}
+
+	// Neighboring clusters would end up with a corridor that is not any smaller than the regular search.
+	const NavMapClusterGraph3D::Cluster &begin = cluster_graph.clusters[begin_cluster];
+	for (uint32_t i = begin.first_neighbor; i < begin.first_neighbor + begin.neighbor_count; i++) {
+		if (cluster_graph.neighbors[i] == end_cluster) {
+			return false;
+		}
+	}
+
+	path_query_slot->cluster_search_id++;
+	if (path_query_slot->cluster_search_id == 0) {
+		// Stamps wrapped around, clear the old ones so they can't match again.
+		for (ClusterSearchNode &node : path_query_slot->cluster_nodes) {
+			node.search_id = 0;
+		}
+		for (uint32_t &cluster_stamp : path_query_slot->cluster_corridor) {
+			cluster_stamp = 0;
+		}
+		path_query_slot->cluster_search_id = 1;
+	}
+	const uint32_t search_id = path_query_slot->cluster_search_id;
+
+	const uint64_t route_key = (uint64_t(begin_cluster) << 32) | end_cluster;
+	LocalVector<uint32_t> route;
+	bool route_cached = false;
+	{
+		MutexLock lock(cluster_graph.route_cache_mutex);
+		const LocalVector<uint32_t> *cached_route = cluster_graph.route_cache.getptr(route_key);
+		if (cached_route) {
+			route = *cached_route;
+			route_cached = true;
+		}
+	}
+
+	if (!route_cached) {
+		// A* over the cluster graph, the cost of a step is the distance between the cluster positions.
+		LocalVector<ClusterSearchNode> &cluster_nodes = path_query_slot->cluster_nodes;
+		Heap<ClusterSearchNode *, ClusterSearchCostGreaterThan, ClusterSearchHeapIndexer> &traversable_clusters = path_query_slot->traversable_clusters;
+		traversable_clusters.clear();
+
+		const Vector3 &end_position = cluster_graph.clusters[end_cluster].position;
+
+		ClusterSearchNode &begin_node = cluster_nodes[begin_cluster];
+		begin_node.search_id = search_id;
+		begin_node.back_cluster = UINT32_MAX;
+		begin_node.traveled_distance = 0.0;
+		begin_node.distance_to_destination = begin.position.distance_to(end_position);
+		traversable_clusters.push(&begin_node);
+
+		bool found_route = false;
+		while (!traversable_clusters.is_empty()) {
+			const ClusterSearchNode *least_cost_node = traversable_clusters.pop();
+			const uint32_t least_cost_cluster = least_cost_node - cluster_nodes.ptr();
+			if (least_cost_cluster == end_cluster) {
+				found_route = true;
+				break;
+			}
+
+			const NavMapClusterGraph3D::Cluster &cluster = cluster_graph.clusters[least_cost_cluster];
+			for (uint32_t i = cluster.first_neighbor; i < cluster.first_neighbor + cluster.neighbor_count; i++) {
+				const uint32_t neighbor_cluster = cluster_graph.neighbors[i];
+				const Vector3 &neighbor_position = cluster_graph.clusters[neighbor_cluster].position;
+				const real_t traveled_distance = least_cost_node->traveled_distance + cluster.position.distance_to(neighbor_position);
+
+				ClusterSearchNode &neighbor_node = cluster_nodes[neighbor_cluster];
+				if (neighbor_node.search_id != search_id) {
+					neighbor_node.search_id = search_id;
+					neighbor_node.heap_index = traversable_clusters.INVALID_INDEX;
+					neighbor_node.traveled_distance = FLT_MAX;
+					neighbor_node.distance_to_destination = neighbor_position.distance_to(end_position);
+				}
+				if (traveled_distance >= neighbor_node.traveled_distance) {
+					continue;
+				}
+
+				neighbor_node.back_cluster = least_cost_cluster;
+				neighbor_node.traveled_distance = traveled_distance;
+				if (neighbor_node.heap_index != traversable_clusters.INVALID_INDEX) {
+					traversable_clusters.shift(neighbor_node.heap_index);
+				} else {
+					traversable_clusters.push(&neighbor_node);
+				}
+			}
+		}
+		traversable_clusters.clear();
+
+		if (found_route) {
+			for (uint32_t cluster = end_cluster; cluster != UINT32_MAX; cluster = cluster_nodes[cluster].back_cluster) {
+				route.push_back(cluster);
+			}
+		}
+
+		// Unreachable destinations are cached as well, as an empty route.
+		MutexLock lock(cluster_graph.route_cache_mutex);
+		if (cluster_graph.route_cache.size() >= 1024) {
+			cluster_graph.route_cache.clear();
+		}
+		cluster_graph.route_cache.insert(route_key, route);
+	}
+
+	if (route.is_empty()) {
+		// Let the regular search find the closest reachable polygon instead.
+		return false;
+	}
+
+	// The corridor also includes the neighbors of every cluster on the route so the polygon search
+	// has some room to find a shorter path than the one through the cluster positions.
+	LocalVector<uint32_t> &cluster_corridor = path_query_slot->cluster_corridor;
+	for (uint32_t route_cluster : route) {
+		cluster_corridor[route_cluster] = search_id;
+		const NavMapClusterGraph3D::Cluster &cluster = cluster_graph.clusters[route_cluster];
+		for (uint32_t i = cluster.first_neighbor; i < cluster.first_neighbor + cluster.neighbor_count; i++) {
+			cluster_corridor[cluster_graph.neighbors[i]] = search_id;
+		}
+	}
+
+	p_query_task.use_cluster_corridor = true;
+	p_query_task.polygon_clusters = &cluster_graph.polygon_clusters;
+	return true;
+}
+
 void NavMeshQueries3D::query_task_map_iteration_get_path(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration) {
 	p_query_task.path_clear();
 
@@ -530,8 +703,32 @@ void NavMeshQueries3D::query_task_map_iteration_get_path(NavMeshPathQueryTask3D
 		return;
 	}
 
+	const Polygon *begin_polygon = p_query_task.begin_polygon;
+	const Polygon *end_polygon = p_query_task.end_polygon;
+	const Vector3 begin_position = p_query_task.begin_position;
+	const Vector3 end_position = p_query_task.end_position;
+
+	p_query_task.use_cluster_corridor = false;
+	_query_task_mark_cluster_corridor(p_query_task, p_map_iteration);
+
 	_query_task_build_path_corridor(p_query_task, p_map_iteration);
 
+	if (p_query_task.use_cluster_corridor) {
+		p_query_task.use_cluster_corridor = false;
+
+		// The corridor didn't lead to the end polygon, search the whole map instead.
+		if (p_query_task.status == NavMeshPathQueryTask3D::TaskStatus::QUERY_FINISHED || p_query_task.status == NavMeshPathQueryTask3D::TaskStatus::QUERY_FAILED || p_query_task.end_polygon != end_polygon) {
+			p_query_task.path_clear();
+			p_query_task.begin_polygon = begin_polygon;
+			p_query_task.end_polygon = end_polygon;
+			p_query_task.begin_position = begin_position;
+			p_query_task.end_position = end_position;
+			p_query_task.status = NavMeshPathQueryTask3D::TaskStatus::QUERY_STARTED;
+
+			_query_task_build_path_corridor(p_query_task, p_map_iteration);
+		}
+	}
+
 	if (p_query_task.status == NavMeshPathQueryTask3D::TaskStatus::QUERY_FINISHED || p_query_task.status == NavMeshPathQueryTask3D::TaskStatus::QUERY_FAILED) {
 		_query_task_process_path_result_limits(p_query_task);
 		return;
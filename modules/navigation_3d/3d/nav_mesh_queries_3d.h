@@ -52,6 +52,15 @@ public:
 		bool in_use = false;
 		uint32_t slot_index = 0;
 		AHashMap<const Nav3D::Polygon *, uint32_t> poly_to_id;
+		// Polygons the last search wrote to, so the next one only has to reset those.
+		LocalVector<uint32_t> touched_poly_ids;
+
+		// Coarse search over the map's polygon clusters, see NavMapClusterGraph3D.
+		LocalVector<Nav3D::ClusterSearchNode> cluster_nodes;
+		Heap<Nav3D::ClusterSearchNode *, Nav3D::ClusterSearchCostGreaterThan, Nav3D::ClusterSearchHeapIndexer> traversable_clusters;
+		// Clusters the polygon search is restricted to are marked with the current search id.
+		LocalVector<uint32_t> cluster_corridor;
+		uint32_t cluster_search_id = 0;
 	};
 
 	struct NavMeshPathQueryTask3D {
@@ -95,6 +104,10 @@ public:
 		NavMap3D *map = nullptr;
 		PathQuerySlot *path_query_slot = nullptr;
 
+		// Set while the polygon search only visits the clusters along a coarse route.
+		bool use_cluster_corridor = false;
+		const LocalVector<uint32_t> *polygon_clusters = nullptr;
+
 		// Path points.
 		LocalVector<Vector3> path_points;
 		LocalVector<int32_t> path_meta_point_types;
@@ -140,10 +153,14 @@ public:
 	static Vector3 map_iteration_get_random_point(const NavMapIteration3D &p_map_iteration, uint32_t p_navigation_layers, bool p_uniformly);
 
 	static void map_query_path(NavMap3D *map, const Ref<NavigationPathQueryParameters3D> &p_query_parameters, Ref<NavigationPathQueryResult3D> p_query_result, const Callable &p_callback);
+	static void map_query_paths(NavMap3D *map, const LocalVector<Ref<NavigationPathQueryParameters3D>> &p_query_parameters, const LocalVector<Ref<NavigationPathQueryResult3D>> &p_query_results);
 
+	static void _query_task_setup(NavMeshPathQueryTask3D &r_query_task, const Ref<NavigationPathQueryParameters3D> &p_query_parameters);
+	static void _query_task_write_result(const NavMeshPathQueryTask3D &p_query_task, Ref<NavigationPathQueryResult3D> p_query_result);
 	static void query_task_map_iteration_get_path(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration);
 	static void _query_task_push_back_point_with_metadata(NavMeshPathQueryTask3D &p_query_task, const Vector3 &p_point, const Nav3D::Polygon *p_point_polygon);
 	static void _query_task_find_start_end_positions(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration);
+	static bool _query_task_mark_cluster_corridor(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration);
 	static void _query_task_build_path_corridor(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration);
 	static void _query_task_post_process_corridorfunnel(NavMeshPathQueryTask3D &p_query_task);
 	static void _query_task_post_process_edgecentered(NavMeshPathQueryTask3D &p_query_task);
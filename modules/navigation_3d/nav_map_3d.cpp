@@ -144,41 +144,105 @@ PointKey NavMap3D::get_point_key(const Vector3 &p_pos) const {
 	return p;
 }
 
-void NavMap3D::query_path(NavMeshQueries3D::NavMeshPathQueryTask3D &p_query_task) {
-	if (iteration_id == 0) {
-		return;
-	}
+NavMeshQueries3D::PathQuerySlot *NavMap3D::_acquire_path_query_slot(NavMapIteration3D &p_map_iteration) {
+	p_map_iteration.path_query_slots_semaphore.wait();
 
-	GET_MAP_ITERATION();
+	NavMeshQueries3D::PathQuerySlot *path_query_slot = nullptr;
 
-	map_iteration.path_query_slots_semaphore.wait();
-
-	map_iteration.path_query_slots_mutex.lock();
-	for (NavMeshQueries3D::PathQuerySlot &p_path_query_slot : map_iteration.path_query_slots) {
+	p_map_iteration.path_query_slots_mutex.lock();
+	for (NavMeshQueries3D::PathQuerySlot &p_path_query_slot : p_map_iteration.path_query_slots) {
 		if (!p_path_query_slot.in_use) {
 			p_path_query_slot.in_use = true;
-			p_query_task.path_query_slot = &p_path_query_slot;
+			path_query_slot = &p_path_query_slot;
 			break;
 		}
 	}
-	map_iteration.path_query_slots_mutex.unlock();
+	p_map_iteration.path_query_slots_mutex.unlock();
+
+	if (path_query_slot == nullptr) {
+		p_map_iteration.path_query_slots_semaphore.post();
+		ERR_FAIL_NULL_V_MSG(path_query_slot, nullptr, "No unused NavMap3D path query slot found! This should never happen :(.");
+	}
+
+	return path_query_slot;
+}
+
+void NavMap3D::_release_path_query_slot(NavMapIteration3D &p_map_iteration, NavMeshQueries3D::PathQuerySlot *p_path_query_slot) {
+	p_map_iteration.path_query_slots_mutex.lock();
+	p_map_iteration.path_query_slots[p_path_query_slot->slot_index].in_use = false;
+	p_map_iteration.path_query_slots_mutex.unlock();
+
+	p_map_iteration.path_query_slots_semaphore.post();
+}
+
+void NavMap3D::query_path(NavMeshQueries3D::NavMeshPathQueryTask3D &p_query_task) {
+	if (iteration_id == 0) {
+		return;
+	}
 
+	GET_MAP_ITERATION();
+
+	p_query_task.path_query_slot = _acquire_path_query_slot(map_iteration);
 	if (p_query_task.path_query_slot == nullptr) {
-		map_iteration.path_query_slots_semaphore.post();
-		ERR_FAIL_NULL_MSG(p_query_task.path_query_slot, "No unused NavMap3D path query slot found! This should never happen :(.");
+		return;
 	}
 
 	p_query_task.map_up = map_iteration.map_up;
 
 	NavMeshQueries3D::query_task_map_iteration_get_path(p_query_task, map_iteration);
 
-	map_iteration.path_query_slots_mutex.lock();
-	uint32_t used_slot_index = p_query_task.path_query_slot->slot_index;
-	map_iteration.path_query_slots[used_slot_index].in_use = false;
+	_release_path_query_slot(map_iteration, p_query_task.path_query_slot);
 	p_query_task.path_query_slot = nullptr;
-	map_iteration.path_query_slots_mutex.unlock();
+}
+
+void NavMap3D::query_paths(NavMeshQueries3D::NavMeshPathQueryTask3D *p_query_tasks, uint32_t p_query_task_count) {
+	if (iteration_id == 0 || p_query_task_count == 0) {
+		return;
+	}
+
+	GET_MAP_ITERATION();
+
+	PathQueryBatch batch;
+	batch.map_iteration = &map_iteration;
+	batch.query_tasks = p_query_tasks;
+	batch.query_task_count = p_query_task_count;
+
+	// Every worker holds on to one path query slot, and with it the search heap and polygon buffers,
+	// for all the queries it takes from the batch.
+	const uint32_t worker_count = MIN(p_query_task_count, map_iteration.path_query_slots.size());
+	if (worker_count <= 1) {
+		_query_paths_batch_worker(0, &batch);
+		return;
+	}
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap3D::_query_paths_batch_worker, &batch, worker_count, worker_count, true, SNAME("NavMapQueryPaths3D"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
+void NavMap3D::_query_paths_batch_worker(uint32_t p_worker_index, PathQueryBatch *p_batch) {
+	NavMapIteration3D &map_iteration = *p_batch->map_iteration;
+
+	NavMeshQueries3D::PathQuerySlot *path_query_slot = _acquire_path_query_slot(map_iteration);
+	if (path_query_slot == nullptr) {
+		return;
+	}
+
+	while (true) {
+		const uint32_t query_task_index = p_batch->next_query_task.postincrement();
+		if (query_task_index >= p_batch->query_task_count) {
+			break;
+		}
+
+		NavMeshQueries3D::NavMeshPathQueryTask3D &query_task = p_batch->query_tasks[query_task_index];
+		query_task.path_query_slot = path_query_slot;
+		query_task.map_up = map_iteration.map_up;
 
-	map_iteration.path_query_slots_semaphore.post();
+		NavMeshQueries3D::query_task_map_iteration_get_path(query_task, map_iteration);
+
+		query_task.path_query_slot = nullptr;
+	}
+
+	_release_path_query_slot(map_iteration, path_query_slot);
 }
 
 Vector3 NavMap3D::get_closest_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) const {
@@ -369,6 +433,7 @@ void NavMap3D::_build_iteration() {
 	iteration_build.use_edge_connections = get_use_edge_connections();
 	iteration_build.edge_connection_margin = get_edge_connection_margin();
 	iteration_build.link_connection_radius = get_link_connection_radius();
+	iteration_build.path_search_cluster_size = path_search_cluster_size;
 
 	next_map_iteration.clear();
 
@@ -563,80 +628,126 @@ void NavMap3D::_update_rvo_obstacles_tree_2d() {
 	rvo_simulation_2d.kdTree_->buildObstacleTree(raw_obstacles);
 }
 
-void NavMap3D::_update_rvo_agents_tree_2d() {
-	// Cannot use LocalVector here as RVO library expects std::vector to build KdTree.
-	std::vector<RVO2D::Agent2D *> raw_agents;
-	raw_agents.reserve(active_2d_avoidance_agents.size());
-	for (NavAgent3D *agent : active_2d_avoidance_agents) {
-		raw_agents.push_back(agent->get_rvo_agent_2d());
+void NavMap3D::_update_rvo_simulation() {
+	if (obstacles_dirty) {
+		_update_rvo_obstacles_tree_2d();
 	}
-	rvo_simulation_2d.kdTree_->buildAgentTree(raw_agents);
 }
 
-void NavMap3D::_update_rvo_agents_tree_3d() {
-	// Cannot use LocalVector here as RVO library expects std::vector to build KdTree.
-	std::vector<RVO3D::Agent3D *> raw_agents;
-	raw_agents.reserve(active_3d_avoidance_agents.size());
-	for (NavAgent3D *agent : active_3d_avoidance_agents) {
-		raw_agents.push_back(agent->get_rvo_agent_3d());
+void NavMap3D::_update_avoidance_grid_2d() {
+	avoidance_positions.resize(active_2d_avoidance_agents.size());
+	real_t neighbor_distance_sum = 0.0;
+	for (uint32_t i = 0; i < active_2d_avoidance_agents.size(); i++) {
+		const RVO2D::Agent2D *rvo_agent = active_2d_avoidance_agents[i]->get_rvo_agent_2d();
+		avoidance_positions[i] = Vector3(rvo_agent->position_.x(), 0.0, rvo_agent->position_.y());
+		neighbor_distance_sum += rvo_agent->neighborDist_;
 	}
-	rvo_simulation_3d.kdTree_->buildAgentTree(raw_agents);
+	avoidance_grid_2d.update(avoidance_positions, _get_avoidance_grid_cell_size(neighbor_distance_sum, active_2d_avoidance_agents.size()), false);
 }
 
-void NavMap3D::_update_rvo_simulation() {
-	if (obstacles_dirty) {
-		_update_rvo_obstacles_tree_2d();
-	}
-	if (agents_dirty) {
-		_update_rvo_agents_tree_2d();
-		_update_rvo_agents_tree_3d();
+void NavMap3D::_update_avoidance_grid_3d() {
+	avoidance_positions.resize(active_3d_avoidance_agents.size());
+	real_t neighbor_distance_sum = 0.0;
+	for (uint32_t i = 0; i < active_3d_avoidance_agents.size(); i++) {
+		const RVO3D::Agent3D *rvo_agent = active_3d_avoidance_agents[i]->get_rvo_agent_3d();
+		avoidance_positions[i] = Vector3(rvo_agent->position_.x(), rvo_agent->position_.y(), rvo_agent->position_.z());
+		neighbor_distance_sum += rvo_agent->neighborDist_;
 	}
+	avoidance_grid_3d.update(avoidance_positions, _get_avoidance_grid_cell_size(neighbor_distance_sum, active_3d_avoidance_agents.size()), true);
+}
+
+real_t NavMap3D::_get_avoidance_grid_cell_size(real_t p_neighbor_distance_sum, uint32_t p_agent_count) {
+	// Agents usually share similar neighbor distances, so the average keeps the query of most agents
+	// within the 3x3(x3) cells around them. Snapped so small changes don't rebuild the grid.
+	const real_t cell_size = Math::snapped(p_neighbor_distance_sum / MAX(p_agent_count, 1u), real_t(0.5));
+	return MAX(cell_size, real_t(0.5));
 }
 
-void NavMap3D::compute_single_avoidance_step_2d(uint32_t index, NavAgent3D **agent) {
-	(*(agent + index))->get_rvo_agent_2d()->computeNeighbors(&rvo_simulation_2d);
-	(*(agent + index))->get_rvo_agent_2d()->computeNewVelocity(&rvo_simulation_2d);
-	(*(agent + index))->get_rvo_agent_2d()->update(&rvo_simulation_2d);
-	(*(agent + index))->update();
+void NavMap3D::compute_avoidance_velocities_2d(uint32_t p_chunk_index, NavAgent3D **p_agents) {
+	const uint32_t from = p_chunk_index * AVOIDANCE_AGENTS_PER_TASK;
+	const uint32_t to = MIN(from + AVOIDANCE_AGENTS_PER_TASK, active_2d_avoidance_agents.size());
+	for (uint32_t i = from; i < to; i++) {
+		RVO2D::Agent2D *rvo_agent = p_agents[i]->get_rvo_agent_2d();
+
+		rvo_agent->obstacleNeighbors_.clear();
+		rvo_simulation_2d.kdTree_->computeObstacleNeighbors(rvo_agent, RVO2D::sqr(rvo_agent->timeHorizonObst_ * rvo_agent->maxSpeed_ + rvo_agent->radius_));
+
+		rvo_agent->agentNeighbors_.clear();
+		if (rvo_agent->maxNeighbors_ > 0) {
+			float range_sq = rvo_agent->neighborDist_ * rvo_agent->neighborDist_;
+			const Vector3 position = Vector3(rvo_agent->position_.x(), 0.0, rvo_agent->position_.y());
+			avoidance_grid_2d.query(position, rvo_agent->neighborDist_, [&](uint32_t p_agent_index) {
+				rvo_agent->insertAgentNeighbor(p_agents[p_agent_index]->get_rvo_agent_2d(), range_sq);
+			});
+		}
+
+		rvo_agent->computeNewVelocity(&rvo_simulation_2d);
+	}
 }
 
-void NavMap3D::compute_single_avoidance_step_3d(uint32_t index, NavAgent3D **agent) {
-	(*(agent + index))->get_rvo_agent_3d()->computeNeighbors(&rvo_simulation_3d);
-	(*(agent + index))->get_rvo_agent_3d()->computeNewVelocity(&rvo_simulation_3d);
-	(*(agent + index))->get_rvo_agent_3d()->update(&rvo_simulation_3d);
-	(*(agent + index))->update();
+void NavMap3D::compute_avoidance_velocities_3d(uint32_t p_chunk_index, NavAgent3D **p_agents) {
+	const uint32_t from = p_chunk_index * AVOIDANCE_AGENTS_PER_TASK;
+	const uint32_t to = MIN(from + AVOIDANCE_AGENTS_PER_TASK, active_3d_avoidance_agents.size());
+	for (uint32_t i = from; i < to; i++) {
+		RVO3D::Agent3D *rvo_agent = p_agents[i]->get_rvo_agent_3d();
+
+		rvo_agent->agentNeighbors_.clear();
+		if (rvo_agent->maxNeighbors_ > 0) {
+			float range_sq = rvo_agent->neighborDist_ * rvo_agent->neighborDist_;
+			const Vector3 position = Vector3(rvo_agent->position_.x(), rvo_agent->position_.y(), rvo_agent->position_.z());
+			avoidance_grid_3d.query(position, rvo_agent->neighborDist_, [&](uint32_t p_agent_index) {
+				rvo_agent->insertAgentNeighbor(p_agents[p_agent_index]->get_rvo_agent_3d(), range_sq);
+			});
+		}
+
+		rvo_agent->computeNewVelocity(&rvo_simulation_3d);
+	}
 }
 
 void NavMap3D::step(double p_delta_time) {
 	rvo_simulation_2d.setTimeStep(float(p_delta_time));
 	rvo_simulation_3d.setTimeStep(float(p_delta_time));
 
+	const bool use_avoidance_threads = use_threads && avoidance_use_multiple_threads;
+
+	// New velocities are computed for all agents before any agent moves, so the result doesn't depend
+	// on the order the agents are processed in.
 	if (active_2d_avoidance_agents.size() > 0) {
-		if (use_threads && avoidance_use_multiple_threads) {
-			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap3D::compute_single_avoidance_step_2d, active_2d_avoidance_agents.ptr(), active_2d_avoidance_agents.size(), -1, true, SNAME("RVOAvoidanceAgents2D"));
+		_update_avoidance_grid_2d();
+
+		const uint32_t chunk_count = Math::division_round_up(active_2d_avoidance_agents.size(), AVOIDANCE_AGENTS_PER_TASK);
+		if (use_avoidance_threads && chunk_count > 1) {
+			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap3D::compute_avoidance_velocities_2d, active_2d_avoidance_agents.ptr(), chunk_count, -1, true, SNAME("RVOAvoidanceAgents2D"));
 			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 		} else {
-			for (NavAgent3D *agent : active_2d_avoidance_agents) {
-				agent->get_rvo_agent_2d()->computeNeighbors(&rvo_simulation_2d);
-				agent->get_rvo_agent_2d()->computeNewVelocity(&rvo_simulation_2d);
-				agent->get_rvo_agent_2d()->update(&rvo_simulation_2d);
-				agent->update();
+			for (uint32_t i = 0; i < chunk_count; i++) {
+				compute_avoidance_velocities_2d(i, active_2d_avoidance_agents.ptr());
 			}
 		}
+
+		for (NavAgent3D *agent : active_2d_avoidance_agents) {
+			agent->get_rvo_agent_2d()->update(&rvo_simulation_2d);
+			agent->update();
+		}
 	}
 
 	if (active_3d_avoidance_agents.size() > 0) {
-		if (use_threads && avoidance_use_multiple_threads) {
-			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap3D::compute_single_avoidance_step_3d, active_3d_avoidance_agents.ptr(), active_3d_avoidance_agents.size(), -1, true, SNAME("RVOAvoidanceAgents3D"));
+		_update_avoidance_grid_3d();
+
+		const uint32_t chunk_count = Math::division_round_up(active_3d_avoidance_agents.size(), AVOIDANCE_AGENTS_PER_TASK);
+		if (use_avoidance_threads && chunk_count > 1) {
+			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap3D::compute_avoidance_velocities_3d, active_3d_avoidance_agents.ptr(), chunk_count, -1, true, SNAME("RVOAvoidanceAgents3D"));
 			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 		} else {
-			for (NavAgent3D *agent : active_3d_avoidance_agents) {
-				agent->get_rvo_agent_3d()->computeNeighbors(&rvo_simulation_3d);
-				agent->get_rvo_agent_3d()->computeNewVelocity(&rvo_simulation_3d);
-				agent->get_rvo_agent_3d()->update(&rvo_simulation_3d);
-				agent->update();
+			for (uint32_t i = 0; i < chunk_count; i++) {
+				compute_avoidance_velocities_3d(i, active_3d_avoidance_agents.ptr());
 			}
 		}
+
+		for (NavAgent3D *agent : active_3d_avoidance_agents) {
+			agent->get_rvo_agent_3d()->update(&rvo_simulation_3d);
+			agent->update();
+		}
 	}
 }
 
@@ -870,6 +981,8 @@ NavMap3D::NavMap3D() {
 		path_query_slots_max = 1;
 	}
 
+	path_search_cluster_size = GLOBAL_GET("navigation/3d/path_search_cluster_size");
+
 	iteration_slots.resize(2);
 
 	for (NavMapIteration3D &iteration_slot : iteration_slots) {
@@ -30,6 +30,7 @@
 
 #pragma once
 
+#include "3d/nav_avoidance_grid_3d.h"
 #include "3d/nav_map_iteration_3d.h"
 #include "3d/nav_mesh_queries_3d.h"
 #include "nav_rid_3d.h"
@@ -88,6 +89,14 @@ class NavMap3D : public NavRid3D {
 	LocalVector<NavAgent3D *> active_2d_avoidance_agents;
 	LocalVector<NavAgent3D *> active_3d_avoidance_agents;
 
+	/// Neighbor search of the avoidance agents, indexed like the arrays above.
+	NavAvoidanceGrid3D avoidance_grid_2d;
+	NavAvoidanceGrid3D avoidance_grid_3d;
+	LocalVector<Vector3> avoidance_positions;
+
+	/// Avoidance agents processed by each worker thread task.
+	static constexpr uint32_t AVOIDANCE_AGENTS_PER_TASK = 64;
+
 	/// dirty flag when one of the agent's arrays are modified
 	bool agents_dirty = true;
 
@@ -138,6 +147,9 @@ class NavMap3D : public NavRid3D {
 
 	int path_query_slots_max = 4;
 
+	// Size of the cells that group polygons into clusters for the coarse path search, 0 disables it.
+	real_t path_search_cluster_size = 0.0;
+
 	bool use_async_iterations = true;
 
 	uint32_t iteration_slot_index = 0;
@@ -148,6 +160,17 @@ class NavMap3D : public NavRid3D {
 	WorkerThreadPool::TaskID iteration_build_thread_task_id = WorkerThreadPool::INVALID_TASK_ID;
 	static void _build_iteration_threaded(void *p_arg);
 
+	struct PathQueryBatch {
+		NavMapIteration3D *map_iteration = nullptr;
+		NavMeshQueries3D::NavMeshPathQueryTask3D *query_tasks = nullptr;
+		uint32_t query_task_count = 0;
+		SafeNumeric<uint32_t> next_query_task;
+	};
+
+	NavMeshQueries3D::PathQuerySlot *_acquire_path_query_slot(NavMapIteration3D &p_map_iteration);
+	void _release_path_query_slot(NavMapIteration3D &p_map_iteration, NavMeshQueries3D::PathQuerySlot *p_path_query_slot);
+	void _query_paths_batch_worker(uint32_t p_worker_index, PathQueryBatch *p_batch);
+
 	bool iteration_dirty = true;
 	bool iteration_building = false;
 	bool iteration_ready = false;
@@ -198,6 +221,7 @@ public:
 	const Vector3 &get_merge_rasterizer_cell_size() const;
 
 	void query_path(NavMeshQueries3D::NavMeshPathQueryTask3D &p_query_task);
+	void query_paths(NavMeshQueries3D::NavMeshPathQueryTask3D *p_query_tasks, uint32_t p_query_task_count);
 
 	Vector3 get_closest_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) const;
 	Vector3 get_closest_point(const Vector3 &p_point) const;
@@ -278,14 +302,15 @@ private:
 
 	void compute_single_step(uint32_t index, NavAgent3D **agent);
 
-	void compute_single_avoidance_step_2d(uint32_t index, NavAgent3D **agent);
-	void compute_single_avoidance_step_3d(uint32_t index, NavAgent3D **agent);
+	void compute_avoidance_velocities_2d(uint32_t p_chunk_index, NavAgent3D **p_agents);
+	void compute_avoidance_velocities_3d(uint32_t p_chunk_index, NavAgent3D **p_agents);
 
 	void _sync_avoidance();
 	void _update_rvo_simulation();
 	void _update_rvo_obstacles_tree_2d();
-	void _update_rvo_agents_tree_2d();
-	void _update_rvo_agents_tree_3d();
+	void _update_avoidance_grid_2d();
+	void _update_avoidance_grid_3d();
+	static real_t _get_avoidance_grid_cell_size(real_t p_neighbor_distance_sum, uint32_t p_agent_count);
 
 	void _update_merge_rasterizer_cell_dimensions();
 };
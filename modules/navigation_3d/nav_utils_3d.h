@@ -171,6 +171,27 @@ struct NavPolyHeapIndexer {
 	}
 };
 
+struct ClusterSearchNode {
+	/// Search that last wrote to this node, nodes from older searches count as unvisited.
+	uint32_t search_id = 0;
+	uint32_t back_cluster = UINT32_MAX;
+	uint32_t heap_index = UINT32_MAX;
+	real_t traveled_distance = 0.0;
+	real_t distance_to_destination = 0.0;
+};
+
+struct ClusterSearchCostGreaterThan {
+	bool operator()(const ClusterSearchNode *p_node_a, const ClusterSearchNode *p_node_b) const {
+		return p_node_a->traveled_distance + p_node_a->distance_to_destination > p_node_b->traveled_distance + p_node_b->distance_to_destination;
+	}
+};
+
+struct ClusterSearchHeapIndexer {
+	void operator()(ClusterSearchNode *p_node, uint32_t p_heap_index) const {
+		p_node->heap_index = p_heap_index;
+	}
+};
+
 struct ClosestPointQueryResult {
 	Vector3 point;
 	Vector3 normal;
@@ -321,6 +321,8 @@ void Skeleton3D::_notification(int p_what) {
 			int len = bones.size();
 
 			LocalVector<bool> bone_global_pose_dirty_backup;
+			int bone_global_pose_dirty_begin_backup = 0;
+			int bone_global_pose_dirty_end_backup = 0;
 
 			// Process modifiers.
 
@@ -334,6 +336,8 @@ void Skeleton3D::_notification(int p_what) {
 				}
 				// Store dirty flags for global bone poses.
 				bone_global_pose_dirty_backup = bone_global_pose_dirty;
+				bone_global_pose_dirty_begin_backup = bone_global_pose_dirty_begin;
+				bone_global_pose_dirty_end_backup = bone_global_pose_dirty_end;
 
 				if (update_flags & UPDATE_FLAG_MODIFIER) {
 					_process_modifiers();
@@ -413,6 +417,8 @@ void Skeleton3D::_notification(int p_what) {
 				}
 				// Restore dirty flags for global bone poses.
 				bone_global_pose_dirty = bone_global_pose_dirty_backup;
+				bone_global_pose_dirty_begin = bone_global_pose_dirty_begin_backup;
+				bone_global_pose_dirty_end = bone_global_pose_dirty_end_backup;
 			}
 
 			updating = false;
@@ -498,6 +504,8 @@ void Skeleton3D::_make_bone_global_poses_dirty() const {
 	for (uint32_t i = 0; i < bone_global_pose_dirty.size(); i++) {
 		bone_global_pose_dirty[i] = true;
 	}
+	bone_global_pose_dirty_begin = 0;
+	bone_global_pose_dirty_end = bone_global_pose_dirty.size();
 }
 
 void Skeleton3D::_make_bone_global_pose_subtree_dirty(int p_bone) const {
@@ -517,6 +525,13 @@ void Skeleton3D::_make_bone_global_pose_subtree_dirty(int p_bone) const {
 	for (int i = span_offset; i < span_end; i++) {
 		bone_global_pose_dirty[i] = true;
 	}
+	if (bone_global_pose_dirty_begin >= bone_global_pose_dirty_end) {
+		bone_global_pose_dirty_begin = span_offset;
+		bone_global_pose_dirty_end = span_end;
+	} else {
+		bone_global_pose_dirty_begin = MIN(bone_global_pose_dirty_begin, span_offset);
+		bone_global_pose_dirty_end = MAX(bone_global_pose_dirty_end, span_end);
+	}
 }
 
 void Skeleton3D::_update_bone_global_pose(int p_bone) const {
@@ -832,6 +847,8 @@ void Skeleton3D::clear_bones() {
 	// All these structures contain references to now invalid bone indices.
 	skin_bindings.clear();
 	bone_global_pose_dirty.clear();
+	bone_global_pose_dirty_begin = 0;
+	bone_global_pose_dirty_end = 0;
 	parentless_bones.clear();
 	nested_set_offset_to_bone_index.clear();
 
@@ -1072,9 +1089,10 @@ void Skeleton3D::force_update_all_bone_transforms() {
 
 void Skeleton3D::_force_update_all_bone_transforms() const {
 	_update_process_order();
-	for (int i = 0; i < parentless_bones.size(); i++) {
-		_force_update_bone_children_transforms(parentless_bones[i]);
-	}
+	// All roots are covered by the nested set, so walk it once instead of once per root.
+	_update_bone_transforms_in_nested_set(0, bones.size());
+	bone_global_pose_dirty_begin = 0;
+	bone_global_pose_dirty_end = 0;
 	if (rest_dirty) {
 		rest_dirty = false;
 		const_cast<Skeleton3D *>(this)->emit_signal(SNAME("rest_updated"));
@@ -1098,16 +1116,31 @@ void Skeleton3D::_force_update_bone_children_transforms(int p_bone_idx) const {
 
 	_update_process_order();
 
+	const Bone &bone = bones[p_bone_idx];
+	// The sweep only covers the subtree, so dirty ancestors have to be brought up to date first.
+	if (bone.parent >= 0) {
+		_update_bone_global_pose(bone.parent);
+	}
+	_update_bone_transforms_in_nested_set(bone.nested_set_offset, bone.nested_set_offset + bone.nested_set_span);
+}
+
+void Skeleton3D::_update_bone_transforms_in_nested_set(int p_begin, int p_end) const {
 	Bone *bonesptr = bones.ptr();
 
-	// Loop through nested set.
-	for (int offset = 0; offset < bone_size; offset++) {
-		if (rest_dirty) {
-			int current_bone_idx = nested_set_offset_to_bone_index[offset];
-			Bone &b = bonesptr[current_bone_idx];
-			b.global_rest = b.parent >= 0 ? bonesptr[b.parent].global_rest * b.rest : b.rest; // Rest needs update apert from pose.
+	if (rest_dirty) {
+		// Rest needs update apart from pose, and parents of the range may be affected too.
+		for (uint32_t offset = 0; offset < bones.size(); offset++) {
+			Bone &b = bonesptr[nested_set_offset_to_bone_index[offset]];
+			b.global_rest = b.parent >= 0 ? bonesptr[b.parent].global_rest * b.rest : b.rest;
 		}
+	}
 
+	// Bones outside the dirty range keep their global poses, and the nested set order guarantees parents are updated before their children.
+	const int begin = MAX(p_begin, bone_global_pose_dirty_begin);
+	const int end = MIN(p_end, bone_global_pose_dirty_end);
+
+	// Loop through nested set.
+	for (int offset = begin; offset < end; offset++) {
 		if (!bone_global_pose_dirty[offset]) {
 			continue;
 		}
@@ -200,10 +200,14 @@ private:
 	// Global bone pose calculation.
 	mutable LocalVector<int> nested_set_offset_to_bone_index; // Map from Bone::nested_set_offset to bone index.
 	mutable LocalVector<bool> bone_global_pose_dirty; // Indexable with Bone::nested_set_offset.
+	// Nested set range containing every dirty global pose, so updates only walk the changed chains.
+	mutable int bone_global_pose_dirty_begin = 0;
+	mutable int bone_global_pose_dirty_end = 0;
 	void _update_bones_nested_set() const;
 	int _update_bone_nested_set(int p_bone, int p_offset) const;
 	void _make_bone_global_poses_dirty() const;
 	void _make_bone_global_pose_subtree_dirty(int p_bone) const;
+	void _update_bone_transforms_in_nested_set(int p_begin, int p_end) const;
 	void _update_bone_global_pose(int p_bone) const;
 
 #ifndef DISABLE_DEPRECATED
@@ -33,21 +33,29 @@
 
 #include "core/config/engine.h"
 #include "core/config/project_settings.h"
+#include "core/debugger/engine_debugger.h"
 #include "core/object/callable_mp.h"
 #include "core/object/class_db.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/os/os.h"
 #include "core/string/string_name.h"
 #include "scene/2d/audio_stream_player_2d.h"
+#include "scene/2d/visible_on_screen_notifier_2d.h"
 #include "scene/animation/animation_player.h"
 #include "scene/audio/audio_stream_player.h"
+#include "scene/main/scene_tree.h"
+#include "scene/main/viewport.h"
 #include "scene/resources/animation.h"
 #include "servers/audio/audio_server.h"
 #include "servers/audio/audio_stream.h"
 
 #ifndef _3D_DISABLED
 #include "scene/3d/audio_stream_player_3d.h"
+#include "scene/3d/camera_3d.h"
 #include "scene/3d/mesh_instance_3d.h"
 #include "scene/3d/node_3d.h"
 #include "scene/3d/skeleton_3d.h"
+#include "scene/3d/visible_on_screen_notifier_3d.h"
 #endif // _3D_DISABLED
 
 #ifdef TOOLS_ENABLED
@@ -475,6 +483,7 @@ void AnimationMixer::set_active(bool p_active) {
 	_set_process(processing, true);
 
 	if (!active && is_inside_tree()) {
+		_set_lod_state(LOD_STATE_MAX);
 		_clear_caches();
 	}
 }
@@ -541,6 +550,122 @@ AnimationMixer::AnimationCallbackModeDiscrete AnimationMixer::get_callback_mode_
 	return callback_mode_discrete;
 }
 
+void AnimationMixer::set_lod_enabled(bool p_enabled) {
+	lod_enabled = p_enabled;
+	if (!lod_enabled) {
+		lod_skip_detail = false;
+		lod_pending_delta = 0.0;
+		_set_lod_state(LOD_STATE_MAX);
+	}
+}
+
+bool AnimationMixer::is_lod_enabled() const {
+	return lod_enabled;
+}
+
+void AnimationMixer::set_lod_distance(real_t p_distance) {
+	lod_distance = MAX(p_distance, (real_t)0.0);
+}
+
+real_t AnimationMixer::get_lod_distance() const {
+	return lod_distance;
+}
+
+void AnimationMixer::set_lod_max_update_interval(int p_interval) {
+	ERR_FAIL_COND(p_interval < 1);
+	lod_max_update_interval = p_interval;
+}
+
+int AnimationMixer::get_lod_max_update_interval() const {
+	return lod_max_update_interval;
+}
+
+void AnimationMixer::set_lod_visibility_notifier(const NodePath &p_path) {
+	lod_visibility_notifier = p_path;
+}
+
+NodePath AnimationMixer::get_lod_visibility_notifier() const {
+	return lod_visibility_notifier;
+}
+
+void AnimationMixer::set_lod_detail_tracks(const TypedArray<NodePath> &p_tracks) {
+	lod_detail_tracks = p_tracks;
+	_update_lod_detail_tracks();
+}
+
+TypedArray<NodePath> AnimationMixer::get_lod_detail_tracks() const {
+	return lod_detail_tracks;
+}
+
+uint32_t AnimationMixer::get_lod_state_count(LODState p_state) {
+	ERR_FAIL_INDEX_V(p_state, LOD_STATE_MAX, 0);
+	return lod_state_counts[p_state].get();
+}
+
+void AnimationMixer::_update_lod_detail_tracks() {
+	for (const KeyValue<Animation::TrackCacheID, TrackCache *> &K : track_cache) {
+		K.value->lod_detail = lod_detail_tracks.has(K.value->path);
+	}
+}
+
+void AnimationMixer::_set_lod_state(LODState p_state) {
+	if (lod_state == p_state) {
+		return;
+	}
+	if (lod_state != LOD_STATE_MAX) {
+		lod_state_counts[lod_state].decrement();
+	}
+	lod_state = p_state;
+	if (lod_state != LOD_STATE_MAX) {
+		lod_state_counts[lod_state].increment();
+	}
+}
+
+bool AnimationMixer::_lod_process(double &r_delta) {
+	// Skipped frames are accumulated, so playback speed doesn't change with the update rate.
+	lod_pending_delta += r_delta;
+
+	Node *notifier = lod_visibility_notifier.is_empty() ? nullptr : get_node_or_null(lod_visibility_notifier);
+	bool on_screen = true;
+	if (VisibleOnScreenNotifier2D *notifier_2d = Object::cast_to<VisibleOnScreenNotifier2D>(notifier)) {
+		on_screen = notifier_2d->is_on_screen();
+	}
+#ifndef _3D_DISABLED
+	if (VisibleOnScreenNotifier3D *notifier_3d = Object::cast_to<VisibleOnScreenNotifier3D>(notifier)) {
+		on_screen = notifier_3d->is_on_screen();
+	}
+#endif // _3D_DISABLED
+	if (!on_screen) {
+		// Don't catch up on all the time spent off-screen at once, only on as much as the longest interval would skip.
+		lod_pending_delta = MIN(lod_pending_delta, r_delta * lod_max_update_interval);
+		_set_lod_state(LOD_STATE_OFFSCREEN);
+		return false;
+	}
+
+	uint32_t interval = 1;
+#ifndef _3D_DISABLED
+	if (lod_distance > 0.0 && lod_max_update_interval > 1) {
+		const Node3D *target = Object::cast_to<Node3D>(get_node_or_null(root_node));
+		const Camera3D *camera = target ? get_viewport()->get_camera_3d() : nullptr;
+		if (camera) {
+			const real_t distance = camera->get_global_position().distance_to(target->get_global_position());
+			interval = MIN((uint32_t)(distance / lod_distance) + 1, (uint32_t)lod_max_update_interval);
+		}
+	}
+#endif // _3D_DISABLED
+	_set_lod_state(interval > 1 ? LOD_STATE_REDUCED_RATE : LOD_STATE_FULL_RATE);
+	lod_skip_detail = interval > 1;
+
+	// The tick starts from the instance ID, which spreads reduced rate mixers over different frames.
+	lod_tick++;
+	if (lod_tick % interval != 0) {
+		return false;
+	}
+	r_delta = lod_pending_delta;
+	lod_pending_delta = 0.0;
+	return true;
+}
+
 void AnimationMixer::set_audio_max_polyphony(int p_audio_max_polyphony) {
 	ERR_FAIL_COND(p_audio_max_polyphony < 0 || p_audio_max_polyphony > 128);
 	audio_max_polyphony = p_audio_max_polyphony;
@@ -592,6 +717,7 @@ void AnimationMixer::_clear_caches() {
 	}
 	track_cache.clear();
 	animation_track_num_to_track_cache.clear();
+	animation_track_num_to_key_hint.clear();
 	cache_valid = false;
 	capture_cache.clear();
 
@@ -638,7 +764,10 @@ void AnimationMixer::_create_track_num_to_track_cache_for_animation(const Ref<An
 	const LocalVector<Animation::Track *> &tracks = p_animation->get_tracks();
 
 	track_num_to_track_cache.resize(tracks.size());
+	LocalVector<int> &track_num_to_key_hint = animation_track_num_to_key_hint.insert(p_animation, LocalVector<int>())->value;
+	track_num_to_key_hint.resize_initialized(tracks.size());
 	for (uint32_t i = 0; i < tracks.size(); i++) {
+		track_num_to_key_hint[i] = -1;
 		TrackCache **track_ptr = track_cache.getptr(tracks[i]->get_unique_id());
 		if (track_ptr == nullptr) {
 			track_num_to_track_cache[i] = nullptr;
@@ -662,6 +791,7 @@ bool AnimationMixer::_update_caches() {
 	get_animation_list(&sname_list);
 
 	bool check_path = GLOBAL_GET_CACHED(bool, "animation/warnings/check_invalid_track_paths");
+	parallel_blend_safe = true;
 	bool check_angle_interpolation = GLOBAL_GET_CACHED(bool, "animation/warnings/check_angle_interpolation_type_conflicting");
 
 	Node *parent = get_node_or_null(root_node);
@@ -701,6 +831,9 @@ bool AnimationMixer::_update_caches() {
 			const Animation::TrackCacheID &track_unique_id = anim->track_get_unique_id(i);
 			Animation::TrackType track_src_type = anim->track_get_type(i);
 			Animation::TrackType track_cache_type = Animation::get_cache_type(track_src_type);
+			if (track_src_type == Animation::TYPE_VALUE && anim->value_track_get_update_mode(i) == Animation::UPDATE_DISCRETE && callback_mode_discrete != ANIMATION_CALLBACK_MODE_DISCRETE_FORCE_CONTINUOUS) {
+				parallel_blend_safe = false; // Discrete keys are set on the object while blending.
+			}
 
 			TrackCache *track = nullptr;
 			if (TrackCache **p = track_cache.getptr(track_unique_id)) {
@@ -978,6 +1111,21 @@ bool AnimationMixer::_update_caches() {
 		track_cache.erase(unique_id);
 	}
 
+	for (const KeyValue<Animation::TrackCacheID, TrackCache *> &K : track_cache) {
+		K.value->lod_detail = lod_detail_tracks.has(K.value->path);
+		if (!parallel_blend_safe) {
+			continue;
+		}
+		if (K.value->type == Animation::TYPE_METHOD || K.value->type == Animation::TYPE_AUDIO || K.value->type == Animation::TYPE_ANIMATION) {
+			parallel_blend_safe = false;
+			continue;
+		}
+		Node *target = ObjectDB::get_instance<Node>(K.value->object_id);
+		if (!target || (target != parent && !parent->is_ancestor_of(target))) {
+			parallel_blend_safe = false; // Resources and nodes outside of root_node may be shared with other mixers.
+		}
+	}
+
 	track_map.clear();
 
 	int idx = 0;
@@ -996,6 +1144,7 @@ bool AnimationMixer::_update_caches() {
 	}
 
 	animation_track_num_to_track_cache.clear();
+	animation_track_num_to_key_hint.clear();
 	for (const StringName &E : sname_list) {
 		const Ref<Animation> &anim = get_animation(E);
 		_create_track_num_to_track_cache_for_animation(anim);
@@ -1027,6 +1176,163 @@ void AnimationMixer::_process_animation(double p_delta, bool p_update_only) {
 	}
 }
 
+void AnimationMixer::_process_notification(bool p_physics) {
+	if (parallel_group) {
+		_process_parallel_group(p_physics);
+		return;
+	}
+
+	double delta = p_physics ? get_physics_process_delta_time() : get_process_delta_time();
+	if (lod_enabled && !_lod_process(delta)) {
+		return;
+	}
+	if (EngineDebugger::is_profiling("servers")) {
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		_process_animation(delta);
+		EngineDebugger::profiler_add_frame_data("servers", Array{ "animation_mixers", String(get_path()), USEC_TO_SEC(OS::get_singleton()->get_ticks_usec() - begin) });
+	} else {
+		_process_animation(delta);
+	}
+}
+
+void AnimationMixer::_parallel_frame_started() {
+	parallel_group_pass++;
+}
+
+void AnimationMixer::_update_parallel_group() {
+	// Mixers in a sub-thread process group are notified on their own thread, keep them out of the main thread batch.
+	parallel_group = true;
+	for (Node *node = this; node; node = node->get_parent()) {
+		if (node->get_process_thread_group() != PROCESS_THREAD_GROUP_INHERIT) {
+			parallel_group = node->get_process_thread_group() != PROCESS_THREAD_GROUP_SUB_THREAD;
+			break;
+		}
+	}
+	if (!parallel_group) {
+		remove_from_group(SNAME("_animation_mixers_parallel"));
+		return;
+	}
+	add_to_group(SNAME("_animation_mixers_parallel"));
+
+	// Any frame start ends the current batch. Only mixers with the same callback mode are batched together,
+	// so idle and physics frames can share the counter.
+	SceneTree *tree = get_tree();
+	Callable frame_started = callable_mp_static(&AnimationMixer::_parallel_frame_started);
+	if (!tree->is_connected(SNAME("process_frame"), frame_started)) {
+		tree->connect(SNAME("process_frame"), frame_started);
+		tree->connect(SNAME("physics_frame"), frame_started);
+	}
+}
+
+bool AnimationMixer::_can_blend_in_parallel() const {
+	// Scripts overriding _post_process_key_value() are called for every key, keep them on the main thread.
+	return parallel_blend_safe && !GDVIRTUAL_IS_OVERRIDDEN(_post_process_key_value);
+}
+
+void AnimationMixer::_blend_process_parallel_task(uint32_t p_index, AnimationMixer *const *p_mixers) {
+	AnimationMixer *mixer = p_mixers[p_index];
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	mixer->_blend_process(mixer->parallel_delta);
+	mixer->parallel_process_usec += OS::get_singleton()->get_ticks_usec() - begin;
+}
+
+void AnimationMixer::_process_parallel_group(bool p_physics) {
+	// The first mixer notified in a frame processes every parallel mixer with the same callback mode.
+	// Only sampling and blending into the track caches runs on worker threads, everything that may call
+	// into scripts or touch nodes (pre-process, signals, apply) runs on the main thread in tree order.
+	if (parallel_pass == parallel_group_pass) {
+		return; // Already processed along with another mixer.
+	}
+	const AnimationCallbackModeProcess mode = p_physics ? ANIMATION_CALLBACK_MODE_PROCESS_PHYSICS : ANIMATION_CALLBACK_MODE_PROCESS_IDLE;
+
+	LocalVector<ObjectID> mixer_ids;
+	for (Node *node : get_tree()->get_nodes_in_group(SNAME("_animation_mixers_parallel"))) {
+		AnimationMixer *mixer = Object::cast_to<AnimationMixer>(node);
+		if (!mixer || !mixer->parallel_group || mixer->parallel_pass == parallel_group_pass || !mixer->active || mixer->callback_mode_process != mode || !mixer->can_process()) {
+			continue;
+		}
+		if (p_physics ? !mixer->is_physics_processing_internal() : !mixer->is_processing_internal()) {
+			continue;
+		}
+		mixer->parallel_pass = parallel_group_pass;
+		mixer->parallel_delta = p_physics ? mixer->get_physics_process_delta_time() : mixer->get_process_delta_time();
+		if (mixer->lod_enabled && !mixer->_lod_process(mixer->parallel_delta)) {
+			continue;
+		}
+		mixer_ids.push_back(mixer->get_instance_id());
+	}
+	parallel_pass = parallel_group_pass;
+
+	// Pre-process on the main thread. Mixers that can't be blended in parallel are blended here as well.
+	LocalVector<ObjectID> blended_ids;
+	uint32_t parallel_count = 0;
+	for (const ObjectID &id : mixer_ids) {
+		AnimationMixer *mixer = ObjectDB::get_instance<AnimationMixer>(id);
+		if (!mixer) {
+			continue;
+		}
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		mixer->_blend_init();
+		if (mixer->cache_valid && mixer->_blend_pre_process(mixer->parallel_delta, mixer->track_count, mixer->track_map)) {
+			mixer->_blend_capture(mixer->parallel_delta);
+			mixer->_blend_calc_total_weight();
+			if (mixer->_can_blend_in_parallel()) {
+				parallel_count++;
+			} else {
+				mixer->_blend_process(mixer->parallel_delta);
+			}
+			blended_ids.push_back(id);
+		} else {
+			mixer->clear_animation_instances();
+		}
+		mixer->parallel_process_usec = OS::get_singleton()->get_ticks_usec() - begin;
+	}
+
+	if (parallel_count > 0) {
+		// Pre-processing may have freed mixers, so resolve them again.
+		LocalVector<AnimationMixer *> parallel_mixers;
+		parallel_mixers.reserve(parallel_count);
+		for (const ObjectID &id : blended_ids) {
+			AnimationMixer *mixer = ObjectDB::get_instance<AnimationMixer>(id);
+			if (mixer && mixer->_can_blend_in_parallel()) {
+				parallel_mixers.push_back(mixer);
+			}
+		}
+		if (parallel_mixers.size() > 1) {
+			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &AnimationMixer::_blend_process_parallel_task, parallel_mixers.ptr(), parallel_mixers.size(), -1, true, SNAME("AnimationMixerBlend"));
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		} else if (parallel_mixers.size() == 1) {
+			_blend_process_parallel_task(0, parallel_mixers.ptr());
+		}
+	}
+
+	// Apply the results in tree order.
+	const bool profiling = EngineDebugger::is_profiling("servers");
+	Array profile_values;
+	if (profiling) {
+		profile_values.push_back("animation_mixers");
+	}
+	for (const ObjectID &id : blended_ids) {
+		AnimationMixer *mixer = ObjectDB::get_instance<AnimationMixer>(id);
+		if (!mixer) {
+			continue;
+		}
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		mixer->clear_animation_instances();
+		mixer->_blend_apply();
+		mixer->_blend_post_process();
+		mixer->emit_signal(SNAME("mixer_applied"));
+		if (profiling && ObjectDB::get_instance(id)) {
+			mixer->parallel_process_usec += OS::get_singleton()->get_ticks_usec() - begin;
+			profile_values.push_back(String(mixer->get_path()));
+			profile_values.push_back(USEC_TO_SEC(mixer->parallel_process_usec));
+		}
+	}
+	if (profiling) {
+		EngineDebugger::profiler_add_frame_data("servers", profile_values);
+	}
+}
+
 Variant AnimationMixer::_post_process_key_value(const Ref<Animation> &p_anim, int p_track, Variant &p_value, ObjectID p_object_id, int p_object_sub_idx) {
 #ifndef _3D_DISABLED
 	switch (p_anim->track_get_type(p_track)) {
@@ -1135,6 +1441,7 @@ void AnimationMixer::blend_capture(double p_delta) {
 	if (Animation::is_less_or_equal_approx(capture_cache.remain, 0)) {
 		if (capture_cache.animation.is_valid()) {
 			animation_track_num_to_track_cache.erase(capture_cache.animation);
+			animation_track_num_to_key_hint.erase(capture_cache.animation);
 		}
 		capture_cache.clear();
 		return;
@@ -1243,10 +1550,12 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 		LocalVector<TrackCache *> *t_cache = animation_track_num_to_track_cache.getptr(a);
 		ERR_CONTINUE_EDMSG(!t_cache, "No animation in cache.");
 		LocalVector<TrackCache *> &track_num_to_track_cache = *t_cache;
+		LocalVector<int> *key_hints = animation_track_num_to_key_hint.getptr(a);
 
 		const LocalVector<Animation::Track *> &tracks = a->get_tracks();
 		Animation::Track *const *tracks_ptr = tracks.ptr();
 		double a_length = a->get_length();
+		int *key_hints_ptr = key_hints && key_hints->size() == tracks.size() ? key_hints->ptr() : nullptr;
 		int count = tracks.size();
 		for (int i = 0; i < count; i++) {
 			const Animation::Track *animation_track = tracks_ptr[i];
@@ -1257,6 +1566,9 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 			if (track == nullptr) {
 				continue; // No path, but avoid error spamming.
 			}
+			if (lod_skip_detail && track->lod_detail) {
+				continue; // Keeps the value applied at full rate.
+			}
 			int blend_idx = track->blend_idx;
 			ERR_CONTINUE(blend_idx < 0 || blend_idx >= track_count);
 			real_t blend;
@@ -1412,7 +1724,7 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 					}
 					{
 						Vector3 loc;
-						Error err = a->try_position_track_interpolate(i, time, &loc);
+						Error err = a->try_position_track_interpolate(i, time, &loc, false, key_hints_ptr ? &key_hints_ptr[i] : nullptr);
 						if (err != OK) {
 							continue;
 						}
@@ -1500,7 +1812,7 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 					}
 					{
 						Quaternion rot;
-						Error err = a->try_rotation_track_interpolate(i, time, &rot);
+						Error err = a->try_rotation_track_interpolate(i, time, &rot, false, key_hints_ptr ? &key_hints_ptr[i] : nullptr);
 						if (err != OK) {
 							continue;
 						}
@@ -1588,7 +1900,7 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 					}
 					{
 						Vector3 scale;
-						Error err = a->try_scale_track_interpolate(i, time, &scale);
+						Error err = a->try_scale_track_interpolate(i, time, &scale, false, key_hints_ptr ? &key_hints_ptr[i] : nullptr);
 						if (err != OK) {
 							continue;
 						}
@@ -1604,7 +1916,7 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 					}
 					TrackCacheBlendShape *t = static_cast<TrackCacheBlendShape *>(track);
 					float value;
-					Error err = a->try_blend_shape_track_interpolate(i, time, &value);
+					Error err = a->try_blend_shape_track_interpolate(i, time, &value, false, key_hints_ptr ? &key_hints_ptr[i] : nullptr);
 					//ERR_CONTINUE(err!=OK); //used for testing, should be removed
 					if (err != OK) {
 						continue;
@@ -1903,6 +2215,9 @@ void AnimationMixer::_blend_apply() {
 	// Finally, set the tracks.
 	for (const KeyValue<Animation::TrackCacheID, TrackCache *> &K : track_cache) {
 		TrackCache *track = K.value;
+		if (lod_skip_detail && track->lod_detail) {
+			continue;
+		}
 		bool is_zero_amount = Math::is_zero_approx(track->total_weight);
 		if (!deterministic && is_zero_amount) {
 			continue;
@@ -2357,6 +2672,7 @@ void AnimationMixer::capture(const StringName &p_name, double p_duration, Tween:
 	capture_cache.ease_type = p_ease_type;
 	if (capture_cache.animation.is_valid()) {
 		animation_track_num_to_track_cache.erase(capture_cache.animation);
+		animation_track_num_to_key_hint.erase(capture_cache.animation);
 	}
 	capture_cache.animation.instantiate();
 
@@ -2402,21 +2718,25 @@ void AnimationMixer::_notification(int p_what) {
 				set_process_internal(false);
 			}
 			_clear_caches();
+			if (parallel_processing) {
+				_update_parallel_group();
+			}
 		} break;
 
 		case NOTIFICATION_INTERNAL_PROCESS: {
 			if (active && callback_mode_process == ANIMATION_CALLBACK_MODE_PROCESS_IDLE) {
-				_process_animation(get_process_delta_time());
+				_process_notification(false);
 			}
 		} break;
 
 		case NOTIFICATION_INTERNAL_PHYSICS_PROCESS: {
 			if (active && callback_mode_process == ANIMATION_CALLBACK_MODE_PROCESS_PHYSICS) {
-				_process_animation(get_physics_process_delta_time());
+				_process_notification(true);
 			}
 		} break;
 
 		case NOTIFICATION_EXIT_TREE: {
+			_set_lod_state(LOD_STATE_MAX);
 			_clear_caches();
 		} break;
 	}
@@ -2474,6 +2794,22 @@ void AnimationMixer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_callback_mode_discrete", "mode"), &AnimationMixer::set_callback_mode_discrete);
 	ClassDB::bind_method(D_METHOD("get_callback_mode_discrete"), &AnimationMixer::get_callback_mode_discrete);
 
+	/* ---- LOD ---- */
+	ClassDB::bind_method(D_METHOD("set_lod_enabled", "enabled"), &AnimationMixer::set_lod_enabled);
+	ClassDB::bind_method(D_METHOD("is_lod_enabled"), &AnimationMixer::is_lod_enabled);
+
+	ClassDB::bind_method(D_METHOD("set_lod_distance", "distance"), &AnimationMixer::set_lod_distance);
+	ClassDB::bind_method(D_METHOD("get_lod_distance"), &AnimationMixer::get_lod_distance);
+
+	ClassDB::bind_method(D_METHOD("set_lod_max_update_interval", "interval"), &AnimationMixer::set_lod_max_update_interval);
+	ClassDB::bind_method(D_METHOD("get_lod_max_update_interval"), &AnimationMixer::get_lod_max_update_interval);
+
+	ClassDB::bind_method(D_METHOD("set_lod_visibility_notifier", "path"), &AnimationMixer::set_lod_visibility_notifier);
+	ClassDB::bind_method(D_METHOD("get_lod_visibility_notifier"), &AnimationMixer::get_lod_visibility_notifier);
+
+	ClassDB::bind_method(D_METHOD("set_lod_detail_tracks", "tracks"), &AnimationMixer::set_lod_detail_tracks);
+	ClassDB::bind_method(D_METHOD("get_lod_detail_tracks"), &AnimationMixer::get_lod_detail_tracks);
+
 	/* ---- Audio ---- */
 	ClassDB::bind_method(D_METHOD("set_audio_max_polyphony", "max_polyphony"), &AnimationMixer::set_audio_max_polyphony);
 	ClassDB::bind_method(D_METHOD("get_audio_max_polyphony"), &AnimationMixer::get_audio_max_polyphony);
@@ -2515,6 +2851,13 @@ void AnimationMixer::_bind_methods() {
 	ADD_GROUP("Audio", "audio_");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "audio_max_polyphony", PROPERTY_HINT_RANGE, "1,127,1"), "set_audio_max_polyphony", "get_audio_max_polyphony");
 
+	ADD_GROUP("LOD", "lod_");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "lod_enabled"), "set_lod_enabled", "is_lod_enabled");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "lod_distance", PROPERTY_HINT_RANGE, "0,1000,0.01,or_greater,suffix:m"), "set_lod_distance", "get_lod_distance");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "lod_max_update_interval", PROPERTY_HINT_RANGE, "1,16,1,or_greater"), "set_lod_max_update_interval", "get_lod_max_update_interval");
+	ADD_PROPERTY(PropertyInfo(Variant::NODE_PATH, "lod_visibility_notifier", PROPERTY_HINT_NODE_PATH_VALID_TYPES, "VisibleOnScreenNotifier2D,VisibleOnScreenNotifier3D"), "set_lod_visibility_notifier", "get_lod_visibility_notifier");
+	ADD_PROPERTY(PropertyInfo(Variant::ARRAY, "lod_detail_tracks", PROPERTY_HINT_ARRAY_TYPE, "NodePath"), "set_lod_detail_tracks", "get_lod_detail_tracks");
+
 	ADD_GROUP("Callback Mode", "callback_mode_");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "callback_mode_process", PROPERTY_HINT_ENUM, "Physics,Idle,Manual"), "set_callback_mode_process", "get_callback_mode_process");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "callback_mode_method", PROPERTY_HINT_ENUM, "Deferred,Immediate"), "set_callback_mode_method", "get_callback_mode_method");
@@ -2545,6 +2888,9 @@ void AnimationMixer::_bind_methods() {
 
 AnimationMixer::AnimationMixer() {
 	root_node = NodePath("..");
+
+	parallel_processing = GLOBAL_GET("animation/mixer/parallel_processing");
+	lod_tick = (uint32_t)(uint64_t)get_instance_id();
 }
 
 AnimationMixer::~AnimationMixer() {
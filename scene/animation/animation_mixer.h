@@ -31,6 +31,7 @@
 #pragma once
 
 #include "core/templates/a_hash_map.h"
+#include "core/variant/typed_array.h"
 #include "scene/animation/tween.h"
 #include "scene/main/node.h"
 #include "scene/resources/animation.h"
@@ -68,6 +69,13 @@ public:
 		ANIMATION_CALLBACK_MODE_DISCRETE_FORCE_CONTINUOUS,
 	};
 
+	enum LODState {
+		LOD_STATE_FULL_RATE,
+		LOD_STATE_REDUCED_RATE,
+		LOD_STATE_OFFSCREEN,
+		LOD_STATE_MAX,
+	};
+
 	/* ---- Data ---- */
 	struct AnimationLibraryData {
 		StringName name;
@@ -150,6 +158,7 @@ protected:
 		ObjectID object_id;
 		real_t total_weight = 0.0;
 		uint64_t animation_instance_weight_applied_at = 0;
+		bool lod_detail = false; // Only evaluated at full update rate.
 
 		TrackCache() = default;
 		TrackCache(const TrackCache &p_other) :
@@ -158,7 +167,8 @@ protected:
 				type(p_other.type),
 				object_id(p_other.object_id),
 				total_weight(p_other.total_weight),
-				animation_instance_weight_applied_at(p_other.animation_instance_weight_applied_at) {}
+				animation_instance_weight_applied_at(p_other.animation_instance_weight_applied_at),
+				lod_detail(p_other.lod_detail) {}
 
 		virtual ~TrackCache() {}
 	};
@@ -306,6 +316,8 @@ protected:
 	RootMotionCache root_motion_cache;
 	AHashMap<Animation::TrackCacheID, TrackCache *, HashHasher> track_cache;
 	AHashMap<Ref<Animation>, LocalVector<TrackCache *>> animation_track_num_to_track_cache;
+	// Last key sampled per track, lets playback find the next key without a binary search.
+	AHashMap<Ref<Animation>, LocalVector<int>> animation_track_num_to_key_hint;
 	HashSet<TrackCache *> playing_caches;
 	Vector<Node *> playing_audio_stream_players;
 
@@ -328,6 +340,27 @@ protected:
 	int track_count = 0;
 	bool deterministic = false;
 
+	/* ---- Parallel processing ---- */
+	static inline uint64_t parallel_group_pass = 1;
+	bool parallel_processing = false;
+	bool parallel_group = false;
+	bool parallel_blend_safe = false; // All cached tracks only write to the track caches and target nodes under root_node.
+	uint64_t parallel_pass = 0;
+	double parallel_delta = 0.0;
+	uint64_t parallel_process_usec = 0;
+
+	/* ---- LOD ---- */
+	static inline SafeNumeric<uint32_t> lod_state_counts[LOD_STATE_MAX];
+	bool lod_enabled = false;
+	real_t lod_distance = 20.0;
+	int lod_max_update_interval = 4;
+	NodePath lod_visibility_notifier;
+	TypedArray<NodePath> lod_detail_tracks;
+	LODState lod_state = LOD_STATE_MAX;
+	uint32_t lod_tick = 0;
+	double lod_pending_delta = 0.0;
+	bool lod_skip_detail = false;
+
 	/* ---- Root motion accumulator for Skeleton3D ---- */
 	NodePath root_motion_track;
 	bool root_motion_local = false;
@@ -374,6 +407,17 @@ protected:
 	virtual void _blend_post_process();
 	void _call_object(ObjectID p_object_id, const StringName &p_method, const Vector<Variant> &p_params, bool p_deferred);
 
+	void _process_notification(bool p_physics);
+	void _set_lod_state(LODState p_state);
+	bool _lod_process(double &r_delta);
+	void _update_lod_detail_tracks();
+
+	static void _parallel_frame_started();
+	void _update_parallel_group();
+	bool _can_blend_in_parallel() const;
+	void _process_parallel_group(bool p_physics);
+	void _blend_process_parallel_task(uint32_t p_index, AnimationMixer *const *p_mixers);
+
 	/* ---- Capture feature ---- */
 	struct CaptureCache {
 		Ref<Animation> animation;
@@ -435,6 +479,24 @@ public:
 	void set_callback_mode_discrete(AnimationCallbackModeDiscrete p_mode);
 	AnimationCallbackModeDiscrete get_callback_mode_discrete() const;
 
+	/* ---- LOD ---- */
+	void set_lod_enabled(bool p_enabled);
+	bool is_lod_enabled() const;
+
+	void set_lod_distance(real_t p_distance);
+	real_t get_lod_distance() const;
+
+	void set_lod_max_update_interval(int p_interval);
+	int get_lod_max_update_interval() const;
+
+	void set_lod_visibility_notifier(const NodePath &p_path);
+	NodePath get_lod_visibility_notifier() const;
+
+	void set_lod_detail_tracks(const TypedArray<NodePath> &p_tracks);
+	TypedArray<NodePath> get_lod_detail_tracks() const;
+
+	static uint32_t get_lod_state_count(LODState p_state);
+
 	/* ---- Audio ---- */
 	void set_audio_max_polyphony(int p_audio_max_polyphony);
 	int get_audio_max_polyphony() const;
@@ -31,8 +31,12 @@
 #include "animation.h"
 #include "animation.compat.inc"
 
+#include "core/config/project_settings.h"
+#include "core/io/file_access.h"
 #include "core/io/marshalls.h"
 #include "core/object/class_db.h"
+#include "core/os/mutex.h"
+#include "core/templates/lru.h"
 
 bool Animation::_set(const StringName &p_name, const Variant &p_value) {
 	String prop_name = p_name;
@@ -52,13 +56,29 @@ bool Animation::_set(const StringName &p_name, const Variant &p_value) {
 		for (int i = 0; i < bounds.size(); i++) {
 			compression.bounds[i] = bounds[i];
 		}
+		_clear_streamed_pages();
+		compression.stream_path = comp.get("stream_path", String());
 		Array pages = comp["pages"];
 		compression.pages.resize(pages.size());
 		for (int i = 0; i < pages.size(); i++) {
 			Dictionary page = pages[i];
-			ERR_FAIL_COND_V(!page.has("data"), false);
 			ERR_FAIL_COND_V(!page.has("time_offset"), false);
-			compression.pages[i].data = page["data"];
+			if (compression.stream_path.is_empty()) {
+				ERR_FAIL_COND_V(!page.has("data"), false);
+				compression.pages[i].data = page["data"];
+			} else {
+				ERR_FAIL_COND_V(!page.has("stream_offset"), false);
+				ERR_FAIL_COND_V(!page.has("stream_size"), false);
+				compression.pages[i].data = Vector<uint8_t>();
+				compression.pages[i].stream_offset = page["stream_offset"];
+				compression.pages[i].stream_size = page["stream_size"];
+				Vector<int32_t> key_counts = page.get("key_counts", Vector<int32_t>());
+				ERR_FAIL_COND_V(!key_counts.is_empty() && key_counts.size() != bounds.size(), false);
+				compression.pages[i].key_counts.resize(key_counts.size());
+				for (int j = 0; j < key_counts.size(); j++) {
+					compression.pages[i].key_counts[j] = key_counts[j];
+				}
+			}
 			compression.pages[i].time_offset = page["time_offset"];
 		}
 		compression.enabled = true;
@@ -480,11 +500,25 @@ bool Animation::_get(const StringName &p_name, Variant &r_ret) const {
 		pages.resize(compression.pages.size());
 		for (uint32_t i = 0; i < compression.pages.size(); i++) {
 			Dictionary page;
-			page["data"] = compression.pages[i].data;
+			if (compression.stream_path.is_empty()) {
+				page["data"] = compression.pages[i].data;
+			} else {
+				page["stream_offset"] = compression.pages[i].stream_offset;
+				page["stream_size"] = compression.pages[i].stream_size;
+				Vector<int32_t> key_counts;
+				key_counts.resize(compression.pages[i].key_counts.size());
+				for (uint32_t j = 0; j < compression.pages[i].key_counts.size(); j++) {
+					key_counts.write[j] = compression.pages[i].key_counts[j];
+				}
+				page["key_counts"] = key_counts;
+			}
 			page["time_offset"] = compression.pages[i].time_offset;
 			pages[i] = page;
 		}
 		comp["pages"] = pages;
+		if (!compression.stream_path.is_empty()) {
+			comp["stream_path"] = compression.stream_path;
+		}
 		comp["format_version"] = Compression::FORMAT_VERSION;
 
 		r_ret = comp;
@@ -1180,7 +1214,7 @@ Error Animation::position_track_get_key(int p_track, int p_key, Vector3 *r_posit
 	return OK;
 }
 
-Error Animation::try_position_track_interpolate(int p_track, double p_time, Vector3 *r_interpolation, bool p_backward) const {
+Error Animation::try_position_track_interpolate(int p_track, double p_time, Vector3 *r_interpolation, bool p_backward, int *r_key_hint) const {
 	ERR_FAIL_UNSIGNED_INDEX_V((uint32_t)p_track, tracks.size(), ERR_INVALID_PARAMETER);
 	Track *t = tracks[p_track];
 	ERR_FAIL_COND_V(t->type != TYPE_POSITION_3D, ERR_INVALID_PARAMETER);
@@ -1197,7 +1231,7 @@ Error Animation::try_position_track_interpolate(int p_track, double p_time, Vect
 
 	bool ok = false;
 
-	Vector3 tk = _interpolate(tt->positions, p_time, tt->interpolation, tt->loop_wrap, &ok, p_backward);
+	Vector3 tk = _interpolate(tt->positions, p_time, tt->interpolation, tt->loop_wrap, &ok, p_backward, r_key_hint);
 
 	if (!ok) {
 		return ERR_UNAVAILABLE;
@@ -1260,7 +1294,7 @@ Error Animation::rotation_track_get_key(int p_track, int p_key, Quaternion *r_ro
 	return OK;
 }
 
-Error Animation::try_rotation_track_interpolate(int p_track, double p_time, Quaternion *r_interpolation, bool p_backward) const {
+Error Animation::try_rotation_track_interpolate(int p_track, double p_time, Quaternion *r_interpolation, bool p_backward, int *r_key_hint) const {
 	ERR_FAIL_UNSIGNED_INDEX_V((uint32_t)p_track, tracks.size(), ERR_INVALID_PARAMETER);
 	Track *t = tracks[p_track];
 	ERR_FAIL_COND_V(t->type != TYPE_ROTATION_3D, ERR_INVALID_PARAMETER);
@@ -1277,7 +1311,7 @@ Error Animation::try_rotation_track_interpolate(int p_track, double p_time, Quat
 
 	bool ok = false;
 
-	Quaternion tk = _interpolate(rt->rotations, p_time, rt->interpolation, rt->loop_wrap, &ok, p_backward);
+	Quaternion tk = _interpolate(rt->rotations, p_time, rt->interpolation, rt->loop_wrap, &ok, p_backward, r_key_hint);
 
 	if (!ok) {
 		return ERR_UNAVAILABLE;
@@ -1340,7 +1374,7 @@ Error Animation::scale_track_get_key(int p_track, int p_key, Vector3 *r_scale) c
 	return OK;
 }
 
-Error Animation::try_scale_track_interpolate(int p_track, double p_time, Vector3 *r_interpolation, bool p_backward) const {
+Error Animation::try_scale_track_interpolate(int p_track, double p_time, Vector3 *r_interpolation, bool p_backward, int *r_key_hint) const {
 	ERR_FAIL_UNSIGNED_INDEX_V((uint32_t)p_track, tracks.size(), ERR_INVALID_PARAMETER);
 	Track *t = tracks[p_track];
 	ERR_FAIL_COND_V(t->type != TYPE_SCALE_3D, ERR_INVALID_PARAMETER);
@@ -1357,7 +1391,7 @@ Error Animation::try_scale_track_interpolate(int p_track, double p_time, Vector3
 
 	bool ok = false;
 
-	Vector3 tk = _interpolate(st->scales, p_time, st->interpolation, st->loop_wrap, &ok, p_backward);
+	Vector3 tk = _interpolate(st->scales, p_time, st->interpolation, st->loop_wrap, &ok, p_backward, r_key_hint);
 
 	if (!ok) {
 		return ERR_UNAVAILABLE;
@@ -1420,7 +1454,7 @@ Error Animation::blend_shape_track_get_key(int p_track, int p_key, float *r_blen
 	return OK;
 }
 
-Error Animation::try_blend_shape_track_interpolate(int p_track, double p_time, float *r_interpolation, bool p_backward) const {
+Error Animation::try_blend_shape_track_interpolate(int p_track, double p_time, float *r_interpolation, bool p_backward, int *r_key_hint) const {
 	ERR_FAIL_UNSIGNED_INDEX_V((uint32_t)p_track, tracks.size(), ERR_INVALID_PARAMETER);
 	Track *t = tracks[p_track];
 	ERR_FAIL_COND_V(t->type != TYPE_BLEND_SHAPE, ERR_INVALID_PARAMETER);
@@ -1437,7 +1471,7 @@ Error Animation::try_blend_shape_track_interpolate(int p_track, double p_time, f
 
 	bool ok = false;
 
-	float tk = _interpolate(bst->blend_shapes, p_time, bst->interpolation, bst->loop_wrap, &ok, p_backward);
+	float tk = _interpolate(bst->blend_shapes, p_time, bst->interpolation, bst->loop_wrap, &ok, p_backward, r_key_hint);
 
 	if (!ok) {
 		return ERR_UNAVAILABLE;
@@ -2447,6 +2481,35 @@ int Animation::_find(const LocalVector<K> &p_keys, double p_time, bool p_backwar
 	return middle;
 }
 
+template <typename K>
+int Animation::_find_with_hint(const LocalVector<K> &p_keys, double p_time, bool p_backward, int *r_key_hint) const {
+	if (!r_key_hint) {
+		return _find(p_keys, p_time, p_backward);
+	}
+
+	// Playback moves forward by less than a key per step most of the time, so the key is usually the one
+	// found last time or one right after it. Only times that are clearly between two keys are resolved
+	// here, anything close to a key is left to _find() so the result is always the same.
+	const int len = p_keys.size();
+	const int hint = *r_key_hint;
+	if (!p_backward && hint >= 0) {
+		const K *keys = p_keys.ptr();
+		for (int k = hint; k < len && k <= hint + 2; k++) {
+			if (keys[k].time > p_time || Math::is_equal_approx(p_time, (double)keys[k].time)) {
+				break;
+			}
+			if (k + 1 == len || (keys[k + 1].time > p_time && !Math::is_equal_approx(p_time, (double)keys[k + 1].time))) {
+				*r_key_hint = k;
+				return k;
+			}
+		}
+	}
+
+	const int idx = _find(p_keys, p_time, p_backward);
+	*r_key_hint = idx;
+	return idx;
+}
+
 // Linear interpolation for anytype.
 
 Vector3 Animation::_interpolate(const Vector3 &p_a, const Vector3 &p_b, real_t p_c) const {
@@ -2516,8 +2579,13 @@ Variant Animation::_cubic_interpolate_angle_in_time(const Variant &p_pre_a, cons
 }
 
 template <typename T>
-T Animation::_interpolate(const LocalVector<TKey<T>> &p_keys, double p_time, InterpolationType p_interp, bool p_loop_wrap, bool *p_ok, bool p_backward) const {
-	int len = _find(p_keys, length) + 1; // try to find last key (there may be more past the end)
+T Animation::_interpolate(const LocalVector<TKey<T>> &p_keys, double p_time, InterpolationType p_interp, bool p_loop_wrap, bool *p_ok, bool p_backward, int *r_key_hint) const {
+	int len;
+	if (!p_keys.is_empty() && p_keys[p_keys.size() - 1].time < length && !Math::is_equal_approx(length, (double)p_keys[p_keys.size() - 1].time)) {
+		len = p_keys.size(); // All keys are within the length, which is by far the most common case.
+	} else {
+		len = _find(p_keys, length) + 1; // try to find last key (there may be more past the end)
+	}
 
 	if (len <= 0) {
 		// (-1 or -2 returned originally) (plus one above)
@@ -2534,7 +2602,7 @@ T Animation::_interpolate(const LocalVector<TKey<T>> &p_keys, double p_time, Int
 		return p_keys[0].value;
 	}
 
-	int idx = _find(p_keys, p_time, p_backward);
+	int idx = _find_with_hint(p_keys, p_time, p_backward, r_key_hint);
 
 	ERR_FAIL_COND_V(idx == -2, T());
 	int maxi = len - 1;
@@ -4066,6 +4134,8 @@ void Animation::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("optimize", "allowed_velocity_err", "allowed_angular_err", "precision"), &Animation::optimize, DEFVAL(0.01), DEFVAL(0.01), DEFVAL(3));
 	ClassDB::bind_method(D_METHOD("compress", "page_size", "fps", "split_tolerance"), &Animation::compress, DEFVAL(8192), DEFVAL(120), DEFVAL(4.0));
+	ClassDB::bind_method(D_METHOD("stream_compressed_pages", "path"), &Animation::stream_compressed_pages);
+	ClassDB::bind_method(D_METHOD("get_compressed_page_stream_path"), &Animation::get_compressed_page_stream_path);
 
 	ClassDB::bind_method(D_METHOD("is_capture_included"), &Animation::is_capture_included);
 
@@ -4114,9 +4184,11 @@ void Animation::clear() {
 	tracks.clear();
 	loop_mode = LOOP_NONE;
 	length = 1;
+	_clear_streamed_pages();
 	compression.enabled = false;
 	compression.bounds.clear();
 	compression.pages.clear();
+	compression.stream_path = String();
 	compression.fps = 120;
 	emit_changed();
 }
@@ -4848,30 +4920,50 @@ Vector3i Animation::_compress_key(uint32_t p_track, const AABB &p_bounds, int32_
 }
 
 struct AnimationCompressionBufferBitsRead {
-	uint32_t buffer = 0;
+	uint64_t buffer = 0;
 	uint32_t used = 0;
 	const uint8_t *src_data = nullptr;
 
 	_FORCE_INLINE_ uint32_t read(uint32_t p_bits) {
-		uint32_t output = 0;
-		uint32_t written = 0;
-		while (p_bits > 0) {
-			if (used == 0) {
-				used = 8;
-				buffer = *src_data;
-				src_data++;
-			}
-			uint32_t to_write = MIN(used, p_bits);
-			output |= (buffer & ((1 << to_write) - 1)) << written;
-			buffer >>= to_write;
-			used -= to_write;
-			p_bits -= to_write;
-			written += to_write;
-		}
+		// Values are at most 16 bits wide, so a couple of byte loads refill the accumulator.
+		// Bytes are only fetched when needed, which keeps reads within the packet.
+		while (used < p_bits) {
+			buffer |= uint64_t(*src_data) << used;
+			src_data++;
+			used += 8;
+		}
+		uint32_t output = uint32_t(buffer & ((uint64_t(1) << p_bits) - 1));
+		buffer >>= p_bits;
+		used -= p_bits;
 		return output;
 	}
 };
 
+struct AnimationStreamedPageKey {
+	ObjectID animation;
+	uint32_t page = 0;
+
+	static uint32_t hash(const AnimationStreamedPageKey &p_key) {
+		return hash_murmur3_one_32(p_key.page, hash_murmur3_one_64(uint64_t(p_key.animation)));
+	}
+	bool operator==(const AnimationStreamedPageKey &p_key) const {
+		return animation == p_key.animation && page == p_key.page;
+	}
+};
+
+static BinaryMutex streamed_page_mutex;
+static uint64_t streamed_page_memory = 0;
+
+static void _streamed_page_evicted(AnimationStreamedPageKey &p_key, Vector<uint8_t> &p_data) {
+	streamed_page_memory -= p_data.size();
+}
+
+typedef LRUCache<AnimationStreamedPageKey, Vector<uint8_t>, AnimationStreamedPageKey, HashMapComparatorDefault<AnimationStreamedPageKey>, _streamed_page_evicted> AnimationStreamedPageCache;
+static AnimationStreamedPageCache *streamed_page_cache = nullptr;
+// Stream files stay open while their animation exists, so cache misses only seek and read.
+typedef HashMap<ObjectID, Ref<FileAccess>> AnimationStreamedPageFiles;
+static AnimationStreamedPageFiles *streamed_page_files = nullptr;
+
 void Animation::compress(uint32_t p_page_size, uint32_t p_fps, float p_split_tolerance) {
 	ERR_FAIL_COND_MSG(compression.enabled, "This animation is already compressed");
 
@@ -5264,6 +5356,124 @@ void Animation::compress(uint32_t p_page_size, uint32_t p_fps, float p_split_tol
 #endif
 }
 
+Error Animation::stream_compressed_pages(const String &p_path) {
+	ERR_FAIL_COND_V_MSG(!compression.enabled, ERR_UNCONFIGURED, "Only compressed animations can stream their pages.");
+	ERR_FAIL_COND_V_MSG(!compression.stream_path.is_empty(), ERR_ALREADY_IN_USE, "Compressed pages of this animation are already streamed from: " + compression.stream_path);
+
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(f.is_null(), err, "Cannot open file to stream compressed animation pages: " + p_path);
+
+	for (uint32_t p = 0; p < compression.pages.size(); p++) {
+		Compression::Page &page = compression.pages[p];
+		page.stream_offset = f->get_position();
+		page.stream_size = page.data.size();
+		f->store_buffer(page.data.ptr(), page.data.size());
+		LocalVector<uint32_t> key_counts;
+		for (uint32_t i = 0; i < compression.bounds.size(); i++) {
+			key_counts.push_back(_get_compressed_page_key_count(p, i));
+		}
+		page.key_counts = key_counts;
+	}
+	f->flush();
+	ERR_FAIL_COND_V_MSG(f->get_error() != OK, ERR_FILE_CANT_WRITE, "Cannot write compressed animation pages to: " + p_path);
+	f.unref();
+
+	for (Compression::Page &page : compression.pages) {
+		page.data = Vector<uint8_t>();
+	}
+	compression.stream_path = p_path;
+	emit_changed();
+	return OK;
+}
+
+String Animation::get_compressed_page_stream_path() const {
+	return compression.stream_path;
+}
+
+uint64_t Animation::get_compressed_page_memory_usage() const {
+	uint64_t usage = 0;
+	for (const Compression::Page &page : compression.pages) {
+		usage += page.data.size();
+	}
+	return usage;
+}
+
+uint64_t Animation::get_streamed_page_cache_memory_usage() {
+	MutexLock lock(streamed_page_mutex);
+	return streamed_page_memory;
+}
+
+const uint8_t *Animation::_get_compressed_page_data(uint32_t p_page, Vector<uint8_t> &r_holder) const {
+	if (compression.stream_path.is_empty()) {
+		return compression.pages[p_page].data.ptr();
+	}
+	// The holder keeps the page alive even if the cache evicts it while it is being decoded.
+	r_holder = _load_streamed_page(p_page);
+	return r_holder.ptr();
+}
+
+Vector<uint8_t> Animation::_load_streamed_page(uint32_t p_page) const {
+	const AnimationStreamedPageKey key = { get_instance_id(), p_page };
+	// Reads are done under the lock too, so the shared file position is not moved by another thread.
+	MutexLock lock(streamed_page_mutex);
+	if (!streamed_page_cache) {
+		streamed_page_cache = memnew(AnimationStreamedPageCache(MAX(1, int(GLOBAL_GET("animation/compression/streamed_page_cache_size")))));
+	}
+	const Vector<uint8_t> *cached = streamed_page_cache->getptr(key);
+	if (cached) {
+		return *cached;
+	}
+
+	if (!streamed_page_files) {
+		streamed_page_files = memnew(AnimationStreamedPageFiles);
+	}
+	Ref<FileAccess> *file = streamed_page_files->getptr(key.animation);
+	if (!file) {
+		Ref<FileAccess> f = FileAccess::open(compression.stream_path, FileAccess::READ);
+		ERR_FAIL_COND_V_MSG(f.is_null(), Vector<uint8_t>(), "Cannot open compressed animation page stream: " + compression.stream_path);
+		file = &streamed_page_files->insert(key.animation, f)->value;
+	}
+	const Compression::Page &page = compression.pages[p_page];
+	(*file)->seek(page.stream_offset);
+	Vector<uint8_t> data = (*file)->get_buffer(page.stream_size);
+	ERR_FAIL_COND_V_MSG(data.size() != int64_t(page.stream_size), Vector<uint8_t>(), "Compressed animation page stream is truncated: " + compression.stream_path);
+
+	streamed_page_memory += data.size();
+	streamed_page_cache->insert(key, data);
+	return data;
+}
+
+void Animation::_clear_streamed_pages() {
+	if (compression.stream_path.is_empty()) {
+		return;
+	}
+	MutexLock lock(streamed_page_mutex);
+	const ObjectID id = get_instance_id();
+	if (streamed_page_files) {
+		streamed_page_files->erase(id);
+		if (streamed_page_files->is_empty()) {
+			memdelete(streamed_page_files);
+			streamed_page_files = nullptr;
+		}
+	}
+	if (!streamed_page_cache) {
+		return;
+	}
+	for (uint32_t i = 0; i < compression.pages.size(); i++) {
+		const AnimationStreamedPageKey key = { id, i };
+		const Vector<uint8_t> *cached = streamed_page_cache->getptr(key);
+		if (cached) {
+			streamed_page_memory -= cached->size();
+			streamed_page_cache->erase(key);
+		}
+	}
+	if (streamed_page_cache->get_size() == 0) {
+		memdelete(streamed_page_cache);
+		streamed_page_cache = nullptr;
+	}
+}
+
 bool Animation::_rotation_interpolate_compressed(uint32_t p_compressed_track, double p_time, Quaternion &r_ret) const {
 	Vector3i current;
 	Vector3i next;
@@ -5346,42 +5556,49 @@ bool Animation::_fetch_compressed(uint32_t p_compressed_track, double p_time, Ve
 
 	double frame_to_sec = 1.0 / double(compression.fps);
 
-	int32_t page_index = -1;
-	for (uint32_t i = 0; i < compression.pages.size(); i++) {
-		if (compression.pages[i].time_offset > p_time) {
-			break;
+	// Pages are sorted by time, find the last one starting at or before p_time.
+	uint32_t page_begin = 0;
+	uint32_t page_end = compression.pages.size();
+	while (page_begin < page_end) {
+		uint32_t middle = (page_begin + page_end) / 2;
+		if (compression.pages[middle].time_offset > p_time) {
+			page_end = middle;
+		} else {
+			page_begin = middle + 1;
 		}
-		page_index = i;
 	}
+	int32_t page_index = int32_t(page_begin) - 1;
 
 	ERR_FAIL_COND_V(page_index == -1, false); //should not happen
 
 	double page_base_time = compression.pages[page_index].time_offset;
-	const uint8_t *page_data = compression.pages[page_index].data.ptr();
+	Vector<uint8_t> page_holder;
+	const uint8_t *page_data = _get_compressed_page_data(page_index, page_holder);
+	ERR_FAIL_NULL_V(page_data, false);
 	// Little endian assumed. No major big endian hardware exists any longer, but in case it does it will need to be supported.
 	const uint32_t *indices = (const uint32_t *)page_data;
 	const uint16_t *time_keys = (const uint16_t *)&page_data[indices[p_compressed_track * 3 + 0]];
 	uint32_t time_key_count = indices[p_compressed_track * 3 + 1];
 
-	int32_t packet_idx = 0;
-	double packet_time = double(time_keys[0]) * frame_to_sec + page_base_time;
-	uint32_t base_frame = time_keys[0];
-
-	for (uint32_t i = 1; i < time_key_count; i++) {
-		uint32_t f = time_keys[i * 2 + 0];
-		double frame_time = double(f) * frame_to_sec + page_base_time;
-
-		if (frame_time > p_time) {
-			break;
+	// Time keys are sorted too, find the last packet starting at or before p_time.
+	uint32_t packet_begin = 1;
+	uint32_t packet_end = MAX(time_key_count, 1u);
+	while (packet_begin < packet_end) {
+		uint32_t middle = (packet_begin + packet_end) / 2;
+		if (double(time_keys[middle * 2 + 0]) * frame_to_sec + page_base_time > p_time) {
+			packet_end = middle;
+		} else {
+			packet_begin = middle + 1;
 		}
+	}
+	int32_t packet_idx = packet_begin - 1;
+	uint32_t base_frame = time_keys[packet_idx * 2 + 0];
+	double packet_time = double(base_frame) * frame_to_sec + page_base_time;
 
-		if (key_index) {
-			(*key_index) += (time_keys[(i - 1) * 2 + 1] >> 12) + 1;
+	if (key_index) {
+		for (int32_t i = 0; i < packet_idx; i++) {
+			(*key_index) += (time_keys[i * 2 + 1] >> 12) + 1;
 		}
-
-		packet_idx = i;
-		packet_time = frame_time;
-		base_frame = f;
 	}
 
 	const uint8_t *data_keys_base = (const uint8_t *)&page_data[indices[p_compressed_track * 3 + 2]];
@@ -5500,7 +5717,9 @@ void Animation::_get_compressed_key_indices_in_range(uint32_t p_compressed_track
 		uint32_t page_index = p;
 
 		double page_base_time = compression.pages[page_index].time_offset;
-		const uint8_t *page_data = compression.pages[page_index].data.ptr();
+		Vector<uint8_t> page_holder;
+		const uint8_t *page_data = _get_compressed_page_data(page_index, page_holder);
+		ERR_FAIL_NULL(page_data);
 		// Little endian assumed. No major big endian hardware exists any longer, but in case it does it will need to be supported.
 		const uint32_t *indices = (const uint32_t *)page_data;
 		const uint16_t *time_keys = (const uint16_t *)&page_data[indices[p_compressed_track * 3 + 0]];
@@ -5563,24 +5782,35 @@ void Animation::_get_compressed_key_indices_in_range(uint32_t p_compressed_track
 	}
 }
 
+uint32_t Animation::_get_compressed_page_key_count(uint32_t p_page, uint32_t p_compressed_track) const {
+	const Compression::Page &page = compression.pages[p_page];
+	if (!page.key_counts.is_empty()) {
+		return page.key_counts[p_compressed_track];
+	}
+
+	Vector<uint8_t> page_holder;
+	const uint8_t *page_data = _get_compressed_page_data(p_page, page_holder);
+	ERR_FAIL_NULL_V(page_data, 0);
+	// Little endian assumed. No major big endian hardware exists any longer, but in case it does it will need to be supported.
+	const uint32_t *indices = (const uint32_t *)page_data;
+	const uint16_t *time_keys = (const uint16_t *)&page_data[indices[p_compressed_track * 3 + 0]];
+	uint32_t time_key_count = indices[p_compressed_track * 3 + 1];
+
+	uint32_t key_count = 0;
+	for (uint32_t j = 0; j < time_key_count; j++) {
+		key_count += (time_keys[j * 2 + 1] >> 12) + 1;
+	}
+	return key_count;
+}
+
 int Animation::_get_compressed_key_count(uint32_t p_compressed_track) const {
 	ERR_FAIL_COND_V(!compression.enabled, -1);
 	ERR_FAIL_UNSIGNED_INDEX_V(p_compressed_track, compression.bounds.size(), -1);
 
 	int key_count = 0;
-
-	for (const Compression::Page &page : compression.pages) {
-		const uint8_t *page_data = page.data.ptr();
-		// Little endian assumed. No major big endian hardware exists any longer, but in case it does it will need to be supported.
-		const uint32_t *indices = (const uint32_t *)page_data;
-		const uint16_t *time_keys = (const uint16_t *)&page_data[indices[p_compressed_track * 3 + 0]];
-		uint32_t time_key_count = indices[p_compressed_track * 3 + 1];
-
-		for (uint32_t j = 0; j < time_key_count; j++) {
-			key_count += (time_keys[j * 2 + 1] >> 12) + 1;
-		}
+	for (uint32_t p = 0; p < compression.pages.size(); p++) {
+		key_count += _get_compressed_page_key_count(p, p_compressed_track);
 	}
-
 	return key_count;
 }
 
@@ -5603,8 +5833,18 @@ bool Animation::_fetch_compressed_by_index(uint32_t p_compressed_track, int p_in
 	ERR_FAIL_COND_V(!compression.enabled, false);
 	ERR_FAIL_UNSIGNED_INDEX_V(p_compressed_track, compression.bounds.size(), false);
 
-	for (const Compression::Page &page : compression.pages) {
-		const uint8_t *page_data = page.data.ptr();
+	for (uint32_t p = 0; p < compression.pages.size(); p++) {
+		// Pages before the key are skipped by their key count, which streamed pages have without being loaded.
+		const uint32_t page_key_count = _get_compressed_page_key_count(p, p_compressed_track);
+		if ((uint32_t)p_index >= page_key_count) {
+			p_index -= page_key_count;
+			continue;
+		}
+
+		const Compression::Page &page = compression.pages[p];
+		Vector<uint8_t> page_holder;
+		const uint8_t *page_data = _get_compressed_page_data(p, page_holder);
+		ERR_FAIL_NULL_V(page_data, false);
 		// Little endian assumed. No major big endian hardware exists any longer, but in case it does it will need to be supported.
 		const uint32_t *indices = (const uint32_t *)page_data;
 		const uint16_t *time_keys = (const uint16_t *)&page_data[indices[p_compressed_track * 3 + 0]];
@@ -6552,6 +6792,7 @@ Animation::Animation() {
 }
 
 Animation::~Animation() {
+	_clear_streamed_pages();
 	for (uint32_t i = 0; i < tracks.size(); i++) {
 		memdelete(tracks[i]);
 	}
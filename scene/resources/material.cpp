@@ -654,13 +654,28 @@ void BaseMaterial3D::finish_shaders() {
 }
 
 void BaseMaterial3D::_update_shader() {
+	MaterialKey mk;
+	String code;
+	if (!_prepare_shader_update(mk, code)) {
+		return;
+	}
+
+	// We must create the shader outside the shader_map_mutex to avoid potential deadlocks with
+	// other tasks in the WorkerThreadPool simultaneously creating materials, which
+	// may also hold the shared shader_map_mutex lock.
+	RID new_shader = RS::get_singleton()->shader_create_from_code(code);
+
+	_finish_shader_update(mk, new_shader);
+}
+
+bool BaseMaterial3D::_prepare_shader_update(MaterialKey &r_key, String &r_code) {
 	if (!_is_initialized()) {
 		_mark_ready();
 	}
 
 	MaterialKey mk = _compute_key();
 	if (mk == current_key) {
-		return; //no update required in the end
+		return false; //no update required in the end
 	}
 
 	{
@@ -687,7 +702,7 @@ void BaseMaterial3D::_update_shader() {
 				RS::get_singleton()->material_set_shader(_get_material(), shader_rid);
 			}
 
-			return;
+			return false;
 		}
 	}
 
@@ -2037,24 +2052,29 @@ void fragment() {)";
 
 	code += "}\n";
 
-	// We must create the shader outside the shader_map_mutex to avoid potential deadlocks with
-	// other tasks in the WorkerThreadPool simultaneously creating materials, which
-	// may also hold the shared shader_map_mutex lock.
-	RID new_shader = RS::get_singleton()->shader_create_from_code(code);
+	r_key = mk;
+	r_code = code;
+	return true;
+}
 
+void BaseMaterial3D::_finish_shader_update(const MaterialKey &p_key, RID p_shader) {
 	MutexLock lock(shader_map_mutex);
 
-	ShaderData *v = shader_map.getptr(mk);
+	ShaderData *v = shader_map.getptr(p_key);
 	if (unlikely(v)) {
 		// We raced and managed to create the same key concurrently, so we'll free the shader we just created,
-		// given we know it isn't used, and use the winner.
-		RS::get_singleton()->free_rid(new_shader);
+		// given we know it isn't used, and use the winner. No shader is passed when the material shares
+		// the one created for another material in the same flush, which has already been registered.
+		if (p_shader.is_valid()) {
+			RS::get_singleton()->free_rid(p_shader);
+		}
 	} else {
+		ERR_FAIL_COND(p_shader.is_null());
 		ShaderData shader_data;
-		shader_data.shader = new_shader;
+		shader_data.shader = p_shader;
 		// ShaderData will be inserted with a users count of 0, but we
 		// increment unconditionally outside this if block, whilst still under lock.
-		v = &shader_map.insert(mk, shader_data)->value;
+		v = &shader_map.insert(p_key, shader_data)->value;
 	}
 
 	shader_rid = v->shader;
@@ -2093,9 +2113,45 @@ void BaseMaterial3D::flush_changes() {
 		}
 	}
 
+	// Create all the shaders that are missing first, so that their code can be set, and thus compiled, in a single batch.
+	// Materials that end up with the same key share the shader created for the first of them.
+	LocalVector<BaseMaterial3D *> materials;
+	LocalVector<MaterialKey> keys;
+	LocalVector<RID> material_shaders;
+	HashSet<MaterialKey, MaterialKey> created_keys;
+	Vector<RID> shaders;
+	Vector<String> codes;
+
 	while (SelfList<BaseMaterial3D> *E = copy.first()) {
-		E->self()->_update_shader();
+		BaseMaterial3D *material = E->self();
 		copy.remove(E);
+
+		MaterialKey mk;
+		String code;
+		if (!material->_prepare_shader_update(mk, code)) {
+			continue;
+		}
+
+		RID shader;
+		if (!created_keys.has(mk)) {
+			created_keys.insert(mk);
+			shader = RS::get_singleton()->shader_create();
+			shaders.push_back(shader);
+			codes.push_back(code);
+		}
+		materials.push_back(material);
+		keys.push_back(mk);
+		material_shaders.push_back(shader);
+	}
+
+	if (shaders.is_empty()) {
+		return;
+	}
+
+	RS::get_singleton()->shaders_set_code(shaders, codes);
+
+	for (uint32_t i = 0; i < materials.size(); i++) {
+		materials[i]->_finish_shader_update(keys[i], material_shaders[i]);
 	}
 }
 
@@ -527,6 +527,8 @@ private:
 	SelfList<BaseMaterial3D> element;
 
 	void _update_shader();
+	bool _prepare_shader_update(MaterialKey &r_key, String &r_code);
+	void _finish_shader_update(const MaterialKey &p_key, RID p_shader);
 	_FORCE_INLINE_ void _queue_shader_change();
 	void _check_material_rid();
 	void _material_set_param(const StringName &p_name, const Variant &p_value);
@@ -97,6 +97,10 @@ void AudioDriverDummy::set_use_threads(bool p_use_threads) {
 	use_threads = p_use_threads;
 }
 
+bool AudioDriverDummy::is_using_threads() const {
+	return use_threads;
+}
+
 void AudioDriverDummy::set_speaker_mode(SpeakerMode p_mode) {
 	speaker_mode = p_mode;
 }
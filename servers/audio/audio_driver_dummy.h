@@ -71,6 +71,7 @@ public:
 	virtual void finish() override;
 
 	void set_use_threads(bool p_use_threads);
+	bool is_using_threads() const;
 	void set_speaker_mode(SpeakerMode p_mode);
 	void set_mix_rate(int p_rate);
 
@@ -30,7 +30,9 @@
 
 #include "audio_filter_sw.h"
 
+#include "core/math/audio_frame.h"
 #include "core/math/math_funcs.h"
+#include "servers/audio/audio_mix_simd.h"
 
 void AudioFilterSW::set_mode(Mode p_mode) {
 	mode = p_mode;
@@ -260,3 +262,65 @@ void AudioFilterSW::Processor::process(float *p_samples, int p_amount, int p_str
 		}
 	}
 }
+
+void AudioFilterSW::Processor::process_stereo_interp(Processor *p_left, Processor *p_right, AudioFrame *p_frames, int p_amount) {
+#ifdef AUDIO_MIX_SIMD_ENABLED
+	using namespace AudioMixSIMD;
+
+	// One lane per channel. Operations are kept in the same order and precision as process_one_interp().
+	Vec2d b0 = set_pair(p_left->coeffs.b0, p_right->coeffs.b0);
+	Vec2d b1 = set_pair(p_left->coeffs.b1, p_right->coeffs.b1);
+	Vec2d b2 = set_pair(p_left->coeffs.b2, p_right->coeffs.b2);
+	Vec2d a1 = set_pair(p_left->coeffs.a1, p_right->coeffs.a1);
+	Vec2d a2 = set_pair(p_left->coeffs.a2, p_right->coeffs.a2);
+	const Vec2d incr_b0 = set_pair(p_left->incr_coeffs.b0, p_right->incr_coeffs.b0);
+	const Vec2d incr_b1 = set_pair(p_left->incr_coeffs.b1, p_right->incr_coeffs.b1);
+	const Vec2d incr_b2 = set_pair(p_left->incr_coeffs.b2, p_right->incr_coeffs.b2);
+	const Vec2d incr_a1 = set_pair(p_left->incr_coeffs.a1, p_right->incr_coeffs.a1);
+	const Vec2d incr_a2 = set_pair(p_left->incr_coeffs.a2, p_right->incr_coeffs.a2);
+	Vec2d ha1 = set_pair(p_left->ha1, p_right->ha1);
+	Vec2d ha2 = set_pair(p_left->ha2, p_right->ha2);
+	Vec2d hb1 = set_pair(p_left->hb1, p_right->hb1);
+	Vec2d hb2 = set_pair(p_left->hb2, p_right->hb2);
+
+	for (int i = 0; i < p_amount; i++) {
+		const Vec2d pre = load_pair(&p_frames[i].left);
+		const Vec2d result = add(add(add(add(mul(pre, b0), mul(hb1, b1)), mul(hb2, b2)), mul(ha1, a1)), mul(ha2, a2));
+		store_pair(&p_frames[i].left, result);
+		ha2 = ha1;
+		hb2 = hb1;
+		hb1 = pre;
+		ha1 = round_to_float(result);
+
+		b0 = add(b0, incr_b0);
+		b1 = add(b1, incr_b1);
+		b2 = add(b2, incr_b2);
+		a1 = add(a1, incr_a1);
+		a2 = add(a2, incr_a2);
+	}
+
+	p_left->coeffs.b0 = get_first(b0);
+	p_left->coeffs.b1 = get_first(b1);
+	p_left->coeffs.b2 = get_first(b2);
+	p_left->coeffs.a1 = get_first(a1);
+	p_left->coeffs.a2 = get_first(a2);
+	p_right->coeffs.b0 = get_second(b0);
+	p_right->coeffs.b1 = get_second(b1);
+	p_right->coeffs.b2 = get_second(b2);
+	p_right->coeffs.a1 = get_second(a1);
+	p_right->coeffs.a2 = get_second(a2);
+	p_left->ha1 = get_first(ha1);
+	p_left->ha2 = get_first(ha2);
+	p_left->hb1 = get_first(hb1);
+	p_left->hb2 = get_first(hb2);
+	p_right->ha1 = get_second(ha1);
+	p_right->ha2 = get_second(ha2);
+	p_right->hb1 = get_second(hb1);
+	p_right->hb2 = get_second(hb2);
+#else
+	for (int i = 0; i < p_amount; i++) {
+		p_left->process_one_interp(p_frames[i].left);
+		p_right->process_one_interp(p_frames[i].right);
+	}
+#endif
+}
@@ -32,6 +32,8 @@
 
 #include "core/typedefs.h"
 
+struct AudioFrame;
+
 class AudioFilterSW {
 public:
 	struct Coeffs {
@@ -70,6 +72,9 @@ public:
 		_ALWAYS_INLINE_ void process_one(float &p_sample);
 		_ALWAYS_INLINE_ void process_one_interp(float &p_sample);
 
+		// Same as calling process_one_interp() on the left and right channels of every frame, but processes both channels at once.
+		static void process_stereo_interp(Processor *p_left, Processor *p_right, AudioFrame *p_frames, int p_amount);
+
 		Processor();
 	};
 
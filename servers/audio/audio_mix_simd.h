@@ -0,0 +1,183 @@
+/**************************************************************************/
+/*  audio_mix_simd.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/math/audio_frame.h"
+
+// SSE2 is part of the x86_64 baseline and NEON of arm64, so these kernels are selected at compile time.
+// Other targets use the scalar versions. Every kernel performs the same operations in the same order and
+// precision as its scalar version, and the build disables floating-point contraction, so results are identical.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define AUDIO_MIX_SIMD_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#define AUDIO_MIX_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+namespace AudioMixSIMD {
+
+#if defined(AUDIO_MIX_SIMD_SSE2)
+typedef __m128 Vec4;
+_ALWAYS_INLINE_ Vec4 load(const float *p_src) { return _mm_loadu_ps(p_src); }
+_ALWAYS_INLINE_ void store(float *p_dst, Vec4 p_value) { _mm_storeu_ps(p_dst, p_value); }
+_ALWAYS_INLINE_ Vec4 set(float p_a, float p_b, float p_c, float p_d) { return _mm_setr_ps(p_a, p_b, p_c, p_d); }
+_ALWAYS_INLINE_ Vec4 splat(float p_value) { return _mm_set1_ps(p_value); }
+_ALWAYS_INLINE_ Vec4 add(Vec4 p_a, Vec4 p_b) { return _mm_add_ps(p_a, p_b); }
+_ALWAYS_INLINE_ Vec4 sub(Vec4 p_a, Vec4 p_b) { return _mm_sub_ps(p_a, p_b); }
+_ALWAYS_INLINE_ Vec4 mul(Vec4 p_a, Vec4 p_b) { return _mm_mul_ps(p_a, p_b); }
+_ALWAYS_INLINE_ Vec4 div(Vec4 p_a, Vec4 p_b) { return _mm_div_ps(p_a, p_b); }
+_ALWAYS_INLINE_ void store_low(float *p_dst, Vec4 p_value) { _mm_storel_pi((__m64 *)p_dst, p_value); }
+
+// Stereo pairs in double precision, used by filters whose coefficients are doubles.
+typedef __m128d Vec2d;
+_ALWAYS_INLINE_ Vec2d load_pair(const float *p_src) { return _mm_cvtps_pd(_mm_castsi128_ps(_mm_loadl_epi64((const __m128i *)p_src))); }
+_ALWAYS_INLINE_ void store_pair(float *p_dst, Vec2d p_value) { _mm_storel_pi((__m64 *)p_dst, _mm_cvtpd_ps(p_value)); }
+_ALWAYS_INLINE_ Vec2d set_pair(double p_a, double p_b) { return _mm_setr_pd(p_a, p_b); }
+_ALWAYS_INLINE_ Vec2d add(Vec2d p_a, Vec2d p_b) { return _mm_add_pd(p_a, p_b); }
+_ALWAYS_INLINE_ Vec2d mul(Vec2d p_a, Vec2d p_b) { return _mm_mul_pd(p_a, p_b); }
+_ALWAYS_INLINE_ Vec2d round_to_float(Vec2d p_value) { return _mm_cvtps_pd(_mm_cvtpd_ps(p_value)); }
+_ALWAYS_INLINE_ double get_first(Vec2d p_value) { return _mm_cvtsd_f64(p_value); }
+_ALWAYS_INLINE_ double get_second(Vec2d p_value) { return _mm_cvtsd_f64(_mm_unpackhi_pd(p_value, p_value)); }
+#elif defined(AUDIO_MIX_SIMD_NEON)
+typedef float32x4_t Vec4;
+_ALWAYS_INLINE_ Vec4 load(const float *p_src) { return vld1q_f32(p_src); }
+_ALWAYS_INLINE_ void store(float *p_dst, Vec4 p_value) { vst1q_f32(p_dst, p_value); }
+_ALWAYS_INLINE_ Vec4 set(float p_a, float p_b, float p_c, float p_d) {
+	const float values[4] = { p_a, p_b, p_c, p_d };
+	return vld1q_f32(values);
+}
+_ALWAYS_INLINE_ Vec4 splat(float p_value) { return vdupq_n_f32(p_value); }
+_ALWAYS_INLINE_ Vec4 add(Vec4 p_a, Vec4 p_b) { return vaddq_f32(p_a, p_b); }
+_ALWAYS_INLINE_ Vec4 sub(Vec4 p_a, Vec4 p_b) { return vsubq_f32(p_a, p_b); }
+_ALWAYS_INLINE_ Vec4 mul(Vec4 p_a, Vec4 p_b) { return vmulq_f32(p_a, p_b); }
+_ALWAYS_INLINE_ Vec4 div(Vec4 p_a, Vec4 p_b) { return vdivq_f32(p_a, p_b); }
+_ALWAYS_INLINE_ void store_low(float *p_dst, Vec4 p_value) { vst1_f32(p_dst, vget_low_f32(p_value)); }
+
+// Stereo pairs in double precision, used by filters whose coefficients are doubles.
+typedef float64x2_t Vec2d;
+_ALWAYS_INLINE_ Vec2d load_pair(const float *p_src) { return vcvt_f64_f32(vld1_f32(p_src)); }
+_ALWAYS_INLINE_ void store_pair(float *p_dst, Vec2d p_value) { vst1_f32(p_dst, vcvt_f32_f64(p_value)); }
+_ALWAYS_INLINE_ Vec2d set_pair(double p_a, double p_b) { return vcombine_f64(vdup_n_f64(p_a), vdup_n_f64(p_b)); }
+_ALWAYS_INLINE_ Vec2d add(Vec2d p_a, Vec2d p_b) { return vaddq_f64(p_a, p_b); }
+_ALWAYS_INLINE_ Vec2d mul(Vec2d p_a, Vec2d p_b) { return vmulq_f64(p_a, p_b); }
+_ALWAYS_INLINE_ Vec2d round_to_float(Vec2d p_value) { return vcvt_f64_f32(vcvt_f32_f64(p_value)); }
+_ALWAYS_INLINE_ double get_first(Vec2d p_value) { return vgetq_lane_f64(p_value, 0); }
+_ALWAYS_INLINE_ double get_second(Vec2d p_value) { return vgetq_lane_f64(p_value, 1); }
+#endif
+
+#if defined(AUDIO_MIX_SIMD_SSE2) || defined(AUDIO_MIX_SIMD_NEON)
+#define AUDIO_MIX_SIMD_ENABLED
+// Two stereo frames per vector.
+_ALWAYS_INLINE_ Vec4 load_frames(const AudioFrame *p_src) { return load(&p_src->left); }
+_ALWAYS_INLINE_ Vec4 load_frames(const AudioFrame &p_a, const AudioFrame &p_b) { return set(p_a.left, p_a.right, p_b.left, p_b.right); }
+_ALWAYS_INLINE_ void store_frames(AudioFrame *p_dst, Vec4 p_value) { store(&p_dst->left, p_value); }
+_ALWAYS_INLINE_ void store_frame(AudioFrame *p_dst, Vec4 p_value) { store_low(&p_dst->left, p_value); }
+#endif
+
+// Applies a linear volume ramp from p_vol_start to p_vol_final to p_src, writing (or adding, if ACCUMULATE) the result to p_dst.
+// The ramp spans p_ramp_length frames, and p_src starts p_ramp_offset frames into it.
+template <bool ACCUMULATE>
+void volume_ramp(AudioFrame *p_dst, const AudioFrame *p_src, uint32_t p_frames, AudioFrame p_vol_start, AudioFrame p_vol_final, uint32_t p_ramp_offset, uint32_t p_ramp_length) {
+	uint32_t i = 0;
+#ifdef AUDIO_MIX_SIMD_ENABLED
+	const Vec4 one = splat(1.0f);
+	const Vec4 ramp_length = splat(float(p_ramp_length));
+	const Vec4 vol_start = load_frames(p_vol_start, p_vol_start);
+	const Vec4 vol_final = load_frames(p_vol_final, p_vol_final);
+	const Vec4 index_step = splat(2.0f);
+	Vec4 index = set(p_ramp_offset, p_ramp_offset, p_ramp_offset + 1, p_ramp_offset + 1);
+	for (; i + 2 <= p_frames; i += 2) {
+		const Vec4 lerp_param = div(index, ramp_length);
+		const Vec4 vol = add(mul(vol_final, lerp_param), mul(sub(one, lerp_param), vol_start));
+		Vec4 mixed = mul(vol, load_frames(p_src + i));
+		if constexpr (ACCUMULATE) {
+			mixed = add(load_frames(p_dst + i), mixed);
+		}
+		store_frames(p_dst + i, mixed);
+		index = add(index, index_step);
+	}
+#endif
+	for (; i < p_frames; i++) {
+		float lerp_param = (float)(p_ramp_offset + i) / p_ramp_length;
+		AudioFrame mixed = (p_vol_final * lerp_param + (1 - lerp_param) * p_vol_start) * p_src[i];
+		if constexpr (ACCUMULATE) {
+			p_dst[i] += mixed;
+		} else {
+			p_dst[i] = mixed;
+		}
+	}
+}
+
+// Cubic (Hermite) interpolation of two output frames at once. p_a and p_b point to the four history frames of each output frame.
+_ALWAYS_INLINE_ void cubic_interpolate_2(AudioFrame *p_dst, const AudioFrame *p_a, const AudioFrame *p_b, float p_mu_a, float p_mu_b) {
+	const float mu2_a = p_mu_a * p_mu_a;
+	const float h11_a = mu2_a * (p_mu_a - 1);
+	const float z_a = mu2_a - h11_a;
+	const float h01_a = z_a - h11_a;
+	const float h10_a = p_mu_a - z_a;
+
+	const float mu2_b = p_mu_b * p_mu_b;
+	const float h11_b = mu2_b * (p_mu_b - 1);
+	const float z_b = mu2_b - h11_b;
+	const float h01_b = z_b - h11_b;
+	const float h10_b = p_mu_b - z_b;
+
+#ifdef AUDIO_MIX_SIMD_ENABLED
+	const Vec4 y0 = load_frames(p_a[0], p_b[0]);
+	const Vec4 y1 = load_frames(p_a[1], p_b[1]);
+	const Vec4 y2 = load_frames(p_a[2], p_b[2]);
+	const Vec4 y3 = load_frames(p_a[3], p_b[3]);
+	const Vec4 h01 = set(h01_a, h01_a, h01_b, h01_b);
+	const Vec4 h10 = set(h10_a, h10_a, h10_b, h10_b);
+	const Vec4 h11 = set(h11_a, h11_a, h11_b, h11_b);
+	const Vec4 result = add(add(y1, mul(sub(y2, y1), h01)), mul(add(mul(sub(y2, y0), h10), mul(sub(y3, y1), h11)), splat(0.5f)));
+	store_frames(p_dst, result);
+#else
+	p_dst[0] = p_a[1] + (p_a[2] - p_a[1]) * h01_a + ((p_a[2] - p_a[0]) * h10_a + (p_a[3] - p_a[1]) * h11_a) * 0.5;
+	p_dst[1] = p_b[1] + (p_b[2] - p_b[1]) * h01_b + ((p_b[2] - p_b[0]) * h10_b + (p_b[3] - p_b[1]) * h11_b) * 0.5;
+#endif
+}
+
+// Adds p_src to p_dst.
+inline void accumulate(AudioFrame *p_dst, const AudioFrame *p_src, uint32_t p_frames) {
+	uint32_t i = 0;
+#ifdef AUDIO_MIX_SIMD_ENABLED
+	for (; i + 2 <= p_frames; i += 2) {
+		store_frames(p_dst + i, add(load_frames(p_dst + i), load_frames(p_src + i)));
+	}
+#endif
+	for (; i < p_frames; i++) {
+		p_dst[i] += p_src[i];
+	}
+}
+
+} // namespace AudioMixSIMD
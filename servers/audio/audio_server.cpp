@@ -36,11 +36,13 @@
 #include "core/io/resource_loader.h"
 #include "core/math/audio_frame.h"
 #include "core/object/class_db.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 #include "core/string/string_name.h"
 #include "core/templates/pair.h"
 #include "scene/scene_string_names.h"
 #include "servers/audio/audio_driver_dummy.h"
+#include "servers/audio/audio_mix_simd.h"
 #include "servers/audio/audio_stream.h"
 #include "servers/audio/effects/audio_effect_compressor.h"
 
@@ -394,288 +396,519 @@ void AudioServer::_mix_step() {
 	// Main mixing loop for audio streams.
 	// The basic idea here is to copy the samples returned by the AudioStreamPlayback's mix function into the audio buffers,
 	//  while always maintaining a lookahead buffer of size LOOKAHEAD_BUFFER_SIZE to allow fade-outs for sudden stoppages.
-	for (AudioStreamPlaybackListNode *playback : playback_list) {
-		// Paused streams are no-ops. Don't even mix audio from the stream playback.
-		if (playback->state.load() == AudioStreamPlaybackListNode::PAUSED) {
-			continue;
-		}
-
-		if (playback->stream_playback->get_is_sample()) {
-			continue;
-		}
-
-		// If `fading_out` is true, we're in the process of fading out the stream playback.
-		// TODO: Currently this sets the volume of the stream to 0 which creates a linear interpolation between its previous volume and silence.
-		//  A more punchy option for fading out could be to just use the lookahead buffer.
-		bool fading_out = playback->state.load() == AudioStreamPlaybackListNode::FADE_OUT_TO_DELETION || playback->state.load() == AudioStreamPlaybackListNode::FADE_OUT_TO_PAUSE;
-
-		AudioFrame *buf = mix_buffer.ptrw();
-
-		// Copy the old contents of the lookahead buffer into the beginning of the mix buffer.
-		for (int i = 0; i < LOOKAHEAD_BUFFER_SIZE; i++) {
-			buf[i] = playback->lookahead[i];
+	parallel_playbacks.clear();
+	if (parallel_mixing) {
+		for (AudioStreamPlaybackListNode *playback : playback_list) {
+			if (playback->state.load() == AudioStreamPlaybackListNode::PAUSED || playback->stream_playback->get_is_sample()) {
+				continue;
+			}
+			if (playback->mix_buffer.size() != buffer_size + LOOKAHEAD_BUFFER_SIZE) {
+				playback->mix_buffer.resize(buffer_size + LOOKAHEAD_BUFFER_SIZE);
+			}
+			parallel_playbacks.push_back(playback);
 		}
+	}
 
-		// Mix the audio stream.
-		unsigned int mixed_frames = playback->stream_playback->mix(&buf[LOOKAHEAD_BUFFER_SIZE], playback->pitch_scale.get(), buffer_size);
+	if (parallel_playbacks.size() > 1) {
+		// Rendering a stream only touches its own playback, so all of them can be rendered at once.
+		// Mixing into the buses is done afterwards in list order, so the result matches serial mixing.
+		_mix_step_run_parallel(&AudioServer::_mix_step_render_parallel_playback, parallel_playbacks.size());
 
-		if (tag_used_audio_streams && playback->stream_playback->is_playing()) {
-			playback->stream_playback->tag_used_streams();
+		for (AudioStreamPlaybackListNode *playback : parallel_playbacks) {
+			if (!_mix_step_mix_playback(playback, playback->mix_buffer.ptr())) {
+				return;
+			}
 		}
+	} else {
+		for (AudioStreamPlaybackListNode *playback : playback_list) {
+			// Paused streams are no-ops. Don't even mix audio from the stream playback.
+			if (playback->state.load() == AudioStreamPlaybackListNode::PAUSED) {
+				continue;
+			}
 
-		// Check to see if the stream has run out of samples.
-		if (mixed_frames != buffer_size) {
-			// We know we have at least the size of our lookahead buffer for fade-out purposes.
-
-			float fadeout_base = 0.94;
-			float fadeout_coefficient = 1;
-			static_assert(LOOKAHEAD_BUFFER_SIZE == 64, "Update fadeout_base and comment here if you change LOOKAHEAD_BUFFER_SIZE.");
-			// 0.94 ^ 64 = 0.01906. There might still be a pop but it'll be way better than if we didn't do this.
-			for (unsigned int idx = mixed_frames; idx < buffer_size; idx++) {
-				fadeout_coefficient *= fadeout_base;
-				buf[idx] *= fadeout_coefficient;
+			if (playback->stream_playback->get_is_sample()) {
+				continue;
 			}
-			AudioStreamPlaybackListNode::PlaybackState new_state;
-			new_state = AudioStreamPlaybackListNode::AWAITING_DELETION;
-			playback->state.store(new_state);
-		} else {
-			// Move the last little bit of what we just mixed into our lookahead buffer for the next call to _mix_step.
-			for (int i = 0; i < LOOKAHEAD_BUFFER_SIZE; i++) {
-				playback->lookahead[i] = buf[buffer_size + i];
+
+			AudioFrame *buf = mix_buffer.ptrw();
+			_mix_step_render_playback(playback, buf);
+			if (!_mix_step_mix_playback(playback, buf)) {
+				return;
 			}
 		}
+	}
 
-		// Get the bus details for this playback. This contains information about which buses the playback is assigned to and the volume of the playback on each bus.
-		AudioStreamPlaybackBusDetails *bus_details_ptr = playback->bus_details.load();
-		ERR_FAIL_NULL(bus_details_ptr);
-		// Make a copy of the bus details so we can modify it without worrying about other threads.
-		AudioStreamPlaybackBusDetails bus_details = *bus_details_ptr;
+	// Now that all of the buses have their audio sources mixed into them, we can process the effects and bus sends.
+	if (parallel_mixing && buses.size() > 2) {
+		_mix_step_process_buses_parallel(solo_mode);
+	} else {
+		for (int i = buses.size() - 1; i >= 0; i--) {
+			Bus *bus = buses[i];
+			_mix_step_process_bus(bus, solo_mode, temp_buffer);
 
-		// Mix to any active buses.
-		for (int idx = 0; idx < MAX_BUSES_PER_PLAYBACK; idx++) {
-			if (!bus_details.bus_active[idx]) {
+			// Process send.
+			Bus *send = _mix_step_get_bus_send(i);
+			if (!send) {
 				continue;
 			}
-			// This is the AudioServer-internal index of the bus we're mixing to in this step of the loop. Not to be confused with `idx` which is an index into `AudioStreamPlaybackBusDetails` member var arrays.
-			int bus_idx = thread_find_bus_index(bus_details.bus[idx]);
-
-			// It's important to know whether or not this bus was active in the previous mix step of this stream. If it was, we need to perform volume interpolation to avoid pops.
-			int prev_bus_idx = -1;
-			for (int search_idx = 0; search_idx < MAX_BUSES_PER_PLAYBACK; search_idx++) {
-				if (!playback->prev_bus_details->bus_active[search_idx]) {
+			for (int k = 0; k < bus->channels.size(); k++) {
+				if (!bus->channels[k].active) {
 					continue;
 				}
-				// If the StringNames of the buses match, we've found the previous bus index. This indicates that this playback mixed to `prev_bus_details->bus[prev_bus_index]` in the previous mix step, which gives us a way to look up the playback's previous volume.
-				if (playback->prev_bus_details->bus[search_idx].hash() == bus_details.bus[idx].hash()) {
-					prev_bus_idx = search_idx;
-					break;
+				const AudioFrame *buf = bus->channels[k].buffer.ptr();
+				AudioFrame *target_buf = thread_get_channel_mix_buffer(send->index_cache, k);
+
+				for (uint32_t j = 0; j < buffer_size; j++) {
+					target_buf[j] += buf[j];
 				}
 			}
+		}
+	}
 
-			// It's now time to mix to the bus. We do this by going through each channel of the bus and mixing to it.
-			//  The channels correspond to output channels of the audio device, e.g. stereo or 5.1. To reduce needless nesting, this is done with a helper method named `_mix_step_for_channel`.
-			for (int channel_idx = 0; channel_idx < channel_count; channel_idx++) {
-				AudioFrame *channel_buf = thread_get_channel_mix_buffer(bus_idx, channel_idx);
-				// TODO: This `fading_out` check could be replaced with with an exponential fadeout of the samples from the lookahead buffer for more punchy results.
-				if (fading_out) {
-					bus_details.volume[idx][channel_idx] = AudioFrame(0, 0);
-				}
-				AudioFrame channel_vol = bus_details.volume[idx][channel_idx];
+	mix_frames += buffer_size;
+	to_mix = buffer_size;
+}
 
-				// If this bus was not active in the previous mix step, we want to start playback at the full volume to avoid crushing transients.
-				AudioFrame prev_channel_vol = channel_vol;
-				// If this bus was active in the previous mix step, we need to interpolate between the previous volume and the current volume to avoid pops. Set `prev_channel_volume` accordingly.
-				if (prev_bus_idx != -1) {
-					prev_channel_vol = playback->prev_bus_details->volume[prev_bus_idx][channel_idx];
-				}
-				_mix_step_for_channel(channel_buf, buf, prev_channel_vol, channel_vol, playback->attenuation_filter_cutoff_hz.get(), playback->highshelf_gain.get(), &playback->filter_process[channel_idx * 2], &playback->filter_process[channel_idx * 2 + 1]);
-			}
+// Volume reached after mixing p_frames frames of a ramp from p_vol_start to p_vol_final that spans p_ramp_length frames.
+static AudioFrame _get_volume_ramp_end(AudioFrame p_vol_start, AudioFrame p_vol_final, uint32_t p_frames, uint32_t p_ramp_length) {
+	float lerp_param = (float)p_frames / p_ramp_length;
+	return p_vol_final * lerp_param + (1 - lerp_param) * p_vol_start;
+}
+
+void AudioServer::_mix_step_render_playback(AudioStreamPlaybackListNode *p_playback, AudioFrame *p_buf) {
+	// If `mix_fading_out` is true, we're in the process of fading out the stream playback.
+	// TODO: Currently this sets the volume of the stream to 0 which creates a linear interpolation between its previous volume and silence.
+	//  A more punchy option for fading out could be to just use the lookahead buffer.
+	p_playback->mix_fading_out = p_playback->state.load() == AudioStreamPlaybackListNode::FADE_OUT_TO_DELETION || p_playback->state.load() == AudioStreamPlaybackListNode::FADE_OUT_TO_PAUSE;
+
+	if (!p_playback->mix_fading_out) {
+		p_playback->fade_out_frames = 0;
+	}
+
+	// Copy the old contents of the lookahead buffer into the beginning of the mix buffer.
+	for (uint32_t i = 0; i < stream_lookahead; i++) {
+		p_buf[i] = p_playback->lookahead[i];
+	}
+
+	if (p_playback->drain_frames > 0) {
+		// The stream has ended and was already faded out, only what is left of the lookahead buffer is output.
+		for (uint32_t i = stream_lookahead; i < buffer_size + stream_lookahead; i++) {
+			p_buf[i] = AudioFrame(0, 0);
+		}
+		_mix_step_drain_playback(p_playback, p_buf, p_playback->drain_frames);
+		return;
+	}
+
+	// Mix the audio stream.
+	unsigned int mixed_frames = p_playback->stream_playback->mix(&p_buf[stream_lookahead], p_playback->pitch_scale.get(), buffer_size);
+
+	// Check to see if the stream has run out of samples.
+	if (mixed_frames != buffer_size) {
+		// We know we have at least the size of our lookahead buffer for fade-out purposes.
+		// Without lookahead, the last frames that were just mixed are faded out instead, as far as this mix step reaches back.
+
+		float fadeout_base = 0.94;
+		float fadeout_coefficient = 1;
+		static_assert(LOOKAHEAD_BUFFER_SIZE == 64, "Update fadeout_base and comment here if you change LOOKAHEAD_BUFFER_SIZE.");
+		// 0.94 ^ 64 = 0.01906. There might still be a pop but it'll be way better than if we didn't do this.
+		// The fade-out also covers the frames past this mix step, which are kept in the lookahead buffer for the next ones.
+		unsigned int fadeout_from = MAX(int(mixed_frames + stream_lookahead) - LOOKAHEAD_BUFFER_SIZE, 0);
+		for (unsigned int idx = fadeout_from; idx < buffer_size + stream_lookahead; idx++) {
+			fadeout_coefficient *= fadeout_base;
+			p_buf[idx] *= fadeout_coefficient;
 		}
+		_mix_step_drain_playback(p_playback, p_buf, mixed_frames + stream_lookahead);
+	} else {
+		// Move the last little bit of what we just mixed into our lookahead buffer for the next call to _mix_step.
+		for (uint32_t i = 0; i < stream_lookahead; i++) {
+			p_playback->lookahead[i] = p_buf[buffer_size + i];
+		}
+	}
+}
 
-		// Now go through and fade-out any buses that were being played to previously that we missed by going through current data.
-		for (int idx = 0; idx < MAX_BUSES_PER_PLAYBACK; idx++) {
-			if (!playback->prev_bus_details->bus_active[idx]) {
+void AudioServer::_mix_step_drain_playback(AudioStreamPlaybackListNode *p_playback, AudioFrame *p_buf, uint32_t p_frames_left) {
+	if (p_frames_left <= buffer_size) {
+		// Everything that was left of the stream is output in this mix step.
+		p_playback->drain_frames = 0;
+		AudioStreamPlaybackListNode::PlaybackState new_state;
+		new_state = AudioStreamPlaybackListNode::AWAITING_DELETION;
+		p_playback->state.store(new_state);
+		return;
+	}
+	// Mix buffers shorter than the lookahead buffer take several mix steps to output it.
+	p_playback->drain_frames = p_frames_left - buffer_size;
+	for (uint32_t i = 0; i < stream_lookahead; i++) {
+		p_playback->lookahead[i] = p_buf[buffer_size + i];
+	}
+}
+
+void AudioServer::_mix_step_render_parallel_playback(uint32_t p_index) {
+	AudioStreamPlaybackListNode *playback = parallel_playbacks[p_index];
+	_mix_step_render_playback(playback, playback->mix_buffer.ptr());
+}
+
+bool AudioServer::_mix_step_mix_playback(AudioStreamPlaybackListNode *p_playback, AudioFrame *p_buf) {
+	// Tagging writes to the AudioStream, which can be shared by playbacks rendered in parallel. This runs on the mixing thread only.
+	if (tag_used_audio_streams && p_playback->stream_playback->is_playing()) {
+		p_playback->stream_playback->tag_used_streams();
+	}
+
+	// Get the bus details for this playback. This contains information about which buses the playback is assigned to and the volume of the playback on each bus.
+	AudioStreamPlaybackBusDetails *bus_details_ptr = p_playback->bus_details.load();
+	ERR_FAIL_NULL_V(bus_details_ptr, false);
+	// Make a copy of the bus details so we can modify it without worrying about other threads.
+	AudioStreamPlaybackBusDetails bus_details = *bus_details_ptr;
+
+	// Mix to any active buses.
+	for (int idx = 0; idx < MAX_BUSES_PER_PLAYBACK; idx++) {
+		if (!bus_details.bus_active[idx]) {
+			continue;
+		}
+		// This is the AudioServer-internal index of the bus we're mixing to in this step of the loop. Not to be confused with `idx` which is an index into `AudioStreamPlaybackBusDetails` member var arrays.
+		int bus_idx = thread_find_bus_index(bus_details.bus[idx]);
+
+		// It's important to know whether or not this bus was active in the previous mix step of this stream. If it was, we need to perform volume interpolation to avoid pops.
+		int prev_bus_idx = -1;
+		for (int search_idx = 0; search_idx < MAX_BUSES_PER_PLAYBACK; search_idx++) {
+			if (!p_playback->prev_bus_details->bus_active[search_idx]) {
 				continue;
 			}
-			int bus_idx = thread_find_bus_index(playback->prev_bus_details->bus[idx]);
-
-			int current_bus_idx = -1;
-			for (int search_idx = 0; search_idx < MAX_BUSES_PER_PLAYBACK; search_idx++) {
-				if (bus_details.bus[search_idx] == playback->prev_bus_details->bus[idx]) {
-					current_bus_idx = search_idx;
-				}
+			// If the StringNames of the buses match, we've found the previous bus index. This indicates that this playback mixed to `prev_bus_details->bus[prev_bus_index]` in the previous mix step, which gives us a way to look up the playback's previous volume.
+			if (p_playback->prev_bus_details->bus[search_idx].hash() == bus_details.bus[idx].hash()) {
+				prev_bus_idx = search_idx;
+				break;
 			}
-			if (current_bus_idx != -1) {
-				// If we found a corresponding bus in the current bus assignments, we've already mixed to this bus.
-				continue;
+		}
+
+		// It's now time to mix to the bus. We do this by going through each channel of the bus and mixing to it.
+		//  The channels correspond to output channels of the audio device, e.g. stereo or 5.1. To reduce needless nesting, this is done with a helper method named `_mix_step_for_channel`.
+		for (int channel_idx = 0; channel_idx < channel_count; channel_idx++) {
+			AudioFrame *channel_buf = thread_get_channel_mix_buffer(bus_idx, channel_idx);
+			// TODO: This `fading_out` check could be replaced with with an exponential fadeout of the samples from the lookahead buffer for more punchy results.
+			if (p_playback->mix_fading_out) {
+				bus_details.volume[idx][channel_idx] = AudioFrame(0, 0);
 			}
+			AudioFrame channel_vol = bus_details.volume[idx][channel_idx];
 
-			for (int channel_idx = 0; channel_idx < channel_count; channel_idx++) {
-				AudioFrame *channel_buf = thread_get_channel_mix_buffer(bus_idx, channel_idx);
-				AudioFrame prev_channel_vol = playback->prev_bus_details->volume[idx][channel_idx];
-				// Fade out to silence. This could be replaced with an exponential fadeout of the samples from the lookahead buffer for more punchy results.
-				_mix_step_for_channel(channel_buf, buf, prev_channel_vol, AudioFrame(0, 0), playback->attenuation_filter_cutoff_hz.get(), playback->highshelf_gain.get(), &playback->filter_process[channel_idx * 2], &playback->filter_process[channel_idx * 2 + 1]);
+			// If this bus was not active in the previous mix step, we want to start playback at the full volume to avoid crushing transients.
+			AudioFrame prev_channel_vol = channel_vol;
+			// If this bus was active in the previous mix step, we need to interpolate between the previous volume and the current volume to avoid pops. Set `prev_channel_volume` accordingly.
+			if (prev_bus_idx != -1) {
+				prev_channel_vol = p_playback->prev_bus_details->volume[prev_bus_idx][channel_idx];
+			}
+			// Fade-outs must reach silence by the end of the ramp, so they ramp over the frames that are left of it.
+			uint32_t ramp_length = volume_ramp_length;
+			if (p_playback->mix_fading_out) {
+				ramp_length = MAX(volume_ramp_length - MIN(p_playback->fade_out_frames, volume_ramp_length), buffer_size);
 			}
+			_mix_step_for_channel(channel_buf, p_buf, prev_channel_vol, channel_vol, ramp_length, p_playback->attenuation_filter_cutoff_hz.get(), p_playback->highshelf_gain.get(), &p_playback->filter_process[channel_idx * 2], &p_playback->filter_process[channel_idx * 2 + 1]);
+			// With mix buffers shorter than the ramp, the next mix step continues from the volume reached in this one.
+			bus_details.volume[idx][channel_idx] = _get_volume_ramp_end(prev_channel_vol, channel_vol, buffer_size, ramp_length);
 		}
+	}
 
-		// Copy the bus details we mixed with to the previous bus details to maintain volume ramps.
-		for (int i = 0; i < MAX_BUSES_PER_PLAYBACK; i++) {
-			playback->prev_bus_details->bus_active[i] = bus_details.bus_active[i];
-		}
-		for (int i = 0; i < MAX_BUSES_PER_PLAYBACK; i++) {
-			playback->prev_bus_details->bus[i] = bus_details.bus[i];
+	// Now go through and fade-out any buses that were being played to previously that we missed by going through current data.
+	for (int idx = 0; idx < MAX_BUSES_PER_PLAYBACK; idx++) {
+		if (!p_playback->prev_bus_details->bus_active[idx]) {
+			continue;
 		}
-		for (int i = 0; i < MAX_BUSES_PER_PLAYBACK; i++) {
-			for (int j = 0; j < MAX_CHANNELS_PER_BUS; j++) {
-				playback->prev_bus_details->volume[i][j] = bus_details.volume[i][j];
+		int bus_idx = thread_find_bus_index(p_playback->prev_bus_details->bus[idx]);
+
+		int current_bus_idx = -1;
+		for (int search_idx = 0; search_idx < MAX_BUSES_PER_PLAYBACK; search_idx++) {
+			if (bus_details.bus[search_idx] == p_playback->prev_bus_details->bus[idx]) {
+				current_bus_idx = search_idx;
 			}
 		}
+		if (current_bus_idx != -1) {
+			// If we found a corresponding bus in the current bus assignments, we've already mixed to this bus.
+			continue;
+		}
 
-		switch (playback->state.load()) {
-			case AudioStreamPlaybackListNode::AWAITING_DELETION:
-			case AudioStreamPlaybackListNode::FADE_OUT_TO_DELETION:
+		for (int channel_idx = 0; channel_idx < channel_count; channel_idx++) {
+			AudioFrame *channel_buf = thread_get_channel_mix_buffer(bus_idx, channel_idx);
+			AudioFrame prev_channel_vol = p_playback->prev_bus_details->volume[idx][channel_idx];
+			// Fade out to silence. This could be replaced with an exponential fadeout of the samples from the lookahead buffer for more punchy results.
+			// The bus is forgotten after this mix step, so the fade-out has to finish within it.
+			_mix_step_for_channel(channel_buf, p_buf, prev_channel_vol, AudioFrame(0, 0), buffer_size, p_playback->attenuation_filter_cutoff_hz.get(), p_playback->highshelf_gain.get(), &p_playback->filter_process[channel_idx * 2], &p_playback->filter_process[channel_idx * 2 + 1]);
+		}
+	}
+
+	// Copy the bus details we mixed with to the previous bus details to maintain volume ramps.
+	for (int i = 0; i < MAX_BUSES_PER_PLAYBACK; i++) {
+		p_playback->prev_bus_details->bus_active[i] = bus_details.bus_active[i];
+	}
+	for (int i = 0; i < MAX_BUSES_PER_PLAYBACK; i++) {
+		p_playback->prev_bus_details->bus[i] = bus_details.bus[i];
+	}
+	for (int i = 0; i < MAX_BUSES_PER_PLAYBACK; i++) {
+		for (int j = 0; j < MAX_CHANNELS_PER_BUS; j++) {
+			p_playback->prev_bus_details->volume[i][j] = bus_details.volume[i][j];
+		}
+	}
+
+	// Fade-outs can span several mix steps when the mix buffer is shorter than the volume ramp.
+	bool fade_out_finished = true;
+	if (p_playback->mix_fading_out) {
+		p_playback->fade_out_frames += buffer_size;
+		fade_out_finished = p_playback->fade_out_frames >= volume_ramp_length;
+	}
+
+	switch (p_playback->state.load()) {
+		case AudioStreamPlaybackListNode::AWAITING_DELETION:
+			// Remove the playback from the list.
+			_delete_stream_playback_list_node(p_playback);
+			break;
+		case AudioStreamPlaybackListNode::FADE_OUT_TO_DELETION:
+			if (fade_out_finished) {
 				// Remove the playback from the list.
-				_delete_stream_playback_list_node(playback);
-				break;
-			case AudioStreamPlaybackListNode::FADE_OUT_TO_PAUSE: {
+				_delete_stream_playback_list_node(p_playback);
+			}
+			break;
+		case AudioStreamPlaybackListNode::FADE_OUT_TO_PAUSE: {
+			if (fade_out_finished) {
 				// Pause the stream.
-				playback->state.store(AudioStreamPlaybackListNode::PAUSED);
-			} break;
-			case AudioStreamPlaybackListNode::PLAYING:
-			case AudioStreamPlaybackListNode::PAUSED:
-				// No-op!
-				break;
-		}
+				p_playback->state.store(AudioStreamPlaybackListNode::PAUSED);
+			}
+		} break;
+		case AudioStreamPlaybackListNode::PLAYING:
+		case AudioStreamPlaybackListNode::PAUSED:
+			// No-op!
+			break;
 	}
 
-	// Now that all of the buses have their audio sources mixed into them, we can process the effects and bus sends.
-	for (int i = buses.size() - 1; i >= 0; i--) {
-		Bus *bus = buses[i];
+	return true;
+}
 
-		for (int k = 0; k < bus->channels.size(); k++) {
-			if (bus->channels[k].active && !bus->channels[k].used) {
-				// Buffer was not used, but it's still active, so it must be cleaned.
-				AudioFrame *buf = bus->channels.write[k].buffer.ptrw();
+AudioServer::Bus *AudioServer::_mix_step_get_bus_send(int p_bus) const {
+	if (p_bus == 0) {
+		return nullptr; // Everything has a send except for the master bus.
+	}
+	Bus *bus = buses[p_bus];
+	if (!bus_map.has(bus->send)) {
+		return buses[0];
+	}
+	Bus *send = bus_map[bus->send];
+	if (send->index_cache >= bus->index_cache) { // Invalid, send to master.
+		return buses[0];
+	}
+	return send;
+}
 
-				for (uint32_t j = 0; j < buffer_size; j++) {
-					buf[j] = AudioFrame(0, 0);
-				}
+void AudioServer::_mix_step_process_bus(Bus *p_bus, bool p_solo_mode, Vector<Vector<AudioFrame>> &r_temp_buffer) {
+#ifdef DEBUG_ENABLED
+	uint64_t bus_ticks = OS::get_singleton()->get_ticks_usec();
+#endif
+	for (int k = 0; k < p_bus->channels.size(); k++) {
+		if (p_bus->channels[k].active && !p_bus->channels[k].used) {
+			// Buffer was not used, but it's still active, so it must be cleaned.
+			AudioFrame *buf = p_bus->channels.write[k].buffer.ptrw();
+
+			for (uint32_t j = 0; j < buffer_size; j++) {
+				buf[j] = AudioFrame(0, 0);
 			}
 		}
+	}
 
-		// Process effects.
-		if (!bus->bypass) {
-			for (int j = 0; j < bus->effects.size(); j++) {
-				if (!bus->effects[j].enabled) {
-					continue;
-				}
+	// Process effects.
+	if (!p_bus->bypass) {
+		for (int j = 0; j < p_bus->effects.size(); j++) {
+			if (!p_bus->effects[j].enabled) {
+				continue;
+			}
 
 #ifdef DEBUG_ENABLED
-				uint64_t ticks = OS::get_singleton()->get_ticks_usec();
+			uint64_t ticks = OS::get_singleton()->get_ticks_usec();
 #endif
 
-				for (int k = 0; k < bus->channels.size(); k++) {
-					if (!(bus->channels[k].active || bus->channels[k].effect_instances[j]->process_silence())) {
-						continue;
-					}
-					bus->channels.write[k].effect_instances.write[j]->process(bus->channels[k].buffer.ptr(), temp_buffer.write[k].ptrw(), buffer_size);
+			for (int k = 0; k < p_bus->channels.size(); k++) {
+				if (!(p_bus->channels[k].active || p_bus->channels[k].effect_instances[j]->process_silence())) {
+					continue;
 				}
+				p_bus->channels.write[k].effect_instances.write[j]->process(p_bus->channels[k].buffer.ptr(), r_temp_buffer.write[k].ptrw(), buffer_size);
+			}
 
-				// Swap buffers, so internal buffer always has the right data.
-				for (int k = 0; k < bus->channels.size(); k++) {
-					if (!(buses[i]->channels[k].active || bus->channels[k].effect_instances[j]->process_silence())) {
-						continue;
-					}
-					SWAP(bus->channels.write[k].buffer, temp_buffer.write[k]);
+			// Swap buffers, so internal buffer always has the right data.
+			for (int k = 0; k < p_bus->channels.size(); k++) {
+				if (!(p_bus->channels[k].active || p_bus->channels[k].effect_instances[j]->process_silence())) {
+					continue;
 				}
+				SWAP(p_bus->channels.write[k].buffer, r_temp_buffer.write[k]);
+			}
 
 #ifdef DEBUG_ENABLED
-				bus->effects.write[j].prof_time += OS::get_singleton()->get_ticks_usec() - ticks;
+			p_bus->effects.write[j].prof_time += OS::get_singleton()->get_ticks_usec() - ticks;
 #endif
-			}
 		}
+	}
 
-		// Process send.
+	for (int k = 0; k < p_bus->channels.size(); k++) {
+		if (!p_bus->channels[k].active) {
+			p_bus->channels.write[k].peak_volume = AudioFrame(AUDIO_MIN_PEAK_DB, AUDIO_MIN_PEAK_DB);
+			continue;
+		}
 
-		Bus *send = nullptr;
+		AudioFrame *buf = p_bus->channels.write[k].buffer.ptrw();
 
-		if (i > 0) {
-			// Everything has a send except for the master bus.
-			if (!bus_map.has(bus->send)) {
-				send = buses[0];
-			} else {
-				send = bus_map[bus->send];
-				if (send->index_cache >= bus->index_cache) { // Invalid, send to master.
-					send = buses[0];
-				}
+		AudioFrame peak = AudioFrame(0, 0);
+
+		float volume = Math::db_to_linear(p_bus->volume_db);
+
+		if (p_solo_mode) {
+			if (!p_bus->soloed) {
+				volume = 0.0;
+			}
+		} else {
+			if (p_bus->mute) {
+				volume = 0.0;
 			}
 		}
 
-		for (int k = 0; k < bus->channels.size(); k++) {
-			if (!bus->channels[k].active) {
-				bus->channels.write[k].peak_volume = AudioFrame(AUDIO_MIN_PEAK_DB, AUDIO_MIN_PEAK_DB);
-				continue;
-			}
+		// Apply volume and compute peak.
+		for (uint32_t j = 0; j < buffer_size; j++) {
+			buf[j] *= volume;
 
-			AudioFrame *buf = bus->channels.write[k].buffer.ptrw();
+			float l = Math::abs(buf[j].left);
+			if (l > peak.left) {
+				peak.left = l;
+			}
+			float r = Math::abs(buf[j].right);
+			if (r > peak.right) {
+				peak.right = r;
+			}
+		}
 
-			AudioFrame peak = AudioFrame(0, 0);
+		p_bus->channels.write[k].peak_volume = AudioFrame(Math::linear_to_db(peak.left + AUDIO_PEAK_OFFSET), Math::linear_to_db(peak.right + AUDIO_PEAK_OFFSET));
 
-			float volume = Math::db_to_linear(bus->volume_db);
+		if (!p_bus->channels[k].used) {
+			// See if any audio is contained, because channel was not used.
 
-			if (solo_mode) {
-				if (!bus->soloed) {
-					volume = 0.0;
-				}
-			} else {
-				if (bus->mute) {
-					volume = 0.0;
-				}
+			if (MAX(peak.right, peak.left) > Math::db_to_linear(channel_disable_threshold_db)) {
+				p_bus->channels.write[k].last_mix_with_audio = mix_frames;
+			} else if (mix_frames - p_bus->channels[k].last_mix_with_audio > channel_disable_frames) {
+				p_bus->channels.write[k].active = false;
+				continue; //went inactive, don't mix.
 			}
+		}
+	}
 
-			// Apply volume and compute peak.
-			for (uint32_t j = 0; j < buffer_size; j++) {
-				buf[j] *= volume;
+#ifdef DEBUG_ENABLED
+	p_bus->prof_time += OS::get_singleton()->get_ticks_usec() - bus_ticks;
+#endif
+}
 
-				float l = Math::abs(buf[j].left);
-				if (l > peak.left) {
-					peak.left = l;
-				}
-				float r = Math::abs(buf[j].right);
-				if (r > peak.right) {
-					peak.right = r;
-				}
+void AudioServer::_mix_step_process_buses_parallel(bool p_solo_mode) {
+	// Buses only send to buses with a lower index, so each bus is assigned a level above all the buses sending to it.
+	// Buses on the same level don't depend on each other and are processed at the same time.
+	for (int i = 0; i < buses.size(); i++) {
+		buses[i]->parallel_sources.clear();
+		buses[i]->parallel_level = 0;
+		if (buses[i]->parallel_temp_buffer.size() != channel_count) {
+			buses[i]->parallel_temp_buffer.resize(channel_count);
+		}
+		for (int k = 0; k < channel_count; k++) {
+			if (buses[i]->parallel_temp_buffer[k].size() != int(buffer_size)) {
+				buses[i]->parallel_temp_buffer.write[k].resize(buffer_size);
+			}
+		}
+	}
+	for (int i = buses.size() - 1; i > 0; i--) {
+		Bus *send = _mix_step_get_bus_send(i);
+		send->parallel_sources.push_back(i);
+		send->parallel_level = MAX(send->parallel_level, buses[i]->parallel_level + 1);
+	}
+
+	parallel_mixing_solo_mode = p_solo_mode;
+	// Every bus ends up in the master bus, so it is always on the last level.
+	for (int level = 0; level <= buses[0]->parallel_level; level++) {
+		parallel_buses.clear();
+		for (int i = buses.size() - 1; i >= 0; i--) {
+			if (buses[i]->parallel_level == level) {
+				parallel_buses.push_back(i);
 			}
+		}
+		_mix_step_run_parallel(&AudioServer::_mix_step_process_parallel_bus, parallel_buses.size());
+	}
+}
 
-			bus->channels.write[k].peak_volume = AudioFrame(Math::linear_to_db(peak.left + AUDIO_PEAK_OFFSET), Math::linear_to_db(peak.right + AUDIO_PEAK_OFFSET));
+void AudioServer::_mix_step_run_parallel(void (AudioServer::*p_function)(uint32_t), uint32_t p_element_count) {
+	ParallelMixJob &job = parallel_mix_job;
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
 
-			if (!bus->channels[k].used) {
-				// See if any audio is contained, because channel was not used.
+	bool helpers_available = true;
+	if (job.helper_group != WorkerThreadPool::INVALID_TASK_ID) {
+		if (pool->is_group_task_completed(job.helper_group)) {
+			pool->wait_for_group_task_completion(job.helper_group);
+			job.helper_group = WorkerThreadPool::INVALID_TASK_ID;
+		} else {
+			helpers_available = false;
+		}
+	}
 
-				if (MAX(peak.right, peak.left) > Math::db_to_linear(channel_disable_threshold_db)) {
-					bus->channels.write[k].last_mix_with_audio = mix_frames;
-				} else if (mix_frames - bus->channels[k].last_mix_with_audio > channel_disable_frames) {
-					bus->channels.write[k].active = false;
-					continue; //went inactive, don't mix.
-				}
-			}
+	const uint32_t helper_count = helpers_available && p_element_count > 1 ? MIN(p_element_count - 1, uint32_t(pool->get_thread_count())) : 0;
+	if (helper_count == 0) {
+		for (uint32_t i = 0; i < p_element_count; i++) {
+			(this->*p_function)(i);
+		}
+		return;
+	}
 
-			if (send) {
-				// If not master bus, send.
-				AudioFrame *target_buf = thread_get_channel_mix_buffer(send->index_cache, k);
+	job.function = p_function;
+	job.element_count = p_element_count;
+	job.next_element.set(0);
+	job.finished_elements.set(0);
+	job.helper_group = pool->add_template_group_task(this, &AudioServer::_mix_step_parallel_helper_task, (void *)nullptr, helper_count, helper_count, true, SNAME("AudioServerMix"));
 
-				for (uint32_t j = 0; j < buffer_size; j++) {
-					target_buf[j] += buf[j];
-				}
+	_mix_step_run_parallel_elements();
+	// Only elements that were claimed are waited for, helpers that start later find nothing left to do.
+	job.finished_semaphore.wait();
+}
+
+void AudioServer::_mix_step_run_parallel_elements() {
+	ParallelMixJob &job = parallel_mix_job;
+	for (uint32_t i = job.next_element.postincrement(); i < job.element_count; i = job.next_element.postincrement()) {
+		(this->*job.function)(i);
+		if (job.finished_elements.increment() == job.element_count) {
+			job.finished_semaphore.post();
+		}
+	}
+}
+
+void AudioServer::_mix_step_parallel_helper_task(uint32_t p_index, void *p_userdata) {
+	_mix_step_run_parallel_elements();
+}
+
+void AudioServer::_mix_step_finish_parallel_helpers() {
+	if (parallel_mix_job.helper_group != WorkerThreadPool::INVALID_TASK_ID) {
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(parallel_mix_job.helper_group);
+		parallel_mix_job.helper_group = WorkerThreadPool::INVALID_TASK_ID;
+	}
+}
+
+void AudioServer::_mix_step_process_parallel_bus(uint32_t p_index) {
+	const int bus_index = parallel_buses[p_index];
+	Bus *bus = buses[bus_index];
+
+	// Pull the sends first, in the same order serial mixing pushes them.
+	for (const int source_index : bus->parallel_sources) {
+		const Bus *source = buses[source_index];
+		for (int k = 0; k < source->channels.size(); k++) {
+			if (!source->channels[k].active) {
+				continue;
+			}
+			const AudioFrame *buf = source->channels[k].buffer.ptr();
+			AudioFrame *target_buf = thread_get_channel_mix_buffer(bus_index, k);
+
+			for (uint32_t j = 0; j < buffer_size; j++) {
+				target_buf[j] += buf[j];
 			}
 		}
 	}
 
-	mix_frames += buffer_size;
-	to_mix = buffer_size;
+	_mix_step_process_bus(bus, parallel_mixing_solo_mode, bus->parallel_temp_buffer);
 }
 
-void AudioServer::_mix_step_for_channel(AudioFrame *p_out_buf, AudioFrame *p_source_buf, AudioFrame p_vol_start, AudioFrame p_vol_final, float p_attenuation_filter_cutoff_hz, float p_highshelf_gain, AudioFilterSW::Processor *p_processor_l, AudioFilterSW::Processor *p_processor_r) {
+void AudioServer::_mix_step_for_channel(AudioFrame *p_out_buf, AudioFrame *p_source_buf, AudioFrame p_vol_start, AudioFrame p_vol_final, uint32_t p_ramp_length, float p_attenuation_filter_cutoff_hz, float p_highshelf_gain, AudioFilterSW::Processor *p_processor_l, AudioFilterSW::Processor *p_processor_r) {
 	// TODO: In the future it could be nice to replace all of these hardcoded effects with something a bit cleaner and more flexible, but for now this is what we do to support 3D audio players.
 	if (p_highshelf_gain != 0) {
 		AudioFilterSW filter;
@@ -695,22 +928,18 @@ void AudioServer::_mix_step_for_channel(AudioFrame *p_out_buf, AudioFrame *p_sou
 		p_processor_r->set_filter(&filter, /* clear_history= */ is_just_started);
 		p_processor_r->update_coeffs(buffer_size);
 
-		for (unsigned int frame_idx = 0; frame_idx < buffer_size; frame_idx++) {
-			// TODO: Make lerp speed buffer-size-invariant if buffer_size ever becomes a project setting to avoid very small buffer sizes causing pops due to too-fast lerps.
-			float lerp_param = (float)frame_idx / buffer_size;
-			AudioFrame vol = p_vol_final * lerp_param + (1 - lerp_param) * p_vol_start;
-			AudioFrame mixed = vol * p_source_buf[frame_idx];
-			p_processor_l->process_one_interp(mixed.left);
-			p_processor_r->process_one_interp(mixed.right);
-			p_out_buf[frame_idx] += mixed;
+		// Filter in small chunks so the volume-ramped frames stay in cache between passes.
+		const uint32_t chunk_size = 128;
+		AudioFrame mixed[chunk_size];
+		for (uint32_t chunk_start = 0; chunk_start < buffer_size; chunk_start += chunk_size) {
+			const uint32_t frames = MIN(chunk_size, buffer_size - chunk_start);
+			AudioMixSIMD::volume_ramp<false>(mixed, p_source_buf + chunk_start, frames, p_vol_start, p_vol_final, chunk_start, p_ramp_length);
+			AudioFilterSW::Processor::process_stereo_interp(p_processor_l, p_processor_r, mixed, frames);
+			AudioMixSIMD::accumulate(p_out_buf + chunk_start, mixed, frames);
 		}
 
 	} else {
-		for (unsigned int frame_idx = 0; frame_idx < buffer_size; frame_idx++) {
-			// TODO: Make lerp speed buffer-size-invariant if buffer_size ever becomes a project setting to avoid very small buffer sizes causing pops due to too-fast lerps.
-			float lerp_param = (float)frame_idx / buffer_size;
-			p_out_buf[frame_idx] += (p_vol_final * lerp_param + (1 - lerp_param) * p_vol_start) * p_source_buf[frame_idx];
-		}
+		AudioMixSIMD::volume_ramp<true>(p_out_buf, p_source_buf, buffer_size, p_vol_start, p_vol_final, 0, p_ramp_length);
 	}
 }
 
@@ -1236,6 +1465,41 @@ float AudioServer::get_playback_speed_scale() const {
 	return playback_speed_scale;
 }
 
+void AudioServer::set_parallel_mixing_enabled(bool p_enabled) {
+	lock();
+	parallel_mixing = p_enabled;
+	unlock();
+}
+
+bool AudioServer::is_parallel_mixing_enabled() const {
+	return parallel_mixing;
+}
+
+void AudioServer::set_mix_buffer_size(int p_frames) {
+	ERR_FAIL_COND_MSG(p_frames < MIN_MIX_BUFFER_SIZE || p_frames > MAX_MIX_BUFFER_SIZE, vformat("Mix buffer size must be between %d and %d frames.", MIN_MIX_BUFFER_SIZE, MAX_MIX_BUFFER_SIZE));
+	lock();
+	buffer_size = p_frames;
+	volume_ramp_length = MAX(buffer_size, uint32_t(DEFAULT_MIX_BUFFER_SIZE));
+	init_channels_and_buffers();
+	// Whatever is left of the previous mix step doesn't fit the new buffers.
+	to_mix = 0;
+	unlock();
+}
+
+void AudioServer::set_stream_lookahead_enabled(bool p_enabled) {
+	lock();
+	stream_lookahead = p_enabled ? LOOKAHEAD_BUFFER_SIZE : 0;
+	unlock();
+}
+
+bool AudioServer::is_stream_lookahead_enabled() const {
+	return stream_lookahead > 0;
+}
+
+int AudioServer::get_mix_latency_frames() const {
+	return buffer_size + stream_lookahead;
+}
+
 void AudioServer::start_playback_stream(Ref<AudioStreamPlayback> p_playback, const StringName &p_bus, Vector<AudioFrame> p_volume_db_vector, float p_start_time, float p_pitch_scale) {
 	ERR_FAIL_COND(p_playback.is_null());
 
@@ -1526,9 +1790,15 @@ void AudioServer::init_channels_and_buffers() {
 void AudioServer::init() {
 	channel_disable_threshold_db = GLOBAL_DEF_RST(PropertyInfo(Variant::FLOAT, "audio/buses/channel_disable_threshold_db", PROPERTY_HINT_RANGE, "-80,0,0.1,suffix:dB"), -60.0);
 	channel_disable_frames = float(GLOBAL_DEF_RST(PropertyInfo(Variant::FLOAT, "audio/buses/channel_disable_time", PROPERTY_HINT_RANGE, "0,5,0.01,or_greater"), 2.0)) * get_mix_rate();
-	// TODO: Buffer size is hardcoded for now. This would be really nice to have as a project setting because currently it limits audio latency to an absolute minimum of 11ms with default mix rate, but there's some additional work required to make that happen. See TODOs in `_mix_step_for_channel`.
-	// When this becomes a project setting, it should be specified in milliseconds rather than raw sample count, because 512 samples at 192khz is shorter than it is at 48khz, for example.
-	buffer_size = 512;
+	parallel_mixing = GLOBAL_DEF_RST("audio/general/parallel_mixing", false);
+	// Specified in milliseconds rather than frames, because 512 frames at 192khz is shorter than it is at 48khz, for example.
+	float mix_buffer_length_ms = GLOBAL_DEF_RST(PropertyInfo(Variant::FLOAT, "audio/general/mix_buffer_length_ms", PROPERTY_HINT_RANGE, "0,50,0.01,suffix:ms"), 0.0);
+	stream_lookahead = GLOBAL_DEF_RST("audio/general/stream_lookahead", true) ? LOOKAHEAD_BUFFER_SIZE : 0;
+	buffer_size = DEFAULT_MIX_BUFFER_SIZE;
+	if (mix_buffer_length_ms > 0) {
+		buffer_size = CLAMP(uint32_t(Math::round(mix_buffer_length_ms * get_mix_rate() / 1000.0)), uint32_t(MIN_MIX_BUFFER_SIZE), uint32_t(MAX_MIX_BUFFER_SIZE));
+	}
+	volume_ramp_length = MAX(buffer_size, uint32_t(DEFAULT_MIX_BUFFER_SIZE));
 
 	init_channels_and_buffers();
 
@@ -1565,6 +1835,10 @@ void AudioServer::update() {
 
 		for (int i = buses.size() - 1; i >= 0; i--) {
 			Bus *bus = buses[i];
+			// Bus time includes its effects. With parallel mixing it is spent on worker threads.
+			values.push_back(String(bus->name) + " Bus");
+			values.push_back(USEC_TO_SEC(bus->prof_time));
+
 			if (bus->bypass) {
 				continue;
 			}
@@ -1599,6 +1873,7 @@ void AudioServer::update() {
 	// Reset profiling times
 	for (int i = buses.size() - 1; i >= 0; i--) {
 		Bus *bus = buses[i];
+		bus->prof_time = 0;
 		if (bus->bypass) {
 			continue;
 		}
@@ -1654,6 +1929,8 @@ void AudioServer::finish() {
 	for (int i = 0; i < AudioDriverManager::get_driver_count(); i++) {
 		AudioDriverManager::get_driver(i)->finish();
 	}
+	// Helpers of the last parallel job may not have run yet.
+	_mix_step_finish_parallel_helpers();
 
 	for (int i = 0; i < buses.size(); i++) {
 		memdelete(buses[i]);
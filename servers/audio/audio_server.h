@@ -31,7 +31,11 @@
 #pragma once
 
 #include "core/math/audio_frame.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/os/semaphore.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/safe_list.h"
+#include "core/templates/safe_refcount.h"
 #include "core/variant/variant.h"
 #include "servers/audio/audio_effect.h"
 #include "servers/audio/audio_filter_sw.h"
@@ -201,6 +205,9 @@ public:
 		MAX_CHANNELS_PER_BUS = 4,
 		MAX_BUSES_PER_PLAYBACK = 6,
 		LOOKAHEAD_BUFFER_SIZE = 64,
+		DEFAULT_MIX_BUFFER_SIZE = 512,
+		MIN_MIX_BUFFER_SIZE = 16,
+		MAX_MIX_BUFFER_SIZE = 8192,
 	};
 
 	typedef void (*AudioCallback)(void *p_userdata);
@@ -210,6 +217,10 @@ private:
 	int mix_size = 0;
 
 	uint32_t buffer_size = 0;
+	// Frames of lookahead kept per playback to fade out streams that end abruptly. Zero if disabled.
+	uint32_t stream_lookahead = LOOKAHEAD_BUFFER_SIZE;
+	// Volume changes are spread over at least this many frames, so small mix buffers don't cause pops.
+	uint32_t volume_ramp_length = DEFAULT_MIX_BUFFER_SIZE;
 	uint64_t mix_count = 0;
 	uint64_t mix_frames = 0;
 #ifdef DEBUG_ENABLED
@@ -226,6 +237,10 @@ private:
 
 	bool tag_used_audio_streams = false;
 
+	// Render playbacks and process independent buses on the WorkerThreadPool.
+	bool parallel_mixing = false;
+	bool parallel_mixing_solo_mode = false;
+
 #ifdef DEBUG_ENABLED
 	bool debug_mute = false;
 #endif // DEBUG_ENABLED
@@ -266,6 +281,14 @@ private:
 		float volume_db = 0.0f;
 		StringName send;
 		int index_cache = 0;
+
+		// Scratch buffers for effects, so buses processed at the same time don't share them.
+		Vector<Vector<AudioFrame>> parallel_temp_buffer;
+		LocalVector<int> parallel_sources; // Buses sending here, in descending index order.
+		int parallel_level = 0;
+#ifdef DEBUG_ENABLED
+		uint64_t prof_time = 0;
+#endif
 	};
 
 	struct AudioStreamPlaybackBusDetails {
@@ -306,6 +329,13 @@ private:
 		AudioStreamPlaybackBusDetails *prev_bus_details = nullptr;
 		// The next few samples are stored here so we have some time to fade audio out if it ends abruptly at the beginning of the next mix.
 		AudioFrame lookahead[LOOKAHEAD_BUFFER_SIZE];
+		// Result of the last render. The buffer is only used when playbacks are rendered in parallel.
+		LocalVector<AudioFrame> mix_buffer;
+		bool mix_fading_out = false;
+		// Frames of the current fade-out that have already been mixed.
+		uint32_t fade_out_frames = 0;
+		// After the stream ended, frames of it left in the lookahead buffer. They are output before the playback is deleted.
+		uint32_t drain_frames = 0;
 	};
 
 	SafeList<AudioStreamPlaybackListNode *> playback_list;
@@ -330,7 +360,36 @@ private:
 	void init_channels_and_buffers();
 
 	void _mix_step();
-	void _mix_step_for_channel(AudioFrame *p_out_buf, AudioFrame *p_source_buf, AudioFrame p_vol_start, AudioFrame p_vol_final, float p_attenuation_filter_cutoff_hz, float p_highshelf_gain, AudioFilterSW::Processor *p_processor_l, AudioFilterSW::Processor *p_processor_r);
+	void _mix_step_render_playback(AudioStreamPlaybackListNode *p_playback, AudioFrame *p_buf);
+	void _mix_step_drain_playback(AudioStreamPlaybackListNode *p_playback, AudioFrame *p_buf, uint32_t p_frames_left);
+	void _mix_step_render_parallel_playback(uint32_t p_index);
+	bool _mix_step_mix_playback(AudioStreamPlaybackListNode *p_playback, AudioFrame *p_buf);
+	Bus *_mix_step_get_bus_send(int p_bus) const;
+	void _mix_step_process_bus(Bus *p_bus, bool p_solo_mode, Vector<Vector<AudioFrame>> &r_temp_buffer);
+	void _mix_step_process_buses_parallel(bool p_solo_mode);
+	void _mix_step_process_parallel_bus(uint32_t p_index);
+
+	LocalVector<AudioStreamPlaybackListNode *> parallel_playbacks;
+	LocalVector<int> parallel_buses;
+
+	// Elements of a parallel job are claimed by the audio thread as well as by helper tasks on the WorkerThreadPool,
+	// so the audio thread never waits for helpers that haven't started. While the helpers of the previous job
+	// haven't all run, the workers are busy with something else and jobs are mixed on the audio thread alone.
+	struct ParallelMixJob {
+		void (AudioServer::*function)(uint32_t) = nullptr;
+		uint32_t element_count = 0;
+		SafeNumeric<uint32_t> next_element;
+		SafeNumeric<uint32_t> finished_elements;
+		Semaphore finished_semaphore;
+		WorkerThreadPool::GroupID helper_group = WorkerThreadPool::INVALID_TASK_ID;
+	};
+	ParallelMixJob parallel_mix_job;
+
+	void _mix_step_run_parallel(void (AudioServer::*p_function)(uint32_t), uint32_t p_element_count);
+	void _mix_step_run_parallel_elements();
+	void _mix_step_parallel_helper_task(uint32_t p_index, void *p_userdata);
+	void _mix_step_finish_parallel_helpers();
+	void _mix_step_for_channel(AudioFrame *p_out_buf, AudioFrame *p_source_buf, AudioFrame p_vol_start, AudioFrame p_vol_final, uint32_t p_ramp_length, float p_attenuation_filter_cutoff_hz, float p_highshelf_gain, AudioFilterSW::Processor *p_processor_l, AudioFilterSW::Processor *p_processor_r);
 
 	// Should only be called on the main thread.
 	AudioStreamPlaybackListNode *_find_playback_list_node(Ref<AudioStreamPlayback> p_playback);
@@ -430,6 +489,15 @@ public:
 	void set_playback_speed_scale(float p_scale);
 	float get_playback_speed_scale() const;
 
+	void set_parallel_mixing_enabled(bool p_enabled);
+	bool is_parallel_mixing_enabled() const;
+
+	void set_mix_buffer_size(int p_frames);
+	void set_stream_lookahead_enabled(bool p_enabled);
+	bool is_stream_lookahead_enabled() const;
+	// Maximum number of frames between a playback starting and it reaching the driver, excluding the driver's own latency.
+	int get_mix_latency_frames() const;
+
 	// Convenience method.
 	void start_playback_stream(Ref<AudioStreamPlayback> p_playback, const StringName &p_bus, Vector<AudioFrame> p_volume_db_vector, float p_start_time = 0, float p_pitch_scale = 1);
 	// Expose all parameters.
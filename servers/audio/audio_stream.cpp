@@ -32,6 +32,7 @@
 
 #include "core/config/project_settings.h"
 #include "core/object/class_db.h"
+#include "servers/audio/audio_mix_simd.h"
 
 void AudioStreamPlayback::start(double p_from_pos) {
 	GDVIRTUAL_CALL(_start, p_from_pos);
@@ -189,31 +190,54 @@ int AudioStreamPlaybackResampled::mix(AudioFrame *p_buffer, float p_rate_scale,
 
 	int mixed_frames_total = -1;
 
-	int i;
-	for (i = 0; i < p_frames; i++) {
+	int i = 0;
+	while (i < p_frames) {
 		uint32_t idx = CUBIC_INTERP_HISTORY + uint32_t(mix_offset >> FP_BITS);
 		//standard cubic interpolation (great quality/performance ratio)
 		//this used to be moved to a LUT for greater performance, but nowadays CPU speed is generally faster than memory.
 		float mu = (mix_offset & FP_MASK) / float(FP_LEN);
-		AudioFrame y0 = internal_buffer[idx - 3];
-		AudioFrame y1 = internal_buffer[idx - 2];
-		AudioFrame y2 = internal_buffer[idx - 1];
-		AudioFrame y3 = internal_buffer[idx - 0];
-
-		if (idx >= internal_buffer_end && mixed_frames_total == -1) {
-			// The internal buffer ends somewhere in this range, and we haven't yet recorded the number of good frames we have.
-			mixed_frames_total = i;
-		}
 
-		float mu2 = mu * mu;
-		float h11 = mu2 * (mu - 1);
-		float z = mu2 - h11;
-		float h01 = z - h11;
-		float h10 = mu - z;
+		uint64_t next_mix_offset = mix_offset + mix_increment;
+		if (i + 1 < p_frames && (next_mix_offset >> FP_BITS) < INTERNAL_BUFFER_LEN) {
+			// The internal buffer doesn't need refilling before the next frame, so interpolate both frames at once.
+			uint32_t next_idx = CUBIC_INTERP_HISTORY + uint32_t(next_mix_offset >> FP_BITS);
+			float next_mu = (next_mix_offset & FP_MASK) / float(FP_LEN);
+
+			if (mixed_frames_total == -1) {
+				// The internal buffer may end somewhere in this range, and we haven't yet recorded the number of good frames we have.
+				if (idx >= internal_buffer_end) {
+					mixed_frames_total = i;
+				} else if (next_idx >= internal_buffer_end) {
+					mixed_frames_total = i + 1;
+				}
+			}
 
-		p_buffer[i] = y1 + (y2 - y1) * h01 + ((y2 - y0) * h10 + (y3 - y1) * h11) * 0.5;
+			AudioMixSIMD::cubic_interpolate_2(&p_buffer[i], &internal_buffer[idx - 3], &internal_buffer[next_idx - 3], mu, next_mu);
 
-		mix_offset += mix_increment;
+			mix_offset = next_mix_offset + mix_increment;
+			i += 2;
+		} else {
+			AudioFrame y0 = internal_buffer[idx - 3];
+			AudioFrame y1 = internal_buffer[idx - 2];
+			AudioFrame y2 = internal_buffer[idx - 1];
+			AudioFrame y3 = internal_buffer[idx - 0];
+
+			if (idx >= internal_buffer_end && mixed_frames_total == -1) {
+				// The internal buffer ends somewhere in this range, and we haven't yet recorded the number of good frames we have.
+				mixed_frames_total = i;
+			}
+
+			float mu2 = mu * mu;
+			float h11 = mu2 * (mu - 1);
+			float z = mu2 - h11;
+			float h01 = z - h11;
+			float h10 = mu - z;
+
+			p_buffer[i] = y1 + (y2 - y1) * h01 + ((y2 - y0) * h10 + (y3 - y1) * h11) * 0.5;
+
+			mix_offset += mix_increment;
+			i++;
+		}
 
 		while ((mix_offset >> FP_BITS) >= INTERNAL_BUFFER_LEN) {
 			internal_buffer[0] = internal_buffer[INTERNAL_BUFFER_LEN + 0];
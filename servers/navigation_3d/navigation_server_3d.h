@@ -278,6 +278,7 @@ public:
 	/* QUERY API */
 
 	virtual void query_path(const Ref<NavigationPathQueryParameters3D> &p_query_parameters, Ref<NavigationPathQueryResult3D> p_query_result, const Callable &p_callback = Callable()) = 0;
+	virtual void query_paths(const TypedArray<NavigationPathQueryParameters3D> &p_query_parameters, const TypedArray<NavigationPathQueryResult3D> &p_query_results) = 0;
 
 	/* NAVMESH BAKE API */
 
@@ -331,6 +332,8 @@ public:
 		INFO_EDGE_CONNECTION_COUNT,
 		INFO_EDGE_FREE_COUNT,
 		INFO_OBSTACLE_COUNT,
+		INFO_PATH_QUERIES_PER_SECOND,
+		INFO_PATH_QUERY_TIME_USEC,
 	};
 
 	virtual int get_process_info(ProcessInfo p_info) const = 0;
@@ -626,6 +626,26 @@ bool PhysicsServer2D::_body_test_motion(RID p_body, RequiredParam<PhysicsTestMot
 	return body_test_motion(p_body, p_parameters->get_parameters(), result_ptr);
 }
 
+PackedByteArray PhysicsServer2D::space_get_snapshot(RID p_space) const {
+	ERR_FAIL_V_MSG(PackedByteArray(), "Space snapshots are not supported by this physics server.");
+}
+
+bool PhysicsServer2D::space_restore_snapshot(RID p_space, const PackedByteArray &p_snapshot) {
+	ERR_FAIL_V_MSG(false, "Space snapshots are not supported by this physics server.");
+}
+
+void PhysicsServer2D::space_set_deterministic(RID p_space, bool p_deterministic) {
+	ERR_FAIL_MSG("Deterministic spaces are not supported by this physics server.");
+}
+
+bool PhysicsServer2D::space_is_deterministic(RID p_space) const {
+	return false;
+}
+
+uint32_t PhysicsServer2D::space_get_state_hash(RID p_space) const {
+	ERR_FAIL_V_MSG(0, "Space state hashes are not supported by this physics server.");
+}
+
 void PhysicsServer2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("world_boundary_shape_create"), &PhysicsServer2D::world_boundary_shape_create);
 	ClassDB::bind_method(D_METHOD("separation_ray_shape_create"), &PhysicsServer2D::separation_ray_shape_create);
@@ -646,6 +666,11 @@ void PhysicsServer2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("space_is_active", "space"), &PhysicsServer2D::space_is_active);
 	ClassDB::bind_method(D_METHOD("space_set_param", "space", "param", "value"), &PhysicsServer2D::space_set_param);
 	ClassDB::bind_method(D_METHOD("space_get_param", "space", "param"), &PhysicsServer2D::space_get_param);
+	ClassDB::bind_method(D_METHOD("space_get_snapshot", "space"), &PhysicsServer2D::space_get_snapshot);
+	ClassDB::bind_method(D_METHOD("space_restore_snapshot", "space", "snapshot"), &PhysicsServer2D::space_restore_snapshot);
+	ClassDB::bind_method(D_METHOD("space_set_deterministic", "space", "deterministic"), &PhysicsServer2D::space_set_deterministic);
+	ClassDB::bind_method(D_METHOD("space_is_deterministic", "space"), &PhysicsServer2D::space_is_deterministic);
+	ClassDB::bind_method(D_METHOD("space_get_state_hash", "space"), &PhysicsServer2D::space_get_state_hash);
 	ClassDB::bind_method(D_METHOD("space_get_direct_state", "space"), &PhysicsServer2D::space_get_direct_state);
 
 	ClassDB::bind_method(D_METHOD("area_create"), &PhysicsServer2D::area_create);
@@ -919,6 +944,7 @@ PhysicsServer2D::PhysicsServer2D() {
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/2d/solver/contact_max_allowed_penetration", PROPERTY_HINT_RANGE, "0.01,10,0.01,or_greater"), 0.3);
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/2d/solver/default_contact_bias", PROPERTY_HINT_RANGE, "0,1,0.01"), 0.8);
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/2d/solver/default_constraint_bias", PROPERTY_HINT_RANGE, "0,1,0.01"), 0.2);
+	GLOBAL_DEF("physics/2d/solver/deterministic", false);
 }
 
 PhysicsServer2D::~PhysicsServer2D() {
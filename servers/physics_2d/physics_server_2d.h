@@ -212,6 +212,7 @@ class PhysicsTestMotionResult2D;
 
 class PhysicsServer2D : public Object {
 	GDCLASS(PhysicsServer2D, Object);
+	friend class TestPhysicsServerAccessor;
 
 	static PhysicsServer2D *singleton;
 
@@ -280,6 +281,17 @@ public:
 	virtual void space_set_param(RID p_space, SpaceParameter p_param, real_t p_value) = 0;
 	virtual real_t space_get_param(RID p_space, SpaceParameter p_param) const = 0;
 
+	// Compact binary copy of the simulation state of a space, to roll it back and step it again.
+	// Not every physics server supports them, the default implementations fail.
+	virtual PackedByteArray space_get_snapshot(RID p_space) const;
+	virtual bool space_restore_snapshot(RID p_space, const PackedByteArray &p_snapshot);
+
+	// Deterministic spaces step the same way whenever they are given the same inputs, and their
+	// state hash can be compared to check two runs haven't diverged. Not every physics server supports them.
+	virtual void space_set_deterministic(RID p_space, bool p_deterministic);
+	virtual bool space_is_deterministic(RID p_space) const;
+	virtual uint32_t space_get_state_hash(RID p_space) const;
+
 	// this function only works on physics process, errors and returns null otherwise
 	virtual PhysicsDirectSpaceState2D *space_get_direct_state(RID p_space) = 0;
 
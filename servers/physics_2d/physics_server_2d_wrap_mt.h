@@ -63,6 +63,8 @@
 class PhysicsServer2DWrapMT : public PhysicsServer2D {
 	GDSOFTCLASS(PhysicsServer2DWrapMT, PhysicsServer2D);
 
+	friend class TestPhysicsServerAccessor;
+
 	mutable PhysicsServer2D *physics_server_2d = nullptr;
 
 	mutable CommandQueueMT command_queue;
@@ -111,6 +113,13 @@ public:
 	FUNC3(space_set_param, RID, SpaceParameter, real_t);
 	FUNC2RC(real_t, space_get_param, RID, SpaceParameter);
 
+	FUNC1RC(PackedByteArray, space_get_snapshot, RID);
+	FUNC2R(bool, space_restore_snapshot, RID, const PackedByteArray &);
+
+	FUNC2(space_set_deterministic, RID, bool);
+	FUNC1RC(bool, space_is_deterministic, RID);
+	FUNC1RC(uint32_t, space_get_state_hash, RID);
+
 	// this function only works on physics process, errors and returns null otherwise
 	PhysicsDirectSpaceState2D *space_get_direct_state(RID p_space) override {
 		ERR_FAIL_COND_V(!Thread::is_main_thread(), nullptr);
@@ -127,9 +127,11 @@ class PhysicsDirectSpaceState3D : public Object {
 
 private:
 	Dictionary _intersect_ray(RequiredParam<PhysicsRayQueryParameters3D> rp_ray_query);
+	Dictionary _intersect_ray_batch(RequiredParam<PhysicsRayQueryParameters3D> rp_ray_query, const PackedVector3Array &p_from, const PackedVector3Array &p_to);
 	TypedArray<Dictionary> _intersect_point(RequiredParam<PhysicsPointQueryParameters3D> rp_point_query, int p_max_results = 32);
 	TypedArray<Dictionary> _intersect_shape(RequiredParam<PhysicsShapeQueryParameters3D> rp_shape_query, int p_max_results = 32);
 	Vector<real_t> _cast_motion(RequiredParam<PhysicsShapeQueryParameters3D> rp_shape_query);
+	Vector<real_t> _cast_motion_batch(RequiredParam<PhysicsShapeQueryParameters3D> rp_shape_query, const PackedVector3Array &p_origins, const PackedVector3Array &p_motions);
 	TypedArray<Vector3> _collide_shape(RequiredParam<PhysicsShapeQueryParameters3D> rp_shape_query, int p_max_results = 32);
 	Dictionary _get_rest_info(RequiredParam<PhysicsShapeQueryParameters3D> rp_shape_query);
 
@@ -164,6 +166,10 @@ public:
 
 	virtual bool intersect_ray(const RayParameters &p_parameters, RayResult &r_result) = 0;
 
+	// Casts `p_count` rays sharing the filtering options of `p_parameters` (its `from` and `to` are ignored).
+	// The default implementation loops over `intersect_ray()`, servers can override it to run the rays in parallel.
+	virtual void intersect_ray_batch(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results, bool *r_hits);
+
 	struct ShapeResult {
 		RID rid;
 		ObjectID collider_id;
@@ -205,6 +211,9 @@ public:
 
 	virtual int intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) = 0;
 	virtual bool cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe, ShapeRestInfo *r_info = nullptr) = 0;
+	// Casts the shape of `p_parameters` from each of `p_transforms` along the matching entry of `p_motions`.
+	// Returns false, with both fractions left at 1.0 for every cast, if a cast fails because the shape is invalid.
+	virtual bool cast_motion_batch(const ShapeParameters &p_parameters, const Transform3D *p_transforms, const Vector3 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe);
 	virtual bool collide_shape(const ShapeParameters &p_parameters, Vector3 *r_results, int p_result_max, int &r_result_count) = 0;
 	virtual bool rest_info(const ShapeParameters &p_parameters, ShapeRestInfo *r_info) = 0;
 
@@ -235,6 +244,7 @@ class PhysicsTestMotionResult3D;
 
 class PhysicsServer3D : public Object {
 	GDCLASS(PhysicsServer3D, Object);
+	friend class TestPhysicsServerAccessor;
 
 	static PhysicsServer3D *singleton;
 
@@ -304,6 +314,11 @@ public:
 	virtual void space_set_param(RID p_space, SpaceParameter p_param, real_t p_value) = 0;
 	virtual real_t space_get_param(RID p_space, SpaceParameter p_param) const = 0;
 
+	// Compact binary copy of the simulation state of a space, to roll it back and step it again.
+	// Not every physics server supports them, the default implementations fail.
+	virtual PackedByteArray space_get_snapshot(RID p_space) const;
+	virtual bool space_restore_snapshot(RID p_space, const PackedByteArray &p_snapshot);
+
 	// this function only works on physics process, errors and returns null otherwise
 	virtual PhysicsDirectSpaceState3D *space_get_direct_state(RID p_space) = 0;
 
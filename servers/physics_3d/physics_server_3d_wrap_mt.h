@@ -63,6 +63,8 @@
 class PhysicsServer3DWrapMT : public PhysicsServer3D {
 	GDSOFTCLASS(PhysicsServer3DWrapMT, PhysicsServer3D);
 
+	friend class TestPhysicsServerAccessor;
+
 	mutable PhysicsServer3D *physics_server_3d = nullptr;
 
 	mutable CommandQueueMT command_queue;
@@ -117,6 +119,9 @@ public:
 	FUNC3(space_set_param, RID, SpaceParameter, real_t);
 	FUNC2RC(real_t, space_get_param, RID, SpaceParameter);
 
+	FUNC1RC(PackedByteArray, space_get_snapshot, RID);
+	FUNC2R(bool, space_restore_snapshot, RID, const PackedByteArray &);
+
 	// this function only works on physics process, errors and returns null otherwise
 	PhysicsDirectSpaceState3D *space_get_direct_state(RID p_space) override {
 		ERR_FAIL_COND_V(!Thread::is_main_thread(), nullptr);
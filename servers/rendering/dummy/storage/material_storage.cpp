@@ -192,6 +192,13 @@ void MaterialStorage::shader_set_code(RID p_shader, const String &p_code) {
 	ERR_FAIL_COND_MSG(err != OK, "Shader compilation failed.");
 }
 
+void MaterialStorage::shaders_set_code(const Vector<RID> &p_shaders, const Vector<String> &p_codes) {
+	ERR_FAIL_COND(p_shaders.size() != p_codes.size());
+	for (int i = 0; i < p_shaders.size(); i++) {
+		shader_set_code(p_shaders[i], p_codes[i]);
+	}
+}
+
 void MaterialStorage::get_shader_parameter_list(RID p_shader, List<PropertyInfo> *p_param_list) const {
 	DummyShader *shader = shader_owner.get_or_null(p_shader);
 	ERR_FAIL_NULL(shader);
@@ -0,0 +1,602 @@
+/**************************************************************************/
+/*  raster_occlusion_cull.cpp                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "raster_occlusion_cull.h"
+
+#include "core/config/engine.h"
+#include "core/config/project_settings.h"
+#include "core/math/projection.h"
+#include "core/object/worker_thread_pool.h"
+
+RasterOcclusionCull *RasterOcclusionCull::raster_singleton = nullptr;
+
+void RasterOcclusionCull::RasterHZBuffer::clear() {
+	HZBuffer::clear();
+
+	thread_bins.clear();
+	depth_to_distance.clear();
+	tile_grid_size = Size2i();
+}
+
+void RasterOcclusionCull::RasterHZBuffer::resize(const Size2i &p_size) {
+	if (p_size == Size2i()) {
+		clear();
+		return;
+	}
+
+	if (!sizes.is_empty() && p_size == sizes[0]) {
+		return; // Size didn't change
+	}
+
+	HZBuffer::resize(p_size);
+
+	tile_grid_size = Size2i((p_size.x + TILE_SIZE - 1) / TILE_SIZE, (p_size.y + TILE_SIZE - 1) / TILE_SIZE);
+	thread_bins.resize(WorkerThreadPool::get_singleton()->get_thread_count());
+	for (ThreadBins &bins : thread_bins) {
+		bins.tiles.resize(tile_grid_size.x * tile_grid_size.y);
+	}
+	depth_to_distance.resize(p_size.x * p_size.y);
+}
+
+void RasterOcclusionCull::RasterHZBuffer::_update_depth_to_distance(const Projection &p_cam_projection, bool p_cam_orthogonal) {
+	const Size2i &buffer_size = sizes[0];
+
+	if (p_cam_orthogonal) {
+		// The distance to the camera plane is the view depth itself.
+		for (float &factor : depth_to_distance) {
+			factor = 1.0f;
+		}
+		return;
+	}
+
+	// Distance along the ray going through a pixel center is its view depth scaled by the ray length per unit of depth.
+	// The ray offsets are separable, so they can be computed per row and per column.
+	const Projection inv_projection = p_cam_projection.inverse();
+	const real_t ray_z = Math::abs(inv_projection.xform(Vector3(0, 0, -1)).z);
+
+	LocalVector<float> column_offsets;
+	column_offsets.resize(buffer_size.x);
+	for (int x = 0; x < buffer_size.x; x++) {
+		const real_t ndc_x = (x + 0.5f) / buffer_size.x * 2.0f - 1.0f;
+		column_offsets[x] = inv_projection.xform(Vector3(ndc_x, 0, -1)).x / ray_z;
+	}
+
+	for (int y = 0; y < buffer_size.y; y++) {
+		const real_t ndc_y = (y + 0.5f) / buffer_size.y * 2.0f - 1.0f;
+		const float row_offset = inv_projection.xform(Vector3(0, ndc_y, -1)).y / ray_z;
+		float *row = &depth_to_distance[y * buffer_size.x];
+		for (int x = 0; x < buffer_size.x; x++) {
+			row[x] = Math::sqrt(1.0f + column_offsets[x] * column_offsets[x] + row_offset * row_offset);
+		}
+	}
+}
+
+void RasterOcclusionCull::RasterHZBuffer::_setup_triangle(ThreadBins &r_bins, const Vector3 p_view[3], const Projection &p_cam_projection) {
+	const Size2i &buffer_size = sizes[0];
+
+	float x[3];
+	float y[3];
+	float inv_w[3];
+	float depth_over_w[3];
+	for (int i = 0; i < 3; i++) {
+		const Vector4 clip = p_cam_projection.xform(Vector4(p_view[i].x, p_view[i].y, p_view[i].z, 1.0));
+		inv_w[i] = 1.0f / clip.w;
+		x[i] = (clip.x * inv_w[i] * 0.5f + 0.5f) * buffer_size.x;
+		y[i] = (clip.y * inv_w[i] * 0.5f + 0.5f) * buffer_size.y;
+		depth_over_w[i] = -p_view[i].z * inv_w[i];
+	}
+
+	float area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+	if (!(Math::abs(area) > 1e-8f)) {
+		return; // Degenerate, or not finite.
+	}
+
+	// Occluders are double-sided, so make the winding consistent instead of culling back faces.
+	if (area < 0.0f) {
+		SWAP(x[1], x[2]);
+		SWAP(y[1], y[2]);
+		SWAP(inv_w[1], inv_w[2]);
+		SWAP(depth_over_w[1], depth_over_w[2]);
+		area = -area;
+	}
+
+	Triangle triangle;
+	// Pixels are sampled at their centers, like the raycast backend does.
+	triangle.min_x = MAX(0, (int)Math::floor(MIN(x[0], MIN(x[1], x[2])) - 0.5f));
+	triangle.min_y = MAX(0, (int)Math::floor(MIN(y[0], MIN(y[1], y[2])) - 0.5f));
+	triangle.max_x = MIN(buffer_size.x - 1, (int)Math::ceil(MAX(x[0], MAX(x[1], x[2])) - 0.5f));
+	triangle.max_y = MIN(buffer_size.y - 1, (int)Math::ceil(MAX(y[0], MAX(y[1], y[2])) - 0.5f));
+	if (triangle.min_x > triangle.max_x || triangle.min_y > triangle.max_y) {
+		return;
+	}
+
+	for (int i = 0; i < 3; i++) {
+		const int j = (i + 1) % 3;
+		triangle.edges[i][0] = y[i] - y[j];
+		triangle.edges[i][1] = x[j] - x[i];
+		triangle.edges[i][2] = x[i] * y[j] - x[j] * y[i];
+	}
+
+	// Both 1/w and depth/w are linear in screen space, so they're interpolated as planes.
+	const float inv_area = 1.0f / area;
+	const float dx1 = x[1] - x[0];
+	const float dx2 = x[2] - x[0];
+	const float dy1 = y[1] - y[0];
+	const float dy2 = y[2] - y[0];
+	const float *attributes[2] = { inv_w, depth_over_w };
+	float *planes[2] = { triangle.inv_w, triangle.depth_over_w };
+	for (int i = 0; i < 2; i++) {
+		const float *v = attributes[i];
+		const float a = ((v[1] - v[0]) * dy2 - (v[2] - v[0]) * dy1) * inv_area;
+		const float b = ((v[2] - v[0]) * dx1 - (v[1] - v[0]) * dx2) * inv_area;
+		planes[i][0] = a;
+		planes[i][1] = b;
+		planes[i][2] = v[0] - a * x[0] - b * y[0];
+	}
+
+	const uint32_t index = r_bins.triangles.size();
+	r_bins.triangles.push_back(triangle);
+
+	for (int tile_y = triangle.min_y / TILE_SIZE; tile_y <= triangle.max_y / TILE_SIZE; tile_y++) {
+		for (int tile_x = triangle.min_x / TILE_SIZE; tile_x <= triangle.max_x / TILE_SIZE; tile_x++) {
+			r_bins.tiles[tile_y * tile_grid_size.x + tile_x].push_back(index);
+		}
+	}
+}
+
+void RasterOcclusionCull::RasterHZBuffer::_setup_triangles_threaded(uint32_t p_thread, const RasterThreadData *p_data) {
+	ThreadBins &bins = thread_bins[p_thread];
+	bins.triangles.clear();
+	for (LocalVector<uint32_t> &tile : bins.tiles) {
+		tile.clear();
+	}
+
+	const LocalVector<Mesh> &meshes = *p_data->meshes;
+	const Vector<Plane> &planes = p_data->frustum_planes;
+	const uint32_t from = p_thread * meshes.size() / p_data->thread_count;
+	const uint32_t to = (p_thread + 1 == p_data->thread_count) ? meshes.size() : ((p_thread + 1) * meshes.size() / p_data->thread_count);
+
+	for (uint32_t i = from; i < to; i++) {
+		const Mesh &mesh = meshes[i];
+
+		bool outside = false;
+		for (const Plane &plane : planes) {
+			// The corner of the AABB that is the furthest inside the plane.
+			const Vector3 corner = mesh.aabb.position + Vector3(
+																plane.normal.x < 0 ? mesh.aabb.size.x : 0,
+																plane.normal.y < 0 ? mesh.aabb.size.y : 0,
+																plane.normal.z < 0 ? mesh.aabb.size.z : 0);
+			if (plane.distance_to(corner) > 0) {
+				outside = true;
+				break;
+			}
+		}
+		if (outside) {
+			continue;
+		}
+
+		for (uint32_t j = 0; j + 2 < mesh.index_count; j += 3) {
+			Vector3 view[3];
+			int behind_count = 0;
+			for (int k = 0; k < 3; k++) {
+				view[k] = p_data->cam_inv_transform.xform(mesh.vertices[mesh.indices[j + k]]);
+				behind_count += view[k].z > -p_data->z_near ? 1 : 0;
+			}
+
+			if (behind_count == 3) {
+				continue;
+			}
+			if (behind_count == 0) {
+				_setup_triangle(bins, view, p_data->cam_projection);
+				continue;
+			}
+
+			// Clip against the near plane, which leaves either a triangle or a quad.
+			Vector3 clipped[4];
+			int clipped_count = 0;
+			for (int k = 0; k < 3; k++) {
+				const Vector3 &a = view[k];
+				const Vector3 &b = view[(k + 1) % 3];
+				const real_t da = -a.z - p_data->z_near;
+				const real_t db = -b.z - p_data->z_near;
+				if (da >= 0) {
+					clipped[clipped_count++] = a;
+				}
+				if ((da >= 0) != (db >= 0)) {
+					clipped[clipped_count++] = a.lerp(b, da / (da - db));
+				}
+			}
+
+			_setup_triangle(bins, clipped, p_data->cam_projection);
+			if (clipped_count == 4) {
+				const Vector3 second[3] = { clipped[0], clipped[2], clipped[3] };
+				_setup_triangle(bins, second, p_data->cam_projection);
+			}
+		}
+	}
+}
+
+void RasterOcclusionCull::RasterHZBuffer::_rasterize_tile_threaded(uint32_t p_tile, const RasterThreadData *p_data) {
+	const Size2i &buffer_size = sizes[0];
+	const int tile_min_x = (p_tile % tile_grid_size.x) * TILE_SIZE;
+	const int tile_min_y = (p_tile / tile_grid_size.x) * TILE_SIZE;
+	const int tile_max_x = MIN(tile_min_x + TILE_SIZE, buffer_size.x) - 1;
+	const int tile_max_y = MIN(tile_min_y + TILE_SIZE, buffer_size.y) - 1;
+
+	float tile_depth[TILE_SIZE * TILE_SIZE];
+	for (float &depth : tile_depth) {
+		depth = FLT_MAX;
+	}
+
+	for (uint32_t i = 0; i < p_data->thread_count; i++) {
+		const ThreadBins &bins = thread_bins[i];
+		for (uint32_t index : bins.tiles[p_tile]) {
+			const Triangle &triangle = bins.triangles[index];
+			const int min_y = MAX(triangle.min_y, tile_min_y);
+			const int max_y = MIN(triangle.max_y, tile_max_y);
+			const float min_x = MAX(triangle.min_x, tile_min_x);
+			const float max_x = MIN(triangle.max_x, tile_max_x);
+
+			for (int y = min_y; y <= max_y; y++) {
+				const float py = y + 0.5f;
+
+				// Solve the edge functions for this row, so that the inner loop only has to interpolate depth.
+				float span_min = min_x;
+				float span_max = max_x;
+				for (int e = 0; e < 3; e++) {
+					const float a = triangle.edges[e][0];
+					const float t = -(triangle.edges[e][1] * py + triangle.edges[e][2]);
+					if (a > 0.0f) {
+						span_min = MAX(span_min, Math::ceil(t / a - 0.5f));
+					} else if (a < 0.0f) {
+						span_max = MIN(span_max, Math::floor(t / a - 0.5f));
+					} else if (t > 0.0f) {
+						span_max = -1.0f;
+					}
+				}
+				if (span_min > span_max) {
+					continue;
+				}
+
+				const float inv_w_row = triangle.inv_w[1] * py + triangle.inv_w[2];
+				const float depth_over_w_row = triangle.depth_over_w[1] * py + triangle.depth_over_w[2];
+				float *row = &tile_depth[(y - tile_min_y) * TILE_SIZE];
+				const int from = span_min;
+				const int to = span_max;
+				for (int x = from; x <= to; x++) {
+					const float px = x + 0.5f;
+					const float depth = (triangle.depth_over_w[0] * px + depth_over_w_row) / (triangle.inv_w[0] * px + inv_w_row);
+					row[x - tile_min_x] = MIN(row[x - tile_min_x], depth);
+				}
+			}
+		}
+	}
+
+	for (int y = tile_min_y; y <= tile_max_y; y++) {
+		const float *src = &tile_depth[(y - tile_min_y) * TILE_SIZE];
+		const float *factors = &depth_to_distance[y * buffer_size.x + tile_min_x];
+		float *dst = &mips[0][y * buffer_size.x + tile_min_x];
+		for (int x = 0; x <= tile_max_x - tile_min_x; x++) {
+			dst[x] = MIN(src[x] * factors[x], clear_distance);
+		}
+	}
+}
+
+void RasterOcclusionCull::RasterHZBuffer::rasterize(const LocalVector<Mesh> &p_meshes, const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal) {
+	ERR_FAIL_COND(is_empty());
+
+	RasterThreadData td;
+	td.meshes = &p_meshes;
+	td.cam_inv_transform = p_cam_transform.affine_inverse();
+	td.cam_projection = p_cam_projection;
+	td.frustum_planes = p_cam_projection.get_projection_planes(p_cam_transform);
+	td.z_near = p_cam_projection.get_z_near();
+	td.thread_count = CLAMP(p_meshes.size(), 1u, thread_bins.size());
+
+	// Same value as the rays that don't hit anything in the raycast backend.
+	clear_distance = p_cam_projection.get_z_far() * 1.05f;
+	debug_tex_range = clear_distance;
+
+	_update_depth_to_distance(p_cam_projection, p_cam_orthogonal);
+
+	// Triangles are set up and binned per thread, then each tile rasterizes the bins of all threads.
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RasterHZBuffer::_setup_triangles_threaded, &td, td.thread_count, -1, true, SNAME("RasterOcclusionCullSetup"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RasterHZBuffer::_rasterize_tile_threaded, &td, tile_grid_size.x * tile_grid_size.y, -1, true, SNAME("RasterOcclusionCullRasterize"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
+////////////////////////////////////////////////////////
+
+bool RasterOcclusionCull::is_occluder(RID p_rid) {
+	return occluder_owner.owns(p_rid);
+}
+
+RID RasterOcclusionCull::occluder_allocate() {
+	return occluder_owner.allocate_rid();
+}
+
+void RasterOcclusionCull::occluder_initialize(RID p_occluder) {
+	Occluder *occluder = memnew(Occluder);
+	occluder_owner.initialize_rid(p_occluder, occluder);
+}
+
+void RasterOcclusionCull::occluder_set_mesh(RID p_occluder, const PackedVector3Array &p_vertices, const PackedInt32Array &p_indices) {
+	Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+	ERR_FAIL_NULL(occluder);
+
+	occluder->vertices = p_vertices;
+	occluder->indices = p_indices;
+
+	for (const InstanceID &E : occluder->users) {
+		Scenario *scenario = scenarios.getptr(E.scenario);
+		ERR_CONTINUE(!scenario || !scenario->instances.has(E.instance));
+		scenario->dirty_instances.insert(E.instance);
+		scenario->dirty = true;
+	}
+}
+
+void RasterOcclusionCull::free_occluder(RID p_occluder) {
+	Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+	ERR_FAIL_NULL(occluder);
+	memdelete(occluder);
+	occluder_owner.free(p_occluder);
+}
+
+////////////////////////////////////////////////////////
+
+void RasterOcclusionCull::add_scenario(RID p_scenario) {
+	ERR_FAIL_COND(scenarios.has(p_scenario));
+	scenarios[p_scenario] = Scenario();
+}
+
+void RasterOcclusionCull::remove_scenario(RID p_scenario) {
+	ERR_FAIL_COND(!scenarios.has(p_scenario));
+	scenarios.erase(p_scenario);
+}
+
+void RasterOcclusionCull::scenario_set_instance(RID p_scenario, RID p_instance, RID p_occluder, const Transform3D &p_xform, bool p_enabled) {
+	Scenario *scenario = scenarios.getptr(p_scenario);
+	ERR_FAIL_NULL(scenario);
+
+	if (!scenario->instances.has(p_instance)) {
+		scenario->instances[p_instance] = OccluderInstance();
+	}
+
+	OccluderInstance &instance = scenario->instances[p_instance];
+
+	bool changed = false;
+
+	if (instance.occluder != p_occluder) {
+		Occluder *old_occluder = occluder_owner.get_or_null(instance.occluder);
+		if (old_occluder) {
+			old_occluder->users.erase(InstanceID(p_scenario, p_instance));
+		}
+
+		instance.occluder = p_occluder;
+
+		if (p_occluder.is_valid()) {
+			Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+			ERR_FAIL_NULL(occluder);
+			occluder->users.insert(InstanceID(p_scenario, p_instance));
+		}
+		changed = true;
+	}
+
+	if (instance.xform != p_xform) {
+		instance.xform = p_xform;
+		changed = true;
+	}
+
+	if (instance.enabled != p_enabled) {
+		instance.enabled = p_enabled;
+		scenario->dirty = true; // The mesh list needs a rebuild, but the instance doesn't need update
+	}
+
+	if (changed) {
+		scenario->dirty_instances.insert(p_instance);
+		scenario->dirty = true;
+	}
+}
+
+void RasterOcclusionCull::scenario_remove_instance(RID p_scenario, RID p_instance) {
+	Scenario *scenario = scenarios.getptr(p_scenario);
+	ERR_FAIL_NULL(scenario);
+
+	OccluderInstance *instance = scenario->instances.getptr(p_instance);
+	if (!instance) {
+		return;
+	}
+
+	Occluder *occluder = occluder_owner.get_or_null(instance->occluder);
+	if (occluder) {
+		occluder->users.erase(InstanceID(p_scenario, p_instance));
+	}
+
+	scenario->instances.erase(p_instance);
+	scenario->dirty_instances.erase(p_instance);
+	scenario->dirty = true;
+}
+
+void RasterOcclusionCull::Scenario::_update_dirty_instance(OccluderInstance &r_instance) {
+	r_instance.xformed_vertices.clear();
+	r_instance.indices.clear();
+
+	const Occluder *occ = raster_singleton->occluder_owner.get_or_null(r_instance.occluder);
+	if (!occ) {
+		return;
+	}
+
+	const int vertex_count = occ->vertices.size();
+	const Vector3 *read = occ->vertices.ptr();
+	r_instance.xformed_vertices.resize(vertex_count);
+	for (int i = 0; i < vertex_count; i++) {
+		const Vector3 p = r_instance.xform.xform(read[i]);
+		r_instance.xformed_vertices[i] = p;
+		if (i == 0) {
+			r_instance.aabb = AABB(p, Vector3());
+		} else {
+			r_instance.aabb.expand_to(p);
+		}
+	}
+
+	// Only keep the triangles that are fully valid, so rasterization doesn't have to check indices.
+	const int32_t *indices = occ->indices.ptr();
+	const int index_count = occ->indices.size() - occ->indices.size() % 3;
+	r_instance.indices.reserve(index_count);
+	for (int i = 0; i < index_count; i += 3) {
+		if ((uint32_t)indices[i] < (uint32_t)vertex_count && (uint32_t)indices[i + 1] < (uint32_t)vertex_count && (uint32_t)indices[i + 2] < (uint32_t)vertex_count) {
+			r_instance.indices.push_back(indices[i]);
+			r_instance.indices.push_back(indices[i + 1]);
+			r_instance.indices.push_back(indices[i + 2]);
+		}
+	}
+}
+
+void RasterOcclusionCull::Scenario::update() {
+	if (!dirty) {
+		return;
+	}
+
+	for (const RID &rid : dirty_instances) {
+		OccluderInstance *instance = instances.getptr(rid);
+		if (instance) {
+			_update_dirty_instance(*instance);
+		}
+	}
+	dirty_instances.clear();
+
+	meshes.clear();
+	for (const KeyValue<RID, OccluderInstance> &E : instances) {
+		const OccluderInstance &instance = E.value;
+		if (!instance.enabled || instance.indices.is_empty()) {
+			continue;
+		}
+
+		RasterHZBuffer::Mesh mesh;
+		mesh.vertices = instance.xformed_vertices.ptr();
+		mesh.indices = instance.indices.ptr();
+		mesh.index_count = instance.indices.size();
+		mesh.aabb = instance.aabb;
+		meshes.push_back(mesh);
+	}
+
+	dirty = false;
+}
+
+////////////////////////////////////////////////////////
+
+void RasterOcclusionCull::add_buffer(RID p_buffer) {
+	ERR_FAIL_COND(buffers.has(p_buffer));
+	buffers[p_buffer] = RasterHZBuffer();
+}
+
+void RasterOcclusionCull::remove_buffer(RID p_buffer) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	buffers.erase(p_buffer);
+}
+
+void RasterOcclusionCull::buffer_set_scenario(RID p_buffer, RID p_scenario) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	ERR_FAIL_COND(p_scenario.is_valid() && !scenarios.has(p_scenario));
+	buffers[p_buffer].scenario_rid = p_scenario;
+}
+
+void RasterOcclusionCull::buffer_set_size(RID p_buffer, const Vector2i &p_size) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	buffers[p_buffer].resize(p_size);
+}
+
+Vector2 RasterOcclusionCull::_get_jitter(const Size2i &p_buffer_size) {
+	if (!_jitter_enabled) {
+		return Vector2();
+	}
+
+	// Prevent divide by zero when using NULL viewport.
+	if ((p_buffer_size.x <= 0) || (p_buffer_size.y <= 0)) {
+		return Vector2();
+	}
+
+	// Same pattern and magnitude as the raycast backend, expressed in NDC units.
+	static const Vector2 pattern[9] = {
+		Vector2(0, 0),
+		Vector2(-1, -1),
+		Vector2(1, -1),
+		Vector2(-1, 1),
+		Vector2(1, 1),
+		Vector2(-0.5f, -0.5f),
+		Vector2(0.5f, -0.5f),
+		Vector2(-0.5f, 0.5f),
+		Vector2(0.5f, 0.5f),
+	};
+
+	const int frame = Engine::get_singleton()->get_frames_drawn() % 9;
+	return pattern[frame] * Vector2(1.0f / p_buffer_size.x, 1.0f / p_buffer_size.y) * 0.66f;
+}
+
+void RasterOcclusionCull::buffer_update(RID p_buffer, const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal) {
+	RasterHZBuffer *buffer = buffers.getptr(p_buffer);
+	if (!buffer || buffer->is_empty()) {
+		return;
+	}
+
+	Scenario *scenario = scenarios.getptr(buffer->scenario_rid);
+	if (!scenario) {
+		return;
+	}
+	scenario->update();
+
+	Projection correction;
+	correction.add_jitter_offset(_get_jitter(buffer->get_occlusion_buffer_size()));
+
+	buffer->rasterize(scenario->meshes, p_cam_transform, correction * p_cam_projection, p_cam_orthogonal);
+	buffer->update_mips();
+}
+
+RendererSceneOcclusionCull::HZBuffer *RasterOcclusionCull::buffer_get_ptr(RID p_buffer) {
+	return buffers.getptr(p_buffer);
+}
+
+RID RasterOcclusionCull::buffer_get_debug_texture(RID p_buffer) {
+	ERR_FAIL_COND_V(!buffers.has(p_buffer), RID());
+	return buffers[p_buffer].get_debug_texture();
+}
+
+////////////////////////////////////////////////////////
+
+RasterOcclusionCull::RasterOcclusionCull() {
+	raster_singleton = this;
+	_jitter_enabled = GLOBAL_GET("rendering/occlusion_culling/jitter_projection");
+}
+
+RasterOcclusionCull::~RasterOcclusionCull() {
+	raster_singleton = nullptr;
+}
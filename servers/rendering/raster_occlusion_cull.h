@@ -0,0 +1,178 @@
+/**************************************************************************/
+/*  raster_occlusion_cull.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/math/aabb.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/hash_set.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/rid_owner.h"
+#include "servers/rendering/renderer_scene_occlusion_cull.h"
+
+// Occlusion culling backend that rasterizes occluders into a depth buffer on the CPU.
+// Unlike the raycast module, it has no dependency on Embree, so it works on every architecture.
+class RasterOcclusionCull : public RendererSceneOcclusionCull {
+public:
+	class RasterHZBuffer : public HZBuffer {
+	public:
+		// World space triangle soup to rasterize.
+		struct Mesh {
+			const Vector3 *vertices = nullptr;
+			const uint32_t *indices = nullptr;
+			uint32_t index_count = 0;
+			AABB aabb;
+		};
+
+		static const int TILE_SIZE = 32;
+
+	private:
+		// Screen space triangle, with its edge functions and the planes used to interpolate depth.
+		struct Triangle {
+			float edges[3][3];
+			float inv_w[3];
+			float depth_over_w[3];
+			int min_x;
+			int min_y;
+			int max_x;
+			int max_y;
+		};
+
+		struct ThreadBins {
+			LocalVector<Triangle> triangles;
+			LocalVector<LocalVector<uint32_t>> tiles;
+		};
+
+		struct RasterThreadData {
+			const LocalVector<Mesh> *meshes = nullptr;
+			Transform3D cam_inv_transform;
+			Projection cam_projection;
+			Vector<Plane> frustum_planes;
+			float z_near = 0.0f;
+			uint32_t thread_count = 0;
+		};
+
+		Size2i tile_grid_size;
+		LocalVector<ThreadBins> thread_bins;
+		LocalVector<float> depth_to_distance;
+		float clear_distance = FLT_MAX;
+
+		void _setup_triangle(ThreadBins &r_bins, const Vector3 p_view[3], const Projection &p_cam_projection);
+		void _setup_triangles_threaded(uint32_t p_thread, const RasterThreadData *p_data);
+		void _rasterize_tile_threaded(uint32_t p_tile, const RasterThreadData *p_data);
+		void _update_depth_to_distance(const Projection &p_cam_projection, bool p_cam_orthogonal);
+
+	public:
+		RID scenario_rid;
+
+		virtual void clear() override;
+		virtual void resize(const Size2i &p_size) override;
+
+		// Fills the top mip with the distance to the closest occluder for each pixel.
+		// Call update_mips() afterwards to build the rest of the hierarchy.
+		void rasterize(const LocalVector<Mesh> &p_meshes, const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal);
+	};
+
+private:
+	struct InstanceID {
+		RID scenario;
+		RID instance;
+
+		static uint32_t hash(const InstanceID &p_ins) {
+			uint32_t h = hash_murmur3_one_64(p_ins.scenario.get_id());
+			return hash_fmix32(hash_murmur3_one_64(p_ins.instance.get_id(), h));
+		}
+		bool operator==(const InstanceID &rhs) const {
+			return instance == rhs.instance && rhs.scenario == scenario;
+		}
+
+		InstanceID() {}
+		InstanceID(RID s, RID i) :
+				scenario(s), instance(i) {}
+	};
+
+	struct Occluder {
+		PackedVector3Array vertices;
+		PackedInt32Array indices;
+		HashSet<InstanceID, InstanceID> users;
+	};
+
+	struct OccluderInstance {
+		RID occluder;
+		LocalVector<Vector3> xformed_vertices;
+		LocalVector<uint32_t> indices;
+		AABB aabb;
+		Transform3D xform;
+		bool enabled = true;
+	};
+
+	struct Scenario {
+		HashMap<RID, OccluderInstance> instances;
+		HashSet<RID> dirty_instances;
+		LocalVector<RasterHZBuffer::Mesh> meshes;
+		bool dirty = false;
+
+		void _update_dirty_instance(OccluderInstance &r_instance);
+		void update();
+	};
+
+	static RasterOcclusionCull *raster_singleton;
+
+	RID_PtrOwner<Occluder> occluder_owner;
+	HashMap<RID, Scenario> scenarios;
+	HashMap<RID, RasterHZBuffer> buffers;
+	bool _jitter_enabled = false;
+
+	Vector2 _get_jitter(const Size2i &p_buffer_size);
+
+public:
+	virtual bool is_occluder(RID p_rid) override;
+	virtual RID occluder_allocate() override;
+	virtual void occluder_initialize(RID p_occluder) override;
+	virtual void occluder_set_mesh(RID p_occluder, const PackedVector3Array &p_vertices, const PackedInt32Array &p_indices) override;
+	virtual void free_occluder(RID p_occluder) override;
+
+	virtual void add_scenario(RID p_scenario) override;
+	virtual void remove_scenario(RID p_scenario) override;
+	virtual void scenario_set_instance(RID p_scenario, RID p_instance, RID p_occluder, const Transform3D &p_xform, bool p_enabled) override;
+	virtual void scenario_remove_instance(RID p_scenario, RID p_instance) override;
+
+	virtual void add_buffer(RID p_buffer) override;
+	virtual void remove_buffer(RID p_buffer) override;
+	virtual HZBuffer *buffer_get_ptr(RID p_buffer) override;
+	virtual void buffer_set_scenario(RID p_buffer, RID p_scenario) override;
+	virtual void buffer_set_size(RID p_buffer, const Vector2i &p_size) override;
+	virtual void buffer_update(RID p_buffer, const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal) override;
+
+	virtual RID buffer_get_debug_texture(RID p_buffer) override;
+
+	RasterOcclusionCull();
+	~RasterOcclusionCull();
+};
@@ -47,6 +47,77 @@ const static float FEATHER_SIZE = 1.25f;
 
 static RendererCanvasCull *_canvas_cull_singleton = nullptr;
 
+// Identifies which canvas_item_add_*() call produced a draw hash.
+enum CanvasItemDrawCall : uint32_t {
+	DRAW_CALL_LINE,
+	DRAW_CALL_POLYLINE,
+	DRAW_CALL_MULTILINE,
+	DRAW_CALL_RECT,
+	DRAW_CALL_ELLIPSE,
+	DRAW_CALL_TEXTURE_RECT,
+	DRAW_CALL_MSDF_TEXTURE_RECT_REGION,
+	DRAW_CALL_LCD_TEXTURE_RECT_REGION,
+	DRAW_CALL_TEXTURE_RECT_REGION,
+	DRAW_CALL_NINE_PATCH,
+	DRAW_CALL_PRIMITIVE,
+	DRAW_CALL_POLYGON,
+	DRAW_CALL_TRIANGLE_ARRAY,
+	DRAW_CALL_SET_TRANSFORM,
+	DRAW_CALL_MESH,
+	DRAW_CALL_PARTICLES,
+	DRAW_CALL_MULTIMESH,
+	DRAW_CALL_CLIP_IGNORE,
+	DRAW_CALL_ANIMATION_SLICE,
+};
+
+// Hashes the arguments of a draw call with two differently seeded murmur3 streams,
+// so that two different redraws practically never end up with the same 64-bit hash.
+class CanvasItemDrawHash {
+	uint32_t h0 = HASH_MURMUR3_SEED;
+	uint32_t h1 = 0x9e3779b9;
+
+	void _add_buffer(const void *p_data, uint32_t p_size) {
+		const uint8_t *data = (const uint8_t *)p_data;
+		for (; p_size >= 4; p_size -= 4, data += 4) {
+			uint32_t word;
+			memcpy(&word, data, 4);
+			h0 = hash_murmur3_one_32(word, h0);
+			h1 = hash_murmur3_one_32(word, h1);
+		}
+		if (p_size > 0) {
+			uint32_t word = 0;
+			memcpy(&word, data, p_size);
+			h0 = hash_murmur3_one_32(word, h0);
+			h1 = hash_murmur3_one_32(word, h1);
+		}
+	}
+
+public:
+	template <typename T>
+	void add(const T &p_value) {
+		static_assert(std::is_trivially_copyable_v<T>);
+		_add_buffer(&p_value, sizeof(T));
+	}
+
+	template <typename T>
+	void add(const Vector<T> &p_vector) {
+		add(p_vector.size());
+		_add_buffer(p_vector.ptr(), p_vector.size() * sizeof(T));
+	}
+
+	uint64_t get() const {
+		return ((uint64_t)hash_fmix32(h0) << 32) | hash_fmix32(h1);
+	}
+};
+
+template <typename... Args>
+static uint64_t _draw_call_hash(CanvasItemDrawCall p_call, const Args &...p_args) {
+	CanvasItemDrawHash hash;
+	hash.add(p_call);
+	(hash.add(p_args), ...);
+	return hash.get();
+}
+
 void RendererCanvasCull::_dependency_changed(Dependency::DependencyChangedNotification p_notification, DependencyTracker *p_tracker) {
 	Item *item = (Item *)p_tracker->userdata;
 
@@ -226,6 +297,12 @@ void RendererCanvasCull::_attach_canvas_item_for_draw(RendererCanvasCull::Item *
 				// No commands, or sole command is the one used to draw, so we (re)create the draw command.
 				ci->clear();
 
+				// This command isn't part of the item's own draw calls, make sure the next redraw doesn't keep it.
+				ci->draw_hashes.clear();
+				ci->draw_starts.clear();
+				ci->draw_hashes.push_back(0);
+				ci->draw_starts.push_back(nullptr);
+
 				if (rect_accum == Rect2()) {
 					rect_accum.size = Size2(1, 1);
 				}
@@ -682,6 +759,11 @@ void RendererCanvasCull::canvas_item_set_custom_rect(RID p_item, bool p_custom_r
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
 
+	if (!p_custom_rect && canvas_item->rect != p_rect) {
+		// The rect computed from the commands gets overwritten, make sure it's computed again.
+		canvas_item->rect_dirty = true;
+	}
+
 	canvas_item->custom_rect = p_custom_rect;
 	canvas_item->rect = p_rect;
 }
@@ -748,6 +830,10 @@ void RendererCanvasCull::canvas_item_add_line(RID p_item, const Point2 &p_from,
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
 
+	if (_retain_draw(canvas_item, _draw_call_hash(DRAW_CALL_LINE, p_from, p_to, p_color, p_width, p_antialiased))) {
+		return;
+	}
+
 	Item::CommandPrimitive *line = canvas_item->alloc_command<Item::CommandPrimitive>();
 	ERR_FAIL_NULL(line);
 
@@ -982,6 +1068,10 @@ void RendererCanvasCull::canvas_item_add_polyline(RID p_item, const Vector<Point
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
 
+	if (_retain_draw(canvas_item, _draw_call_hash(DRAW_CALL_POLYLINE, p_points, p_colors, p_width, p_antialiased))) {
+		return;
+	}
+
 	Color color = Color(1, 1, 1, 1);
 
 	Vector<int> indices;
@@ -1259,6 +1349,10 @@ void RendererCanvasCull::canvas_item_add_multiline(RID p_item, const Vector<Poin
 		Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 		ERR_FAIL_NULL(canvas_item);
 
+		if (_retain_draw(canvas_item, _draw_call_hash(DRAW_CALL_MULTILINE, p_points, p_colors, p_width, p_antialiased))) {
+			return;
+		}
+
 		Vector<Color> colors;
 		if (p_colors.size() == 1) {
 			colors = p_colors;
@@ -1301,6 +1395,10 @@ void RendererCanvasCull::canvas_item_add_rect(RID p_item, const Rect2 &p_rect, c
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
 
+	if (_retain_draw(canvas_item, _draw_call_hash(DRAW_CALL_RECT, p_rect, p_color, p_antialiased))) {
+		return;
+	}
+
 	// Adjust the rectangle size to account for the antialiasing width.
 	const Rect2 &rect_adjusted = p_antialiased ? p_rect.grow(-FEATHER_SIZE * 0.25f) : p_rect;
 
@@ -1468,6 +1566,10 @@ void RendererCanvasCull::canvas_item_add_ellipse(RID p_item, const Point2 &p_pos
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
 
+	if (_retain_draw(canvas_item, _draw_call_hash(DRAW_CALL_ELLIPSE, p_pos, p_major, p_minor, p_color, p_antialiased))) {
+		return;
+	}
+
 	static const int ellipse_segments = 64;
 
 	float major = p_major;
@@ -1571,6 +1673,10 @@ void RendererCanvasCull::canvas_item_add_texture_rect(RID p_item, const Rect2 &p
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
 
+	if (_retain_draw(canvas_item, _draw_call_hash(DRAW_CALL_TEXTURE_RECT, p_rect, p_texture, p_tile, p_modulate, p_transpose))) {
+		return;
+	}
+
 	Item::CommandRect *rect = canvas_item->alloc_command<Item::CommandRect>();
 	ERR_FAIL_NULL(rect);
 	rect->modulate = p_modulate;
@@ -1602,6 +1708,10 @@ void RendererCanvasCull::canvas_item_add_msdf_texture_rect_region(RID p_item, co
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
 
+	if (_retain_draw(canvas_item, _draw_call_hash(DRAW_CALL_MSDF_TEXTURE_RECT_REGION, p_rect, p_texture, p_src_rect, p_modulate, p_outline_size, p_px_range, p_scale))) {
+		return;
+	}
+
 	Item::CommandRect *rect = canvas_item->alloc_command<Item::CommandRect>();
 	ERR_FAIL_NULL(rect);
 	rect->modulate = p_modulate;
@@ -1636,6 +1746,10 @@ void RendererCanvasCull::canvas_item_add_lcd_texture_rect_region(RID p_item, con
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
 
+	if (_retain_draw(canvas_item, _draw_call_hash(DRAW_CALL_LCD_TEXTURE_RECT_REGION, p_rect, p_texture, p_src_rect, p_modulate))) {
+		return;
+	}
+
 	Item::CommandRect *rect = canvas_item->alloc_command<Item::CommandRect>();
 	ERR_FAIL_NULL(rect);
 	rect->modulate = p_modulate;
@@ -1668,6 +1782,10 @@ void RendererCanvasCull::canvas_item_add_texture_rect_region(RID p_item, const R
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
 
+	if (_retain_draw(canvas_item, _draw_call_hash(DRAW_CALL_TEXTURE_RECT_REGION, p_rect, p_texture, p_src_rect, p_modulate, p_transpose, p_clip_uv))) {
+		return;
+	}
+
 	Item::CommandRect *rect = canvas_item->alloc_command<Item::CommandRect>();
 	ERR_FAIL_NULL(rect);
 	rect->modulate = p_modulate;
@@ -1709,6 +1827,10 @@ void RendererCanvasCull::canvas_item_add_nine_patch(RID p_item, const Rect2 &p_r
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
 
+	if (_retain_draw(canvas_item, _draw_call_hash(DRAW_CALL_NINE_PATCH, p_rect, p_source, p_texture, p_topleft, p_bottomright, p_x_axis_mode, p_y_axis_mode, p_draw_center, p_modulate))) {
+		return;
+	}
+
 	Item::CommandNinePatch *style = canvas_item->alloc_command<Item::CommandNinePatch>();
 	ERR_FAIL_NULL(style);
 
@@ -1733,6 +1855,10 @@ void RendererCanvasCull::canvas_item_add_primitive(RID p_item, const Vector<Poin
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
 
+	if (_retain_draw(canvas_item, _draw_call_hash(DRAW_CALL_PRIMITIVE, p_points, p_colors, p_uvs, p_texture))) {
+		return;
+	}
+
 	Item::CommandPrimitive *prim = canvas_item->alloc_command<Item::CommandPrimitive>();
 	ERR_FAIL_NULL(prim);
 
@@ -1758,6 +1884,7 @@ void RendererCanvasCull::canvas_item_add_primitive(RID p_item, const Vector<Poin
 void RendererCanvasCull::canvas_item_add_polygon(RID p_item, const Vector<Point2> &p_points, const Vector<Color> &p_colors, const Vector<Point2> &p_uvs, RID p_texture) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+
 #ifdef DEBUG_ENABLED
 	int pointcount = p_points.size();
 	ERR_FAIL_COND(pointcount < 3);
@@ -1766,6 +1893,13 @@ void RendererCanvasCull::canvas_item_add_polygon(RID p_item, const Vector<Point2
 	ERR_FAIL_COND(color_size != 0 && color_size != 1 && color_size != pointcount);
 	ERR_FAIL_COND(uv_size != 0 && (uv_size != pointcount));
 #endif
+
+	// Triangulation is what retaining saves, so it's only validated for changed draws.
+	// A failed triangulation still records the draw call, identical redraws then keep drawing nothing.
+	if (_retain_draw(canvas_item, _draw_call_hash(DRAW_CALL_POLYGON, p_points, p_colors, p_uvs, p_texture))) {
+		return;
+	}
+
 	Vector<int> indices = Geometry2D::triangulate_polygon(p_points);
 	ERR_FAIL_COND_MSG(indices.is_empty(), "Invalid polygon data, triangulation failed.");
 
@@ -1787,6 +1921,10 @@ void RendererCanvasCull::canvas_item_add_triangle_array(RID p_item, const Vector
 	ERR_FAIL_COND(!p_bones.is_empty() && p_bones.size() != vertex_count * 4);
 	ERR_FAIL_COND(!p_weights.is_empty() && p_weights.size() != vertex_count * 4);
 
+	if (_retain_draw(canvas_item, _draw_call_hash(DRAW_CALL_TRIANGLE_ARRAY, p_indices, p_points, p_colors, p_uvs, p_bones, p_weights, p_texture, p_count))) {
+		return;
+	}
+
 	Item::CommandPolygon *polygon = canvas_item->alloc_command<Item::CommandPolygon>();
 	ERR_FAIL_NULL(polygon);
 
@@ -1801,6 +1939,10 @@ void RendererCanvasCull::canvas_item_add_set_transform(RID p_item, const Transfo
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
 
+	if (_retain_draw(canvas_item, _draw_call_hash(DRAW_CALL_SET_TRANSFORM, p_transform))) {
+		return;
+	}
+
 	Item::CommandTransform *tr = canvas_item->alloc_command<Item::CommandTransform>();
 	ERR_FAIL_NULL(tr);
 	tr->xform = p_transform;
@@ -1811,6 +1953,10 @@ void RendererCanvasCull::canvas_item_add_mesh(RID p_item, const RID &p_mesh, con
 	ERR_FAIL_NULL(canvas_item);
 	ERR_FAIL_COND(!p_mesh.is_valid());
 
+	if (_retain_draw(canvas_item, _draw_call_hash(DRAW_CALL_MESH, p_mesh, p_transform, p_modulate, p_texture))) {
+		return;
+	}
+
 	Item::CommandMesh *m = canvas_item->alloc_command<Item::CommandMesh>();
 	ERR_FAIL_NULL(m);
 	m->mesh = p_mesh;
@@ -1829,6 +1975,11 @@ void RendererCanvasCull::canvas_item_add_particles(RID p_item, RID p_particles,
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
 
+	if (_retain_draw(canvas_item, _draw_call_hash(DRAW_CALL_PARTICLES, p_particles, p_texture))) {
+		RSG::particles_storage->particles_request_process(p_particles);
+		return;
+	}
+
 	Item::CommandParticles *part = canvas_item->alloc_command<Item::CommandParticles>();
 	ERR_FAIL_NULL(part);
 	part->particles = p_particles;
@@ -1843,6 +1994,10 @@ void RendererCanvasCull::canvas_item_add_multimesh(RID p_item, RID p_mesh, RID p
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
 
+	if (_retain_draw(canvas_item, _draw_call_hash(DRAW_CALL_MULTIMESH, p_mesh, p_texture))) {
+		return;
+	}
+
 	Item::CommandMultiMesh *mm = canvas_item->alloc_command<Item::CommandMultiMesh>();
 	ERR_FAIL_NULL(mm);
 	mm->multimesh = p_mesh;
@@ -1854,6 +2009,10 @@ void RendererCanvasCull::canvas_item_add_clip_ignore(RID p_item, bool p_ignore)
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
 
+	if (_retain_draw(canvas_item, _draw_call_hash(DRAW_CALL_CLIP_IGNORE, p_ignore))) {
+		return;
+	}
+
 	Item::CommandClipIgnore *ci = canvas_item->alloc_command<Item::CommandClipIgnore>();
 	ERR_FAIL_NULL(ci);
 	ci->ignore = p_ignore;
@@ -1863,6 +2022,10 @@ void RendererCanvasCull::canvas_item_add_animation_slice(RID p_item, double p_an
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
 
+	if (_retain_draw(canvas_item, _draw_call_hash(DRAW_CALL_ANIMATION_SLICE, p_animation_length, p_slice_begin, p_slice_end, p_offset))) {
+		return;
+	}
+
 	Item::CommandAnimationSlice *as = canvas_item->alloc_command<Item::CommandAnimationSlice>();
 	ERR_FAIL_NULL(as);
 	as->animation_length = p_animation_length;
@@ -1946,7 +2109,19 @@ void RendererCanvasCull::canvas_item_clear(RID p_item) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
 
-	canvas_item->clear();
+	if (canvas_item->retaining_draws) {
+		_end_retained_draws(canvas_item, true);
+	}
+
+	// Keep the commands around, the draw calls that follow will either match and keep them,
+	// or rebuild them from the first call that differs (see _retain_draw()).
+	canvas_item->retaining_draws = true;
+	canvas_item->retained_draws = 0;
+	canvas_item->clip = false;
+	canvas_item->final_clip_owner = nullptr;
+	canvas_item->material_owner = nullptr;
+	canvas_item->light_masked = false;
+	_item_queue_update(canvas_item, false);
 
 #ifdef DEBUG_ENABLED
 	if (debug_redraw) {
@@ -1955,6 +2130,38 @@ void RendererCanvasCull::canvas_item_clear(RID p_item) {
 #endif
 }
 
+bool RendererCanvasCull::_retain_draw(Item *p_item, uint64_t p_hash) {
+	if (p_item->retaining_draws) {
+		if (p_item->retained_draws < p_item->draw_hashes.size() && p_item->draw_hashes[p_item->retained_draws] == p_hash) {
+			p_item->retained_draws++;
+			return true;
+		}
+
+		// The redraw differs from here on, so the rest of the previous commands can't be reused.
+		_end_retained_draws(p_item, false);
+	}
+
+	p_item->draw_hashes.push_back(p_hash);
+	p_item->draw_starts.push_back(p_item->last_command);
+	return false;
+}
+
+void RendererCanvasCull::_end_retained_draws(Item *p_item, bool p_finished) {
+	p_item->retaining_draws = false;
+
+	if (p_item->retained_draws < p_item->draw_hashes.size()) {
+		p_item->truncate_commands(p_item->draw_starts[p_item->retained_draws]);
+		p_item->draw_hashes.resize(p_item->retained_draws);
+		p_item->draw_starts.resize(p_item->retained_draws);
+	} else if (p_finished) {
+		// Every draw call matched, nothing was rebuilt.
+		items_reused_pending++;
+		return;
+	}
+
+	items_rebuilt_pending++;
+}
+
 void RendererCanvasCull::canvas_item_set_draw_index(RID p_item, int p_index) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
@@ -2596,12 +2803,23 @@ void RendererCanvasCull::_update_dirty_item(Item *p_item) {
 
 		p_item->dependency_tracker.update_end();
 	}
+
+	if (p_item->retaining_draws) {
+		// Drawing is over, drop the previous commands that weren't drawn again.
+		_end_retained_draws(p_item, true);
+	}
+
 	_item_update_list.remove(&p_item->update_item);
 	p_item->update_dependencies = false;
 }
 
 void RendererCanvasCull::update() {
 	update_dirty_items();
+
+	items_reused_in_frame = items_reused_pending;
+	items_rebuilt_in_frame = items_rebuilt_pending;
+	items_reused_pending = 0;
+	items_rebuilt_pending = 0;
 }
 
 bool RendererCanvasCull::free(RID p_rid) {
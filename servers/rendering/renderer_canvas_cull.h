@@ -83,6 +83,13 @@ public:
 
 		bool update_dependencies = false;
 
+		// Hash of every canvas_item_add_*() call made since the last clear, along with the last command before each call.
+		// When the item is redrawn with the same calls, the existing commands are kept instead of being rebuilt.
+		LocalVector<uint64_t> draw_hashes;
+		LocalVector<Command *> draw_starts;
+		uint32_t retained_draws = 0;
+		bool retaining_draws = false;
+
 		Item() :
 				update_item(this) {
 			children_order_dirty = true;
@@ -108,6 +115,14 @@ public:
 	void _item_queue_update(Item *p_item, bool p_update_dependencies);
 	SelfList<Item>::List _item_update_list;
 
+	uint64_t items_reused_pending = 0;
+	uint64_t items_rebuilt_pending = 0;
+	uint64_t items_reused_in_frame = 0;
+	uint64_t items_rebuilt_in_frame = 0;
+
+	bool _retain_draw(Item *p_item, uint64_t p_hash);
+	void _end_retained_draws(Item *p_item, bool p_finished);
+
 	struct ItemIndexSort {
 		_FORCE_INLINE_ bool operator()(const Item *p_left, const Item *p_right) const {
 			return p_left->index < p_right->index;
@@ -379,6 +394,10 @@ public:
 	void update_visibility_notifiers();
 	void update_dirty_items();
 
+	// Number of redrawn canvas items whose commands were kept or rebuilt, for the last frame.
+	uint64_t get_items_reused_in_frame() const { return items_reused_in_frame; }
+	uint64_t get_items_rebuilt_in_frame() const { return items_rebuilt_in_frame; }
+
 	void _update_dirty_item(Item *p_item);
 
 	Rect2 _debug_canvas_item_get_rect(RID p_item);
@@ -429,10 +429,17 @@ public:
 			return command;
 		}
 
-		void clear() {
+		// Destroys every command after p_last (all of them if p_last is null),
+		// so the next allocated command goes right after it.
+		void truncate_commands(Command *p_last) {
+			Command *first_removed = p_last ? p_last->next : commands;
+			if (first_removed == nullptr) {
+				return;
+			}
+
 			// The first one is always allocated on heap
 			// the rest go in the blocks
-			Command *c = commands;
+			Command *c = first_removed;
 			while (c) {
 				Command *n = c->next;
 				if (c == commands) {
@@ -443,13 +450,41 @@ public:
 				}
 				c = n;
 			}
-			{
-				uint32_t cbc = MIN((current_block + 1), (uint32_t)blocks.size());
-				CommandBlock *blockptr = blocks.ptrw();
+
+			uint32_t cbc = MIN((current_block + 1), (uint32_t)blocks.size());
+			CommandBlock *blockptr = blocks.ptrw();
+			uint32_t keep_block = 0;
+			uint32_t first_free_block = 0;
+			if (p_last != nullptr && p_last != commands) {
+				// Commands are laid out contiguously in the blocks, rewind the block holding p_last.
 				for (uint32_t i = 0; i < cbc; i++) {
-					blockptr[i].usage = 0;
+					uint8_t *memory = blockptr[i].memory;
+					if ((uint8_t *)p_last >= memory && (uint8_t *)p_last < memory + CommandBlock::MAX_SIZE) {
+						if ((uint8_t *)first_removed > (uint8_t *)p_last && (uint8_t *)first_removed < memory + CommandBlock::MAX_SIZE) {
+							blockptr[i].usage = (uint8_t *)first_removed - memory;
+						}
+						keep_block = i;
+						first_free_block = i + 1;
+						break;
+					}
 				}
 			}
+			for (uint32_t i = first_free_block; i < cbc; i++) {
+				blockptr[i].usage = 0;
+			}
+
+			if (p_last) {
+				p_last->next = nullptr;
+			} else {
+				commands = nullptr;
+			}
+			last_command = p_last;
+			current_block = keep_block;
+			rect_dirty = true;
+		}
+
+		void clear() {
+			truncate_commands(nullptr);
 
 			last_command = nullptr;
 			commands = nullptr;
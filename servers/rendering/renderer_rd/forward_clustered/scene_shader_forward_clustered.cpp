@@ -38,25 +38,20 @@
 
 using namespace RendererSceneRenderImplementation;
 
-void SceneShaderForwardClustered::ShaderData::set_code(const String &p_code) {
-	//compile
-
+bool SceneShaderForwardClustered::ShaderData::_compile_prepare(const String &p_code, CompileState &r_state) {
 	code = p_code;
 	ubo_size = 0;
 	uniforms.clear();
 	_clear_vertex_input_mask_cache();
 
 	if (code.is_empty()) {
-		return; //just invalid, but no error
+		return false;
 	}
 
-	ShaderCompiler::GeneratedCode gen_code;
-
 	blend_mode = BLEND_MODE_MIX;
 	depth_test_disabledi = 0;
 	depth_test_invertedi = 0;
 	alpha_antialiasing_mode = ALPHA_ANTIALIASING_OFF;
-	int cull_modei = RSE::CULL_MODE_BACK;
 
 	uses_point_size = false;
 	uses_alpha = false;
@@ -83,15 +78,7 @@ void SceneShaderForwardClustered::ShaderData::set_code(const String &p_code) {
 	uses_particle_trails = false;
 	uses_z_clip_scale = false;
 
-	int depth_drawi = DEPTH_DRAW_OPAQUE;
-
-	int stencil_readi = 0;
-	int stencil_writei = 0;
-	int stencil_write_depth_faili = 0;
-	int stencil_comparei = STENCIL_COMPARE_ALWAYS;
-	int stencil_referencei = -1;
-
-	ShaderCompiler::IdentifierActions actions;
+	ShaderCompiler::IdentifierActions &actions = r_state.actions;
 	actions.entry_point_stages["vertex"] = ShaderCompiler::STAGE_VERTEX;
 	actions.entry_point_stages["fragment"] = ShaderCompiler::STAGE_FRAGMENT;
 	actions.entry_point_stages["light"] = ShaderCompiler::STAGE_FRAGMENT;
@@ -105,16 +92,16 @@ void SceneShaderForwardClustered::ShaderData::set_code(const String &p_code) {
 	actions.render_mode_values["alpha_to_coverage"] = Pair<int *, int>(&alpha_antialiasing_mode, ALPHA_ANTIALIASING_ALPHA_TO_COVERAGE);
 	actions.render_mode_values["alpha_to_coverage_and_one"] = Pair<int *, int>(&alpha_antialiasing_mode, ALPHA_ANTIALIASING_ALPHA_TO_COVERAGE_AND_TO_ONE);
 
-	actions.render_mode_values["depth_draw_never"] = Pair<int *, int>(&depth_drawi, DEPTH_DRAW_DISABLED);
-	actions.render_mode_values["depth_draw_opaque"] = Pair<int *, int>(&depth_drawi, DEPTH_DRAW_OPAQUE);
-	actions.render_mode_values["depth_draw_always"] = Pair<int *, int>(&depth_drawi, DEPTH_DRAW_ALWAYS);
+	actions.render_mode_values["depth_draw_never"] = Pair<int *, int>(&r_state.depth_drawi, DEPTH_DRAW_DISABLED);
+	actions.render_mode_values["depth_draw_opaque"] = Pair<int *, int>(&r_state.depth_drawi, DEPTH_DRAW_OPAQUE);
+	actions.render_mode_values["depth_draw_always"] = Pair<int *, int>(&r_state.depth_drawi, DEPTH_DRAW_ALWAYS);
 
 	actions.render_mode_values["depth_test_disabled"] = Pair<int *, int>(&depth_test_disabledi, 1);
 	actions.render_mode_values["depth_test_inverted"] = Pair<int *, int>(&depth_test_invertedi, 1);
 
-	actions.render_mode_values["cull_disabled"] = Pair<int *, int>(&cull_modei, RSE::CULL_MODE_DISABLED);
-	actions.render_mode_values["cull_front"] = Pair<int *, int>(&cull_modei, RSE::CULL_MODE_FRONT);
-	actions.render_mode_values["cull_back"] = Pair<int *, int>(&cull_modei, RSE::CULL_MODE_BACK);
+	actions.render_mode_values["cull_disabled"] = Pair<int *, int>(&r_state.cull_modei, RSE::CULL_MODE_DISABLED);
+	actions.render_mode_values["cull_front"] = Pair<int *, int>(&r_state.cull_modei, RSE::CULL_MODE_FRONT);
+	actions.render_mode_values["cull_back"] = Pair<int *, int>(&r_state.cull_modei, RSE::CULL_MODE_BACK);
 
 	actions.render_mode_flags["unshaded"] = &unshaded;
 	actions.render_mode_flags["wireframe"] = &wireframe;
@@ -152,29 +139,29 @@ void SceneShaderForwardClustered::ShaderData::set_code(const String &p_code) {
 	actions.write_flag_pointers["POSITION"] = &uses_position;
 	actions.write_flag_pointers["Z_CLIP_SCALE"] = &uses_z_clip_scale;
 
-	actions.stencil_mode_values["read"] = Pair<int *, int>(&stencil_readi, STENCIL_FLAG_READ);
-	actions.stencil_mode_values["write"] = Pair<int *, int>(&stencil_writei, STENCIL_FLAG_WRITE);
-	actions.stencil_mode_values["write_depth_fail"] = Pair<int *, int>(&stencil_write_depth_faili, STENCIL_FLAG_WRITE_DEPTH_FAIL);
+	actions.stencil_mode_values["read"] = Pair<int *, int>(&r_state.stencil_readi, STENCIL_FLAG_READ);
+	actions.stencil_mode_values["write"] = Pair<int *, int>(&r_state.stencil_writei, STENCIL_FLAG_WRITE);
+	actions.stencil_mode_values["write_depth_fail"] = Pair<int *, int>(&r_state.stencil_write_depth_faili, STENCIL_FLAG_WRITE_DEPTH_FAIL);
 
-	actions.stencil_mode_values["compare_less"] = Pair<int *, int>(&stencil_comparei, STENCIL_COMPARE_LESS);
-	actions.stencil_mode_values["compare_equal"] = Pair<int *, int>(&stencil_comparei, STENCIL_COMPARE_EQUAL);
-	actions.stencil_mode_values["compare_less_or_equal"] = Pair<int *, int>(&stencil_comparei, STENCIL_COMPARE_LESS_OR_EQUAL);
-	actions.stencil_mode_values["compare_greater"] = Pair<int *, int>(&stencil_comparei, STENCIL_COMPARE_GREATER);
-	actions.stencil_mode_values["compare_not_equal"] = Pair<int *, int>(&stencil_comparei, STENCIL_COMPARE_NOT_EQUAL);
-	actions.stencil_mode_values["compare_greater_or_equal"] = Pair<int *, int>(&stencil_comparei, STENCIL_COMPARE_GREATER_OR_EQUAL);
-	actions.stencil_mode_values["compare_always"] = Pair<int *, int>(&stencil_comparei, STENCIL_COMPARE_ALWAYS);
+	actions.stencil_mode_values["compare_less"] = Pair<int *, int>(&r_state.stencil_comparei, STENCIL_COMPARE_LESS);
+	actions.stencil_mode_values["compare_equal"] = Pair<int *, int>(&r_state.stencil_comparei, STENCIL_COMPARE_EQUAL);
+	actions.stencil_mode_values["compare_less_or_equal"] = Pair<int *, int>(&r_state.stencil_comparei, STENCIL_COMPARE_LESS_OR_EQUAL);
+	actions.stencil_mode_values["compare_greater"] = Pair<int *, int>(&r_state.stencil_comparei, STENCIL_COMPARE_GREATER);
+	actions.stencil_mode_values["compare_not_equal"] = Pair<int *, int>(&r_state.stencil_comparei, STENCIL_COMPARE_NOT_EQUAL);
+	actions.stencil_mode_values["compare_greater_or_equal"] = Pair<int *, int>(&r_state.stencil_comparei, STENCIL_COMPARE_GREATER_OR_EQUAL);
+	actions.stencil_mode_values["compare_always"] = Pair<int *, int>(&r_state.stencil_comparei, STENCIL_COMPARE_ALWAYS);
 
-	actions.stencil_reference = &stencil_referencei;
+	actions.stencil_reference = &r_state.stencil_referencei;
 
 	actions.uniforms = &uniforms;
 
-	Error err = OK;
-	{
-		MutexLock lock(SceneShaderForwardClustered::singleton_mutex);
-		err = SceneShaderForwardClustered::singleton->compiler.compile(RSE::SHADER_SPATIAL, code, &actions, path, gen_code);
-	}
+	return true;
+}
+
+void SceneShaderForwardClustered::ShaderData::_compile_finish(const CompileState &p_state, Error p_error) {
+	const ShaderCompiler::GeneratedCode &gen_code = p_state.gen_code;
 
-	if (err != OK) {
+	if (p_error != OK) {
 		if (version.is_valid()) {
 			SceneShaderForwardClustered::singleton->shader.version_free(version);
 			version = RID();
@@ -186,7 +173,7 @@ void SceneShaderForwardClustered::ShaderData::set_code(const String &p_code) {
 		version = SceneShaderForwardClustered::singleton->shader.version_create(false);
 	}
 
-	depth_draw = DepthDraw(depth_drawi);
+	depth_draw = DepthDraw(p_state.depth_drawi);
 	if (depth_test_disabledi) {
 		depth_test = DEPTH_TEST_DISABLED;
 	} else if (depth_test_invertedi) {
@@ -194,7 +181,7 @@ void SceneShaderForwardClustered::ShaderData::set_code(const String &p_code) {
 	} else {
 		depth_test = DEPTH_TEST_ENABLED;
 	}
-	cull_mode = RSE::CullMode(cull_modei);
+	cull_mode = RSE::CullMode(p_state.cull_modei);
 	uses_screen_texture_mipmaps = gen_code.uses_screen_texture_mipmaps;
 	uses_screen_texture = gen_code.uses_screen_texture;
 	uses_depth_texture = gen_code.uses_depth_texture;
@@ -206,10 +193,10 @@ void SceneShaderForwardClustered::ShaderData::set_code(const String &p_code) {
 	uses_tangent |= uses_normal_map;
 	uses_tangent |= uses_bent_normal_map;
 
-	stencil_enabled = stencil_referencei != -1;
-	stencil_flags = stencil_readi | stencil_writei | stencil_write_depth_faili;
-	stencil_compare = StencilCompare(stencil_comparei);
-	stencil_reference = stencil_referencei;
+	stencil_enabled = p_state.stencil_referencei != -1;
+	stencil_flags = p_state.stencil_readi | p_state.stencil_writei | p_state.stencil_write_depth_faili;
+	stencil_compare = StencilCompare(p_state.stencil_comparei);
+	stencil_reference = p_state.stencil_referencei;
 
 #if 0
 	print_line("**compiling shader:");
@@ -244,6 +231,50 @@ void SceneShaderForwardClustered::ShaderData::set_code(const String &p_code) {
 	uses_blend_alpha = blend_mode_uses_blend_alpha(BlendMode(blend_mode));
 }
 
+void SceneShaderForwardClustered::ShaderData::set_code(const String &p_code) {
+	//compile
+
+	CompileState state;
+	if (!_compile_prepare(p_code, state)) {
+		return; //just invalid, but no error
+	}
+
+	Error err = OK;
+	{
+		MutexLock lock(SceneShaderForwardClustered::singleton_mutex);
+		err = SceneShaderForwardClustered::singleton->compiler.compile(RSE::SHADER_SPATIAL, code, &state.actions, path, state.gen_code);
+	}
+
+	_compile_finish(state, err);
+}
+
+bool SceneShaderForwardClustered::ShaderData::batch_compile_begin(const String &p_code, ShaderCompiler::BatchItem &r_item) {
+	ERR_FAIL_COND_V(batch_state, false);
+
+	// The actions point into the state, so it has to stay in place until the batch is done.
+	CompileState *state = memnew(CompileState);
+	if (!_compile_prepare(p_code, *state)) {
+		memdelete(state);
+		return false;
+	}
+
+	batch_state = state;
+	r_item.mode = RSE::SHADER_SPATIAL;
+	r_item.code = code;
+	r_item.path = path;
+	r_item.actions = &state->actions;
+	r_item.gen_code = &state->gen_code;
+	return true;
+}
+
+void SceneShaderForwardClustered::ShaderData::batch_compile_end(const ShaderCompiler::BatchItem &p_item) {
+	ERR_FAIL_NULL(batch_state);
+
+	_compile_finish(*batch_state, p_item.error);
+	memdelete(batch_state);
+	batch_state = nullptr;
+}
+
 bool SceneShaderForwardClustered::ShaderData::is_animated() const {
 	return (uses_fragment_time && uses_discard) || (uses_vertex_time && uses_vertex);
 }
@@ -567,6 +598,10 @@ SceneShaderForwardClustered::ShaderData::ShaderData() :
 SceneShaderForwardClustered::ShaderData::~ShaderData() {
 	pipeline_hash_map.clear_pipelines();
 
+	if (batch_state) {
+		memdelete(batch_state);
+	}
+
 	if (version.is_valid()) {
 		ERR_FAIL_NULL(SceneShaderForwardClustered::singleton);
 		SceneShaderForwardClustered::singleton->shader.version_free(version);
@@ -580,6 +615,11 @@ RendererRD::MaterialStorage::ShaderData *SceneShaderForwardClustered::_create_sh
 	return shader_data;
 }
 
+void SceneShaderForwardClustered::_compile_shader_batch_func(LocalVector<ShaderCompiler::BatchItem> &p_items) {
+	MutexLock lock(SceneShaderForwardClustered::singleton_mutex);
+	singleton->compiler.compile_batch(p_items);
+}
+
 void SceneShaderForwardClustered::MaterialData::set_render_priority(int p_priority) {
 	priority = p_priority - RSE::MATERIAL_RENDER_PRIORITY_MIN; //8 bits
 }
@@ -694,6 +734,7 @@ void SceneShaderForwardClustered::init(const String p_defines) {
 	}
 
 	material_storage->shader_set_data_request_function(RendererRD::MaterialStorage::SHADER_TYPE_3D, _create_shader_funcs);
+	material_storage->shader_set_batch_compile_function(RendererRD::MaterialStorage::SHADER_TYPE_3D, _compile_shader_batch_func);
 	material_storage->material_set_data_request_function(RendererRD::MaterialStorage::SHADER_TYPE_3D, _create_material_funcs);
 
 	{
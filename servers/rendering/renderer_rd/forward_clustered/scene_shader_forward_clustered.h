@@ -297,7 +297,28 @@ public:
 			return !uses_particle_trails && !writes_modelview_or_projection && !uses_vertex && !uses_position && !uses_discard && !uses_depth_prepass_alpha && !uses_alpha_clip && !uses_alpha_antialiasing && backface_culling && !uses_point_size && !uses_world_coordinates && !wireframe && !uses_z_clip_scale && !stencil_enabled;
 		}
 
+		// What the compiler writes to through its actions, besides the members of this class.
+		struct CompileState {
+			ShaderCompiler::IdentifierActions actions;
+			ShaderCompiler::GeneratedCode gen_code;
+			int cull_modei = RSE::CULL_MODE_BACK;
+			int depth_drawi = DEPTH_DRAW_OPAQUE;
+			int stencil_readi = 0;
+			int stencil_writei = 0;
+			int stencil_write_depth_faili = 0;
+			int stencil_comparei = STENCIL_COMPARE_ALWAYS;
+			int stencil_referencei = -1;
+		};
+
+		// Only set between batch_compile_begin() and batch_compile_end().
+		CompileState *batch_state = nullptr;
+
+		bool _compile_prepare(const String &p_code, CompileState &r_state);
+		void _compile_finish(const CompileState &p_state, Error p_error);
+
 		virtual void set_code(const String &p_Code);
+		virtual bool batch_compile_begin(const String &p_code, ShaderCompiler::BatchItem &r_item);
+		virtual void batch_compile_end(const ShaderCompiler::BatchItem &p_item);
 
 		virtual bool is_animated() const;
 		virtual bool casts_shadows() const;
@@ -322,6 +343,7 @@ public:
 	static RendererRD::MaterialStorage::ShaderData *_create_shader_funcs() {
 		return static_cast<SceneShaderForwardClustered *>(singleton)->_create_shader_func();
 	}
+	static void _compile_shader_batch_func(LocalVector<ShaderCompiler::BatchItem> &p_items);
 
 	struct MaterialData : public RendererRD::MaterialStorage::MaterialData {
 		ShaderData *shader_data = nullptr;
@@ -37,6 +37,7 @@
 #include "servers/display/display_server.h"
 #include "servers/rendering/renderer_rd/forward_clustered/render_forward_clustered.h"
 #include "servers/rendering/renderer_rd/forward_mobile/render_forward_mobile.h"
+#include "servers/rendering/shader_compiler.h"
 #include "servers/rendering/rendering_server_types.h"
 
 void RendererCompositorRD::blit_render_targets_to_screen(DisplayServerEnums::WindowID p_screen, const RenderingServerTypes::BlitToScreen *p_render_targets, int p_amount) {
@@ -346,6 +347,7 @@ RendererCompositorRD::RendererCompositorRD() {
 			} else {
 				shader_cache_user_dir = shader_cache_user_dir.path_join("shader_cache");
 				ShaderRD::set_shader_cache_user_dir(shader_cache_user_dir);
+				ShaderCompiler::set_cache_dir(shader_cache_user_dir.path_join("shader_compiler"));
 			}
 		}
 
@@ -395,4 +397,5 @@ RendererCompositorRD::~RendererCompositorRD() {
 	memdelete(framebuffer_cache);
 	ShaderRD::set_shader_cache_user_dir(String());
 	ShaderRD::set_shader_cache_res_dir(String());
+	ShaderCompiler::set_cache_dir(String());
 }
@@ -1494,6 +1494,7 @@ MaterialStorage::MaterialStorage() {
 	// Shaders
 	for (int i = 0; i < SHADER_TYPE_MAX; i++) {
 		shader_data_request_func[i] = nullptr;
+		shader_batch_compile_func[i] = nullptr;
 	}
 
 	static_assert(sizeof(GlobalShaderUniforms::Value) == 16);
@@ -2198,11 +2199,8 @@ void MaterialStorage::shader_free(RID p_rid) {
 	shader_owner.free(p_rid);
 }
 
-void MaterialStorage::shader_set_code(RID p_shader, const String &p_code) {
-	Shader *shader = shader_owner.get_or_null(p_shader);
-	ERR_FAIL_NULL(shader);
-
-	shader->code = p_code;
+void MaterialStorage::_shader_update_type(Shader *p_shader, const String &p_code) {
+	p_shader->code = p_code;
 	String mode_string = ShaderLanguage::get_shader_type(p_code);
 
 	ShaderType new_type;
@@ -2222,13 +2220,13 @@ void MaterialStorage::shader_set_code(RID p_shader, const String &p_code) {
 		new_type = SHADER_TYPE_MAX;
 	}
 
-	if (new_type != shader->type) {
-		if (shader->data) {
-			memdelete(shader->data);
-			shader->data = nullptr;
+	if (new_type != p_shader->type) {
+		if (p_shader->data) {
+			memdelete(p_shader->data);
+			p_shader->data = nullptr;
 		}
 
-		for (Material *E : shader->owners) {
+		for (Material *E : p_shader->owners) {
 			Material *material = E;
 			material->shader_type = new_type;
 			if (material->data) {
@@ -2237,18 +2235,18 @@ void MaterialStorage::shader_set_code(RID p_shader, const String &p_code) {
 			}
 		}
 
-		shader->type = new_type;
+		p_shader->type = new_type;
 
 		if (new_type < SHADER_TYPE_MAX && shader_data_request_func[new_type]) {
-			shader->data = shader_data_request_func[new_type]();
+			p_shader->data = shader_data_request_func[new_type]();
 		} else {
-			shader->type = SHADER_TYPE_MAX; //invalid
+			p_shader->type = SHADER_TYPE_MAX; //invalid
 		}
 
-		for (Material *E : shader->owners) {
+		for (Material *E : p_shader->owners) {
 			Material *material = E;
-			if (shader->data) {
-				material->data = material_get_data_request_function(new_type)(shader->data);
+			if (p_shader->data) {
+				material->data = material_get_data_request_function(new_type)(p_shader->data);
 				material->data->self = material->self;
 				material->data->set_next_pass(material->next_pass);
 				material->data->set_render_priority(material->priority);
@@ -2256,27 +2254,79 @@ void MaterialStorage::shader_set_code(RID p_shader, const String &p_code) {
 			material->shader_type = new_type;
 		}
 
-		if (shader->data) {
-			for (const KeyValue<StringName, HashMap<int, RID>> &E : shader->default_texture_parameter) {
+		if (p_shader->data) {
+			for (const KeyValue<StringName, HashMap<int, RID>> &E : p_shader->default_texture_parameter) {
 				for (const KeyValue<int, RID> &E2 : E.value) {
-					shader->data->set_default_texture_parameter(E.key, E2.value, E2.key);
+					p_shader->data->set_default_texture_parameter(E.key, E2.value, E2.key);
 				}
 			}
 		}
 	}
 
-	if (shader->data) {
-		shader->data->set_path_hint(shader->path_hint);
-		shader->data->set_code(p_code);
+	if (p_shader->data) {
+		p_shader->data->set_path_hint(p_shader->path_hint);
 	}
+}
 
-	for (Material *E : shader->owners) {
+void MaterialStorage::_shader_notify_owners(Shader *p_shader) {
+	for (Material *E : p_shader->owners) {
 		Material *material = E;
 		material->dependency.changed_notify(Dependency::DEPENDENCY_CHANGED_MATERIAL);
 		_material_queue_update(material, true, true);
 	}
 }
 
+void MaterialStorage::shader_set_code(RID p_shader, const String &p_code) {
+	Shader *shader = shader_owner.get_or_null(p_shader);
+	ERR_FAIL_NULL(shader);
+
+	_shader_update_type(shader, p_code);
+	if (shader->data) {
+		shader->data->set_code(p_code);
+	}
+	_shader_notify_owners(shader);
+}
+
+void MaterialStorage::shaders_set_code(const Vector<RID> &p_shaders, const Vector<String> &p_codes) {
+	ERR_FAIL_COND(p_shaders.size() != p_codes.size());
+
+	// Shaders of the types that support it are compiled together on worker threads, the others one at a time.
+	LocalVector<Shader *> batch_shaders[SHADER_TYPE_MAX];
+	LocalVector<ShaderCompiler::BatchItem> batch_items[SHADER_TYPE_MAX];
+	HashSet<Shader *> added;
+
+	for (int i = 0; i < p_shaders.size(); i++) {
+		Shader *shader = shader_owner.get_or_null(p_shaders[i]);
+		ERR_CONTINUE(!shader);
+		ERR_CONTINUE_MSG(added.has(shader), "A shader can only be set once per batch.");
+		added.insert(shader);
+
+		_shader_update_type(shader, p_codes[i]);
+		if (shader->data) {
+			ShaderCompiler::BatchItem item;
+			if (shader_batch_compile_func[shader->type] && shader->data->batch_compile_begin(p_codes[i], item)) {
+				batch_shaders[shader->type].push_back(shader);
+				batch_items[shader->type].push_back(item);
+				continue;
+			}
+			shader->data->set_code(p_codes[i]);
+		}
+		_shader_notify_owners(shader);
+	}
+
+	for (int i = 0; i < SHADER_TYPE_MAX; i++) {
+		if (batch_items[i].is_empty()) {
+			continue;
+		}
+
+		shader_batch_compile_func[i](batch_items[i]);
+		for (uint32_t j = 0; j < batch_items[i].size(); j++) {
+			batch_shaders[i][j]->data->batch_compile_end(batch_items[i][j]);
+			_shader_notify_owners(batch_shaders[i][j]);
+		}
+	}
+}
+
 void MaterialStorage::shader_set_path_hint(RID p_shader, const String &p_path) {
 	Shader *shader = shader_owner.get_or_null(p_shader);
 	ERR_FAIL_NULL(shader);
@@ -2352,6 +2402,11 @@ void MaterialStorage::shader_set_data_request_function(ShaderType p_shader_type,
 	shader_data_request_func[p_shader_type] = p_function;
 }
 
+void MaterialStorage::shader_set_batch_compile_function(ShaderType p_shader_type, ShaderBatchCompileFunction p_function) {
+	ERR_FAIL_INDEX(p_shader_type, SHADER_TYPE_MAX);
+	shader_batch_compile_func[p_shader_type] = p_function;
+}
+
 MaterialStorage::ShaderData *MaterialStorage::shader_get_data(RID p_shader) const {
 	Shader *shader = shader_owner.get_or_null(p_shader);
 	ERR_FAIL_NULL_V(shader, nullptr);
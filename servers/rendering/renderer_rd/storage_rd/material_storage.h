@@ -84,6 +84,11 @@ public:
 		virtual RenderingServerTypes::ShaderNativeSourceCode get_native_source_code() const = 0;
 		virtual Pair<ShaderRD *, RID> get_native_shader_and_version() const = 0;
 
+		// Used by shaders_set_code() to compile several shaders of a type together. Returns false if this shader must be
+		// compiled by set_code() instead. Otherwise r_item is compiled, then passed back to batch_compile_end().
+		virtual bool batch_compile_begin(const String &p_code, ShaderCompiler::BatchItem &r_item) { return false; }
+		virtual void batch_compile_end(const ShaderCompiler::BatchItem &p_item) {}
+
 		virtual ~ShaderData() {}
 
 		static RD::PipelineColorBlendState::Attachment blend_mode_to_blend_attachment(BlendMode p_mode);
@@ -276,6 +281,11 @@ private:
 
 	typedef ShaderData *(*ShaderDataRequestFunction)();
 	ShaderDataRequestFunction shader_data_request_func[SHADER_TYPE_MAX];
+	typedef void (*ShaderBatchCompileFunction)(LocalVector<ShaderCompiler::BatchItem> &p_items);
+	ShaderBatchCompileFunction shader_batch_compile_func[SHADER_TYPE_MAX];
+
+	void _shader_update_type(Shader *p_shader, const String &p_code);
+	void _shader_notify_owners(Shader *p_shader);
 
 	mutable RID_Owner<Shader, true> shader_owner;
 	HashSet<RID> embedded_set;
@@ -464,6 +474,7 @@ public:
 	virtual void shader_free(RID p_rid) override;
 
 	virtual void shader_set_code(RID p_shader, const String &p_code) override;
+	virtual void shaders_set_code(const Vector<RID> &p_shaders, const Vector<String> &p_codes) override;
 	virtual void shader_set_path_hint(RID p_shader, const String &p_path) override;
 	virtual String shader_get_code(RID p_shader) const override;
 	virtual void get_shader_parameter_list(RID p_shader, List<PropertyInfo> *p_param_list) const override;
@@ -472,6 +483,7 @@ public:
 	virtual RID shader_get_default_texture_parameter(RID p_shader, const StringName &p_name, int p_index) const override;
 	virtual Variant shader_get_parameter_default(RID p_shader, const StringName &p_param) const override;
 	void shader_set_data_request_function(ShaderType p_shader_type, ShaderDataRequestFunction p_function);
+	void shader_set_batch_compile_function(ShaderType p_shader_type, ShaderBatchCompileFunction p_function);
 	ShaderData *shader_get_data(RID p_shader) const;
 
 	virtual RenderingServerTypes::ShaderNativeSourceCode shader_get_native_source_code(RID p_shader) const override;
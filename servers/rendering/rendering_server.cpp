@@ -107,6 +107,23 @@ PackedInt64Array RenderingServer::_instances_cull_convex_bind(const TypedArray<P
 	return to_int_array(ids);
 }
 
+void RenderingServer::_instances_set_transform_bind(const TypedArray<RID> &p_instances, const TypedArray<Transform3D> &p_transforms) {
+	ERR_FAIL_COND_MSG(p_instances.size() != p_transforms.size(), "The instances and transforms arrays must have the same size.");
+
+	Vector<RID> instances;
+	Vector<Transform3D> transforms;
+	instances.resize(p_instances.size());
+	transforms.resize(p_transforms.size());
+	RID *instances_ptrw = instances.ptrw();
+	Transform3D *transforms_ptrw = transforms.ptrw();
+	for (int i = 0; i < p_instances.size(); ++i) {
+		instances_ptrw[i] = p_instances[i];
+		transforms_ptrw[i] = p_transforms[i];
+	}
+
+	instances_set_transform(instances, transforms);
+}
+
 RID RenderingServer::get_test_texture() {
 	if (test_texture.is_valid()) {
 		return test_texture;
@@ -3247,6 +3264,7 @@ void RenderingServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("instances_cull_aabb", "aabb", "scenario"), &RenderingServer::_instances_cull_aabb_bind, DEFVAL(RID()));
 	ClassDB::bind_method(D_METHOD("instances_cull_ray", "from", "to", "scenario"), &RenderingServer::_instances_cull_ray_bind, DEFVAL(RID()));
 	ClassDB::bind_method(D_METHOD("instances_cull_convex", "convex", "scenario"), &RenderingServer::_instances_cull_convex_bind, DEFVAL(RID()));
+	ClassDB::bind_method(D_METHOD("instances_set_transform", "instances", "transforms"), &RenderingServer::_instances_set_transform_bind);
 
 	BIND_ENUM_CONSTANT(RSE::INSTANCE_NONE);
 	BIND_ENUM_CONSTANT(RSE::INSTANCE_MESH);
@@ -3551,6 +3569,8 @@ void RenderingServer::_bind_methods() {
 	BIND_ENUM_CONSTANT(RSE::RENDERING_INFO_PIPELINE_COMPILATIONS_SURFACE);
 	BIND_ENUM_CONSTANT(RSE::RENDERING_INFO_PIPELINE_COMPILATIONS_DRAW);
 	BIND_ENUM_CONSTANT(RSE::RENDERING_INFO_PIPELINE_COMPILATIONS_SPECIALIZATION);
+	BIND_ENUM_CONSTANT(RSE::RENDERING_INFO_CANVAS_ITEMS_REUSED_IN_FRAME);
+	BIND_ENUM_CONSTANT(RSE::RENDERING_INFO_CANVAS_ITEMS_REBUILT_IN_FRAME);
 
 	BIND_ENUM_CONSTANT(RSE::PIPELINE_SOURCE_CANVAS);
 	BIND_ENUM_CONSTANT(RSE::PIPELINE_SOURCE_MESH);
@@ -306,6 +306,7 @@ public:
 	}
 
 	FUNC2(shader_set_code, RID, const String &)
+	FUNC2(shaders_set_code, const Vector<RID> &, const Vector<String> &)
 	FUNC2(shader_set_path_hint, RID, const String &)
 	FUNC1RC(String, shader_get_code, RID)
 
@@ -955,6 +956,9 @@ public:
 
 	FUNC2(instance_set_ignore_culling, RID, bool)
 
+	// Both vectors are copy-on-write, so the whole batch is queued as a single command without copying the data.
+	FUNC2(instances_set_transform, const Vector<RID> &, const Vector<Transform3D> &)
+
 	// don't use these in a game!
 	FUNC2RC(Vector<ObjectID>, instances_cull_aabb, const AABB &, RID)
 	FUNC3RC(Vector<ObjectID>, instances_cull_ray, const Vector3 &, const Vector3 &, RID)
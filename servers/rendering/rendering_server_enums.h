@@ -913,6 +913,8 @@ enum RenderingInfo {
 	RENDERING_INFO_PIPELINE_COMPILATIONS_SURFACE,
 	RENDERING_INFO_PIPELINE_COMPILATIONS_DRAW,
 	RENDERING_INFO_PIPELINE_COMPILATIONS_SPECIALIZATION,
+	RENDERING_INFO_CANVAS_ITEMS_REUSED_IN_FRAME,
+	RENDERING_INFO_CANVAS_ITEMS_REBUILT_IN_FRAME,
 	RENDERING_INFO_MAX,
 };
 
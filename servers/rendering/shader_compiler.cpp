@@ -30,6 +30,13 @@
 
 #include "shader_compiler.h"
 
+#include "core/config/engine.h"
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/os/thread.h"
+#include "core/string/string_builder.h"
+#include "core/version.h"
 #include "servers/rendering/rendering_server.h"
 #include "servers/rendering/rendering_server_globals.h"
 #include "servers/rendering/shader_types.h"
@@ -447,7 +454,7 @@ static String _get_global_shader_uniform_from_type_and_index(const String &p_buf
 	}
 }
 
-String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, GeneratedCode &r_gen_code, IdentifierActions &p_actions, const DefaultIdentifierActions &p_default_actions, bool p_assigning, bool p_use_scope) {
+String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, GeneratedCode &r_gen_code, const IdentifierActions &p_actions, const DefaultIdentifierActions &p_default_actions, bool p_assigning, bool p_use_scope) {
 	String code;
 
 	switch (p_node->type) {
@@ -461,31 +468,11 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 					r_gen_code.defines.push_back(p_default_actions.render_mode_defines[pnode->render_modes[i]]);
 					used_rmode_defines.insert(pnode->render_modes[i]);
 				}
-
-				if (p_actions.render_mode_flags.has(pnode->render_modes[i])) {
-					*p_actions.render_mode_flags[pnode->render_modes[i]] = true;
-				}
-
-				if (p_actions.render_mode_values.has(pnode->render_modes[i])) {
-					Pair<int *, int> &p = p_actions.render_mode_values[pnode->render_modes[i]];
-					*p.first = p.second;
-				}
 			}
 
-			// Stencil modes.
+			// Render mode flags and values, stencil modes and stencil reference value.
 
-			for (int i = 0; i < pnode->stencil_modes.size(); i++) {
-				if (p_actions.stencil_mode_values.has(pnode->stencil_modes[i])) {
-					Pair<int *, int> &p = p_actions.stencil_mode_values[pnode->stencil_modes[i]];
-					*p.first = p.second;
-				}
-			}
-
-			// Stencil reference value.
-
-			if (p_actions.stencil_reference && pnode->stencil_reference != -1) {
-				*p_actions.stencil_reference = pnode->stencil_reference;
-			}
+			_apply_render_modes(pnode->render_modes, pnode->stencil_modes, pnode->stencil_reference, p_actions);
 
 			// structs
 
@@ -1523,7 +1510,7 @@ ShaderLanguage::DataType ShaderCompiler::_get_global_shader_uniform_type(const S
 	return (ShaderLanguage::DataType)RS::global_shader_uniform_type_get_shader_datatype(gvt);
 }
 
-Error ShaderCompiler::compile(RSE::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code) {
+Error ShaderCompiler::compile(RSE::ShaderMode p_mode, const String &p_code, const IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code) {
 	SL::ShaderCompileInfo info;
 	info.functions = ShaderTypes::get_singleton()->get_functions(p_mode);
 	info.render_modes = ShaderTypes::get_singleton()->get_modes(p_mode);
@@ -1532,6 +1519,19 @@ Error ShaderCompiler::compile(RSE::ShaderMode p_mode, const String &p_code, Iden
 	info.global_shader_uniform_type_func = _get_global_shader_uniform_type;
 	info.base_varying_index = actions.base_varying_index;
 
+	String cache_key;
+	if (!cache_dir.is_empty()) {
+		cache_key = _get_cache_key(p_mode, p_code);
+
+		CacheEntry entry;
+		if (_load_from_cache(cache_key, entry)) {
+			cache_hits.increment();
+			_apply_cache_entry(entry, *p_actions, r_gen_code);
+			return OK;
+		}
+		cache_misses.increment();
+	}
+
 	Error err = parser.compile(p_code, info);
 
 	if (err != OK) {
@@ -1634,15 +1634,465 @@ Error ShaderCompiler::compile(RSE::ShaderMode p_mode, const String &p_code, Iden
 
 	shader = parser.get_shader();
 	function = nullptr;
-	// Return value only relevant within nested calls.
-	_ALLOW_DISCARD_ _dump_node_code(shader, 1, r_gen_code, *p_actions, actions, false);
+
+	if (cache_key.is_empty()) {
+		// Return value only relevant within nested calls.
+		_ALLOW_DISCARD_ _dump_node_code(shader, 1, r_gen_code, *p_actions, actions, false);
+		return OK;
+	}
+
+	// Redirect every side effect on the caller's actions to local storage, so that it can be
+	// recorded in the cache entry. The entry is then applied the same way as on a cache hit.
+	IdentifierActions recording_actions = *p_actions;
+	int render_mode_sink = 0;
+	for (KeyValue<StringName, Pair<int *, int>> &E : recording_actions.render_mode_values) {
+		E.value.first = &render_mode_sink;
+	}
+	for (KeyValue<StringName, Pair<int *, int>> &E : recording_actions.stencil_mode_values) {
+		E.value.first = &render_mode_sink;
+	}
+	if (recording_actions.stencil_reference) {
+		recording_actions.stencil_reference = &render_mode_sink;
+	}
+	HashMap<StringName, bool> render_mode_flags;
+	for (KeyValue<StringName, bool *> &E : recording_actions.render_mode_flags) {
+		E.value = &render_mode_flags.insert(E.key, false)->value;
+	}
+	HashMap<StringName, bool> usage_flags;
+	for (KeyValue<StringName, bool *> &E : recording_actions.usage_flag_pointers) {
+		E.value = &usage_flags.insert(E.key, false)->value;
+	}
+	HashMap<StringName, bool> write_flags;
+	for (KeyValue<StringName, bool *> &E : recording_actions.write_flag_pointers) {
+		E.value = &write_flags.insert(E.key, false)->value;
+	}
+	HashMap<StringName, SL::ShaderNode::Uniform> uniforms;
+	if (recording_actions.uniforms) {
+		recording_actions.uniforms = &uniforms;
+	}
+
+	CacheEntry entry;
+	_ALLOW_DISCARD_ _dump_node_code(shader, 1, entry.gen_code, recording_actions, actions, false);
+
+	entry.render_modes = shader->render_modes;
+	entry.stencil_modes = shader->stencil_modes;
+	entry.stencil_reference = shader->stencil_reference;
+	for (const KeyValue<StringName, bool> &E : usage_flags) {
+		if (E.value) {
+			entry.usage_flags.push_back(E.key);
+		}
+	}
+	for (const KeyValue<StringName, bool> &E : write_flags) {
+		if (E.value) {
+			entry.write_flags.push_back(E.key);
+		}
+	}
+	for (const KeyValue<StringName, SL::ShaderNode::Uniform> &E : uniforms) {
+		entry.uniforms.push_back(Pair<StringName, SL::ShaderNode::Uniform>(E.key, E.value));
+	}
+
+	_save_to_cache(cache_key, entry);
+	_apply_cache_entry(entry, *p_actions, r_gen_code);
 
 	return OK;
 }
 
+void ShaderCompiler::_compile_batch_thread(uint32_t p_thread, BatchData *p_data) {
+	ShaderCompiler *compiler = p_data->compilers[p_thread];
+	LocalVector<BatchItem> &items = *p_data->items;
+
+	// Items are handed out one at a time, as their compile times vary a lot.
+	uint32_t index = p_data->next_item.postincrement();
+	while (index < items.size()) {
+		BatchItem &item = items[index];
+		item.error = compiler->compile(item.mode, item.code, item.actions, item.path, *item.gen_code);
+		index = p_data->next_item.postincrement();
+	}
+}
+
+void ShaderCompiler::compile_batch(LocalVector<BatchItem> &p_items) {
+	HashSet<const void *> targets;
+	for (const BatchItem &item : p_items) {
+		ERR_FAIL_NULL(item.actions);
+		ERR_FAIL_NULL(item.gen_code);
+		// Items are compiled concurrently, so they may not write to the same place.
+		ERR_FAIL_COND_MSG(targets.has(item.actions) || targets.has(item.gen_code), "Shader batch items must not share actions or generated code.");
+		targets.insert(item.actions);
+		targets.insert(item.gen_code);
+		if (item.actions->uniforms) {
+			ERR_FAIL_COND_MSG(targets.has(item.actions->uniforms), "Shader batch items must not share uniform maps.");
+			targets.insert(item.actions->uniforms);
+		}
+	}
+
+	uint32_t thread_count = MIN(p_items.size(), (uint32_t)WorkerThreadPool::get_singleton()->get_thread_count());
+	if (thread_count <= 1) {
+		for (BatchItem &item : p_items) {
+			item.error = compile(item.mode, item.code, item.actions, item.path, *item.gen_code);
+		}
+		return;
+	}
+
+	BatchData data;
+	data.items = &p_items;
+	data.compilers.resize(thread_count);
+	data.compilers[0] = this;
+	for (uint32_t i = 1; i < thread_count; i++) {
+		data.compilers[i] = memnew(ShaderCompiler);
+		data.compilers[i]->initialize(actions);
+	}
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &ShaderCompiler::_compile_batch_thread, &data, thread_count, -1, true, SNAME("ShaderCompilerBatch"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	for (uint32_t i = 1; i < thread_count; i++) {
+		memdelete(data.compilers[i]);
+	}
+}
+
+void ShaderCompiler::_apply_render_modes(const Vector<StringName> &p_render_modes, const Vector<StringName> &p_stencil_modes, int p_stencil_reference, const IdentifierActions &p_actions) {
+	for (const StringName &mode : p_render_modes) {
+		if (p_actions.render_mode_flags.has(mode)) {
+			*p_actions.render_mode_flags[mode] = true;
+		}
+
+		if (p_actions.render_mode_values.has(mode)) {
+			const Pair<int *, int> &p = p_actions.render_mode_values[mode];
+			*p.first = p.second;
+		}
+	}
+
+	for (const StringName &mode : p_stencil_modes) {
+		if (p_actions.stencil_mode_values.has(mode)) {
+			const Pair<int *, int> &p = p_actions.stencil_mode_values[mode];
+			*p.first = p.second;
+		}
+	}
+
+	if (p_actions.stencil_reference && p_stencil_reference != -1) {
+		*p_actions.stencil_reference = p_stencil_reference;
+	}
+}
+
+void ShaderCompiler::_apply_cache_entry(const CacheEntry &p_entry, const IdentifierActions &p_actions, GeneratedCode &r_gen_code) {
+	_apply_render_modes(p_entry.render_modes, p_entry.stencil_modes, p_entry.stencil_reference, p_actions);
+
+	for (const StringName &name : p_entry.usage_flags) {
+		if (p_actions.usage_flag_pointers.has(name)) {
+			*p_actions.usage_flag_pointers[name] = true;
+		}
+	}
+	for (const StringName &name : p_entry.write_flags) {
+		if (p_actions.write_flag_pointers.has(name)) {
+			*p_actions.write_flag_pointers[name] = true;
+		}
+	}
+	if (p_actions.uniforms) {
+		for (const Pair<StringName, SL::ShaderNode::Uniform> &E : p_entry.uniforms) {
+			p_actions.uniforms->insert(E.first, E.second);
+		}
+	}
+
+	r_gen_code = p_entry.gen_code;
+}
+
+/* SHADER CACHE */
+
+String ShaderCompiler::cache_dir;
+SafeNumeric<uint64_t> ShaderCompiler::cache_hits;
+SafeNumeric<uint64_t> ShaderCompiler::cache_misses;
+
+static const char *shader_cache_file_header = "GDSL";
+static const uint32_t shader_cache_file_version = 1;
+
+String ShaderCompiler::_get_cache_key(RSE::ShaderMode p_mode, const String &p_code) const {
+	StringBuilder hash_build;
+
+	hash_build.append("[version]");
+	hash_build.append(GODOT_VERSION_FULL_BUILD);
+	hash_build.append(GODOT_VERSION_HASH);
+	hash_build.append(itos(shader_cache_file_version));
+	hash_build.append("[mode]");
+	hash_build.append(itos(p_mode));
+	hash_build.append("[actions]");
+	hash_build.append(actions_hash);
+	hash_build.append("[code]");
+	hash_build.append(p_code);
+
+	return hash_build.as_string().sha1_text();
+}
+
+static void _store_string_names(Ref<FileAccess> &p_file, const Vector<StringName> &p_names) {
+	p_file->store_32(p_names.size());
+	for (const StringName &name : p_names) {
+		p_file->store_pascal_string(name);
+	}
+}
+
+static Vector<StringName> _get_string_names(Ref<FileAccess> &p_file) {
+	Vector<StringName> names;
+	uint32_t count = p_file->get_32();
+	for (uint32_t i = 0; i < count && !p_file->eof_reached(); i++) {
+		names.push_back(p_file->get_pascal_string());
+	}
+	return names;
+}
+
+static void _store_strings(Ref<FileAccess> &p_file, const Vector<String> &p_strings) {
+	p_file->store_32(p_strings.size());
+	for (const String &string : p_strings) {
+		p_file->store_pascal_string(string);
+	}
+}
+
+static Vector<String> _get_strings(Ref<FileAccess> &p_file) {
+	Vector<String> strings;
+	uint32_t count = p_file->get_32();
+	for (uint32_t i = 0; i < count && !p_file->eof_reached(); i++) {
+		strings.push_back(p_file->get_pascal_string());
+	}
+	return strings;
+}
+
+bool ShaderCompiler::_load_from_cache(const String &p_key, CacheEntry &r_entry) {
+	Ref<FileAccess> f = FileAccess::open(cache_dir.path_join(p_key + ".cache"), FileAccess::READ);
+	if (f.is_null()) {
+		print_verbose(vformat("Shader compiler cache miss for %s", p_key));
+		return false;
+	}
+
+	char header[5] = { 0, 0, 0, 0, 0 };
+	f->get_buffer((uint8_t *)header, 4);
+	if (header != String(shader_cache_file_header) || f->get_32() != shader_cache_file_version) {
+		return false;
+	}
+
+	GeneratedCode &gen_code = r_entry.gen_code;
+	gen_code.defines = _get_strings(f);
+
+	uint32_t texture_count = f->get_32();
+	for (uint32_t i = 0; i < texture_count && !f->eof_reached(); i++) {
+		GeneratedCode::Texture texture;
+		texture.name = f->get_pascal_string();
+		texture.type = SL::DataType(f->get_32());
+		texture.hint = SL::ShaderNode::Uniform::Hint(f->get_32());
+		texture.use_color = f->get_8();
+		texture.filter = SL::TextureFilter(f->get_32());
+		texture.repeat = SL::TextureRepeat(f->get_32());
+		texture.global = f->get_8();
+		texture.array_size = f->get_32();
+		gen_code.texture_uniforms.push_back(texture);
+	}
+
+	uint32_t offset_count = f->get_32();
+	for (uint32_t i = 0; i < offset_count && !f->eof_reached(); i++) {
+		gen_code.uniform_offsets.push_back(f->get_32());
+	}
+	gen_code.uniform_total_size = f->get_32();
+	gen_code.uniforms = f->get_pascal_string();
+	for (int i = 0; i < STAGE_MAX; i++) {
+		gen_code.stage_globals[i] = f->get_pascal_string();
+	}
+
+	uint32_t code_count = f->get_32();
+	for (uint32_t i = 0; i < code_count && !f->eof_reached(); i++) {
+		String name = f->get_pascal_string();
+		gen_code.code[name] = f->get_pascal_string();
+	}
+
+	gen_code.uses_global_textures = f->get_8();
+	gen_code.uses_fragment_time = f->get_8();
+	gen_code.uses_vertex_time = f->get_8();
+	gen_code.uses_screen_texture_mipmaps = f->get_8();
+	gen_code.uses_screen_texture = f->get_8();
+	gen_code.uses_depth_texture = f->get_8();
+	gen_code.uses_normal_roughness_texture = f->get_8();
+
+	r_entry.render_modes = _get_string_names(f);
+	r_entry.stencil_modes = _get_string_names(f);
+	r_entry.stencil_reference = int32_t(f->get_32());
+	r_entry.usage_flags = _get_string_names(f);
+	r_entry.write_flags = _get_string_names(f);
+
+	uint32_t uniform_count = f->get_32();
+	for (uint32_t i = 0; i < uniform_count && !f->eof_reached(); i++) {
+		StringName name = f->get_pascal_string();
+		SL::ShaderNode::Uniform uniform;
+		uniform.order = int32_t(f->get_32());
+		uniform.prop_order = int32_t(f->get_32());
+		uniform.texture_order = int32_t(f->get_32());
+		uniform.texture_binding = int32_t(f->get_32());
+		uniform.type = SL::DataType(f->get_32());
+		uniform.precision = SL::DataPrecision(f->get_32());
+		uniform.array_size = int32_t(f->get_32());
+		uint32_t value_count = f->get_32();
+		for (uint32_t j = 0; j < value_count && !f->eof_reached(); j++) {
+			SL::Scalar value;
+			value.uint = f->get_32();
+			uniform.default_value.push_back(value);
+		}
+		uniform.scope = SL::ShaderNode::Uniform::Scope(f->get_32());
+		uniform.hint = SL::ShaderNode::Uniform::Hint(f->get_32());
+		uniform.use_color = f->get_8();
+		uniform.filter = SL::TextureFilter(f->get_32());
+		uniform.repeat = SL::TextureRepeat(f->get_32());
+		for (int j = 0; j < 3; j++) {
+			uniform.hint_range[j] = f->get_float();
+		}
+		uniform.hint_enum_names = _get_strings(f);
+		uniform.instance_index = int32_t(f->get_32());
+		uniform.group = f->get_pascal_string();
+
+		// Global uniforms are type checked against the project at parse time in the editor, so the cached result is stale if their type changed since.
+		// Like ShaderLanguage, only check in the editor, the global uniform types aren't available at runtime.
+		if (uniform.scope == SL::ShaderNode::Uniform::SCOPE_GLOBAL && Engine::get_singleton()->is_editor_hint() && _get_global_shader_uniform_type(name) != uniform.type) {
+			return false;
+		}
+		r_entry.uniforms.push_back(Pair<StringName, SL::ShaderNode::Uniform>(name, uniform));
+	}
+
+	// Reading past the end means the file was truncated.
+	return !f->eof_reached();
+}
+
+void ShaderCompiler::_save_to_cache(const String &p_key, const CacheEntry &p_entry) {
+	// Written to a file of its own first, as batches may compile the same source on several threads at once.
+	const String path = cache_dir.path_join(p_key + ".cache");
+	const String temp_path = path + "." + itos(Thread::get_caller_id()) + ".tmp";
+	Ref<FileAccess> f = FileAccess::open(temp_path, FileAccess::WRITE);
+	ERR_FAIL_COND(f.is_null());
+
+	f->store_buffer((const uint8_t *)shader_cache_file_header, 4);
+	f->store_32(shader_cache_file_version);
+
+	const GeneratedCode &gen_code = p_entry.gen_code;
+	_store_strings(f, gen_code.defines);
+
+	f->store_32(gen_code.texture_uniforms.size());
+	for (const GeneratedCode::Texture &texture : gen_code.texture_uniforms) {
+		f->store_pascal_string(texture.name);
+		f->store_32(texture.type);
+		f->store_32(texture.hint);
+		f->store_8(texture.use_color);
+		f->store_32(texture.filter);
+		f->store_32(texture.repeat);
+		f->store_8(texture.global);
+		f->store_32(texture.array_size);
+	}
+
+	f->store_32(gen_code.uniform_offsets.size());
+	for (uint32_t offset : gen_code.uniform_offsets) {
+		f->store_32(offset);
+	}
+	f->store_32(gen_code.uniform_total_size);
+	f->store_pascal_string(gen_code.uniforms);
+	for (int i = 0; i < STAGE_MAX; i++) {
+		f->store_pascal_string(gen_code.stage_globals[i]);
+	}
+
+	f->store_32(gen_code.code.size());
+	for (const KeyValue<String, String> &E : gen_code.code) {
+		f->store_pascal_string(E.key);
+		f->store_pascal_string(E.value);
+	}
+
+	f->store_8(gen_code.uses_global_textures);
+	f->store_8(gen_code.uses_fragment_time);
+	f->store_8(gen_code.uses_vertex_time);
+	f->store_8(gen_code.uses_screen_texture_mipmaps);
+	f->store_8(gen_code.uses_screen_texture);
+	f->store_8(gen_code.uses_depth_texture);
+	f->store_8(gen_code.uses_normal_roughness_texture);
+
+	_store_string_names(f, p_entry.render_modes);
+	_store_string_names(f, p_entry.stencil_modes);
+	f->store_32(p_entry.stencil_reference);
+	_store_string_names(f, p_entry.usage_flags);
+	_store_string_names(f, p_entry.write_flags);
+
+	f->store_32(p_entry.uniforms.size());
+	for (const Pair<StringName, SL::ShaderNode::Uniform> &E : p_entry.uniforms) {
+		const SL::ShaderNode::Uniform &uniform = E.second;
+		f->store_pascal_string(E.first);
+		f->store_32(uniform.order);
+		f->store_32(uniform.prop_order);
+		f->store_32(uniform.texture_order);
+		f->store_32(uniform.texture_binding);
+		f->store_32(uniform.type);
+		f->store_32(uniform.precision);
+		f->store_32(uniform.array_size);
+		f->store_32(uniform.default_value.size());
+		for (const SL::Scalar &value : uniform.default_value) {
+			f->store_32(value.uint);
+		}
+		f->store_32(uniform.scope);
+		f->store_32(uniform.hint);
+		f->store_8(uniform.use_color);
+		f->store_32(uniform.filter);
+		f->store_32(uniform.repeat);
+		for (int j = 0; j < 3; j++) {
+			f->store_float(uniform.hint_range[j]);
+		}
+		_store_strings(f, uniform.hint_enum_names);
+		f->store_32(uniform.instance_index);
+		f->store_pascal_string(uniform.group);
+	}
+
+	f->close();
+	if (DirAccess::rename_absolute(temp_path, path) != OK) {
+		DirAccess::remove_absolute(temp_path);
+	}
+}
+
+void ShaderCompiler::set_cache_dir(const String &p_dir) {
+	cache_dir = String();
+	if (p_dir.is_empty()) {
+		return;
+	}
+
+	Ref<DirAccess> da = DirAccess::create_for_path(p_dir);
+	if (da.is_null() || (!da->dir_exists(p_dir) && da->make_dir_recursive(p_dir) != OK)) {
+		ERR_PRINT("Can't create shader compiler cache folder, no shader compiler caching will happen: " + p_dir);
+		return;
+	}
+	cache_dir = p_dir;
+}
+
+String ShaderCompiler::get_cache_dir() {
+	return cache_dir;
+}
+
+uint64_t ShaderCompiler::get_cache_hits() {
+	return cache_hits.get();
+}
+
+uint64_t ShaderCompiler::get_cache_misses() {
+	return cache_misses.get();
+}
+
+void ShaderCompiler::reset_cache_stats() {
+	cache_hits.set(0);
+	cache_misses.set(0);
+}
+
 void ShaderCompiler::initialize(DefaultIdentifierActions p_actions) {
 	actions = p_actions;
 
+	// The generated code depends on the actions as much as on the source, so they're part of the cache key.
+	StringBuilder hash_build;
+	const HashMap<StringName, String> *maps[] = { &actions.renames, &actions.render_mode_defines, &actions.usage_defines, &actions.custom_samplers };
+	for (const HashMap<StringName, String> *map : maps) {
+		hash_build.append("[map]");
+		for (const KeyValue<StringName, String> &E : *map) {
+			hash_build.append(String(E.key) + "=" + E.value + "\n");
+		}
+	}
+	hash_build.append(vformat("[values]%d,%d,%d,%d,%d,%d,%d\n", actions.default_filter, actions.default_repeat, actions.base_texture_binding_index, actions.texture_layout_set, actions.base_varying_index, actions.apply_luminance_multiplier, actions.check_multiview_samplers));
+	hash_build.append(actions.base_uniform_string + "\n");
+	hash_build.append(actions.global_buffer_array_variable + "\n");
+	hash_build.append(actions.instance_uniform_index_variable + "\n");
+	actions_hash = hash_build.as_string().sha1_text();
+
 	time_name = "TIME";
 
 	List<String> func_list;
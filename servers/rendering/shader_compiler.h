@@ -30,7 +30,9 @@
 
 #pragma once
 
+#include "core/templates/local_vector.h"
 #include "core/templates/pair.h"
+#include "core/templates/safe_refcount.h"
 #include "servers/rendering/rendering_server_enums.h"
 #include "servers/rendering/shader_language.h"
 
@@ -109,13 +111,55 @@ public:
 		bool check_multiview_samplers = false;
 	};
 
+	// Actions are only read while compiling, but the flags, values and uniforms they point to are
+	// written. Every item of a batch must therefore use its own actions and generated code.
+	struct BatchItem {
+		RSE::ShaderMode mode = RSE::SHADER_SPATIAL;
+		String code;
+		String path;
+		const IdentifierActions *actions = nullptr;
+		GeneratedCode *gen_code = nullptr;
+		Error error = OK;
+	};
+
 private:
+	// Everything compile() produces for a given source, so that it can be replayed without parsing the shader again.
+	struct CacheEntry {
+		GeneratedCode gen_code;
+		Vector<StringName> render_modes;
+		Vector<StringName> stencil_modes;
+		int stencil_reference = -1;
+		Vector<StringName> usage_flags;
+		Vector<StringName> write_flags;
+		Vector<Pair<StringName, ShaderLanguage::ShaderNode::Uniform>> uniforms;
+	};
+
+	static String cache_dir;
+	static SafeNumeric<uint64_t> cache_hits;
+	static SafeNumeric<uint64_t> cache_misses;
+
+	String actions_hash;
+
+	String _get_cache_key(RSE::ShaderMode p_mode, const String &p_code) const;
+	static bool _load_from_cache(const String &p_key, CacheEntry &r_entry);
+	static void _save_to_cache(const String &p_key, const CacheEntry &p_entry);
+	static void _apply_cache_entry(const CacheEntry &p_entry, const IdentifierActions &p_actions, GeneratedCode &r_gen_code);
+	static void _apply_render_modes(const Vector<StringName> &p_render_modes, const Vector<StringName> &p_stencil_modes, int p_stencil_reference, const IdentifierActions &p_actions);
+
+	struct BatchData {
+		LocalVector<BatchItem> *items = nullptr;
+		LocalVector<ShaderCompiler *> compilers;
+		SafeNumeric<uint32_t> next_item;
+	};
+
+	void _compile_batch_thread(uint32_t p_thread, BatchData *p_data);
+
 	ShaderLanguage parser;
 
 	String _get_sampler_name(ShaderLanguage::TextureFilter p_filter, ShaderLanguage::TextureRepeat p_repeat);
 
 	void _dump_function_deps(const ShaderLanguage::ShaderNode *p_node, const StringName &p_for_func, const HashMap<StringName, String> &p_func_code, String &r_to_add, HashSet<StringName> &added);
-	String _dump_node_code(const ShaderLanguage::Node *p_node, int p_level, GeneratedCode &r_gen_code, IdentifierActions &p_actions, const DefaultIdentifierActions &p_default_actions, bool p_assigning, bool p_scope = true);
+	String _dump_node_code(const ShaderLanguage::Node *p_node, int p_level, GeneratedCode &r_gen_code, const IdentifierActions &p_actions, const DefaultIdentifierActions &p_default_actions, bool p_assigning, bool p_scope = true);
 
 	const ShaderLanguage::ShaderNode *shader = nullptr;
 	const ShaderLanguage::FunctionNode *function = nullptr;
@@ -134,8 +178,20 @@ private:
 	static ShaderLanguage::DataType _get_global_shader_uniform_type(const StringName &p_name);
 
 public:
-	Error compile(RSE::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code);
+	Error compile(RSE::ShaderMode p_mode, const String &p_code, const IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code);
+
+	// Compiles all items on the WorkerThreadPool and returns once they're done. A compiler instance
+	// is not reentrant, so each worker uses its own, initialized with a copy of this one's actions.
+	void compile_batch(LocalVector<BatchItem> &p_items);
 
 	void initialize(DefaultIdentifierActions p_actions);
+
+	// Directory used to persist compiled shaders across runs. The cache is disabled while empty.
+	static void set_cache_dir(const String &p_dir);
+	static String get_cache_dir();
+	static uint64_t get_cache_hits();
+	static uint64_t get_cache_misses();
+	static void reset_cache_stats();
+
 	ShaderCompiler();
 };
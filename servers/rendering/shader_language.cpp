@@ -31,6 +31,7 @@
 #include "shader_language.h"
 
 #include "core/config/engine.h"
+#include "core/os/mutex.h"
 #include "core/os/os.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/rb_set.h"
@@ -738,21 +739,24 @@ ShaderLanguage::Token ShaderLanguage::_get_token() {
 						CASE_MAX,
 					} lut_case = CASE_ALL;
 
-					static bool suffix_lut[CASE_MAX][127];
-
-					if (!is_const_suffix_lut_initialized) {
-						is_const_suffix_lut_initialized = true;
+					struct SuffixLUT {
+						bool values[CASE_MAX][127];
+					};
 
+					// Initialized once in a thread-safe way, as several parsers may run concurrently.
+					static const SuffixLUT suffix_lut = []() {
+						SuffixLUT lut;
 						for (int i = 0; i < 127; i++) {
 							char t = char(i);
 
-							suffix_lut[CASE_ALL][i] = t == '.' || t == 'x' || t == 'e' || t == 'f' || t == 'u' || t == '-' || t == '+';
-							suffix_lut[CASE_HEXA_PERIOD][i] = t == 'e' || t == 'f' || t == 'u';
-							suffix_lut[CASE_EXPONENT][i] = t == 'f' || t == '-' || t == '+';
-							suffix_lut[CASE_SIGN_AFTER_EXPONENT][i] = t == 'f';
-							suffix_lut[CASE_NONE][i] = false;
+							lut.values[CASE_ALL][i] = t == '.' || t == 'x' || t == 'e' || t == 'f' || t == 'u' || t == '-' || t == '+';
+							lut.values[CASE_HEXA_PERIOD][i] = t == 'e' || t == 'f' || t == 'u';
+							lut.values[CASE_EXPONENT][i] = t == 'f' || t == '-' || t == '+';
+							lut.values[CASE_SIGN_AFTER_EXPONENT][i] = t == 'f';
+							lut.values[CASE_NONE][i] = false;
 						}
-					}
+						return lut;
+					}();
 
 					String str;
 					int i = 0;
@@ -770,7 +774,7 @@ ShaderLanguage::Token ShaderLanguage::_get_token() {
 								error = true;
 							}
 						} else {
-							if (symbol < 0x7F && suffix_lut[lut_case][symbol]) {
+							if (symbol < 0x7F && suffix_lut.values[lut_case][symbol]) {
 								if (symbol == 'x') {
 									hexa_found = true;
 									lut_case = CASE_HEXA_PERIOD;
@@ -3561,6 +3565,8 @@ const ShaderLanguage::BuiltinFuncDef ShaderLanguage::builtin_func_defs[] = {
 };
 
 HashSet<StringName> global_func_set;
+// Guards filling and clearing global_func_set, which happen when the first parser is created and the last one is destroyed.
+static BinaryMutex global_func_set_mutex;
 
 const ShaderLanguage::BuiltinFuncOutArgs ShaderLanguage::builtin_func_out_args[] = {
 	{ "modf", { 1, -1 } },
@@ -3592,8 +3598,6 @@ const ShaderLanguage::BuiltinEntry ShaderLanguage::frag_only_func_defs[] = {
 	{ nullptr }
 };
 
-bool ShaderLanguage::is_const_suffix_lut_initialized = false;
-
 bool ShaderLanguage::_validate_function_call(BlockNode *p_block, const FunctionInfo &p_function_info, OperatorNode *p_func, DataType *r_ret_type, StringName *r_ret_type_str, bool *r_is_custom_function) {
 	ERR_FAIL_COND_V(p_func->op != OP_CALL && p_func->op != OP_CONSTRUCT, false);
 
@@ -12201,16 +12205,19 @@ ShaderLanguage::ShaderLanguage() {
 	nodes = nullptr;
 	completion_class = TAG_GLOBAL;
 
-	if (instance_counter.get() == 0) {
-		int idx = 0;
-		while (builtin_func_defs[idx].name) {
-			if (builtin_func_defs[idx].tag == SubClassTag::TAG_GLOBAL) {
-				global_func_set.insert(builtin_func_defs[idx].name);
+	{
+		MutexLock lock(global_func_set_mutex);
+		if (instance_counter.get() == 0) {
+			int idx = 0;
+			while (builtin_func_defs[idx].name) {
+				if (builtin_func_defs[idx].tag == SubClassTag::TAG_GLOBAL) {
+					global_func_set.insert(builtin_func_defs[idx].name);
+				}
+				idx++;
 			}
-			idx++;
 		}
+		instance_counter.increment();
 	}
-	instance_counter.increment();
 
 #ifdef DEBUG_ENABLED
 	warnings_check_map.insert(ShaderWarning::UNUSED_CONSTANT, &used_constants);
@@ -12225,6 +12232,8 @@ ShaderLanguage::ShaderLanguage() {
 
 ShaderLanguage::~ShaderLanguage() {
 	clear();
+
+	MutexLock lock(global_func_set_mutex);
 	instance_counter.decrement();
 	if (instance_counter.get() == 0) {
 		global_func_set.clear();
@@ -0,0 +1,144 @@
+/**************************************************************************/
+/*  physics_test_utils.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/templates/local_vector.h"
+#include "core/templates/rid.h"
+
+#ifndef PHYSICS_2D_DISABLED
+#include "servers/physics_2d/physics_server_2d.h"
+#include "servers/physics_2d/physics_server_2d_wrap_mt.h"
+#endif // PHYSICS_2D_DISABLED
+#ifndef PHYSICS_3D_DISABLED
+#include "servers/physics_3d/physics_server_3d.h"
+#include "servers/physics_3d/physics_server_3d_wrap_mt.h"
+#endif // PHYSICS_3D_DISABLED
+
+class TestPhysicsServerAccessor {
+public:
+#ifndef PHYSICS_2D_DISABLED
+	static void set_singleton(PhysicsServer2D *p_server) { PhysicsServer2D::singleton = p_server; }
+
+	// Returns the server behind a wrapper, or null if the wrapper runs it on its own thread.
+	static PhysicsServer2D *get_wrapped(PhysicsServer2D *p_server) {
+		PhysicsServer2DWrapMT *wrapper = Object::cast_to<PhysicsServer2DWrapMT>(p_server);
+		if (!wrapper) {
+			return p_server;
+		}
+		return wrapper->create_thread ? nullptr : wrapper->physics_server_2d;
+	}
+#endif // PHYSICS_2D_DISABLED
+#ifndef PHYSICS_3D_DISABLED
+	static void set_singleton(PhysicsServer3D *p_server) { PhysicsServer3D::singleton = p_server; }
+
+	static PhysicsServer3D *get_wrapped(PhysicsServer3D *p_server) {
+		PhysicsServer3DWrapMT *wrapper = Object::cast_to<PhysicsServer3DWrapMT>(p_server);
+		if (!wrapper) {
+			return p_server;
+		}
+		return wrapper->create_thread ? nullptr : wrapper->physics_server_3d;
+	}
+#endif // PHYSICS_3D_DISABLED
+};
+
+namespace TestUtils {
+
+// Provides a physics server of type T for the duration of a test, whatever the project's physics engine is.
+// The active server is used if it has the right type. Otherwise the server registered as `p_name` is created,
+// made the active one while in scope, then freed and the previous server restored.
+// Servers are driven directly from the test, so `get()` is null if they would run on a separate thread.
+// RIDs passed to `track()` are freed in reverse order when going out of scope, or on `free_tracked()`.
+template <typename T, typename TBase, typename TManager>
+class PhysicsServerScope {
+	TBase *previous_server = nullptr;
+	TBase *created_server = nullptr;
+	T *server = nullptr;
+	LocalVector<RID> tracked;
+
+public:
+	T *get() const { return server; }
+	T *operator->() const { return server; }
+
+	RID track(const RID &p_rid) {
+		tracked.push_back(p_rid);
+		return p_rid;
+	}
+
+	void free_tracked() {
+		for (int64_t i = int64_t(tracked.size()) - 1; i >= 0; i--) {
+			server->free_rid(tracked[i]);
+		}
+		tracked.clear();
+	}
+
+	PhysicsServerScope(const String &p_name) {
+		previous_server = TBase::get_singleton();
+		server = Object::cast_to<T>(TestPhysicsServerAccessor::get_wrapped(previous_server));
+		if (server) {
+			return;
+		}
+		created_server = TManager::get_singleton()->new_server(p_name);
+		server = Object::cast_to<T>(TestPhysicsServerAccessor::get_wrapped(created_server));
+		if (server) {
+			created_server->init();
+		} else {
+			if (created_server) {
+				memdelete(created_server);
+				created_server = nullptr;
+			}
+			TestPhysicsServerAccessor::set_singleton(previous_server);
+		}
+	}
+
+	~PhysicsServerScope() {
+		if (!server) {
+			return;
+		}
+		free_tracked();
+		if (created_server) {
+			// The wrapper frees the server it contains.
+			created_server->finish();
+			memdelete(created_server);
+			TestPhysicsServerAccessor::set_singleton(previous_server);
+		}
+	}
+};
+
+#ifndef PHYSICS_2D_DISABLED
+template <typename T>
+using PhysicsServer2DScope = PhysicsServerScope<T, PhysicsServer2D, PhysicsServer2DManager>;
+#endif // PHYSICS_2D_DISABLED
+#ifndef PHYSICS_3D_DISABLED
+template <typename T>
+using PhysicsServer3DScope = PhysicsServerScope<T, PhysicsServer3D, PhysicsServer3DManager>;
+#endif // PHYSICS_3D_DISABLED
+
+} // namespace TestUtils
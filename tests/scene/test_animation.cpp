@@ -32,7 +32,10 @@
 
 TEST_FORCE_LINK(test_animation)
 
+#include "core/io/dir_access.h"
+#include "core/os/os.h"
 #include "scene/resources/animation.h"
+#include "tests/test_utils.h"
 
 namespace TestAnimation {
 
@@ -308,4 +311,188 @@ TEST_CASE("[Animation] Create Bezier track") {
 	ERR_PRINT_ON;
 }
 
+static Ref<Animation> make_position_animation(int p_key_count) {
+	Ref<Animation> animation = memnew(Animation);
+	const int track_index = animation->add_track(Animation::TYPE_POSITION_3D);
+	animation->track_set_path(track_index, NodePath("Enemy"));
+	animation->set_length(p_key_count * 0.1);
+	for (int i = 0; i < p_key_count; i++) {
+		animation->position_track_insert_key(track_index, i * 0.1, Vector3(i, Math::sin(i * 0.3), i * 0.5));
+	}
+	return animation;
+}
+
+TEST_CASE("[Animation] Sampling with a key hint matches sampling without one") {
+	Ref<Animation> animation = make_position_animation(4096);
+
+	// Forward playback, a seek backwards, steps landing on keys and steps skipping several keys.
+	const double times[] = { 0.0, 0.05, 0.1, 0.13, 0.2, 0.45, 0.5, 1.0, 0.3, 0.31, 12.34, 12.4, 12.45, 100.0, 409.5, 409.55 };
+	int key_hint = -1;
+	for (const double time : times) {
+		Vector3 expected;
+		Vector3 hinted;
+		CHECK(animation->try_position_track_interpolate(0, time, &expected) == OK);
+		CHECK(animation->try_position_track_interpolate(0, time, &hinted, false, &key_hint) == OK);
+		CHECK(hinted == expected);
+		CHECK(key_hint == animation->track_find_key(0, time));
+	}
+
+	// A few seconds of playback at 60 FPS, then at a speed skipping keys, wrapping around the end.
+	key_hint = -1;
+	bool values_match = true;
+	bool hints_match = true;
+	for (int i = 0; i < 240; i++) {
+		const double time = i < 120 ? i / 60.0 : Math::fmod(400.0 + (i - 120) * 0.35, animation->get_length());
+		Vector3 expected;
+		Vector3 hinted;
+		animation->try_position_track_interpolate(0, time, &expected);
+		animation->try_position_track_interpolate(0, time, &hinted, false, &key_hint);
+		values_match = values_match && hinted == expected;
+		hints_match = hints_match && key_hint == animation->track_find_key(0, time);
+	}
+	CHECK(values_match);
+	CHECK(hints_match);
+}
+
+TEST_CASE("[Animation][Benchmark] Sampling with a key hint" * doctest::skip()) {
+	const int key_count = 4096;
+	Ref<Animation> animation = make_position_animation(key_count);
+	const int steps = 200000;
+	const double delta = 1.0 / 60.0;
+	Vector3 sum_expected;
+	Vector3 sum_hinted;
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < steps; i++) {
+		Vector3 value;
+		animation->try_position_track_interpolate(0, Math::fmod(i * delta, animation->get_length()), &value);
+		sum_expected += value;
+	}
+	const uint64_t search_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	int key_hint = -1;
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < steps; i++) {
+		Vector3 value;
+		animation->try_position_track_interpolate(0, Math::fmod(i * delta, animation->get_length()), &value, false, &key_hint);
+		sum_hinted += value;
+	}
+	const uint64_t hinted_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	CHECK(sum_hinted == sum_expected);
+	MESSAGE(vformat("Sampled %d keys %d times: %d usec with binary search, %d usec with key hint.", key_count, steps, search_usec, hinted_usec));
+}
+
+// A position track and a rotation track, compressed into several pages each.
+static Ref<Animation> make_compressed_animation(int p_key_count) {
+	Ref<Animation> animation = memnew(Animation);
+	const int position_track = animation->add_track(Animation::TYPE_POSITION_3D);
+	animation->track_set_path(position_track, NodePath("Enemy"));
+	const int rotation_track = animation->add_track(Animation::TYPE_ROTATION_3D);
+	animation->track_set_path(rotation_track, NodePath("Enemy"));
+	animation->set_length(p_key_count / 30.0);
+	for (int i = 0; i < p_key_count; i++) {
+		const double time = i / 30.0;
+		animation->position_track_insert_key(position_track, time, Vector3(Math::sin(time), Math::cos(time * 0.5), time * 0.1));
+		animation->rotation_track_insert_key(rotation_track, time, Quaternion(Vector3(0, 1, 0), Math::fmod(time, Math::TAU)));
+	}
+	animation->compress(2048);
+	return animation;
+}
+
+TEST_CASE("[Animation] Streamed compressed pages sample like resident ones") {
+	const int key_count = 6000;
+	Ref<Animation> animation = make_compressed_animation(key_count);
+	REQUIRE(animation->track_is_compressed(0));
+	CHECK(animation->track_get_key_count(0) == key_count);
+
+	// Spread over the whole animation so every page is visited, in an order that jumps between pages.
+	const int steps = 200;
+	LocalVector<double> times;
+	LocalVector<Vector3> positions;
+	LocalVector<Quaternion> rotations;
+	times.resize(steps);
+	positions.resize(steps);
+	rotations.resize(steps);
+	for (int i = 0; i < steps; i++) {
+		times[i] = Math::fmod(i * 0.37 * animation->get_length(), animation->get_length());
+		animation->try_position_track_interpolate(0, times[i], &positions[i]);
+		animation->try_rotation_track_interpolate(1, times[i], &rotations[i]);
+	}
+	const uint64_t resident_memory = animation->get_compressed_page_memory_usage();
+	CHECK(resident_memory > 0);
+	Vector3 last_key_resident;
+	REQUIRE(animation->position_track_get_key(0, key_count - 1, &last_key_resident) == OK);
+
+	// Decoding stays close to the source keys.
+	Vector3 position;
+	animation->try_position_track_interpolate(0, 1000 / 30.0, &position);
+	CHECK(position.distance_to(Vector3(Math::sin(1000 / 30.0), Math::cos(500 / 30.0), 100 / 30.0)) < 0.01);
+
+	const String path = TestUtils::get_temp_path("animation_pages.bin");
+	REQUIRE(animation->stream_compressed_pages(path) == OK);
+	CHECK(animation->get_compressed_page_stream_path() == path);
+	CHECK(animation->get_compressed_page_memory_usage() == 0);
+
+	// Key counts are kept in the page index, so looking up a key by index only loads the page it is in.
+	CHECK(animation->track_get_key_count(0) == key_count);
+	CHECK(Animation::get_streamed_page_cache_memory_usage() == 0);
+	Vector3 last_key;
+	REQUIRE(animation->position_track_get_key(0, key_count - 1, &last_key) == OK);
+	CHECK(last_key == last_key_resident);
+	CHECK(Animation::get_streamed_page_cache_memory_usage() > 0);
+	CHECK(Animation::get_streamed_page_cache_memory_usage() < resident_memory / 2);
+
+	bool matches = true;
+	for (int i = 0; i < steps; i++) {
+		Vector3 streamed_position;
+		Quaternion streamed_rotation;
+		animation->try_position_track_interpolate(0, times[i], &streamed_position);
+		animation->try_rotation_track_interpolate(1, times[i], &streamed_rotation);
+		matches = matches && streamed_position == positions[i] && streamed_rotation == rotations[i];
+	}
+	CHECK(matches);
+
+	const uint64_t cache_memory = Animation::get_streamed_page_cache_memory_usage();
+	CHECK(cache_memory > 0);
+	CHECK(cache_memory <= resident_memory);
+
+	animation.unref();
+	CHECK(Animation::get_streamed_page_cache_memory_usage() == 0);
+	DirAccess::remove_absolute(path);
+}
+
+TEST_CASE("[Animation][Benchmark] Sampling streamed compressed pages" * doctest::skip()) {
+	Ref<Animation> animation = make_compressed_animation(6000);
+	const int steps = 100000;
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < steps; i++) {
+		const double time = Math::fmod(i * (1.0 / 60.0) * 3.7, animation->get_length());
+		Vector3 position;
+		Quaternion rotation;
+		animation->try_position_track_interpolate(0, time, &position);
+		animation->try_rotation_track_interpolate(1, time, &rotation);
+	}
+	const uint64_t resident_usec = OS::get_singleton()->get_ticks_usec() - begin;
+	const uint64_t resident_memory = animation->get_compressed_page_memory_usage();
+
+	const String path = TestUtils::get_temp_path("animation_pages_benchmark.bin");
+	REQUIRE(animation->stream_compressed_pages(path) == OK);
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < steps; i++) {
+		const double time = Math::fmod(i * (1.0 / 60.0) * 3.7, animation->get_length());
+		Vector3 position;
+		Quaternion rotation;
+		animation->try_position_track_interpolate(0, time, &position);
+		animation->try_rotation_track_interpolate(1, time, &rotation);
+	}
+	const uint64_t streamed_usec = OS::get_singleton()->get_ticks_usec() - begin;
+	const uint64_t cache_memory = Animation::get_streamed_page_cache_memory_usage();
+	MESSAGE(vformat("Sampled 2 compressed tracks %d times: %d usec resident (%d bytes), %d usec streamed (%d bytes cached).", steps, resident_usec, resident_memory, streamed_usec, cache_memory));
+
+	animation.unref();
+	DirAccess::remove_absolute(path);
+}
+
 } // namespace TestAnimation
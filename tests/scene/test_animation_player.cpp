@@ -32,7 +32,13 @@
 
 TEST_FORCE_LINK(test_animation_player)
 
+#include "core/config/project_settings.h"
+#include "scene/3d/camera_3d.h"
+#include "scene/3d/node_3d.h"
+#include "scene/3d/visible_on_screen_notifier_3d.h"
 #include "scene/animation/animation_player.h"
+#include "scene/main/scene_tree.h"
+#include "scene/main/window.h"
 #include "scene/resources/animation.h"
 
 namespace TestAnimationPlayer {
@@ -62,4 +68,158 @@ TEST_CASE("[AnimationPlayer] get & set blend_time") {
 	memdelete(animation_player);
 }
 
+TEST_CASE("[SceneTree][AnimationPlayer] Parallel processing blends every character") {
+	ProjectSettings::get_singleton()->set_setting("animation/mixer/parallel_processing", true);
+
+	Ref<Animation> animation = memnew(Animation);
+	animation->set_length(1.0);
+	const int track_index = animation->add_track(Animation::TYPE_POSITION_3D);
+	animation->track_set_path(track_index, NodePath("Target"));
+	animation->position_track_insert_key(track_index, 0.0, Vector3(0, 0, 0));
+	animation->position_track_insert_key(track_index, 1.0, Vector3(10, 0, 0));
+	Ref<AnimationLibrary> animation_library = memnew(AnimationLibrary);
+	animation_library->add_animation("move", animation);
+
+	// A method track calls into the node, so that character has to be blended on the main thread.
+	Ref<Animation> method_animation = animation->duplicate();
+	const int method_track_index = method_animation->add_track(Animation::TYPE_METHOD);
+	method_animation->track_set_path(method_track_index, NodePath("Target"));
+	Dictionary method_key;
+	method_key["method"] = "hide";
+	method_key["args"] = Array();
+	method_animation->track_insert_key(method_track_index, 0.25, method_key);
+	animation_library->add_animation("move_and_hide", method_animation);
+
+	const int character_count = 16;
+	LocalVector<Node3D *> characters;
+	LocalVector<Node3D *> targets;
+	for (int i = 0; i < character_count; i++) {
+		Node3D *character = memnew(Node3D);
+		Node3D *target = memnew(Node3D);
+		target->set_name("Target");
+		character->add_child(target);
+		AnimationPlayer *animation_player = memnew(AnimationPlayer);
+		animation_player->add_animation_library("", animation_library);
+		animation_player->set_callback_mode_method(AnimationMixer::ANIMATION_CALLBACK_MODE_METHOD_IMMEDIATE);
+		character->add_child(animation_player);
+		SceneTree::get_singleton()->get_root()->add_child(character);
+		animation_player->play(i == 0 ? "move_and_hide" : "move");
+		animation_player->seek(0.0, true); // Playback starts from the first processed frame otherwise.
+		characters.push_back(character);
+		targets.push_back(target);
+	}
+
+	SceneTree::get_singleton()->process(0.5);
+	for (Node3D *target : targets) {
+		CHECK(target->get_position().is_equal_approx(Vector3(5, 0, 0)));
+	}
+	CHECK_FALSE(targets[0]->is_visible());
+	CHECK(targets[1]->is_visible());
+
+	// Each frame processes every mixer once.
+	SceneTree::get_singleton()->process(0.25);
+	for (Node3D *target : targets) {
+		CHECK(target->get_position().is_equal_approx(Vector3(7.5, 0, 0)));
+	}
+
+	for (Node3D *character : characters) {
+		memdelete(character);
+	}
+	ProjectSettings::get_singleton()->set_setting("animation/mixer/parallel_processing", false);
+}
+
+TEST_CASE("[SceneTree][AnimationPlayer] LOD lowers the update rate of distant characters") {
+	Ref<Animation> animation = memnew(Animation);
+	animation->set_length(1.0);
+	const int target_track = animation->add_track(Animation::TYPE_POSITION_3D);
+	animation->track_set_path(target_track, NodePath("Target"));
+	animation->position_track_insert_key(target_track, 0.0, Vector3(0, 0, 0));
+	animation->position_track_insert_key(target_track, 1.0, Vector3(10, 0, 0));
+	const int detail_track = animation->add_track(Animation::TYPE_POSITION_3D);
+	animation->track_set_path(detail_track, NodePath("Detail"));
+	animation->position_track_insert_key(detail_track, 0.0, Vector3(0, 0, 0));
+	animation->position_track_insert_key(detail_track, 1.0, Vector3(0, 10, 0));
+	Ref<AnimationLibrary> animation_library = memnew(AnimationLibrary);
+	animation_library->add_animation("move", animation);
+
+	Camera3D *camera = memnew(Camera3D);
+	SceneTree::get_singleton()->get_root()->add_child(camera);
+	camera->set_current(true);
+
+	Node3D *character = memnew(Node3D);
+	character->set_position(Vector3(0, 0, -100));
+	Node3D *target = memnew(Node3D);
+	target->set_name("Target");
+	character->add_child(target);
+	Node3D *detail = memnew(Node3D);
+	detail->set_name("Detail");
+	character->add_child(detail);
+	VisibleOnScreenNotifier3D *notifier = memnew(VisibleOnScreenNotifier3D);
+	notifier->set_name("Notifier");
+	character->add_child(notifier);
+	AnimationPlayer *animation_player = memnew(AnimationPlayer);
+	animation_player->add_animation_library("", animation_library);
+	animation_player->set_lod_enabled(true);
+	animation_player->set_lod_distance(20.0);
+	animation_player->set_lod_max_update_interval(4);
+	animation_player->set_lod_detail_tracks(TypedArray<NodePath>({ NodePath("Detail") }));
+	character->add_child(animation_player);
+	SceneTree::get_singleton()->get_root()->add_child(character);
+	animation_player->play("move");
+	animation_player->seek(0.0, true);
+
+	const uint32_t reduced_rate_count = AnimationMixer::get_lod_state_count(AnimationMixer::LOD_STATE_REDUCED_RATE);
+
+	// 100m away with a LOD distance of 20m, the update interval is capped at 4 frames.
+	int updates = 0;
+	real_t last_x = 0.0;
+	for (int i = 0; i < 8; i++) {
+		SceneTree::get_singleton()->process(0.1);
+		const real_t x = target->get_position().x;
+		if (!Math::is_equal_approx(x, last_x)) {
+			// Skipped frames are added to the next update.
+			CHECK(x == doctest::Approx((i + 1) * 1.0));
+			updates++;
+			last_x = x;
+		}
+	}
+	CHECK(updates == 2);
+	CHECK(detail->get_position().is_equal_approx(Vector3(0, 0, 0)));
+	CHECK(AnimationMixer::get_lod_state_count(AnimationMixer::LOD_STATE_REDUCED_RATE) == reduced_rate_count + 1);
+
+	// Nothing is rendered in tests, so the notifier is never on screen.
+	animation_player->set_lod_visibility_notifier(NodePath("../Notifier"));
+	for (int i = 0; i < 8; i++) {
+		SceneTree::get_singleton()->process(0.1);
+	}
+	CHECK(target->get_position().x == doctest::Approx(last_x));
+	CHECK(AnimationMixer::get_lod_state_count(AnimationMixer::LOD_STATE_OFFSCREEN) >= 1);
+
+	// Back on screen, the next update only catches up on up to 4 frames skipped while off-screen, plus the ones until its turn.
+	animation_player->seek(0.0, true);
+	animation_player->set_lod_visibility_notifier(NodePath());
+	real_t x = 0.0;
+	for (int i = 0; i < 4 && Math::is_zero_approx(x); i++) {
+		SceneTree::get_singleton()->process(0.1);
+		x = target->get_position().x;
+	}
+	CHECK(x > 4.0);
+	CHECK(x <= 8.0 + CMP_EPSILON);
+
+	// Close to the camera every frame is evaluated, including the detail tracks.
+	// Toggling LOD drops the time accumulated while off-screen.
+	animation_player->set_lod_enabled(false);
+	animation_player->set_lod_enabled(true);
+	animation_player->set_lod_visibility_notifier(NodePath());
+	character->set_position(Vector3(0, 0, -1));
+	animation_player->seek(0.0, true);
+	SceneTree::get_singleton()->process(0.1);
+	CHECK(target->get_position().is_equal_approx(Vector3(1, 0, 0)));
+	CHECK(detail->get_position().is_equal_approx(Vector3(0, 1, 0)));
+
+	memdelete(character);
+	memdelete(camera);
+	CHECK(AnimationMixer::get_lod_state_count(AnimationMixer::LOD_STATE_OFFSCREEN) == 0);
+}
+
 } // namespace TestAnimationPlayer
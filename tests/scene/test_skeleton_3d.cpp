@@ -34,7 +34,10 @@ TEST_FORCE_LINK(test_skeleton_3d)
 
 #ifndef _3D_DISABLED
 
+#include "core/os/os.h"
 #include "scene/3d/skeleton_3d.h"
+#include "scene/main/scene_tree.h"
+#include "scene/main/window.h"
 
 namespace TestSkeleton3D {
 
@@ -75,6 +78,88 @@ TEST_CASE("[Skeleton3D] Test per-bone meta") {
 	memdelete(skeleton);
 }
 
+TEST_CASE("[SceneTree][Skeleton3D] Only dirty bone chains are recalculated") {
+	Skeleton3D *skeleton = memnew(Skeleton3D);
+	SceneTree::get_singleton()->get_root()->add_child(skeleton);
+
+	// Two roots, a head and a face with many leaf bones.
+	const int root = skeleton->add_bone("root");
+	const int prop = skeleton->add_bone("prop");
+	const int head = skeleton->add_bone("head");
+	skeleton->set_bone_parent(head, root);
+	skeleton->set_bone_rest(head, Transform3D(Basis(), Vector3(0, 1.5, 0)));
+	const int face_bone_count = 320;
+	for (int i = 0; i < face_bone_count; i++) {
+		const int bone = skeleton->add_bone(vformat("face_%d", i));
+		skeleton->set_bone_parent(bone, head);
+		skeleton->set_bone_rest(bone, Transform3D(Basis(), Vector3(i * 0.001, 0.1, 0.05)));
+		skeleton->set_bone_pose(bone, skeleton->get_bone_rest(bone));
+	}
+	skeleton->set_bone_pose(head, skeleton->get_bone_rest(head));
+	skeleton->force_update_all_bone_transforms();
+
+	const int face = head + 10;
+	skeleton->set_bone_pose_position(prop, Vector3(2, 0, 0));
+	skeleton->set_bone_pose_rotation(head, Quaternion(Vector3(0, 1, 0), 0.5));
+	skeleton->set_bone_pose_position(face, Vector3(0.2, 0.1, 0.05));
+	skeleton->force_update_all_dirty_bones();
+	CHECK(skeleton->get_bone_global_pose(prop).origin.is_equal_approx(Vector3(2, 0, 0)));
+	CHECK(skeleton->get_bone_global_pose(face).is_equal_approx(skeleton->get_bone_global_pose(head) * skeleton->get_bone_pose(face)));
+	CHECK(skeleton->get_bone_global_pose(face + 1).is_equal_approx(skeleton->get_bone_global_pose(head) * skeleton->get_bone_pose(face + 1)));
+
+	// Updating a single subtree keeps the other root up to date once it is processed.
+	skeleton->set_bone_pose_position(prop, Vector3(3, 0, 0));
+	skeleton->set_bone_pose_position(face, Vector3(0.3, 0.1, 0.05));
+	skeleton->force_update_bone_children_transforms(head);
+	CHECK(skeleton->get_bone_global_pose(face).is_equal_approx(skeleton->get_bone_global_pose(head) * skeleton->get_bone_pose(face)));
+	skeleton->force_update_all_dirty_bones();
+	CHECK(skeleton->get_bone_global_pose(prop).origin.is_equal_approx(Vector3(3, 0, 0)));
+
+	const int iterations = 20000;
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		skeleton->set_bone_pose_rotation(head, Quaternion(Vector3(0, 1, 0), i * 0.001));
+		skeleton->force_update_all_dirty_bones();
+	}
+	const uint64_t full_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		skeleton->set_bone_pose_position(face + i % 4, Vector3(0.1, 0.1, i * 0.0001));
+		skeleton->force_update_all_dirty_bones();
+	}
+	const uint64_t partial_usec = OS::get_singleton()->get_ticks_usec() - begin;
+	CHECK(skeleton->get_bone_global_pose(face).is_equal_approx(skeleton->get_bone_global_pose(head) * skeleton->get_bone_pose(face)));
+
+	MESSAGE(vformat("Updated %d bones %d times: %d usec with the whole face dirty, %d usec with a single face bone dirty.", skeleton->get_bone_count(), iterations, full_usec, partial_usec));
+
+	memdelete(skeleton);
+}
+
+TEST_CASE("[SceneTree][Skeleton3D] Updating a subtree picks up changes to its ancestors") {
+	Skeleton3D *skeleton = memnew(Skeleton3D);
+	SceneTree::get_singleton()->get_root()->add_child(skeleton);
+	const int root = skeleton->add_bone("root");
+	const int arm = skeleton->add_bone("arm");
+	const int hand = skeleton->add_bone("hand");
+	skeleton->set_bone_parent(arm, root);
+	skeleton->set_bone_parent(hand, arm);
+	skeleton->set_bone_pose_position(arm, Vector3(0, 1, 0));
+	skeleton->set_bone_pose_position(hand, Vector3(0, 0.5, 0));
+	skeleton->force_update_all_bone_transforms();
+
+	// Only the hand's subtree is updated, the dirty root lies outside of it.
+	skeleton->set_bone_pose_position(root, Vector3(2, 0, 0));
+	skeleton->set_bone_pose_rotation(root, Quaternion(Vector3(0, 0, 1), Math::PI / 2));
+	skeleton->force_update_bone_children_transforms(hand);
+
+	const Transform3D expected = skeleton->get_bone_pose(root) * skeleton->get_bone_pose(arm) * skeleton->get_bone_pose(hand);
+	CHECK(skeleton->get_bone_global_pose(hand).is_equal_approx(expected));
+	CHECK(skeleton->get_bone_global_pose(arm).is_equal_approx(skeleton->get_bone_pose(root) * skeleton->get_bone_pose(arm)));
+
+	memdelete(skeleton);
+}
+
 } // namespace TestSkeleton3D
 
 #endif // _3D_DISABLED
@@ -0,0 +1,207 @@
+/**************************************************************************/
+/*  test_raster_occlusion_cull.cpp                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(test_raster_occlusion_cull)
+
+#include "core/math/projection.h"
+#include "core/os/os.h"
+#include "servers/rendering/raster_occlusion_cull.h"
+
+namespace TestRasterOcclusionCull {
+
+// Gives access to the top mip, and can fill it by tracing one ray per pixel the same way the raycast backend does.
+class TestHZBuffer : public RasterOcclusionCull::RasterHZBuffer {
+public:
+	float get_distance(int p_x, int p_y) const {
+		return mips[0][p_y * sizes[0].x + p_x];
+	}
+
+	void raycast_reference(const LocalVector<Vector3> &p_vertices, const LocalVector<uint32_t> &p_indices, const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal) {
+		const Size2i &buffer_size = sizes[0];
+		const real_t z_near = p_cam_projection.get_z_near();
+		const real_t z_far = p_cam_projection.get_z_far() * 1.05f;
+		const Vector2 half_extents = p_cam_projection.get_viewport_half_extents();
+
+		for (int y = 0; y < buffer_size.y; y++) {
+			for (int x = 0; x < buffer_size.x; x++) {
+				const Vector3 pixel_pos(-half_extents.x + (x + 0.5f) / buffer_size.x * 2.0f * half_extents.x, -half_extents.y + (y + 0.5f) / buffer_size.y * 2.0f * half_extents.y, -z_near);
+				Vector3 origin;
+				Vector3 dir;
+				real_t t_near = z_near;
+				if (p_cam_orthogonal) {
+					origin = Vector3(pixel_pos.x, pixel_pos.y, 0);
+					dir = Vector3(0, 0, -1);
+				} else {
+					dir = pixel_pos.normalized();
+					t_near /= -dir.z;
+				}
+				origin = p_cam_transform.xform(origin);
+				dir = p_cam_transform.basis.xform(dir);
+
+				real_t closest = z_far;
+				for (uint32_t i = 0; i < p_indices.size(); i += 3) {
+					const Vector3 &a = p_vertices[p_indices[i]];
+					const Vector3 edge1 = p_vertices[p_indices[i + 1]] - a;
+					const Vector3 edge2 = p_vertices[p_indices[i + 2]] - a;
+					const Vector3 p = dir.cross(edge2);
+					const real_t det = edge1.dot(p);
+					if (Math::abs(det) < 1e-12) {
+						continue;
+					}
+					const Vector3 s = origin - a;
+					const real_t u = s.dot(p) / det;
+					const Vector3 q = s.cross(edge1);
+					const real_t v = dir.dot(q) / det;
+					if (u < 0 || v < 0 || u + v > 1) {
+						continue;
+					}
+					const real_t t = edge2.dot(q) / det;
+					if (t >= t_near && t < closest) {
+						closest = t;
+					}
+				}
+				mips[0][y * buffer_size.x + x] = closest;
+			}
+		}
+	}
+};
+
+static void add_box(LocalVector<Vector3> &r_vertices, LocalVector<uint32_t> &r_indices, const AABB &p_aabb) {
+	const uint32_t base = r_vertices.size();
+	for (int i = 0; i < 8; i++) {
+		r_vertices.push_back(p_aabb.get_endpoint(i));
+	}
+	// Endpoint bits are x = 4, y = 2, z = 1.
+	const uint32_t faces[6][4] = { { 0, 1, 3, 2 }, { 4, 6, 7, 5 }, { 0, 4, 5, 1 }, { 2, 3, 7, 6 }, { 0, 2, 6, 4 }, { 1, 5, 7, 3 } };
+	for (const uint32_t *face : faces) {
+		const uint32_t quad[6] = { face[0], face[1], face[2], face[0], face[2], face[3] };
+		for (uint32_t index : quad) {
+			r_indices.push_back(base + index);
+		}
+	}
+}
+
+static void build_scene(LocalVector<Vector3> &r_vertices, LocalVector<uint32_t> &r_indices) {
+	// Ground, a wall, a few boxes and a triangle that crosses the near plane of the perspective camera.
+	r_vertices.push_back(Vector3(-50, 0, -50));
+	r_vertices.push_back(Vector3(50, 0, -50));
+	r_vertices.push_back(Vector3(50, 0, 50));
+	r_vertices.push_back(Vector3(-50, 0, 50));
+	const uint32_t ground[6] = { 0, 1, 2, 0, 2, 3 };
+	for (uint32_t index : ground) {
+		r_indices.push_back(index);
+	}
+	add_box(r_vertices, r_indices, AABB(Vector3(-4, 0, -6), Vector3(8, 3, 0.5)));
+	for (int i = 0; i < 5; i++) {
+		add_box(r_vertices, r_indices, AABB(Vector3(-5 + i * 2.2, 0, -1 - i), Vector3(1, 1 + i * 0.5, 1)));
+	}
+	const uint32_t base = r_vertices.size();
+	r_vertices.push_back(Vector3(-1, 1.2, 6));
+	r_vertices.push_back(Vector3(1.5, 0.8, 4));
+	r_vertices.push_back(Vector3(0.5, 2.5, 2));
+	r_indices.push_back(base);
+	r_indices.push_back(base + 1);
+	r_indices.push_back(base + 2);
+}
+
+static void compare_with_reference(const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal) {
+	LocalVector<Vector3> vertices;
+	LocalVector<uint32_t> indices;
+	build_scene(vertices, indices);
+
+	LocalVector<RasterOcclusionCull::RasterHZBuffer::Mesh> meshes;
+	RasterOcclusionCull::RasterHZBuffer::Mesh mesh;
+	mesh.vertices = vertices.ptr();
+	mesh.indices = indices.ptr();
+	mesh.index_count = indices.size();
+	mesh.aabb = AABB(vertices[0], Vector3());
+	for (const Vector3 &vertex : vertices) {
+		mesh.aabb.expand_to(vertex);
+	}
+	meshes.push_back(mesh);
+
+	const Size2i size(160, 90);
+	TestHZBuffer raster;
+	TestHZBuffer reference;
+	raster.resize(size);
+	reference.resize(size);
+
+	uint64_t raster_begin = OS::get_singleton()->get_ticks_usec();
+	raster.rasterize(meshes, p_cam_transform, p_cam_projection, p_cam_orthogonal);
+	uint64_t raster_usec = OS::get_singleton()->get_ticks_usec() - raster_begin;
+
+	uint64_t reference_begin = OS::get_singleton()->get_ticks_usec();
+	reference.raycast_reference(vertices, indices, p_cam_transform, p_cam_projection, p_cam_orthogonal);
+	uint64_t reference_usec = OS::get_singleton()->get_ticks_usec() - reference_begin;
+
+	int mismatches = 0;
+	for (int y = 0; y < size.y; y++) {
+		for (int x = 0; x < size.x; x++) {
+			const float expected = reference.get_distance(x, y);
+			if (Math::abs(raster.get_distance(x, y) - expected) > expected * 0.001f) {
+				mismatches++;
+			}
+		}
+	}
+
+	MESSAGE(vformat("Rasterized in %d usec, raycast reference in %d usec, %d of %d pixels differ.", raster_usec, reference_usec, mismatches, size.x * size.y).utf8().get_data());
+	// Only pixels whose center lies on a triangle edge are allowed to differ.
+	CHECK(mismatches < size.x * size.y / 100);
+
+	// Both buffers should agree on the occlusion of objects hidden behind the wall or in plain sight.
+	raster.update_mips();
+	reference.update_mips();
+	const Transform3D cam_inv_transform = p_cam_transform.affine_inverse();
+	const AABB hidden(Vector3(-1, 0.5, -12), Vector3(1, 1, 1));
+	const AABB visible(Vector3(-1, 5, -12), Vector3(1, 1, 1));
+	const AABB aabbs[2] = { hidden, visible };
+	for (const AABB &aabb : aabbs) {
+		const real_t bounds[6] = { aabb.position.x, aabb.position.y, aabb.position.z, aabb.position.x + aabb.size.x, aabb.position.y + aabb.size.y, aabb.position.z + aabb.size.z };
+		uint64_t raster_timeout = 0;
+		uint64_t reference_timeout = 0;
+		CHECK(raster.is_occluded(bounds, p_cam_transform.origin, cam_inv_transform, p_cam_projection, p_cam_projection.get_z_near(), p_cam_orthogonal, raster_timeout) == reference.is_occluded(bounds, p_cam_transform.origin, cam_inv_transform, p_cam_projection, p_cam_projection.get_z_near(), p_cam_orthogonal, reference_timeout));
+	}
+}
+
+TEST_CASE("[RasterOcclusionCull] Depth buffer matches raycasting") {
+	const Transform3D cam_transform = Transform3D(Basis(), Vector3(0, 1.5, 5)).looking_at(Vector3(0, 1, -10), Vector3(0, 1, 0));
+
+	SUBCASE("Perspective camera") {
+		compare_with_reference(cam_transform, Projection::create_perspective(70, 16.0 / 9.0, 0.1, 100), false);
+	}
+
+	SUBCASE("Orthogonal camera") {
+		compare_with_reference(cam_transform, Projection::create_orthogonal_aspect(12, 16.0 / 9.0, 0.1, 100), true);
+	}
+}
+
+} // namespace TestRasterOcclusionCull
@@ -0,0 +1,114 @@
+/**************************************************************************/
+/*  test_renderer_canvas_cull.cpp                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(test_renderer_canvas_cull)
+
+#include "servers/rendering/renderer_canvas_cull.h"
+#include "servers/rendering/rendering_server.h"
+#include "servers/rendering/rendering_server_globals.h"
+
+namespace TestRendererCanvasCull {
+
+static void draw_panel(RID p_item, const Color &p_color) {
+	RenderingServer *rs = RenderingServer::get_singleton();
+	rs->canvas_item_add_rect(p_item, Rect2(0, 0, 100, 50), p_color);
+	rs->canvas_item_add_line(p_item, Point2(0, 60), Point2(100, 60), Color(1, 1, 1), 2.0);
+	Vector<Point2> points = { Point2(0, 70), Point2(50, 120), Point2(100, 70) };
+	rs->canvas_item_add_polygon(p_item, points, { p_color });
+}
+
+TEST_CASE("[SceneTree][RendererCanvasCull] Retained draw commands") {
+	RenderingServer *rs = RenderingServer::get_singleton();
+	RID item = rs->canvas_item_create();
+
+	rs->canvas_item_clear(item);
+	draw_panel(item, Color(1, 0, 0));
+	RSG::canvas->update();
+	const Rect2 rect = RSG::canvas->_debug_canvas_item_get_rect(item);
+	CHECK(rect.is_equal_approx(Rect2(0, 0, 100, 120)));
+
+	SUBCASE("Identical redraws keep the previous commands") {
+		rs->canvas_item_clear(item);
+		draw_panel(item, Color(1, 0, 0));
+		RSG::canvas->update();
+		CHECK(RSG::canvas->get_items_reused_in_frame() == 1);
+		CHECK(RSG::canvas->get_items_rebuilt_in_frame() == 0);
+		CHECK(RSG::canvas->_debug_canvas_item_get_rect(item) == rect);
+	}
+
+	SUBCASE("Changed redraws rebuild the commands") {
+		rs->canvas_item_clear(item);
+		draw_panel(item, Color(0, 1, 0));
+		RSG::canvas->update();
+		CHECK(RSG::canvas->get_items_reused_in_frame() == 0);
+		CHECK(RSG::canvas->get_items_rebuilt_in_frame() == 1);
+		CHECK(RSG::canvas->_debug_canvas_item_get_rect(item) == rect);
+	}
+
+	SUBCASE("Invalid draw calls don't affect retained commands") {
+		rs->canvas_item_clear(item);
+		ERR_PRINT_OFF;
+		rs->canvas_item_add_triangle_array(item, Vector<int>(), Vector<Point2>(), Vector<Color>());
+		ERR_PRINT_ON;
+		draw_panel(item, Color(1, 0, 0));
+		RSG::canvas->update();
+		CHECK(RSG::canvas->get_items_reused_in_frame() == 1);
+		CHECK(RSG::canvas->get_items_rebuilt_in_frame() == 0);
+	}
+
+	SUBCASE("Shorter redraws drop the commands that weren't drawn again") {
+		rs->canvas_item_clear(item);
+		rs->canvas_item_add_rect(item, Rect2(0, 0, 100, 50), Color(1, 0, 0));
+		RSG::canvas->update();
+		CHECK(RSG::canvas->get_items_rebuilt_in_frame() == 1);
+		CHECK(RSG::canvas->_debug_canvas_item_get_rect(item).is_equal_approx(Rect2(0, 0, 100, 50)));
+	}
+
+	SUBCASE("Longer redraws keep the previous commands and append new ones") {
+		rs->canvas_item_clear(item);
+		draw_panel(item, Color(1, 0, 0));
+		rs->canvas_item_add_rect(item, Rect2(0, 0, 200, 50), Color(1, 0, 0));
+		RSG::canvas->update();
+		CHECK(RSG::canvas->get_items_rebuilt_in_frame() == 1);
+		CHECK(RSG::canvas->_debug_canvas_item_get_rect(item).is_equal_approx(Rect2(0, 0, 200, 120)));
+
+		rs->canvas_item_clear(item);
+		draw_panel(item, Color(1, 0, 0));
+		rs->canvas_item_add_rect(item, Rect2(0, 0, 200, 50), Color(1, 0, 0));
+		RSG::canvas->update();
+		CHECK(RSG::canvas->get_items_reused_in_frame() == 1);
+	}
+
+	rs->free(item);
+}
+
+} // namespace TestRendererCanvasCull
@@ -0,0 +1,85 @@
+/**************************************************************************/
+/*  test_renderer_scene_cull.cpp                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(test_renderer_scene_cull)
+
+#include "servers/rendering/rendering_server.h"
+
+namespace TestRendererSceneCull {
+
+TEST_CASE("[SceneTree][RendererSceneCull] Batched instance transforms") {
+	RenderingServer *rs = RenderingServer::get_singleton();
+	RID scenario = rs->scenario_create();
+	RID mesh = rs->mesh_create();
+
+	const int count = 3;
+	Vector<RID> instances;
+	Vector<Transform3D> transforms;
+	for (int i = 0; i < count; i++) {
+		RID instance = rs->instance_create2(mesh, scenario);
+		rs->instance_set_custom_aabb(instance, AABB(Vector3(-1, -1, -1), Vector3(2, 2, 2)));
+		rs->instance_attach_object_instance_id(instance, ObjectID(uint64_t(i + 1)));
+		instances.push_back(instance);
+		transforms.push_back(Transform3D(Basis(), Vector3(100 * (i + 1), 0, 0)));
+	}
+
+	rs->instances_set_transform(instances, transforms);
+	CHECK(rs->instances_cull_aabb(AABB(Vector3(-10, -10, -10), Vector3(20, 20, 20)), scenario).is_empty());
+	for (int i = 0; i < count; i++) {
+		const Vector<ObjectID> culled = rs->instances_cull_aabb(AABB(Vector3(100 * (i + 1) - 10, -10, -10), Vector3(20, 20, 20)), scenario);
+		REQUIRE(culled.size() == 1);
+		CHECK(culled[0] == ObjectID(uint64_t(i + 1)));
+	}
+
+	SUBCASE("Mismatched sizes are rejected") {
+		transforms.resize(count - 1);
+		ERR_PRINT_OFF;
+		rs->instances_set_transform(instances, transforms);
+		ERR_PRINT_ON;
+		CHECK(rs->instances_cull_aabb(AABB(Vector3(-10, -10, -10), Vector3(20, 20, 20)), scenario).is_empty());
+	}
+
+	SUBCASE("Matches setting each transform") {
+		transforms.write[1] = Transform3D();
+		rs->instances_set_transform(instances, transforms);
+		rs->instance_set_transform(instances[2], Transform3D());
+		CHECK(rs->instances_cull_aabb(AABB(Vector3(-10, -10, -10), Vector3(20, 20, 20)), scenario).size() == 2);
+	}
+
+	for (const RID &instance : instances) {
+		rs->free(instance);
+	}
+	rs->free(mesh);
+	rs->free(scenario);
+}
+
+} // namespace TestRendererSceneCull
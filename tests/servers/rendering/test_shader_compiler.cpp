@@ -0,0 +1,246 @@
+/**************************************************************************/
+/*  test_shader_compiler.cpp                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(test_shader_compiler)
+
+#include "core/io/dir_access.h"
+#include "core/os/os.h"
+#include "servers/rendering/shader_compiler.h"
+#include "tests/test_utils.h"
+
+namespace TestShaderCompiler {
+
+static const char *shader_code = R"(shader_type canvas_item;
+render_mode blend_add;
+
+uniform vec4 tint : source_color = vec4(1.0, 0.5, 0.25, 1.0);
+
+void fragment() {
+	COLOR *= tint * sin(TIME);
+}
+)";
+
+struct CompileResult {
+	Error error = FAILED;
+	ShaderCompiler::GeneratedCode gen_code;
+	int blend_mode = -1;
+	bool uses_time = false;
+	bool writes_color = false;
+	HashMap<StringName, ShaderLanguage::ShaderNode::Uniform> uniforms;
+};
+
+static CompileResult compile(const String &p_code, const ShaderCompiler::DefaultIdentifierActions &p_default_actions) {
+	ShaderCompiler compiler;
+	compiler.initialize(p_default_actions);
+
+	CompileResult result;
+	ShaderCompiler::IdentifierActions actions;
+	actions.render_mode_values["blend_mix"] = Pair<int *, int>(&result.blend_mode, 0);
+	actions.render_mode_values["blend_add"] = Pair<int *, int>(&result.blend_mode, 1);
+	actions.usage_flag_pointers["TIME"] = &result.uses_time;
+	actions.write_flag_pointers["COLOR"] = &result.writes_color;
+	actions.uniforms = &result.uniforms;
+	result.error = compiler.compile(RSE::SHADER_CANVAS_ITEM, p_code, &actions, "", result.gen_code);
+	return result;
+}
+
+TEST_CASE("[SceneTree][ShaderCompiler] Persistent compilation cache") {
+	const String cache_dir = TestUtils::get_temp_path("shader_compiler_cache");
+	Ref<DirAccess> da = DirAccess::create_for_path(cache_dir);
+	if (da->dir_exists(cache_dir) && da->change_dir(cache_dir) == OK) {
+		da->erase_contents_recursive();
+	}
+	ShaderCompiler::set_cache_dir(cache_dir);
+	REQUIRE(ShaderCompiler::get_cache_dir() == cache_dir);
+	ShaderCompiler::reset_cache_stats();
+
+	ShaderCompiler::DefaultIdentifierActions default_actions;
+	default_actions.render_mode_defines["blend_add"] = "#define MODE_BLEND_ADD\n";
+
+	const CompileResult first = compile(shader_code, default_actions);
+	REQUIRE(first.error == OK);
+	CHECK(ShaderCompiler::get_cache_hits() == 0);
+	CHECK(ShaderCompiler::get_cache_misses() == 1);
+	CHECK(first.blend_mode == 1);
+	CHECK(first.uses_time);
+	CHECK(first.writes_color);
+	REQUIRE(first.uniforms.has("tint"));
+
+	SUBCASE("Identical source is replayed from the cache") {
+		const CompileResult second = compile(shader_code, default_actions);
+		REQUIRE(second.error == OK);
+		CHECK(ShaderCompiler::get_cache_hits() == 1);
+		CHECK(ShaderCompiler::get_cache_misses() == 1);
+
+		CHECK(second.blend_mode == first.blend_mode);
+		CHECK(second.uses_time == first.uses_time);
+		CHECK(second.writes_color == first.writes_color);
+		CHECK(second.gen_code.defines == first.gen_code.defines);
+		CHECK(second.gen_code.uniforms == first.gen_code.uniforms);
+		CHECK(second.gen_code.uniform_offsets == first.gen_code.uniform_offsets);
+		CHECK(second.gen_code.uniform_total_size == first.gen_code.uniform_total_size);
+		REQUIRE(second.gen_code.code.size() == first.gen_code.code.size());
+		for (const KeyValue<String, String> &E : first.gen_code.code) {
+			CHECK(second.gen_code.code[E.key] == E.value);
+		}
+
+		REQUIRE(second.uniforms.has("tint"));
+		const ShaderLanguage::ShaderNode::Uniform &uniform = second.uniforms["tint"];
+		CHECK(uniform.type == ShaderLanguage::TYPE_VEC4);
+		CHECK(uniform.hint == ShaderLanguage::ShaderNode::Uniform::HINT_SOURCE_COLOR);
+		REQUIRE(uniform.default_value.size() == 4);
+		CHECK(uniform.default_value[1].real == doctest::Approx(0.5));
+	}
+
+	SUBCASE("Changed source misses the cache") {
+		const CompileResult second = compile(String(shader_code).replace("blend_add", "blend_mix"), default_actions);
+		REQUIRE(second.error == OK);
+		CHECK(ShaderCompiler::get_cache_hits() == 0);
+		CHECK(ShaderCompiler::get_cache_misses() == 2);
+		CHECK(second.blend_mode == 0);
+	}
+
+	SUBCASE("Changed identifier actions miss the cache") {
+		default_actions.render_mode_defines["blend_add"] = "#define MODE_ADDITIVE\n";
+		const CompileResult second = compile(shader_code, default_actions);
+		REQUIRE(second.error == OK);
+		CHECK(ShaderCompiler::get_cache_hits() == 0);
+		CHECK(ShaderCompiler::get_cache_misses() == 2);
+		CHECK(second.gen_code.defines.has("#define MODE_ADDITIVE\n"));
+	}
+
+	ShaderCompiler::set_cache_dir(String());
+	ShaderCompiler::reset_cache_stats();
+}
+
+TEST_CASE("[SceneTree][ShaderCompiler] Batch compilation matches serial compilation") {
+	// Doubles as a benchmark: run with `--test --test-case="*Batch compilation*" --success` to see the timings.
+	const int shader_count = 64;
+	LocalVector<String> codes;
+	for (int i = 0; i < shader_count; i++) {
+		String code = "shader_type spatial;\n";
+		code += vformat("uniform float scale = %d.0;\n", i);
+		code += "uniform sampler2D albedo_texture : source_color;\n";
+		for (int j = 0; j < 8; j++) {
+			code += vformat("vec3 layer_%d(vec2 uv) {\n\treturn texture(albedo_texture, uv * scale * %d.0).rgb * %d.0;\n}\n", j, j + 1, i + j);
+		}
+		code += "void fragment() {\n\tALBEDO = vec3(0.0);\n";
+		for (int j = 0; j < 8; j++) {
+			code += vformat("\tALBEDO += layer_%d(UV);\n", j);
+		}
+		code += "}\n";
+		codes.push_back(code);
+	}
+
+	ShaderCompiler::DefaultIdentifierActions default_actions;
+	default_actions.renames["ALBEDO"] = "albedo";
+	default_actions.renames["UV"] = "uv_interp";
+	ShaderCompiler compiler;
+	compiler.initialize(default_actions);
+
+	LocalVector<ShaderCompiler::GeneratedCode> serial_gen_code;
+	LocalVector<HashMap<StringName, ShaderLanguage::ShaderNode::Uniform>> serial_uniforms;
+	serial_gen_code.resize(shader_count);
+	serial_uniforms.resize(shader_count);
+	uint64_t serial_begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < shader_count; i++) {
+		ShaderCompiler::IdentifierActions actions;
+		actions.uniforms = &serial_uniforms[i];
+		REQUIRE(compiler.compile(RSE::SHADER_SPATIAL, codes[i], &actions, "", serial_gen_code[i]) == OK);
+	}
+	uint64_t serial_usec = OS::get_singleton()->get_ticks_usec() - serial_begin;
+
+	LocalVector<ShaderCompiler::GeneratedCode> batch_gen_code;
+	LocalVector<ShaderCompiler::IdentifierActions> batch_actions;
+	LocalVector<HashMap<StringName, ShaderLanguage::ShaderNode::Uniform>> batch_uniforms;
+	LocalVector<ShaderCompiler::BatchItem> items;
+	batch_gen_code.resize(shader_count);
+	batch_actions.resize(shader_count);
+	batch_uniforms.resize(shader_count);
+	items.resize(shader_count);
+	for (int i = 0; i < shader_count; i++) {
+		batch_actions[i].uniforms = &batch_uniforms[i];
+		items[i].mode = RSE::SHADER_SPATIAL;
+		items[i].code = codes[i];
+		items[i].actions = &batch_actions[i];
+		items[i].gen_code = &batch_gen_code[i];
+	}
+	uint64_t batch_begin = OS::get_singleton()->get_ticks_usec();
+	compiler.compile_batch(items);
+	uint64_t batch_usec = OS::get_singleton()->get_ticks_usec() - batch_begin;
+
+	MESSAGE(vformat("Compiled %d shaders in %d usec serially and in %d usec as a batch.", shader_count, serial_usec, batch_usec).utf8().get_data());
+
+	for (int i = 0; i < shader_count; i++) {
+		CHECK(items[i].error == OK);
+		CHECK(batch_gen_code[i].uniforms == serial_gen_code[i].uniforms);
+		CHECK(batch_gen_code[i].texture_uniforms.size() == serial_gen_code[i].texture_uniforms.size());
+		CHECK(batch_gen_code[i].code.size() == serial_gen_code[i].code.size());
+		for (const KeyValue<String, String> &E : serial_gen_code[i].code) {
+			CHECK(batch_gen_code[i].code[E.key] == E.value);
+		}
+		CHECK(batch_uniforms[i].size() == serial_uniforms[i].size());
+	}
+}
+
+TEST_CASE("[SceneTree][ShaderCompiler] Batch items can't share their outputs") {
+	ShaderCompiler compiler;
+	compiler.initialize(ShaderCompiler::DefaultIdentifierActions());
+
+	ShaderCompiler::GeneratedCode gen_code;
+	ShaderCompiler::IdentifierActions actions[2];
+	LocalVector<ShaderCompiler::BatchItem> items;
+	items.resize(2);
+	for (uint32_t i = 0; i < items.size(); i++) {
+		items[i].mode = RSE::SHADER_SPATIAL;
+		items[i].code = "shader_type spatial;\nvoid fragment() {\n\tALBEDO = vec3(1.0);\n}\n";
+		actions[i].entry_point_stages["fragment"] = ShaderCompiler::STAGE_FRAGMENT;
+		items[i].actions = &actions[i];
+		items[i].gen_code = &gen_code;
+	}
+
+	// Both items would be written to concurrently, so nothing is compiled.
+	ERR_PRINT_OFF;
+	compiler.compile_batch(items);
+	ERR_PRINT_ON;
+	CHECK(gen_code.code.is_empty());
+
+	ShaderCompiler::GeneratedCode other_gen_code;
+	items[1].gen_code = &other_gen_code;
+	compiler.compile_batch(items);
+	CHECK(items[0].error == OK);
+	CHECK(items[1].error == OK);
+	CHECK_FALSE(gen_code.code.is_empty());
+	CHECK_FALSE(other_gen_code.code.is_empty());
+}
+
+} // namespace TestShaderCompiler
@@ -0,0 +1,398 @@
+/**************************************************************************/
+/*  test_audio_server.cpp                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(test_audio_server)
+
+#include "core/io/marshalls.h"
+#include "core/os/os.h"
+#include "scene/resources/audio_stream_wav.h"
+#include "servers/audio/audio_driver_dummy.h"
+#include "servers/audio/audio_filter_sw.h"
+#include "servers/audio/audio_mix_simd.h"
+#include "servers/audio/audio_server.h"
+#include "servers/audio/effects/audio_effect_amplify.h"
+#include "servers/audio/effects/audio_effect_eq.h"
+#include "servers/audio/effects/audio_effect_reverb.h"
+
+namespace TestAudioServer {
+
+static Ref<AudioStreamWAV> make_tone(float p_frequency) {
+	const int mix_rate = 44100;
+	Vector<uint8_t> data;
+	data.resize(mix_rate * 2);
+	for (int i = 0; i < mix_rate; i++) {
+		const float wave = Math::sin(Math::TAU * p_frequency * i / mix_rate);
+		encode_uint16(uint16_t(int16_t(wave * 16000)), data.ptrw() + i * 2);
+	}
+
+	Ref<AudioStreamWAV> stream = memnew(AudioStreamWAV);
+	stream->set_mix_rate(mix_rate);
+	stream->set_format(AudioStreamWAV::FORMAT_16_BITS);
+	stream->set_data(data);
+	stream->set_loop_mode(AudioStreamWAV::LOOP_FORWARD);
+	stream->set_loop_end(mix_rate);
+	return stream;
+}
+
+// Drives the mix from the test instead of the dummy driver thread. Puts back the driver, the bus layout
+// and the mixing settings as they were when going out of scope, so other tests see the usual setup.
+class ManualMixScope {
+	AudioDriverDummy *driver = nullptr;
+	bool used_threads = true;
+	Ref<AudioBusLayout> bus_layout;
+	bool parallel_mixing = false;
+	int mix_buffer_size = AudioServer::DEFAULT_MIX_BUFFER_SIZE;
+	bool stream_lookahead = true;
+
+public:
+	ManualMixScope(AudioDriverDummy *p_driver) {
+		AudioServer *audio_server = AudioServer::get_singleton();
+		bus_layout = audio_server->generate_bus_layout();
+		parallel_mixing = audio_server->is_parallel_mixing_enabled();
+		mix_buffer_size = audio_server->thread_get_mix_buffer_size();
+		stream_lookahead = audio_server->is_stream_lookahead_enabled();
+
+		driver = p_driver;
+		used_threads = driver->is_using_threads();
+		driver->finish();
+		driver->set_use_threads(false);
+		driver->init();
+		driver->start();
+	}
+
+	~ManualMixScope() {
+		AudioServer *audio_server = AudioServer::get_singleton();
+		audio_server->set_parallel_mixing_enabled(parallel_mixing);
+		audio_server->set_mix_buffer_size(mix_buffer_size);
+		audio_server->set_stream_lookahead_enabled(stream_lookahead);
+		audio_server->set_bus_layout(bus_layout);
+
+		driver->finish();
+		driver->set_use_threads(used_threads);
+		driver->init();
+		driver->start();
+	}
+};
+
+// Mixes a soundscape of many voices through a small bus graph with effects.
+static Vector<int32_t> mix_soundscape(bool p_parallel, int p_voices, int p_frames, uint64_t &r_usec) {
+	AudioServer *audio_server = AudioServer::get_singleton();
+	AudioDriverDummy *driver = AudioDriverDummy::get_dummy_singleton();
+
+	audio_server->set_bus_count(1);
+	audio_server->set_bus_count(5);
+	const StringName bus_names[] = { "Music", "Effects", "Voices", "Ambience" };
+	for (int i = 0; i < 4; i++) {
+		audio_server->set_bus_name(i + 1, bus_names[i]);
+	}
+	audio_server->set_bus_send(3, "Effects");
+	audio_server->add_bus_effect(1, memnew(AudioEffectEQ10));
+	audio_server->add_bus_effect(2, memnew(AudioEffectReverb));
+	audio_server->add_bus_effect(3, memnew(AudioEffectAmplify));
+	audio_server->add_bus_effect(4, memnew(AudioEffectReverb));
+	audio_server->set_parallel_mixing_enabled(p_parallel);
+
+	Vector<AudioFrame> volumes;
+	volumes.resize(AudioServer::MAX_CHANNELS_PER_BUS);
+	volumes.fill(AudioFrame(0.05, 0.05));
+
+	LocalVector<Ref<AudioStreamPlayback>> playbacks;
+	for (int i = 0; i < p_voices; i++) {
+		Ref<AudioStreamPlayback> playback = make_tone(110 + i * 13)->instantiate_playback();
+		audio_server->start_playback_stream(playback, bus_names[i % 4], volumes, 0, 1.0 + i * 0.01);
+		playbacks.push_back(playback);
+	}
+
+	Vector<int32_t> output;
+	output.resize(p_frames * driver->get_channels());
+	const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	driver->mix_audio(p_frames, output.ptrw());
+	r_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	for (const Ref<AudioStreamPlayback> &playback : playbacks) {
+		audio_server->stop_playback_stream(playback);
+	}
+	// Let the playbacks fade out and leave the mix.
+	Vector<int32_t> flush;
+	flush.resize(audio_server->thread_get_mix_buffer_size() * 2 * driver->get_channels());
+	driver->mix_audio(audio_server->thread_get_mix_buffer_size() * 2, flush.ptrw());
+	return output;
+}
+
+TEST_CASE("[Audio][AudioServer] Parallel mixing matches serial mixing") {
+	AudioDriverDummy *driver = AudioDriverDummy::get_dummy_singleton();
+	REQUIRE(driver != nullptr);
+	ManualMixScope manual_mix(driver);
+
+	const int voices = 200;
+	const int frames = 44100 / 4;
+	uint64_t serial_usec = 0;
+	uint64_t parallel_usec = 0;
+	const Vector<int32_t> serial = mix_soundscape(false, voices, frames, serial_usec);
+	const Vector<int32_t> parallel = mix_soundscape(true, voices, frames, parallel_usec);
+
+	CHECK(serial.size() == parallel.size());
+	CHECK(serial == parallel);
+	bool silent = true;
+	for (const int32_t sample : serial) {
+		if (sample != 0) {
+			silent = false;
+			break;
+		}
+	}
+	CHECK_FALSE(silent);
+	MESSAGE(vformat("Mixed %d voices for %d frames: %d usec serial, %d usec parallel.", voices, frames, serial_usec, parallel_usec));
+}
+
+static bool frames_equal(const AudioFrame &p_a, const AudioFrame &p_b) {
+	// The vector kernels repeat the scalar operations in the same order and precision, and the build
+	// disables floating-point contraction, so their output must match bit for bit.
+	return p_a.left == p_b.left && p_a.right == p_b.right;
+}
+
+TEST_CASE("[AudioServer] Volume ramp kernel matches scalar mixing") {
+	const uint32_t frames = 37;
+	const uint32_t ramp_length = 512;
+	const uint32_t ramp_offset = 100;
+	const AudioFrame vol_start(0.25, 1.0);
+	const AudioFrame vol_final(0.75, -0.5);
+
+	LocalVector<AudioFrame> source;
+	LocalVector<AudioFrame> accumulated;
+	LocalVector<AudioFrame> expected;
+	for (uint32_t i = 0; i < frames; i++) {
+		source.push_back(AudioFrame(Math::sin(i * 0.1f), Math::cos(i * 0.3f)));
+		accumulated.push_back(AudioFrame(i * 0.01f, -(i * 0.02f)));
+		float lerp_param = (float)(ramp_offset + i) / ramp_length;
+		expected.push_back((vol_final * lerp_param + (1 - lerp_param) * vol_start) * source[i]);
+	}
+
+	LocalVector<AudioFrame> written;
+	written.resize(frames);
+	AudioMixSIMD::volume_ramp<false>(written.ptr(), source.ptr(), frames, vol_start, vol_final, ramp_offset, ramp_length);
+	AudioMixSIMD::volume_ramp<true>(accumulated.ptr(), source.ptr(), frames, vol_start, vol_final, ramp_offset, ramp_length);
+
+	bool written_matches = true;
+	bool accumulated_matches = true;
+	for (uint32_t i = 0; i < frames; i++) {
+		written_matches = written_matches && frames_equal(written[i], expected[i]);
+		accumulated_matches = accumulated_matches && frames_equal(accumulated[i], expected[i] + AudioFrame(i * 0.01f, -(i * 0.02f)));
+	}
+	CHECK(written_matches);
+	CHECK(accumulated_matches);
+}
+
+TEST_CASE("[AudioServer] Stereo filter kernel matches per-channel filtering") {
+	AudioFilterSW filter;
+	filter.set_mode(AudioFilterSW::HIGHSHELF);
+	filter.set_sampling_rate(44100);
+	filter.set_cutoff(3000);
+	filter.set_resonance(1);
+	filter.set_gain(0.3);
+
+	AudioFilterSW::Processor stereo[2];
+	AudioFilterSW::Processor reference[2];
+	for (int i = 0; i < 2; i++) {
+		stereo[i].set_filter(&filter);
+		stereo[i].update_coeffs(256);
+		reference[i].set_filter(&filter);
+		reference[i].update_coeffs(256);
+	}
+
+	const int frames = 256;
+	LocalVector<AudioFrame> filtered;
+	LocalVector<AudioFrame> expected;
+	for (int i = 0; i < frames; i++) {
+		AudioFrame frame(Math::sin(i * 0.7f), Math::sin(i * 0.05f));
+		filtered.push_back(frame);
+		reference[0].process_one_interp(frame.left);
+		reference[1].process_one_interp(frame.right);
+		expected.push_back(frame);
+	}
+	// Process in two calls to check that the filter state carries over.
+	AudioFilterSW::Processor::process_stereo_interp(&stereo[0], &stereo[1], filtered.ptr(), 100);
+	AudioFilterSW::Processor::process_stereo_interp(&stereo[0], &stereo[1], filtered.ptr() + 100, frames - 100);
+
+	bool matches = true;
+	for (int i = 0; i < frames; i++) {
+		matches = matches && frames_equal(filtered[i], expected[i]);
+	}
+	CHECK(matches);
+}
+
+TEST_CASE("[Audio][AudioServer][Benchmark] Offline mixing throughput") {
+	AudioDriverDummy *driver = AudioDriverDummy::get_dummy_singleton();
+	REQUIRE(driver != nullptr);
+	ManualMixScope manual_mix(driver);
+
+	const int voices = 64;
+	const int frames = 44100;
+	uint64_t usec = 0;
+	const Vector<int32_t> output = mix_soundscape(false, voices, frames, usec);
+	CHECK(output.size() == frames * driver->get_channels());
+	const double seconds = MAX(usec, (uint64_t)1) / 1000000.0;
+	MESSAGE(vformat("Mixed %d voices for %d frames in %d usec (%.0f frames per second, %.1fx realtime).", voices, frames, usec, frames / seconds, frames / seconds / driver->get_mix_rate()));
+}
+
+// Returns the number of output frames between starting an impulse and hearing it, in the worst case where a mix step just happened.
+static int measure_mix_latency(int p_buffer_size, bool p_lookahead) {
+	AudioServer *audio_server = AudioServer::get_singleton();
+	AudioDriverDummy *driver = AudioDriverDummy::get_dummy_singleton();
+	audio_server->set_bus_count(1);
+	audio_server->set_mix_buffer_size(p_buffer_size);
+	audio_server->set_stream_lookahead_enabled(p_lookahead);
+
+	const int impulse_frames = 8192;
+	Vector<uint8_t> data;
+	data.resize(impulse_frames * 2);
+	data.fill(0);
+	encode_uint16(uint16_t(16000), data.ptrw());
+	Ref<AudioStreamWAV> impulse = memnew(AudioStreamWAV);
+	impulse->set_mix_rate(driver->get_mix_rate());
+	impulse->set_format(AudioStreamWAV::FORMAT_16_BITS);
+	impulse->set_data(data);
+
+	const int channels = driver->get_channels();
+	Vector<int32_t> output;
+	output.resize(impulse_frames * channels);
+	// Leave all but one frame of a fresh mix step waiting in the buffer.
+	driver->mix_audio(1, output.ptrw());
+
+	Vector<AudioFrame> volumes;
+	volumes.resize(AudioServer::MAX_CHANNELS_PER_BUS);
+	volumes.fill(AudioFrame(1, 1));
+	Ref<AudioStreamPlayback> playback = impulse->instantiate_playback();
+	audio_server->start_playback_stream(playback, "Master", volumes);
+
+	const int chunk = 8;
+	int latency = -1;
+	for (int frame = 0; frame < impulse_frames && latency == -1; frame += chunk) {
+		driver->mix_audio(chunk, output.ptrw() + frame * channels);
+		for (int i = frame * channels; i < (frame + chunk) * channels; i++) {
+			if (output[i] != 0) {
+				latency = i / channels;
+				break;
+			}
+		}
+	}
+
+	audio_server->stop_playback_stream(playback);
+	driver->mix_audio(impulse_frames, output.ptrw());
+	return latency;
+}
+
+TEST_CASE("[Audio][AudioServer] Mix buffer size bounds the mixing latency") {
+	AudioDriverDummy *driver = AudioDriverDummy::get_dummy_singleton();
+	REQUIRE(driver != nullptr);
+	ManualMixScope manual_mix(driver);
+
+	AudioServer *audio_server = AudioServer::get_singleton();
+	const int buffer_sizes[] = { AudioServer::DEFAULT_MIX_BUFFER_SIZE, 256, 64, AudioServer::MIN_MIX_BUFFER_SIZE };
+	int previous_latency[2] = { INT_MAX, INT_MAX };
+	for (const int buffer_size : buffer_sizes) {
+		for (const bool lookahead : { true, false }) {
+			const int latency = measure_mix_latency(buffer_size, lookahead);
+			// The resampler history adds a couple of frames on top of the mix step.
+			CHECK(latency >= buffer_size - 1);
+			CHECK(latency <= audio_server->get_mix_latency_frames() + 2);
+			MESSAGE(vformat("Mix buffer of %d frames, lookahead %s: %d frames (%.2f ms) of mixing latency.", buffer_size, lookahead ? "on" : "off", latency, latency * 1000.0 / driver->get_mix_rate()));
+			CHECK(latency < previous_latency[lookahead]);
+			previous_latency[lookahead] = latency;
+		}
+	}
+}
+
+TEST_CASE("[Audio][AudioServer] Streams ending with short mix buffers fade out completely") {
+	AudioDriverDummy *driver = AudioDriverDummy::get_dummy_singleton();
+	REQUIRE(driver != nullptr);
+	ManualMixScope manual_mix(driver);
+
+	AudioServer *audio_server = AudioServer::get_singleton();
+	audio_server->set_bus_count(1);
+	audio_server->set_stream_lookahead_enabled(true);
+
+	// A constant signal that stops abruptly, so the only way down to silence is the fade-out.
+	const int stream_frames = 2048;
+	Vector<uint8_t> data;
+	data.resize(stream_frames * 2);
+	for (int i = 0; i < stream_frames; i++) {
+		encode_uint16(uint16_t(16000), data.ptrw() + i * 2);
+	}
+	Ref<AudioStreamWAV> stream = memnew(AudioStreamWAV);
+	stream->set_mix_rate(driver->get_mix_rate());
+	stream->set_format(AudioStreamWAV::FORMAT_16_BITS);
+	stream->set_data(data);
+
+	Vector<AudioFrame> volumes;
+	volumes.resize(AudioServer::MAX_CHANNELS_PER_BUS);
+	volumes.fill(AudioFrame(1, 1));
+
+	const int channels = driver->get_channels();
+	const int output_frames = stream_frames + 1024;
+	Vector<int32_t> output;
+	output.resize(output_frames * channels);
+
+	// Shorter mix buffers than the lookahead buffer take several mix steps to output it.
+	const int buffer_sizes[] = { 64, AudioServer::MIN_MIX_BUFFER_SIZE };
+	for (const int buffer_size : buffer_sizes) {
+		audio_server->set_mix_buffer_size(buffer_size);
+		output.fill(0);
+
+		Ref<AudioStreamPlayback> playback = stream->instantiate_playback();
+		audio_server->start_playback_stream(playback, "Master", volumes);
+		driver->mix_audio(output_frames, output.ptrw());
+		CHECK_FALSE_MESSAGE(audio_server->is_playback_active(playback), vformat("The playback should be removed once it has ended, with a mix buffer of %d frames.", buffer_size));
+
+		int first_heard = -1;
+		int last_heard = -1;
+		int32_t peak = 0;
+		for (int i = 0; i < output_frames; i++) {
+			const int32_t level = Math::abs(output[i * channels]);
+			if (level == 0) {
+				continue;
+			}
+			if (first_heard == -1) {
+				first_heard = i;
+			}
+			last_heard = i;
+			peak = MAX(peak, level);
+		}
+		REQUIRE(first_heard != -1);
+
+		// The resampler may shave a couple of frames off the end of the stream, the lookahead buffer must not be dropped.
+		CHECK_MESSAGE(last_heard - first_heard + 1 >= stream_frames - 4, vformat("All of the stream should be heard with a mix buffer of %d frames.", buffer_size));
+		// 0.94 ^ 64 is about 2% of the level it started fading from.
+		CHECK_MESSAGE(Math::abs(output[last_heard * channels]) < peak / 20, vformat("The stream should fade out to near silence with a mix buffer of %d frames.", buffer_size));
+	}
+}
+
+} // namespace TestAudioServer
@@ -36,7 +36,10 @@ TEST_FORCE_LINK(test_navigation_server_3d)
 
 #ifdef MODULE_NAVIGATION_3D_ENABLED
 
+#include "core/config/project_settings.h"
+#include "core/math/random_pcg.h"
 #include "core/object/callable_mp.h"
+#include "core/os/os.h"
 #include "scene/3d/mesh_instance_3d.h"
 #include "scene/main/scene_tree.h"
 #include "scene/main/window.h"
@@ -60,6 +63,53 @@ public:
 	Variant function1_latest_arg0;
 };
 
+// A grid of 1x1 cells crossed by a wall every `p_wall_spacing` rows, each wall with a single gap on alternating sides.
+static Ref<NavigationMesh> create_walled_grid_navigation_mesh(int p_grid_size, int p_wall_spacing) {
+	Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+	Vector<Vector3> vertices;
+	for (int z = 0; z <= p_grid_size; z++) {
+		for (int x = 0; x <= p_grid_size; x++) {
+			vertices.push_back(Vector3(x, 0, z));
+		}
+	}
+	navigation_mesh->set_vertices(vertices);
+	for (int z = 0; z < p_grid_size; z++) {
+		const bool is_wall = z % p_wall_spacing == p_wall_spacing - 1;
+		const int gap_x = (z / p_wall_spacing) % 2 == 0 ? p_grid_size - 2 : 1;
+		for (int x = 0; x < p_grid_size; x++) {
+			if (is_wall && x != gap_x) {
+				continue;
+			}
+			Vector<int> polygon;
+			polygon.push_back(z * (p_grid_size + 1) + x);
+			polygon.push_back(z * (p_grid_size + 1) + x + 1);
+			polygon.push_back((z + 1) * (p_grid_size + 1) + x + 1);
+			polygon.push_back((z + 1) * (p_grid_size + 1) + x);
+			navigation_mesh->add_polygon(polygon);
+		}
+	}
+	return navigation_mesh;
+}
+
+// Two maps with the same navigation mesh, the first one searching every polygon and the second one through clusters.
+static void create_cluster_comparison_maps(const Ref<NavigationMesh> &p_navigation_mesh, real_t p_cluster_size, RID r_maps[2], RID r_regions[2]) {
+	NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+	const Variant old_cluster_size = GLOBAL_GET("navigation/3d/path_search_cluster_size");
+	for (int i = 0; i < 2; i++) {
+		ProjectSettings::get_singleton()->set_setting("navigation/3d/path_search_cluster_size", i == 0 ? 0.0 : p_cluster_size);
+		r_maps[i] = navigation_server->map_create();
+		r_regions[i] = navigation_server->region_create();
+		navigation_server->map_set_cell_size(r_maps[i], 0.25);
+		navigation_server->map_set_active(r_maps[i], true);
+		navigation_server->map_set_use_async_iterations(r_maps[i], false);
+		navigation_server->region_set_use_async_iterations(r_regions[i], false);
+		navigation_server->region_set_map(r_regions[i], r_maps[i]);
+		navigation_server->region_set_navigation_mesh(r_regions[i], p_navigation_mesh);
+	}
+	ProjectSettings::get_singleton()->set_setting("navigation/3d/path_search_cluster_size", old_cluster_size);
+	navigation_server->physics_process(0.0); // Give server some cycles to commit.
+}
+
 TEST_SUITE("[Navigation3D]") {
 	TEST_CASE("[NavigationServer3D] Server should be empty when initialized") {
 		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
@@ -426,6 +476,78 @@ TEST_SUITE("[Navigation3D]") {
 		navigation_server->free_rid(map);
 	}
 
+	TEST_CASE("[NavigationServer3D] Server should step large crowds of avoidance agents") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		RID map = navigation_server->map_create();
+		navigation_server->map_set_active(map, true);
+
+		// A block of agents walking along +X, every one of them with neighbors in the surrounding grid cells.
+		const int crowd_width = 50;
+		const int crowd_depth = 40;
+		CallableMock crowd_avoidance_callback_mock;
+		LocalVector<RID> crowd_agents;
+		for (int x = 0; x < crowd_width; x++) {
+			for (int z = 0; z < crowd_depth; z++) {
+				RID agent = navigation_server->agent_create();
+				navigation_server->agent_set_map(agent, map);
+				navigation_server->agent_set_avoidance_enabled(agent, true);
+				navigation_server->agent_set_position(agent, Vector3(x * 3.0, 0, z * 3.0));
+				navigation_server->agent_set_radius(agent, 0.5);
+				navigation_server->agent_set_neighbor_distance(agent, 5.0);
+				navigation_server->agent_set_velocity(agent, Vector3(1, 0, 0));
+				navigation_server->agent_set_avoidance_callback(agent, callable_mp(&crowd_avoidance_callback_mock, &CallableMock::function1));
+				crowd_agents.push_back(agent);
+			}
+		}
+
+		// Two agents walking into each other next to the crowd, far from the origin of the grid.
+		RID agent_1 = navigation_server->agent_create();
+		RID agent_2 = navigation_server->agent_create();
+		navigation_server->agent_set_map(agent_1, map);
+		navigation_server->agent_set_avoidance_enabled(agent_1, true);
+		navigation_server->agent_set_position(agent_1, Vector3(500, 0, 500));
+		navigation_server->agent_set_radius(agent_1, 1);
+		navigation_server->agent_set_velocity(agent_1, Vector3(1, 0, 0));
+		CallableMock agent_1_avoidance_callback_mock;
+		navigation_server->agent_set_avoidance_callback(agent_1, callable_mp(&agent_1_avoidance_callback_mock, &CallableMock::function1));
+		navigation_server->agent_set_map(agent_2, map);
+		navigation_server->agent_set_avoidance_enabled(agent_2, true);
+		navigation_server->agent_set_position(agent_2, Vector3(502.5, 0, 500.5));
+		navigation_server->agent_set_radius(agent_2, 1);
+		navigation_server->agent_set_velocity(agent_2, Vector3(-1, 0, 0));
+		CallableMock agent_2_avoidance_callback_mock;
+		navigation_server->agent_set_avoidance_callback(agent_2, callable_mp(&agent_2_avoidance_callback_mock, &CallableMock::function1));
+
+		const int steps = 10;
+		const uint64_t start_usec = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < steps; i++) {
+			navigation_server->physics_process(1.0 / 60.0);
+		}
+		const uint64_t elapsed_usec = OS::get_singleton()->get_ticks_usec() - start_usec;
+		MESSAGE("Avoidance step with ", crowd_agents.size() + 2, " agents took ", elapsed_usec / steps, " usec on average.");
+
+		CHECK_EQ(crowd_avoidance_callback_mock.function1_calls, crowd_agents.size() * steps);
+		CHECK_EQ(agent_1_avoidance_callback_mock.function1_calls, steps);
+		CHECK_EQ(agent_2_avoidance_callback_mock.function1_calls, steps);
+
+		Vector3 agent_1_safe_velocity = agent_1_avoidance_callback_mock.function1_latest_arg0;
+		Vector3 agent_2_safe_velocity = agent_2_avoidance_callback_mock.function1_latest_arg0;
+		CHECK_MESSAGE(agent_1_safe_velocity.z < 0, "agent 1 should move a bit to the side so that it avoids agent 2");
+		CHECK_MESSAGE(agent_2_safe_velocity.z > 0, "agent 2 should move a bit to the side so that it avoids agent 1");
+
+		// Crowd agents are spread out wider than their radius and shouldn't need to leave their lane.
+		Vector3 crowd_safe_velocity = crowd_avoidance_callback_mock.function1_latest_arg0;
+		CHECK(crowd_safe_velocity.is_equal_approx(Vector3(1, 0, 0)));
+
+		navigation_server->free_rid(agent_2);
+		navigation_server->free_rid(agent_1);
+		for (const RID &agent : crowd_agents) {
+			navigation_server->free_rid(agent);
+		}
+		navigation_server->free_rid(map);
+	}
+
 	TEST_CASE("[NavigationServer3D] Server should make agents avoid dynamic obstacles when avoidance enabled") {
 		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
 
@@ -834,6 +956,142 @@ TEST_SUITE("[Navigation3D]") {
 	}
 	*/
 
+	TEST_CASE("[NavigationServer3D] Server should find paths through polygon clusters") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		const Ref<NavigationMesh> navigation_mesh = create_walled_grid_navigation_mesh(60, 15);
+
+		RID maps[2];
+		RID regions[2];
+		create_cluster_comparison_maps(navigation_mesh, 8.0, maps, regions);
+
+		const Vector3 starts[] = { Vector3(0.5, 0, 0.5), Vector3(30.5, 0, 5.5), Vector3(59.5, 0, 59.5) };
+		const Vector3 targets[] = { Vector3(59.5, 0, 59.5), Vector3(2.5, 0, 50.5), Vector3(10.5, 0, 20.5) };
+		for (int i = 0; i < 3; i++) {
+			Vector<Vector3> full_path = navigation_server->map_get_path(maps[0], starts[i], targets[i], true);
+			Vector<Vector3> cluster_path = navigation_server->map_get_path(maps[1], starts[i], targets[i], true);
+			REQUIRE_GE(full_path.size(), 2);
+			REQUIRE_GE(cluster_path.size(), 2);
+			CHECK(cluster_path[cluster_path.size() - 1].is_equal_approx(full_path[full_path.size() - 1]));
+
+			real_t full_length = 0.0;
+			for (int j = 1; j < full_path.size(); j++) {
+				full_length += full_path[j - 1].distance_to(full_path[j]);
+			}
+			real_t cluster_length = 0.0;
+			for (int j = 1; j < cluster_path.size(); j++) {
+				cluster_length += cluster_path[j - 1].distance_to(cluster_path[j]);
+			}
+			CHECK_LE(cluster_length, full_length * 1.25);
+		}
+
+		// Targets off the navigation mesh still end up at the closest reachable point.
+		Vector<Vector3> full_path = navigation_server->map_get_path(maps[0], Vector3(0.5, 0, 0.5), Vector3(30.5, 0, 100.0), true);
+		Vector<Vector3> cluster_path = navigation_server->map_get_path(maps[1], Vector3(0.5, 0, 0.5), Vector3(30.5, 0, 100.0), true);
+		REQUIRE_GE(full_path.size(), 2);
+		REQUIRE_GE(cluster_path.size(), 2);
+		CHECK(cluster_path[cluster_path.size() - 1].is_equal_approx(full_path[full_path.size() - 1]));
+
+		for (int i = 0; i < 2; i++) {
+			navigation_server->free_rid(regions[i]);
+			navigation_server->free_rid(maps[i]);
+		}
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D] Server should find the same paths through polygon clusters on large navigation meshes") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		const int grid_size = 300;
+		const Ref<NavigationMesh> navigation_mesh = create_walled_grid_navigation_mesh(grid_size, 20);
+
+		RID maps[2];
+		RID regions[2];
+		create_cluster_comparison_maps(navigation_mesh, 16.0, maps, regions);
+
+		// Long queries across most of the walls, each between different cells so the cluster route cache can't answer them.
+		const int query_count = 20;
+		RandomPCG rng(1234);
+		LocalVector<Vector3> starts;
+		LocalVector<Vector3> targets;
+		for (int i = 0; i < query_count; i++) {
+			starts.push_back(Vector3(rng.random(0, grid_size - 1) + 0.5, 0, rng.random(0, 18) + 0.5));
+			targets.push_back(Vector3(rng.random(0, grid_size - 1) + 0.5, 0, rng.random(grid_size - 18, grid_size - 1) + 0.5));
+		}
+
+		uint64_t elapsed_usec[2] = {};
+		Vector<Vector3> last_points[2];
+		for (int i = 0; i < 2; i++) {
+			const uint64_t start_usec = OS::get_singleton()->get_ticks_usec();
+			for (int j = 0; j < query_count; j++) {
+				const Vector<Vector3> path = navigation_server->map_get_path(maps[i], starts[j], targets[j], true);
+				last_points[i].push_back(path.is_empty() ? Vector3() : path[path.size() - 1]);
+			}
+			elapsed_usec[i] = OS::get_singleton()->get_ticks_usec() - start_usec;
+		}
+
+		for (int j = 0; j < query_count; j++) {
+			CHECK(last_points[1][j].is_equal_approx(last_points[0][j]));
+		}
+
+		MESSAGE("Path queries on a ", navigation_mesh->get_polygon_count(), " polygon navigation mesh took ", elapsed_usec[0] / query_count, " usec on average searching every polygon and ", elapsed_usec[1] / query_count, " usec searching through clusters.");
+
+		for (int i = 0; i < 2; i++) {
+			navigation_server->free_rid(regions[i]);
+			navigation_server->free_rid(maps[i]);
+		}
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D] Server should answer batched path queries like single ones") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+		Ref<NavigationMeshSourceGeometryData3D> source_geometry = memnew(NavigationMeshSourceGeometryData3D);
+
+		Array arr;
+		arr.resize(RSE::ARRAY_MAX);
+		BoxMesh::create_mesh_array(arr, Vector3(20.0, 0.001, 20.0));
+		source_geometry->add_mesh_array(arr, Transform3D());
+		navigation_server->bake_from_source_geometry_data(navigation_mesh, source_geometry, Callable());
+		CHECK_NE(navigation_mesh->get_polygon_count(), 0);
+
+		RID map = navigation_server->map_create();
+		RID region = navigation_server->region_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->map_set_use_async_iterations(map, false);
+		navigation_server->region_set_use_async_iterations(region, false);
+		navigation_server->region_set_map(region, map);
+		navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+
+		TypedArray<NavigationPathQueryParameters3D> batch_parameters;
+		TypedArray<NavigationPathQueryResult3D> batch_results;
+		for (int i = 0; i < 64; i++) {
+			Ref<NavigationPathQueryParameters3D> query_parameters = memnew(NavigationPathQueryParameters3D);
+			query_parameters->set_map(map);
+			query_parameters->set_start_position(Vector3(-9.0 + (i % 8) * 0.5, 0, -9.0));
+			query_parameters->set_target_position(Vector3(9.0, 0, 9.0 - (i / 8) * 2.0));
+			batch_parameters.push_back(query_parameters);
+			batch_results.push_back(Ref<NavigationPathQueryResult3D>(memnew(NavigationPathQueryResult3D)));
+		}
+
+		navigation_server->query_paths(batch_parameters, batch_results);
+
+		for (int i = 0; i < batch_parameters.size(); i++) {
+			Ref<NavigationPathQueryResult3D> single_result = memnew(NavigationPathQueryResult3D);
+			navigation_server->query_path(batch_parameters[i], single_result);
+			Ref<NavigationPathQueryResult3D> batch_result = batch_results[i];
+			CHECK_NE(single_result->get_path().size(), 0);
+			CHECK_EQ(batch_result->get_path(), single_result->get_path());
+			CHECK_EQ(batch_result->get_path_rids(), single_result->get_path_rids());
+			CHECK(Math::is_equal_approx(batch_result->get_path_length(), single_result->get_path_length()));
+		}
+
+		navigation_server->free_rid(region);
+		navigation_server->free_rid(map);
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+	}
+
 	TEST_CASE("[NavigationServer3D] Server should simplify path properly") {
 		real_t simplify_epsilon = 0.2;
 		Vector<Vector3> source_path;